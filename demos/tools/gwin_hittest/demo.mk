@@ -0,0 +1,3 @@
+DEMODIR = $(GFXLIB)/demos/tools/gwin_hittest
+GFXINC +=   $(DEMODIR)
+GFXSRC +=	$(DEMODIR)/main.c
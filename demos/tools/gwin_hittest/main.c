@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2012, 2013, Joel Bodenmann aka Tectu <joel@unormal.org>
+ * Copyright (c) 2012, 2013, Andrew Hannam aka inmarket
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of the <organization> nor the
+ *      names of its contributors may be used to endorse or promote products
+ *      derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * GWIN hit-test benchmark.
+ *
+ * A grid of buttons is created and the time taken to find the window under random points is
+ * measured for an increasing number of buttons. Each point is found both with gwinFindWindowAt()
+ * and with a scan of every window (which is what widget mouse handling did before the spatial index).
+ *
+ * Compare the results with GWIN_NEED_SPATIAL_INDEX set to TRUE and FALSE in gfxconf.h.
+ */
+
+#include "gfx.h"
+#include <stdlib.h>
+
+#define MAX_BUTTONS		1024
+#define TEST_TIME		500					// Test each count for at least this many milliseconds
+#define TEST_BATCH		1000				// Test this many points between checking the time
+
+static GButtonObject	buttons[MAX_BUTTONS];
+static const unsigned	counts[] = { 16, 64, 256, 1024 };
+static uint32_t			tindex[sizeof(counts)/sizeof(counts[0])];
+static uint32_t			tscan[sizeof(counts)/sizeof(counts[0])];
+static coord_t			width, height;
+
+// What the widget mouse code used to do - test every window in the system
+static GHandle scanWindowAt(GDisplay *g, coord_t x, coord_t y) {
+	GHandle		gh, h;
+
+	for(gh = 0, h = gwinGetNextWindow(0); h; h = gwinGetNextWindow(h)) {
+		if (h->display == g && gwinGetVisible(h)
+				&& x >= h->x && x < h->x + h->width && y >= h->y && y < h->y + h->height)
+			gh = h;
+	}
+	return gh;
+}
+
+// Returns the number of nanoseconds per hit-test
+static uint32_t timeHits(bool_t useIndex) {
+	systemticks_t	start, elapsed;
+	uint32_t		hits;
+	unsigned		i;
+	coord_t			x, y;
+
+	srand(1);
+	hits = 0;
+	start = gfxSystemTicks();
+	do {
+		for(i = 0; i < TEST_BATCH; i++) {
+			x = rand() % width;
+			y = rand() % height;
+			if (useIndex)
+				gwinFindWindowAt(GDISP, x, y);
+			else
+				scanWindowAt(GDISP, x, y);
+		}
+		hits += TEST_BATCH;
+		elapsed = gfxSystemTicks() - start;
+	} while(elapsed < gfxMillisecondsToTicks(TEST_TIME));
+	return (uint32_t)((uint64_t)elapsed * 1000000000 / gfxMillisecondsToTicks(1000) / hits);
+}
+
+int main(void) {
+	GWidgetInit		wi;
+	font_t			font;
+	unsigned		c, i, cols, rows;
+	char			buf[64];
+
+	gfxInit();
+	width = gdispGetWidth();
+	height = gdispGetHeight();
+	font = gdispOpenFont("UI2");
+	gwinSetDefaultFont(font);
+
+	for(c = 0; c < sizeof(counts)/sizeof(counts[0]); c++) {
+		// Lay the buttons out in a grid that fills the display
+		for(cols = 1; cols * cols < counts[c]; cols++);
+		rows = (counts[c] + cols - 1) / cols;
+		gwinWidgetClearInit(&wi);
+		wi.g.show = TRUE;
+		wi.text = "";
+		wi.g.width = width / cols;
+		wi.g.height = height / rows;
+		for(i = 0; i < counts[c]; i++) {
+			wi.g.x = (i % cols) * wi.g.width;
+			wi.g.y = (i / cols) * wi.g.height;
+			gwinButtonCreate(&buttons[i], &wi);
+		}
+
+		tindex[c] = timeHits(TRUE);
+		tscan[c] = timeHits(FALSE);
+
+		for(i = 0; i < counts[c]; i++)
+			gwinDestroy(&buttons[i].w.g);
+
+		// Show the results so far
+		gdispClear(White);
+		for(i = 0; i <= c; i++) {
+			snprintg(buf, sizeof(buf), "%u buttons: %u ns find, %u ns scan", counts[i], tindex[i], tscan[i]);
+			gdispDrawString(0, i * (gdispGetFontMetric(font, fontHeight) + 2), buf, font, Black);
+		}
+	}
+
+	while(TRUE)
+		gfxSleepMilliseconds(500);
+}
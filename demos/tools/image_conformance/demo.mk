@@ -0,0 +1,3 @@
+DEMODIR = $(GFXLIB)/demos/tools/image_conformance
+GFXINC +=   $(DEMODIR)
+GFXSRC +=	$(DEMODIR)/main.c
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2012, 2013, Joel Bodenmann aka Tectu <joel@unormal.org>
+ * Copyright (c) 2012, 2013, Andrew Hannam aka inmarket
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of the <organization> nor the
+ *      names of its contributors may be used to endorse or promote products
+ *      derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * Image decoder conformance and speed test.
+ *
+ * Generate the corpus on the host with "mkcorpus.py <dir>" and run this from that directory.
+ * Each image listed in corpus.txt is decoded (every frame for an animated image) into a pixmap
+ * and a hash of the result is compared against the reference hash in corpus.txt. Each image is
+ * then repeatedly decoded to measure the speed. The peak decoder RAM is also reported.
+ *
+ * A reference hash of "-" just prints the hash of what was decoded. Images that use a format
+ * feature that is not supported (or not turned on in gfxconf.h) are reported but don't fail.
+ */
+
+#include "gfx.h"
+#include <string.h>
+
+#define MANIFEST		"corpus.txt"
+#define BGCOLOR			HTML2COLOR(0x336699)		// Must match BGCOLOR in mkcorpus.py
+#define MAX_FRAMES		64							// Stop an animated image after this many frames
+#define SPEED_TIME		250							// Decode each image for at least this many milliseconds
+
+static char		manifest[8192];
+static unsigned	files, failed, unsupported;
+
+typedef struct result {
+	uint32_t		hash;
+	unsigned		frames;
+	uint32_t		peakmem;
+	long int		filesize;
+	} result;
+
+// A 32 bit FNV-1a hash of the pixel colors
+static uint32_t hashPixels(const pixel_t *p, unsigned cnt, uint32_t hash) {
+	for(; cnt; cnt--, p++) {
+		hash = (hash ^ RED_OF(*p)) * 0x01000193;
+		hash = (hash ^ GREEN_OF(*p)) * 0x01000193;
+		hash = (hash ^ BLUE_OF(*p)) * 0x01000193;
+	}
+	return hash;
+}
+
+// Decode every frame of an image into the pixmap. If res is not NULL the frames are hashed.
+static gdispImageError decodeImage(const char *name, GDisplay **ppix, result *res) {
+	gdispImage			img;
+	gdispImageError		err;
+	unsigned			frames;
+
+	gdispImageInit(&img);
+	if ((err = gdispImageOpenFile(&img, name)))
+		return err;
+
+	// Create the pixmap the first time
+	if (!*ppix && !(*ppix = gdispPixmapCreate(img.width, img.height))) {
+		gdispImageClose(&img);
+		return GDISP_IMAGE_ERR_NOMEMORY;
+	}
+	gdispImageSetBgColor(&img, BGCOLOR);
+	gdispGFillArea(*ppix, 0, 0, img.width, img.height, BGCOLOR);
+
+	if (res) {
+		res->hash = 0x811C9DC5;
+		res->filesize = gfileGetSize(img.f);
+	}
+	for(frames = 1; ; frames++) {
+		if ((err = gdispGImageDraw(*ppix, &img, 0, 0, img.width, img.height, 0, 0)))
+			break;
+		if (res)
+			res->hash = hashPixels(gdispPixmapGetBits(*ppix), img.width*img.height, res->hash);
+		if (frames >= MAX_FRAMES || gdispImageNext(&img) == TIME_INFINITE)
+			break;
+	}
+	if (res) {
+		res->frames = frames;
+		res->peakmem = img.maxmemused;
+	}
+
+	gdispImageClose(&img);
+	return err;
+}
+
+static void testImage(const char *name, const char *refhash) {
+	GDisplay *			pix;
+	gdispImageError		err;
+	result				res;
+	systemticks_t		start, elapsed;
+	uint32_t			ms, count, rate;
+	bool_t				ok;
+	char				hash[9];
+	unsigned			i;
+
+	files++;
+	pix = 0;
+	if ((err = decodeImage(name, &pix, &res))) {
+		if (err == GDISP_IMAGE_ERR_UNSUPPORTED) {
+			fprintg(gfileStdOut, "%-24s UNSUPPORTED\n", name);
+			unsupported++;
+		} else {
+			fprintg(gfileStdOut, "%-24s FAIL error %d\n", name, err);
+			failed++;
+		}
+		if (pix)
+			gdispPixmapDelete(pix);
+		return;
+	}
+
+	// Show it
+	gdispBlitArea(0, 0, gdispGGetWidth(pix), gdispGGetHeight(pix), gdispPixmapGetBits(pix));
+
+	// Check the result
+	for(i = 0; i < 8; i++)
+		hash[i] = "0123456789abcdef"[(res.hash >> (28 - i*4)) & 0x0F];
+	hash[8] = 0;
+	ok = refhash[0] == '-' || !strcmp(hash, refhash);
+	if (!ok)
+		failed++;
+
+	// Now see how fast it is
+	count = 0;
+	start = gfxSystemTicks();
+	do {
+		decodeImage(name, &pix, 0);
+		count++;
+		elapsed = gfxSystemTicks() - start;
+	} while(elapsed < gfxMillisecondsToTicks(SPEED_TIME));
+	ms = elapsed * 1000 / gfxMillisecondsToTicks(1000);
+	if (!ms)
+		ms = 1;
+	rate = (uint32_t)res.filesize * count / ms;			// bytes per millisecond = kB/s
+
+	fprintg(gfileStdOut, "%-24s %-4s %s %3ux%-3u %2u frames %6u us %3u.%02u MB/s %7u bytes peak RAM\n",
+		name, refhash[0] == '-' ? "HASH" : (ok ? "OK" : "FAIL"), hash,
+		gdispGGetWidth(pix), gdispGGetHeight(pix), res.frames,
+		ms * 1000 / count, rate / 1000, (rate % 1000) / 10, res.peakmem);
+
+	gdispPixmapDelete(pix);
+}
+
+int main(void) {
+	GFILE *		f;
+	char *		p;
+	char *		name;
+	char *		refhash;
+	int			len;
+
+	gfxInit();
+	gdispClear(Black);
+
+	if (!(f = gfileOpen(MANIFEST, "r"))) {
+		fprintg(gfileStdOut, "Can't open %s - run mkcorpus.py first\n", MANIFEST);
+		gfxHalt(0);
+	}
+	len = gfileRead(f, manifest, sizeof(manifest)-1);
+	gfileClose(f);
+	manifest[len > 0 ? len : 0] = 0;
+
+	// Each line is "<filename> <hash>"
+	for(p = manifest; *p; ) {
+		name = p;
+		while(*p && *p != ' ' && *p != '\n') p++;
+		if (*p == ' ') *p++ = 0;
+		refhash = p;
+		while(*p && *p != '\n' && *p != '\r') p++;
+		while(*p == '\n' || *p == '\r') *p++ = 0;
+		if (!*name || !*refhash)
+			continue;
+
+		testImage(name, refhash);
+	}
+
+	fprintg(gfileStdOut, "%u images, %u failed, %u unsupported\n", files, failed, unsupported);
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,505 @@
+#!/usr/bin/env python3
+#
+# This file is subject to the terms of the GFX License. If a copy of
+# the license was not distributed with this file, you can obtain one at:
+#
+#              http://ugfx.org/license.html
+#
+# Generate the image decoder conformance corpus.
+#
+# Usage: mkcorpus.py [directory]
+#
+# Every image is generated from known pixels so the expected result of decoding it is also known.
+# The expected result is written as a hash into corpus.txt alongside the images. The hash is a
+# 32 bit FNV-1a over the R, G, B bytes of every pixel of every frame (top to bottom, left to right)
+# as drawn into a pixmap that was first filled with the background color (BGCOLOR).
+#
+# Where a file format stores less than 8 bits per color component the expected color is the one
+# that uGFX defines for that conversion (eg. 5 bit BMP components are shifted left by 3).
+# Transparent pixels leave the background color. Partial PNG alpha above
+# GDISP_NEED_IMAGE_PNG_ALPHACLIFF draws the color unblended as there is no bKGD chunk.
+
+import os, struct, sys, zlib
+
+BGCOLOR = (0x33, 0x66, 0x99)	# Must match BGCOLOR in main.c
+ALPHACLIFF = 32					# Must match GDISP_NEED_IMAGE_PNG_ALPHACLIFF
+
+#------------------------------------------------------------------------------
+# Helpers
+#------------------------------------------------------------------------------
+
+class Rand:
+	"""A tiny LCG so the corpus is the same on every machine and python version."""
+	def __init__(self, seed):
+		self.s = seed & 0xFFFFFFFF
+	def next(self, n):
+		self.s = (self.s * 1103515245 + 12345) & 0xFFFFFFFF
+		return (self.s >> 16) % n
+
+def fnv(frames):
+	h = 0x811C9DC5
+	for f in frames:
+		for row in f:
+			for px in row:
+				for c in px:
+					h = ((h ^ c) * 0x01000193) & 0xFFFFFFFF
+	return h
+
+def pattern(w, h, ncolors, seed):
+	"""Index pattern with runs (for RLE and LZW) mixed with noise."""
+	r = Rand(seed)
+	rows = []
+	for y in range(h):
+		row = []
+		x = 0
+		while x < w:
+			if r.next(3):
+				n = 1 + r.next(12)
+				c = r.next(ncolors)
+				row += [c] * min(n, w-x)
+				x += n
+			else:
+				row.append(((x * 7) ^ (y * 3)) % ncolors)
+				x += 1
+		rows.append(row[:w])
+	return rows
+
+def palette(n, seed, step=1):
+	r = Rand(seed)
+	return [tuple((r.next(256) // step) * step for i in range(3)) for c in range(n)]
+
+def blank(w, h):
+	return [[BGCOLOR] * w for y in range(h)]
+
+#------------------------------------------------------------------------------
+# BMP
+#------------------------------------------------------------------------------
+
+def bmp_file(w, h, bpp, comp, pal, data, masks=b'', topdown=False):
+	info = struct.pack('<IiiHHIIiiII', 40, w, -h if topdown else h, 1, bpp, comp, len(data), 2835, 2835, len(pal), 0)
+	ptab = b''.join(struct.pack('BBBB', b, g, r, 0) for (r, g, b) in pal)
+	off = 14 + len(info) + len(masks) + len(ptab)
+	return b'BM' + struct.pack('<IHHI', off + len(data), 0, 0, off) + info + masks + ptab + data
+
+def bmp_rows(rows, topdown):
+	return rows if topdown else rows[::-1]
+
+def bmp_pack(rows, bpp, topdown):
+	out = b''
+	for row in bmp_rows(rows, topdown):
+		bits = 0
+		nb = 0
+		line = bytearray()
+		for v in row:
+			bits = (bits << bpp) | v
+			nb += bpp
+			if nb == 8:
+				line.append(bits)
+				bits = nb = 0
+		if nb:
+			line.append(bits << (8 - nb))
+		line += b'\0' * (-len(line) & 3)
+		out += bytes(line)
+	return out
+
+def bmp_rle(rows, bpp):
+	"""BI_RLE8 or BI_RLE4 using encoded runs and absolute mode."""
+	out = bytearray()
+	for row in rows[::-1]:
+		x = 0
+		while x < len(row):
+			n = 1
+			while x+n < len(row) and n < 255 and row[x+n] == row[x]:
+				n += 1
+			if n >= 3 or len(row)-x < 3:
+				out += bytes((n, row[x] if bpp == 8 else (row[x] << 4) | row[x]))
+				x += n
+				continue
+			# Absolute mode up to the next run of 3
+			n = 3
+			while x+n < len(row) and n < 255 and not (x+n+2 < len(row) and row[x+n] == row[x+n+1] == row[x+n+2]):
+				n += 1
+			out += bytes((0, n))
+			if bpp == 8:
+				out += bytes(row[x:x+n])
+				out += b'\0' * (n & 1)
+			else:
+				seg = row[x:x+n] + [0]
+				data = bytes((seg[i] << 4) | seg[i+1] for i in range(0, n, 2))
+				out += data + b'\0' * (len(data) & 1)
+			x += n
+		out += b'\0\0'
+	out += b'\0\1'
+	return bytes(out)
+
+def gen_bmp(add):
+	w, h = 61, 37
+	for bpp in (1, 4, 8):
+		pal = palette(1 << bpp, bpp)
+		idx = pattern(w, h, 1 << bpp, 100 + bpp)
+		img = [[pal[i] for i in row] for row in idx]
+		add('bmp%d.bmp' % bpp, bmp_file(w, h, bpp, 0, pal, bmp_pack(idx, bpp, False)), [img])
+		if bpp == 8:
+			add('bmp8_topdown.bmp', bmp_file(w, h, bpp, 0, pal, bmp_pack(idx, bpp, True), topdown=True), [img])
+		if bpp in (4, 8):
+			add('bmp%d_rle.bmp' % bpp, bmp_file(w, h, bpp, 2 if bpp == 4 else 1, pal, bmp_rle(idx, bpp)), [img])
+
+	# 16 bit 555 (default masks) and 565 (bitfields)
+	pal = palette(64, 16, 8)
+	idx = pattern(w, h, 64, 116)
+	img = [[pal[i] for i in row] for row in idx]
+	data = b''
+	for row in idx[::-1]:
+		line = b''.join(struct.pack('<H', ((pal[i][0] >> 3) << 10) | ((pal[i][1] >> 3) << 5) | (pal[i][2] >> 3)) for i in row)
+		data += line + b'\0' * (-len(line) & 3)
+	add('bmp16_555.bmp', bmp_file(w, h, 16, 0, [], data), [img])
+	data = b''
+	for row in idx[::-1]:
+		line = b''.join(struct.pack('<H', ((pal[i][0] >> 3) << 11) | ((pal[i][1] >> 2) << 5) | (pal[i][2] >> 3)) for i in row)
+		data += line + b'\0' * (-len(line) & 3)
+	add('bmp16_565.bmp', bmp_file(w, h, 16, 3, [], data, struct.pack('<III', 0xF800, 0x07E0, 0x001F)), [img])
+
+	# 24 and 32 bit
+	pal = palette(200, 24)
+	idx = pattern(w, h, 200, 124)
+	img = [[pal[i] for i in row] for row in idx]
+	for topdown in (False, True):
+		data = b''
+		for row in bmp_rows(idx, topdown):
+			line = b''.join(bytes(pal[i][::-1]) for i in row)
+			data += line + b'\0' * (-len(line) & 3)
+		add('bmp24%s.bmp' % ('_topdown' if topdown else ''), bmp_file(w, h, 24, 0, [], data, topdown=topdown), [img])
+	data = b''.join(struct.pack('<I', (pal[i][0] << 16) | (pal[i][1] << 8) | pal[i][2]) for row in idx[::-1] for i in row)
+	add('bmp32.bmp', bmp_file(w, h, 32, 0, [], data), [img])
+	data = b''.join(struct.pack('<I', (pal[i][0] << 24) | (pal[i][1] << 16) | (pal[i][2] << 8)) for row in idx[::-1] for i in row)
+	add('bmp32_bitfields.bmp', bmp_file(w, h, 32, 3, [], data, struct.pack('<III', 0xFF000000, 0x00FF0000, 0x0000FF00)), [img])
+
+	# A larger one for speed
+	w, h = 320, 240
+	pal = palette(256, 99)
+	idx = pattern(w, h, 256, 199)
+	img = [[pal[i] for i in row] for row in idx]
+	data = b''
+	for row in idx[::-1]:
+		line = b''.join(bytes(pal[i][::-1]) for i in row)
+		data += line + b'\0' * (-len(line) & 3)
+	add('big24.bmp', bmp_file(w, h, 24, 0, [], data), [img])
+	add('big8_rle.bmp', bmp_file(w, h, 8, 1, pal, bmp_rle(idx, 8)), [img])
+
+#------------------------------------------------------------------------------
+# PNG
+#------------------------------------------------------------------------------
+
+def png_chunk(t, b):
+	return struct.pack('>I', len(b)) + t + b + struct.pack('>I', zlib.crc32(t + b) & 0xFFFFFFFF)
+
+def paeth(a, b, c):
+	p = a + b - c
+	pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+	if pa <= pb and pa <= pc:
+		return a
+	return b if pb <= pc else c
+
+def png_filter(lines, bpp):
+	"""Filter each scanline cycling through all five filter types."""
+	out = b''
+	prev = bytes(len(lines[0])) if lines else b''
+	for n, line in enumerate(lines):
+		ft = n % 5
+		f = bytearray()
+		for i, v in enumerate(line):
+			a = line[i-bpp] if i >= bpp else 0
+			b = prev[i]
+			c = prev[i-bpp] if i >= bpp else 0
+			f.append((v - (0, a, b, (a + b) // 2, paeth(a, b, c))[ft]) & 0xFF)
+		out += bytes((ft,)) + bytes(f)
+		prev = line
+	return out
+
+def png_pack(samples, bitdepth):
+	"""Pack one row of samples into bytes."""
+	if bitdepth == 16:
+		return b''.join(struct.pack('>H', s) for s in samples)
+	if bitdepth == 8:
+		return bytes(samples)
+	bits = 0
+	nb = 0
+	out = bytearray()
+	for s in samples:
+		bits = (bits << bitdepth) | s
+		nb += bitdepth
+		if nb == 8:
+			out.append(bits)
+			bits = nb = 0
+	if nb:
+		out.append(bits << (8 - nb))
+	return bytes(out)
+
+ADAM7 = ((0, 0, 8, 8), (4, 0, 8, 8), (0, 4, 4, 8), (2, 0, 4, 4), (0, 2, 2, 4), (1, 0, 2, 2), (0, 1, 1, 2))
+
+def png_file(w, h, bitdepth, colortype, rows, interlace=False, extra=b'', level=9, strategy=zlib.Z_DEFAULT_STRATEGY, split=0):
+	"""rows is a list of rows of per pixel sample tuples."""
+	nsamples = (1, 0, 3, 1, 2, 0, 4)[colortype]
+	bpp = max(1, nsamples * bitdepth // 8)
+	raw = b''
+	if not interlace:
+		raw = png_filter([png_pack([s for px in row for s in px], bitdepth) for row in rows], bpp)
+	else:
+		for (x0, y0, dx, dy) in ADAM7:
+			lines = [png_pack([s for px in rows[y][x0::dx] for s in px], bitdepth) for y in range(y0, h, dy) if x0 < w]
+			if lines and lines[0]:
+				raw += png_filter(lines, bpp)
+	c = zlib.compressobj(level, zlib.DEFLATED, 15, 9, strategy)
+	z = c.compress(raw) + c.flush()
+	idat = b''
+	split = split or len(z)
+	for i in range(0, len(z), split):
+		idat += png_chunk(b'IDAT', z[i:i+split])
+	return (b'\x89PNG\r\n\x1a\n' + png_chunk(b'IHDR', struct.pack('>IIBBBBB', w, h, bitdepth, colortype, 0, 0, 1 if interlace else 0))
+			+ extra + idat + png_chunk(b'IEND', b''))
+
+def gray124(v, bitdepth):
+	"""The uGFX scaling of a low bit depth grayscale sample."""
+	v = v << (8 - bitdepth)
+	if v >= 0x80:
+		v += (1 << (8 - bitdepth)) - 1
+	return v
+
+def gen_png(add):
+	w, h = 61, 37
+	for interlace in (False, True):
+		sfx = '_i' if interlace else ''
+
+		# Grayscale
+		for bd in (1, 2, 4, 8, 16):
+			n = 1 << min(bd, 8)
+			idx = pattern(w, h, n, 200 + bd)
+			if bd == 16:
+				rows = [[(v * 257,) for v in row] for row in idx]
+				img = [[(v, v, v) for v in row] for row in idx]
+			elif bd == 8:
+				rows = [[(v,) for v in row] for row in idx]
+				img = [[(v, v, v) for v in row] for row in idx]
+			else:
+				rows = [[(v,) for v in row] for row in idx]
+				img = [[(gray124(v, bd),) * 3 for v in row] for row in idx]
+			add('gray%d%s.png' % (bd, sfx), png_file(w, h, bd, 0, rows, interlace), [img])
+
+		# Grayscale with a transparent color
+		idx = pattern(w, h, 256, 209)
+		trns = idx[0][0]
+		img = [[BGCOLOR if v == trns else (v, v, v) for v in row] for row in idx]
+		add('gray8_trns%s.png' % sfx, png_file(w, h, 8, 0, [[(v,) for v in row] for row in idx], interlace, png_chunk(b'tRNS', struct.pack('>H', trns))), [img])
+
+		# RGB
+		pal = palette(200, 300)
+		idx = pattern(w, h, 200, 301)
+		img = [[pal[i] for i in row] for row in idx]
+		add('rgb8%s.png' % sfx, png_file(w, h, 8, 2, img, interlace), [img])
+		add('rgb16%s.png' % sfx, png_file(w, h, 16, 2, [[tuple(c * 257 for c in pal[i]) for i in row] for row in idx], interlace), [img])
+		trns = pal[idx[0][0]]
+		add('rgb8_trns%s.png' % sfx, png_file(w, h, 8, 2, img, interlace, png_chunk(b'tRNS', struct.pack('>HHH', *trns))),
+			[[[BGCOLOR if px == trns else px for px in row] for row in img]])
+
+		# Palette with alpha
+		for bd in (1, 2, 4, 8):
+			n = 1 << bd
+			pal = palette(n, 400 + bd)
+			alpha = [(0, 255, 128)[i % 3] for i in range(n)]
+			idx = pattern(w, h, n, 401 + bd)
+			img = [[BGCOLOR if alpha[i] < ALPHACLIFF else pal[i] for i in row] for row in idx]
+			extra = png_chunk(b'PLTE', b''.join(bytes(c) for c in pal)) + png_chunk(b'tRNS', bytes(alpha))
+			add('pal%d%s.png' % (bd, sfx), png_file(w, h, bd, 3, [[(i,) for i in row] for row in idx], interlace, extra), [img])
+
+		# Gray + alpha and RGBA
+		for bd in (8, 16):
+			m = 257 if bd == 16 else 1
+			idx = pattern(w, h, 256, 500 + bd)
+			aidx = pattern(w, h, 3, 510 + bd)
+			rows = [[(v * m, (0, 255, 128)[a] * m) for v, a in zip(row, arow)] for row, arow in zip(idx, aidx)]
+			img = [[BGCOLOR if a == 0 else (v, v, v) for v, a in zip(row, arow)] for row, arow in zip(idx, aidx)]
+			add('grayalpha%d%s.png' % (bd, sfx), png_file(w, h, bd, 4, rows, interlace), [img])
+			pal = palette(200, 520 + bd)
+			idx = pattern(w, h, 200, 530 + bd)
+			rows = [[tuple(c * m for c in pal[i]) + ((0, 255, 128)[a] * m,) for i, a in zip(row, arow)] for row, arow in zip(idx, aidx)]
+			img = [[BGCOLOR if a == 0 else pal[i] for i, a in zip(row, arow)] for row, arow in zip(idx, aidx)]
+			add('rgba%d%s.png' % (bd, sfx), png_file(w, h, bd, 6, rows, interlace), [img])
+
+	# Small images where interlace passes are empty
+	for (sw, sh) in ((1, 1), (3, 2), (5, 9)):
+		pal = palette(16, 600 + sw)
+		idx = pattern(sw, sh, 16, 601 + sw)
+		img = [[pal[i] for i in row] for row in idx]
+		add('rgb8_%dx%d_i.png' % (sw, sh), png_file(sw, sh, 8, 2, img, True), [img])
+
+	# Each of the deflate block types and IDAT chunk splitting
+	pal = palette(200, 700)
+	idx = pattern(w, h, 200, 701)
+	img = [[pal[i] for i in row] for row in idx]
+	add('rgb8_stored.png', png_file(w, h, 8, 2, img, level=0), [img])
+	add('rgb8_fixed.png', png_file(w, h, 8, 2, img, strategy=zlib.Z_FIXED), [img])
+	add('rgb8_split.png', png_file(w, h, 8, 2, img, split=37), [img])
+
+	# Larger ones for speed
+	w, h = 320, 240
+	pal = palette(256, 800)
+	idx = pattern(w, h, 256, 801)
+	img = [[pal[i] for i in row] for row in idx]
+	add('big_rgb8.png', png_file(w, h, 8, 2, img), [img])
+	add('big_rgb8_i.png', png_file(w, h, 8, 2, img, True), [img])
+	add('big_pal8.png', png_file(w, h, 8, 3, [[(i,) for i in row] for row in idx], extra=png_chunk(b'PLTE', b''.join(bytes(c) for c in pal))), [img])
+
+#------------------------------------------------------------------------------
+# GIF
+#------------------------------------------------------------------------------
+
+def lzw(data, mincode):
+	"""GIF LZW compression including the dictionary reset when it is full."""
+	clear = 1 << mincode
+	eoi = clear + 1
+	out = bytearray()
+	acc = nacc = 0
+
+	def emit(code, size):
+		nonlocal acc, nacc
+		acc |= code << nacc
+		nacc += size
+		while nacc >= 8:
+			out.append(acc & 0xFF)
+			acc >>= 8
+			nacc -= 8
+
+	def reset():
+		return dict(((i,), i) for i in range(clear)), eoi + 1, mincode + 1
+
+	table, nxt, size = reset()
+	emit(clear, size)
+	cur = ()
+	for v in data:
+		t = cur + (v,)
+		if t in table:
+			cur = t
+			continue
+		emit(table[cur], size)
+		if nxt < 4095:
+			table[t] = nxt
+			nxt += 1
+			if nxt > (1 << size) and size < 12:
+				size += 1
+		else:
+			emit(clear, size)
+			table, nxt, size = reset()
+		cur = (v,)
+	if cur:
+		emit(table[cur], size)
+		if nxt >= (1 << size) and size < 12:
+			size += 1
+	emit(eoi, size)
+	if nacc:
+		out.append(acc & 0xFF)
+	blocks = b''
+	for i in range(0, len(out), 255):
+		blocks += bytes((len(out[i:i+255]),)) + out[i:i+255]
+	return bytes((mincode,)) + blocks + b'\0'
+
+def gif_size(n):
+	s = 1
+	while (1 << s) < n:
+		s += 1
+	return s
+
+def gif_ptab(pal):
+	s = gif_size(len(pal))
+	return b''.join(bytes(c) for c in pal) + b'\0' * 3 * ((1 << s) - len(pal)), s
+
+class GifFrame:
+	def __init__(self, x, y, idx, pal=None, trans=None, dispose=1, interlace=False):
+		self.x, self.y, self.idx, self.pal, self.trans, self.dispose, self.interlace = x, y, idx, pal, trans, dispose, interlace
+
+def gif_file(w, h, gpal, bgindex, frames):
+	ptab, s = gif_ptab(gpal)
+	out = b'GIF89a' + struct.pack('<HHBBB', w, h, 0x80 | ((s-1) << 4) | (s-1), bgindex, 0) + ptab
+	for f in frames:
+		fh, fw = len(f.idx), len(f.idx[0])
+		out += b'\x21\xF9\x04' + bytes(((f.dispose << 2) | (1 if f.trans is not None else 0),)) + struct.pack('<H', 10) + bytes((f.trans or 0,)) + b'\0'
+		flags = 0x40 if f.interlace else 0
+		lpal = b''
+		ncolors = len(gpal)
+		if f.pal:
+			lpal, ls = gif_ptab(f.pal)
+			flags |= 0x80 | (ls-1)
+			ncolors = len(f.pal)
+		out += b'\x2C' + struct.pack('<HHHHB', f.x, f.y, fw, fh, flags) + lpal
+		order = list(range(fh))
+		if f.interlace:
+			order = list(range(0, fh, 8)) + list(range(4, fh, 8)) + list(range(2, fh, 4)) + list(range(1, fh, 2))
+		out += lzw([v for y in order for v in f.idx[y]], max(2, gif_size(ncolors)))
+	return out + b'\x3B'
+
+def gif_render(w, h, gpal, bgindex, frames):
+	"""The expected result of drawing each frame on top of the last (uGFX only does dispose by clearing)."""
+	img = blank(w, h)
+	out = []
+	prev = None
+	for f in frames:
+		if prev and prev.dispose in (2, 3):
+			c = BGCOLOR if prev.trans is not None or bgindex >= len(gpal) else gpal[bgindex]
+			for y in range(prev.y, prev.y + len(prev.idx)):
+				for x in range(prev.x, prev.x + len(prev.idx[0])):
+					img[y][x] = c
+		pal = f.pal or gpal
+		for y, row in enumerate(f.idx):
+			for x, v in enumerate(row):
+				if v != f.trans:
+					img[f.y+y][f.x+x] = pal[v]
+		out.append([row[:] for row in img])
+		prev = f
+	return out
+
+def gen_gif(add):
+	w, h = 61, 37
+	for n in (2, 4, 16, 256):
+		pal = palette(n, 900 + n)
+		for interlace in (False, True):
+			frames = [GifFrame(0, 0, pattern(w, h, n, 901 + n), interlace=interlace)]
+			add('gif%d%s.gif' % (n, '_i' if interlace else ''), gif_file(w, h, pal, 0, frames), gif_render(w, h, pal, 0, frames))
+
+	# An animation with sub-frames, transparency, a local palette and disposal
+	pal = palette(16, 950)
+	lpal = palette(64, 951)
+	frames = [
+		GifFrame(0, 0, pattern(w, h, 16, 952), trans=3),
+		GifFrame(10, 5, pattern(30, 20, 16, 953), trans=5, dispose=2),
+		GifFrame(5, 10, pattern(40, 17, 64, 954), pal=lpal, dispose=2),
+		GifFrame(20, 2, pattern(21, 33, 16, 955), trans=0, interlace=True),
+		GifFrame(0, 30, pattern(61, 7, 16, 956)),
+	]
+	add('anim.gif', gif_file(w, h, pal, 1, frames), gif_render(w, h, pal, 1, frames))
+
+	# A larger one for speed (this also fills the LZW dictionary)
+	w, h = 320, 240
+	pal = palette(256, 990)
+	frames = [GifFrame(0, 0, pattern(w, h, 256, 991))]
+	add('big256.gif', gif_file(w, h, pal, 0, frames), gif_render(w, h, pal, 0, frames))
+
+#------------------------------------------------------------------------------
+
+def main():
+	outdir = sys.argv[1] if len(sys.argv) > 1 else '.'
+	os.makedirs(outdir, exist_ok=True)
+	manifest = []
+
+	def add(name, data, frames):
+		with open(os.path.join(outdir, name), 'wb') as f:
+			f.write(data)
+		manifest.append('%s %08x\n' % (name, fnv(frames)))
+
+	gen_bmp(add)
+	gen_png(add)
+	gen_gif(add)
+	with open(os.path.join(outdir, 'corpus.txt'), 'w') as f:
+		f.write(''.join(manifest))
+	print('%d images written to %s' % (len(manifest), outdir))
+
+if __name__ == '__main__':
+	main()
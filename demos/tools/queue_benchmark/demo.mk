@@ -0,0 +1,3 @@
+DEMODIR = $(GFXLIB)/demos/tools/queue_benchmark
+GFXINC +=   $(DEMODIR)
+GFXSRC +=	$(DEMODIR)/main.c
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2012, 2013, Joel Bodenmann aka Tectu <joel@unormal.org>
+ * Copyright (c) 2012, 2013, Andrew Hannam aka inmarket
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of the <organization> nor the
+ *      names of its contributors may be used to endorse or promote products
+ *      derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/**
+ * Queue speed test.
+ *
+ * Compares the bounded ring queues with the existing linked list queues. Each test is run for
+ * at least TEST_TIME milliseconds and the average time taken to put and then get one item is printed.
+ *	- Single thread tests put a batch of items and then get them all back. These measure the cost of
+ *		the queue operations themselves (including turning interrupts off for the linked list queues).
+ *	- Handoff tests have a producer thread putting items and the main thread getting them
+ *		with a blocking get. These include the cost of waking the consumer.
+ */
+
+#include "gfx.h"
+
+#define TEST_TIME		250							// Run each test for at least this many milliseconds
+#define BATCH			16							// Items per batch in the single thread tests
+#define HANDOFF_ITEMS	10000						// Items per run of the handoff tests
+#define RING_SLOTS		32							// Must be a power of 2 and at least BATCH
+
+static gfxQueueGSyncItem	items[BATCH];			// The same items are used for every queue (ASync and GSync items are the same)
+static gfxQueueASync		aq;
+static gfxQueueGSync		gq;
+static gfxQueueRing			rq;
+static gfxQueueRingSlot		rslots[RING_SLOTS];
+static unsigned				errors;
+
+typedef void (*testfn)(void);
+
+// Run the test repeatedly and print the average time per put/get pair
+static void runTest(const char *name, testfn fn, unsigned perrun) {
+	systemticks_t	start, elapsed;
+	uint32_t		runs, ms;
+
+	runs = 0;
+	start = gfxSystemTicks();
+	do {
+		fn();
+		runs++;
+		elapsed = gfxSystemTicks() - start;
+	} while(elapsed < gfxMillisecondsToTicks(TEST_TIME));
+	ms = elapsed * 1000 / gfxMillisecondsToTicks(1000);
+
+	fprintg(gfileStdOut, "%-28s %6u ns per put/get\n", name, (unsigned)((uint64_t)ms * 1000000 / ((uint64_t)runs * perrun)));
+}
+
+/*-----------------------------------------------------------------------
+ * Single thread tests
+ *-----------------------------------------------------------------------*/
+
+static void testASync(void) {
+	unsigned	i;
+
+	for(i = 0; i < BATCH; i++)
+		gfxQueueASyncPut(&aq, &items[i]);
+	for(i = 0; i < BATCH; i++)
+		if (gfxQueueASyncGet(&aq) != &items[i]) errors++;
+}
+
+static void testASyncI(void) {
+	unsigned	i;
+
+	for(i = 0; i < BATCH; i++)
+		gfxQueueASyncPutI(&aq, &items[i]);
+	for(i = 0; i < BATCH; i++)
+		if (gfxQueueASyncGetI(&aq) != &items[i]) errors++;
+}
+
+static void testGSync(void) {
+	unsigned	i;
+
+	for(i = 0; i < BATCH; i++)
+		gfxQueueGSyncPut(&gq, &items[i]);
+	for(i = 0; i < BATCH; i++)
+		if (gfxQueueGSyncGet(&gq, TIME_IMMEDIATE) != &items[i]) errors++;
+}
+
+static void testGSyncI(void) {
+	unsigned	i;
+
+	for(i = 0; i < BATCH; i++)
+		gfxQueueGSyncPutI(&gq, &items[i]);
+	for(i = 0; i < BATCH; i++)
+		if (gfxQueueGSyncGetI(&gq) != &items[i]) errors++;
+}
+
+static void testRing(void) {
+	unsigned	i;
+
+	for(i = 0; i < BATCH; i++)
+		gfxQueueRingPut(&rq, &items[i]);
+	for(i = 0; i < BATCH; i++)
+		if (gfxQueueRingGet(&rq, TIME_IMMEDIATE) != &items[i]) errors++;
+}
+
+static void testRingI(void) {
+	unsigned	i;
+
+	for(i = 0; i < BATCH; i++)
+		gfxQueueRingPutI(&rq, &items[i]);
+	for(i = 0; i < BATCH; i++)
+		if (gfxQueueRingGetI(&rq) != &items[i]) errors++;
+}
+
+static void testRingMulti(void) {
+	unsigned	i;
+
+	for(i = 0; i < BATCH; i++)
+		gfxQueueRingPutMulti(&rq, &items[i]);
+	for(i = 0; i < BATCH; i++)
+		if (gfxQueueRingGet(&rq, TIME_IMMEDIATE) != &items[i]) errors++;
+}
+
+static void testRingMultiI(void) {
+	unsigned	i;
+
+	for(i = 0; i < BATCH; i++)
+		gfxQueueRingPutMultiI(&rq, &items[i]);
+	for(i = 0; i < BATCH; i++)
+		if (gfxQueueRingGetI(&rq) != &items[i]) errors++;
+}
+
+/*-----------------------------------------------------------------------
+ * Handoff tests
+ *-----------------------------------------------------------------------*/
+
+static DECLARE_THREAD_FUNCTION(gsyncProducer, param) {
+	unsigned	i;
+	(void)		param;
+
+	// The consumer takes each item before we put it again
+	for(i = 0; i < HANDOFF_ITEMS; i++) {
+		while(gfxQueueGSyncIsIn(&gq, &items[i % BATCH]))
+			gfxYield();
+		gfxQueueGSyncPut(&gq, &items[i % BATCH]);
+	}
+	return 0;
+}
+
+static DECLARE_THREAD_FUNCTION(ringProducer, param) {
+	unsigned	i;
+	(void)		param;
+
+	for(i = 0; i < HANDOFF_ITEMS; i++) {
+		while(!gfxQueueRingPut(&rq, &items[i % BATCH]))
+			gfxYield();
+	}
+	return 0;
+}
+
+static void testHandoff(DECLARE_THREAD_FUNCTION((*producer),p), bool_t isRing) {
+	gfxThreadHandle	th;
+	unsigned		i;
+	void			*pitem;
+
+	th = gfxThreadCreate(0, 2048, NORMAL_PRIORITY, producer, 0);
+	for(i = 0; i < HANDOFF_ITEMS; i++) {
+		pitem = isRing ? gfxQueueRingGet(&rq, TIME_INFINITE) : (void *)gfxQueueGSyncGet(&gq, TIME_INFINITE);
+		if (pitem != &items[i % BATCH]) errors++;
+	}
+	gfxThreadWait(th);
+	gfxThreadClose(th);
+}
+
+static void testGSyncHandoff(void) {
+	testHandoff(gsyncProducer, FALSE);
+}
+
+static void testRingHandoff(void) {
+	testHandoff(ringProducer, TRUE);
+}
+
+int main(void) {
+	gfxInit();
+
+	gfxQueueASyncInit(&aq);
+	gfxQueueGSyncInit(&gq);
+	gfxQueueRingInit(&rq, rslots, RING_SLOTS);
+
+	runTest("ASync Put/Get", testASync, BATCH);
+	runTest("ASync PutI/GetI", testASyncI, BATCH);
+	runTest("GSync Put/Get", testGSync, BATCH);
+	runTest("GSync PutI/GetI", testGSyncI, BATCH);
+	runTest("Ring Put/Get", testRing, BATCH);
+	runTest("Ring PutI/GetI", testRingI, BATCH);
+	runTest("Ring PutMulti/Get", testRingMulti, BATCH);
+	runTest("Ring PutMultiI/GetI", testRingMultiI, BATCH);
+	runTest("GSync handoff", testGSyncHandoff, HANDOFF_ITEMS);
+	runTest("Ring handoff", testRingHandoff, HANDOFF_ITEMS);
+
+	gfxQueueRingDeinit(&rq);
+	gfxQueueGSyncDeinit(&gq);
+
+	fprintg(gfileStdOut, "%u errors\n", errors);
+	return errors ? 1 : 0;
+}
@@ -0,0 +1,3 @@
+DEMODIR = $(GFXLIB)/demos/tools/sched_latency
+GFXINC +=   $(DEMODIR)
+GFXSRC +=	$(DEMODIR)/main.c
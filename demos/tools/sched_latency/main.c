@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2012, 2013, Joel Bodenmann aka Tectu <joel@unormal.org>
+ * Copyright (c) 2012, 2013, Andrew Hannam aka inmarket
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of the <organization> nor the
+ *      names of its contributors may be used to endorse or promote products
+ *      derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/**
+ * Cooperative scheduler priority and latency test.
+ *
+ * This runs the uGFX cooperative scheduler (GFX_USE_OS_RAW32) as a process on a host operating
+ * system using GFX_OS_UCONTEXT. It checks that:
+ *	- Threads waiting on a semaphore are woken in priority order (first come first served within a priority).
+ *	- A low priority thread holding a mutex wanted by a high priority thread inherits that priority
+ *		so that a normal priority thread can't hold up the high priority thread.
+ * It then measures how long a high priority thread takes to run after being woken by a semaphore
+ * signal from a busy low priority thread, and how long a timed sleep really takes.
+ */
+
+#include "gfx.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#if !GFX_OS_UCONTEXT
+	#error "This test needs GFX_USE_OS_RAW32 and GFX_OS_UCONTEXT"
+#endif
+
+#define LATENCY_LOOPS	1000		// The number of semaphore wake ups to time
+#define SLEEP_LOOPS		100			// The number of timed sleeps to time
+#define BUSY_TIME		50			// How long (in microseconds) the low priority thread works between signals
+
+static gfxSem		sem;
+static gfxSem		finished;
+static gfxMutex		mtx;
+static char			order[16];
+static unsigned		norder;
+static unsigned		failed;
+
+// A microsecond clock
+static uint32_t now(void) {
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+// Keep the CPU busy for a while but let equal or higher priority threads run
+static void busy(uint32_t us) {
+	uint32_t	start;
+
+	start = now();
+	while(now() - start < us)
+		gfxYield();
+}
+
+// Threads that have finished signal the finished semaphore just before they exit.
+// We can't use gfxThreadWait() as a thread that has already exited may have been freed.
+static void waitFinished(gfxThreadHandle *th, unsigned cnt) {
+	for(; cnt; cnt--, th++) {
+		gfxSemWait(&finished, TIME_INFINITE);
+		gfxThreadClose(*th);
+	}
+}
+
+static void check(const char *test, const char *expected) {
+	order[norder] = 0;
+	printf("%-24s %-4s got %s expected %s\n", test, strcmp(order, expected) ? "FAIL" : "OK", order, expected);
+	if (strcmp(order, expected))
+		failed++;
+	norder = 0;
+}
+
+/*-----------------------------------------------------------------------
+ * Semaphore wake up order
+ *-----------------------------------------------------------------------*/
+
+static DECLARE_THREAD_FUNCTION(waiter, param) {
+	gfxSemWait(&sem, TIME_INFINITE);
+	order[norder++] = '0' + (int)(size_t)param;
+	gfxSemSignal(&finished);
+	return 0;
+}
+
+static void testWakeOrder(void) {
+	static const threadpriority_t	prio[5] = { HIGH_PRIORITY, NORMAL_PRIORITY, HIGH_PRIORITY, LOW_PRIORITY, NORMAL_PRIORITY };
+	gfxThreadHandle					th[5];
+	unsigned						i;
+
+	// Queue up the waiters. Let the lower priority ones run until they block too.
+	gfxSemInit(&sem, 0, 5);
+	for(i = 0; i < 5; i++)
+		th[i] = gfxThreadCreate(0, 0, prio[i], waiter, (void *)(size_t)(i+1));
+	gfxSleepMilliseconds(10);
+
+	// Wake them one at a time
+	for(i = 0; i < 5; i++) {
+		gfxSemSignal(&sem);
+		gfxSleepMilliseconds(1);
+	}
+
+	waitFinished(th, 5);
+	gfxSemDestroy(&sem);
+	check("Semaphore wake order", "13254");
+}
+
+/*-----------------------------------------------------------------------
+ * Mutex priority inheritance
+ *-----------------------------------------------------------------------*/
+
+static DECLARE_THREAD_FUNCTION(lowThread, param) {
+	(void) param;
+
+	gfxMutexEnter(&mtx);
+	gfxSemWait(&sem, TIME_INFINITE);
+	order[norder++] = 'L';
+	gfxMutexExit(&mtx);
+	gfxSemSignal(&finished);
+	return 0;
+}
+
+static DECLARE_THREAD_FUNCTION(normalThread, param) {
+	(void) param;
+
+	busy(20000);
+	order[norder++] = 'N';
+	gfxSemSignal(&finished);
+	return 0;
+}
+
+static DECLARE_THREAD_FUNCTION(highThread, param) {
+	(void) param;
+
+	gfxMutexEnter(&mtx);
+	order[norder++] = 'H';
+	gfxMutexExit(&mtx);
+	gfxSemSignal(&finished);
+	return 0;
+}
+
+static void testInheritance(void) {
+	gfxThreadHandle		th[3];
+
+	gfxSemInit(&sem, 0, 1);
+	gfxMutexInit(&mtx);
+
+	// The low priority thread takes the mutex and then waits for us
+	th[0] = gfxThreadCreate(0, 0, LOW_PRIORITY, lowThread, 0);
+	gfxSleepMilliseconds(10);
+
+	// The high priority thread runs straight away and blocks on the mutex
+	th[1] = gfxThreadCreate(0, 0, HIGH_PRIORITY, highThread, 0);
+
+	// A normal priority thread that wants the CPU for a long time
+	th[2] = gfxThreadCreate(0, 0, NORMAL_PRIORITY, normalThread, 0);
+
+	// Let the low priority thread go. Without inheritance the normal priority thread would run first.
+	gfxSemSignal(&sem);
+
+	waitFinished(th, 3);
+	gfxMutexDestroy(&mtx);
+	gfxSemDestroy(&sem);
+	check("Priority inheritance", "LHN");
+}
+
+/*-----------------------------------------------------------------------
+ * Latency
+ *-----------------------------------------------------------------------*/
+
+static volatile uint32_t	signalled;
+static volatile bool_t		done;
+static uint32_t				lmin, lmax, ltotal;
+
+static void addLatency(uint32_t us) {
+	if (us < lmin) lmin = us;
+	if (us > lmax) lmax = us;
+	ltotal += us;
+}
+
+static void printLatency(const char *test, unsigned cnt) {
+	printf("%-24s min %u us, avg %u us, max %u us\n", test, lmin, ltotal / cnt, lmax);
+	lmin = 0xFFFFFFFF;
+	lmax = ltotal = 0;
+}
+
+static DECLARE_THREAD_FUNCTION(semHighThread, param) {
+	unsigned	i;
+	(void)		param;
+
+	for(i = 0; i < LATENCY_LOOPS; i++) {
+		gfxSemWait(&sem, TIME_INFINITE);
+		addLatency(now() - signalled);
+	}
+	gfxSemSignal(&finished);
+	return 0;
+}
+
+static DECLARE_THREAD_FUNCTION(busyLowThread, param) {
+	unsigned	i;
+	(void)		param;
+
+	for(i = 0; i < LATENCY_LOOPS; i++) {
+		busy(BUSY_TIME);
+		signalled = now();
+		gfxSemSignal(&sem);
+	}
+	gfxSemSignal(&finished);
+	return 0;
+}
+
+static DECLARE_THREAD_FUNCTION(sleepHighThread, param) {
+	unsigned	i;
+	uint32_t	start;
+	(void)		param;
+
+	for(i = 0; i < SLEEP_LOOPS; i++) {
+		start = now();
+		gfxSleepMilliseconds(2);
+		addLatency(now() - start);
+	}
+	done = TRUE;
+	gfxSemSignal(&finished);
+	return 0;
+}
+
+static DECLARE_THREAD_FUNCTION(yieldLowThread, param) {
+	(void) param;
+
+	while(!done)
+		gfxYield();
+	gfxSemSignal(&finished);
+	return 0;
+}
+
+static void testLatency(void) {
+	gfxThreadHandle		th[2];
+
+	lmin = 0xFFFFFFFF;
+	lmax = ltotal = 0;
+
+	// Semaphore signalled by a busy low priority thread
+	gfxSemInit(&sem, 0, 1);
+	th[0] = gfxThreadCreate(0, 0, HIGH_PRIORITY, semHighThread, 0);
+	th[1] = gfxThreadCreate(0, 0, LOW_PRIORITY, busyLowThread, 0);
+	waitFinished(th, 2);
+	gfxSemDestroy(&sem);
+	printLatency("Semaphore wake latency", LATENCY_LOOPS);
+
+	// Timed sleep while a low priority thread keeps yielding
+	done = FALSE;
+	th[0] = gfxThreadCreate(0, 0, HIGH_PRIORITY, sleepHighThread, 0);
+	th[1] = gfxThreadCreate(0, 0, LOW_PRIORITY, yieldLowThread, 0);
+	waitFinished(th, 2);
+	printLatency("2ms sleep time", SLEEP_LOOPS);
+}
+
+int main(void) {
+	gfxInit();
+	gfxSemInit(&finished, 0, 5);
+
+	testWakeOrder();
+	testInheritance();
+	testLatency();
+
+	printf("%u tests failed\n", failed);
+	return failed ? 1 : 0;
+}
@@ -45,6 +45,7 @@ bool_t gaudio_record_lld_init(uint16_t channel, uint32_t frequency, ArrayDataFor
 }
 
 void gaudio_record_lld_start(void) {
+	gadcHighSpeedSetBufferPool(gaudioRecordGetBufferPool());
 	gadcHighSpeedStart();
 }
 
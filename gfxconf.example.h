@@ -56,9 +56,14 @@
 //    #define GFX_OS_PRE_INIT_FUNCTION                 myHardwareInitRoutine
 //    #define GFX_OS_EXTRA_INIT_FUNCTION               myOSInitRoutine
 //    #define GFX_OS_EXTRA_DEINIT_FUNCTION             myOSDeInitRoutine
+//    #define GFX_OS_IDLE_FUNCTION                     myIdleRoutine
+//    #define GFX_OS_THREAD_TRACE_FUNCTION             myTraceRoutine
 //    #define GFX_OS_CALL_UGFXMAIN                     FALSE
 //    #define GFX_OS_UGFXMAIN_STACKSIZE                0
 //    #define GFX_EMULATE_MALLOC                       FALSE
+//    #define GFX_OS_UCONTEXT                          FALSE
+//    #define GFX_OS_THREAD_STATS                      FALSE
+//    #define GFX_OS_NEED_WORKQUEUE                    FALSE
 
 
 ///////////////////////////////////////////////////////////////////////////
@@ -81,6 +86,7 @@
 //#define GDISP_NEED_CONTROL                           FALSE
 //#define GDISP_NEED_QUERY                             FALSE
 //#define GDISP_NEED_MULTITHREAD                       FALSE
+//    #define GDISP_MULTITHREAD_STATS                  FALSE
 //#define GDISP_NEED_STREAMING                         FALSE
 //#define GDISP_NEED_TEXT                              FALSE
 //    #define GDISP_NEED_TEXT_WORDWRAP                 FALSE
@@ -112,6 +118,8 @@
 
 //#define GDISP_NEED_IMAGE                             FALSE
 //    #define GDISP_NEED_IMAGE_NATIVE                  FALSE
+//        #define GDISP_NEED_IMAGE_NATIVE_COMPRESSED   FALSE
+//        #define GDISP_IMAGE_NATIVE_FILE_BUFFER_SIZE  32
 //    #define GDISP_NEED_IMAGE_GIF                     FALSE
 //        #define GDISP_IMAGE_GIF_BLIT_BUFFER_SIZE     32
 //    #define GDISP_NEED_IMAGE_BMP                     FALSE
@@ -145,9 +153,17 @@
 //        #define GDISP_IMAGE_PNG_FILE_BUFFER_SIZE     8
 //        #define GDISP_IMAGE_PNG_Z_BUFFER_SIZE        32768
 //    #define GDISP_NEED_IMAGE_ACCOUNTING              FALSE
+//    #define GDISP_NEED_IMAGE_SCALE                   FALSE
+//        #define GDISP_IMAGE_SCALE_BLIT_BUFFER_SIZE   32
+//    #define GDISP_NEED_IMAGE_ASYNC                   FALSE
+//        #define GDISP_IMAGE_ASYNC_THREADS            1
+//        #define GDISP_IMAGE_ASYNC_THREAD_PRIORITY    LOW_PRIORITY
+//        #define GDISP_IMAGE_ASYNC_THREAD_WORKAREA_SIZE   2048
 
 //#define GDISP_NEED_PIXMAP                            FALSE
 //    #define GDISP_NEED_PIXMAP_IMAGE                  FALSE
+//    #define GDISP_NEED_PIXMAP_INDEXED                FALSE
+//        #define GDISP_PIXMAP_INDEXED_BLIT_BUFFER_SIZE    32
 
 //#define GDISP_DEFAULT_ORIENTATION                    GDISP_ROTATE_LANDSCAPE    // If not defined the native hardware orientation is used.
 //#define GDISP_LINEBUF_SIZE                           128
@@ -190,13 +206,19 @@
 //#define GWIN_NEED_WINDOWMANAGER                      FALSE
 //    #define GWIN_REDRAW_IMMEDIATE                    FALSE
 //    #define GWIN_REDRAW_SINGLEOP                     FALSE
+//    #define GWIN_REDRAW_FRAMERATE                    0
 //    #define GWIN_NEED_FLASHING                       FALSE
 //        #define GWIN_FLASHING_PERIOD                 250
+//    #define GWIN_NEED_SPATIAL_INDEX                  FALSE
+//        #define GWIN_SPATIAL_INDEX_CELL_SHIFT        5
+//    #define GWIN_NEED_COMPOSITOR                     FALSE
 
 //#define GWIN_NEED_CONSOLE                            FALSE
 //    #define GWIN_CONSOLE_USE_HISTORY                 FALSE
 //        #define GWIN_CONSOLE_HISTORY_AVERAGING       FALSE
 //        #define GWIN_CONSOLE_HISTORY_ATCREATE        FALSE
+//        #define GWIN_CONSOLE_DEFERRED_RENDER         FALSE
+//            #define GWIN_CONSOLE_DEFERRED_PERIOD     40
 //    #define GWIN_CONSOLE_ESCSEQ                      FALSE
 //    #define GWIN_CONSOLE_USE_BASESTREAM              FALSE
 //    #define GWIN_CONSOLE_USE_FLOAT                   FALSE
@@ -219,6 +241,9 @@
 //    #define GWIN_NEED_RADIO                          FALSE
 //    #define GWIN_NEED_LIST                           FALSE
 //        #define GWIN_NEED_LIST_IMAGES                FALSE
+//        #define GWIN_NEED_LIST_VIRTUAL               FALSE
+//        #define GWIN_LIST_KINETIC_SCROLL             FALSE
+//        #define GWIN_LIST_KINETIC_PERIOD             20
 //    #define GWIN_NEED_PROGRESSBAR                    FALSE
 //        #define GWIN_PROGRESSBAR_AUTO                FALSE
 //    #define GWIN_NEED_KEYBOARD                       FALSE
@@ -228,6 +253,8 @@
 //    #define GWIN_NEED_SPINBOX                        FALSE
 //    #define GWIN_FLAT_STYLING                        FALSE
 //    #define GWIN_WIDGET_TAGS                         FALSE
+//    #define GWIN_WIDGET_CACHE                        FALSE
+//        #define GWIN_WIDGET_CACHE_BUDGET             32768
 
 //#define GWIN_NEED_CONTAINERS                         FALSE
 //    #define GWIN_NEED_CONTAINER                      FALSE
@@ -248,8 +275,11 @@
 //#define GFX_USE_GEVENT                               FALSE
 
 //#define GEVENT_ASSERT_NO_RESOURCE                    FALSE
+//#define GEVENT_NEED_LISTENER_QUEUE                   FALSE
 //#define GEVENT_MAXIMUM_SIZE                          32
 //#define GEVENT_MAX_SOURCE_LISTENERS                  32
+//#define GEVENT_SOURCE_LISTENERS_GROW                 FALSE
+//#define GEVENT_SOURCE_HASH_SIZE                      16
 
 
 ///////////////////////////////////////////////////////////////////////////
@@ -257,6 +287,8 @@
 ///////////////////////////////////////////////////////////////////////////
 //#define GFX_USE_GTIMER                               FALSE
 
+//#define GTIMER_NEED_HIRES                            FALSE
+
 //#define GTIMER_THREAD_PRIORITY                       HIGH_PRIORITY
 //#define GTIMER_THREAD_WORKAREA_SIZE                  2048
 
@@ -270,6 +302,7 @@
 //#define GQUEUE_NEED_GSYNC                            FALSE
 //#define GQUEUE_NEED_FSYNC                            FALSE
 //#define GQUEUE_NEED_BUFFERS                          FALSE
+//#define GQUEUE_NEED_RING                             FALSE
 
 ///////////////////////////////////////////////////////////////////////////
 // GINPUT                                                                //
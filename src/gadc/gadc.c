@@ -34,6 +34,7 @@ static volatile uint16_t		hsFlags;
 static size_t					hsBytesPerConv;
 static GadcTimerJob				hsJob;
 static GDataBuffer				*hsData;
+static GDataBufferPool			*hsPool;
 static gfxQueueGSync			hsListDone;
 static GADCISRCallbackFunction	hsISRcallback;
 #if GFX_USE_GEVENT
@@ -84,7 +85,7 @@ void gadcGotDataI(size_t n) {
 			gadc_lld_stop_timerI();
 
 		// Get the next free buffer
-		} else if (!(hsData = gfxBufferGetI())) {
+		} else if (!(hsData = gfxBufferPoolGetI(hsPool))) {
 
 			// Oops - no free buffers. Stall
 			hsFlags &= ~GADC_HSADC_RUNNING;
@@ -224,6 +225,10 @@ void gadcHighSpeedSetISRCallback(GADCISRCallbackFunction isrfn) {
 	hsISRcallback = isrfn;
 }
 
+void gadcHighSpeedSetBufferPool(GDataBufferPool *pool) {
+	hsPool = pool;
+}
+
 GDataBuffer *gadcHighSpeedGetData(delaytime_t ms) {
 	return (GDataBuffer *)gfxQueueGSyncGet(&hsListDone, ms);
 }
@@ -239,7 +244,7 @@ void gadcHighSpeedStart(void) {
 
 	gfxSystemLock();
 	if (!(hsFlags & GADC_HSADC_RUNNING)) {
-		if (!(hsData = gfxBufferGetI())) {
+		if (!(hsData = gfxBufferPoolGetI(hsPool))) {
 			// Oops - no free buffers. Stall
 			hsFlags |= GADC_HSADC_STALL;
 			#if GFX_USE_GEVENT
@@ -160,6 +160,18 @@ void gadcHighSpeedInit(uint32_t physdev, uint32_t frequency);
  */
 void gadcHighSpeedSetISRCallback(GADCISRCallbackFunction isrfn);
 
+/**
+ * @brief				Set the buffer pool the high speed ADC takes its buffers from.
+ *
+ * @param[in] pool			The buffer pool. NULL means the default pool (the one @p gfxBufferAlloc() uses).
+ *
+ * @note				The pool is not changed by @p gadcHighSpeedInit(). Only change it while the high speed ADC is stopped.
+ * @note				Buffers are returned to the pool they came from when they are released with @p gfxBufferRelease().
+ *
+ * @api
+ */
+void gadcHighSpeedSetBufferPool(GDataBufferPool *pool);
+
 /**
  * @brief		Get a filled buffer from the ADC
  * @return		A GDataBuffer pointer or NULL if the timeout is exceeded
@@ -167,7 +179,8 @@ void gadcHighSpeedSetISRCallback(GADCISRCallbackFunction isrfn);
  * @param[in] ms	The maximum amount of time in milliseconds to wait for data if some is not currently available.
  *
  * @note		After processing the data, your application must return the buffer to the free-list so that
- * 				it can be used again. This can be done using @p gfxBufferRelease().
+ * 				it can be used again. This can be done using @p gfxBufferRelease(). The buffer goes back to the
+ * 				pool set with @p gadcHighSpeedSetBufferPool().
  * @note		A buffer may be returned to the free-list before you have finished processing it provided you finish
  * 				processing it before GADC re-uses it. This is useful when RAM usage is critical to reduce the number
  * 				of buffers required. It works before the free list is a FIFO queue and therefore buffers are kept
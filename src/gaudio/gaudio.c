@@ -15,6 +15,7 @@
 	static gfxQueueASync	playList;
 	static gfxSem			playComplete;
 	static uint16_t			playFlags;
+	static GDataBufferPool	*playPool;
 		#define PLAYFLG_USEEVENTS	0x0001
 		#define PLAYFLG_PLAYING		0x0002
 		#define PLAYFLG_ISINIT		0x0004
@@ -29,6 +30,7 @@
 
 	static gfxQueueGSync	recordList;
 	static uint16_t			recordFlags;
+	static GDataBufferPool	*recordPool;
 		#define RECORDFLG_USEEVENTS		0x0001
 		#define RECORDFLG_RECORDING		0x0002
 		#define RECORDFLG_STALLED		0x0004
@@ -119,6 +121,10 @@ void _gaudioDeinit(void)
 		return gaudio_play_lld_set_volume(vol);
 	}
 
+	void gaudioPlaySetBufferPool(GDataBufferPool *pool) {
+		playPool = pool;
+	}
+
 	bool_t gaudioPlayWait(delaytime_t ms) {
 		if (!(playFlags & PLAYFLG_PLAYING))
 			return TRUE;
@@ -144,7 +150,7 @@ void _gaudioDeinit(void)
 				psl->srcflags = 0;
 				if ((playFlags & PLAYFLG_PLAYING))
 					pe->flags |= GAUDIO_PLAY_PLAYING;
-				if (gfxBufferIsAvailable())
+				if (gfxBufferPoolIsAvailable(playPool))
 					pe->flags |= GAUDIO_PLAY_FREEBLOCK;
 				geventSendEvent(psl);
 			}
@@ -217,6 +223,14 @@ void _gaudioDeinit(void)
 		return (GDataBuffer *)gfxQueueGSyncGet(&recordList, ms);
 	}
 
+	void gaudioRecordSetBufferPool(GDataBufferPool *pool) {
+		recordPool = pool;
+	}
+
+	GDataBufferPool *gaudioRecordGetBufferPool(void) {
+		return recordPool;
+	}
+
 	#if GFX_USE_GEVENT
 		static void RecordTimerCallback(void *param) {
 			(void) param;
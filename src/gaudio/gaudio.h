@@ -170,6 +170,19 @@ extern "C" {
 	 */
 	bool_t gaudioPlaySetVolume(uint8_t vol);
 
+	/**
+	 * @brief				Set the buffer pool the application takes its play buffers from.
+	 *
+	 * @param[in] pool		The buffer pool. NULL means the default pool (the one @p gfxBufferAlloc() uses).
+	 *
+	 * @note				This is only used to report GAUDIO_PLAY_FREEBLOCK events. Played buffers are
+	 * 						always returned to the pool they came from. A buffer from the recording pool can
+	 * 						therefore be played directly without copying it.
+	 *
+	 * @api
+	 */
+	void gaudioPlaySetBufferPool(GDataBufferPool *pool);
+
 	#if GFX_USE_GEVENT || defined(__DOXYGEN__)
 		/**
 		 * @brief   			Turn on sending results to the GEVENT sub-system.
@@ -266,6 +279,17 @@ extern "C" {
 	 */
 	GDataBuffer *gaudioRecordGetData(delaytime_t ms);
 
+	/**
+	 * @brief		Set the buffer pool audio is recorded into.
+	 *
+	 * @param[in] pool	The buffer pool. NULL means the default pool (the one @p gfxBufferAlloc() uses).
+	 *
+	 * @note		It takes effect the next time recording is started.
+	 *
+	 * @api
+	 */
+	void gaudioRecordSetBufferPool(GDataBufferPool *pool);
+
 	#if GFX_USE_GEVENT || defined(__DOXYGEN__)
 		/**
 		 * @brief   			Turn on sending results to the GEVENT sub-system.
@@ -37,7 +37,17 @@
  * @iclass
  * @notapi
  */
-#define gaudioRecordGetFreeBlockI()		gfxBufferGetI()
+#define gaudioRecordGetFreeBlockI()		gfxBufferPoolGetI(gaudioRecordGetBufferPool())
+
+/**
+ * @brief				Get the buffer pool to record into
+ * @return				The buffer pool. NULL means the default pool.
+ *
+ * @note				Defined in the high level GAUDIO code for use by the GAUDIO record drivers.
+ *
+ * @notapi
+ */
+GDataBufferPool *gaudioRecordGetBufferPool(void);
 
 /**
  * @brief				Save a block of recorded audio data ready for the application
@@ -30,7 +30,29 @@
 
 GDisplay	*GDISP;
 
-#if GDISP_NEED_MULTITHREAD
+#if GDISP_NEED_MULTITHREAD && GDISP_MULTITHREAD_STATS
+	#define MUTEX_INIT(g)		{ gfxMutexInit(&(g)->mutex); (g)->locked = FALSE; (g)->lockcount = (g)->lockwaits = 0; }
+	#define MUTEX_ENTER(g)		mutexEnter(g)
+	#define MUTEX_EXIT(g)		mutexExit(g)
+	#define MUTEX_DEINIT(g)		gfxMutexDestroy(&(g)->mutex)
+
+	static void mutexEnter(GDisplay *g) {
+		bool_t	busy;
+
+		// Testing the flag without the mutex is a race but it is only used for counting
+		busy = g->locked;
+		gfxMutexEnter(&g->mutex);
+		g->locked = TRUE;
+		g->lockcount++;
+		if (busy)
+			g->lockwaits++;
+	}
+
+	static void mutexExit(GDisplay *g) {
+		g->locked = FALSE;
+		gfxMutexExit(&g->mutex);
+	}
+#elif GDISP_NEED_MULTITHREAD
 	#define MUTEX_INIT(g)		gfxMutexInit(&(g)->mutex)
 	#define MUTEX_ENTER(g)		gfxMutexEnter(&(g)->mutex)
 	#define MUTEX_EXIT(g)		gfxMutexExit(&(g)->mutex)
@@ -545,6 +567,15 @@ static void line_clip(GDisplay *g) {
 
 void _gdispInit(void)
 {
+	// Initialise the background image decoder
+	#if GDISP_NEED_IMAGE && GDISP_NEED_IMAGE_ASYNC
+		{
+			extern void _gdispImageAsyncInit(void);
+
+			_gdispImageAsyncInit();
+		}
+	#endif
+
 	// GDISP_DRIVER_LIST is defined - create each driver instance
 	#if defined(GDISP_DRIVER_LIST)
 		{
@@ -605,6 +636,15 @@ void _gdispInit(void)
 
 void _gdispDeinit(void)
 {
+	// Stop the background image decoder
+	#if GDISP_NEED_IMAGE && GDISP_NEED_IMAGE_ASYNC
+		{
+			extern void _gdispImageAsyncDeinit(void);
+
+			_gdispImageAsyncDeinit();
+		}
+	#endif
+
 	/* ToDo */
 }
 
@@ -704,6 +744,16 @@ orientation_t gdispGGetOrientation(GDisplay *g)	{ return g->g.Orientation; }
 uint8_t gdispGGetBacklight(GDisplay *g)			{ return g->g.Backlight; }
 uint8_t gdispGGetContrast(GDisplay *g)			{ return g->g.Contrast; }
 
+#if GDISP_NEED_MULTITHREAD && GDISP_MULTITHREAD_STATS
+	void gdispGGetLockStats(GDisplay *g, uint32_t *plocks, uint32_t *pwaits) {
+		// Read without the mutex so profiling doesn't add to the contention
+		if (plocks)
+			*plocks = g->lockcount;
+		if (pwaits)
+			*pwaits = g->lockwaits;
+	}
+#endif
+
 void gdispGFlush(GDisplay *g) {
 	#if GDISP_HARDWARE_FLUSH
 		#if GDISP_HARDWARE_FLUSH == HARDWARE_AUTODETECT
@@ -1095,7 +1145,7 @@ void gdispGBlitArea(GDisplay *g, coord_t x, coord_t y, coord_t cx, coord_t cy, c
 		{
 			// This is a different clipping to fillarea(g) as it needs to take into account srcx,srcy
 			if (x < g->clipx0) { cx -= g->clipx0 - x; srcx += g->clipx0 - x; x = g->clipx0; }
-			if (y < g->clipy0) { cy -= g->clipy0 - y; srcy += g->clipy0 - x; y = g->clipy0; }
+			if (y < g->clipy0) { cy -= g->clipy0 - y; srcy += g->clipy0 - y; y = g->clipy0; }
 			if (x+cx > g->clipx1)	cx = g->clipx1 - x;
 			if (y+cy > g->clipy1)	cy = g->clipy1 - y;
 			if (srcx+cx > srccx) cx = srccx - srcx;
@@ -2674,7 +2724,7 @@ void gdispGBlitArea(GDisplay *g, coord_t x, coord_t y, coord_t cx, coord_t cy, c
 				{
 					cy -= abslines;
 					if (lines < 0) {
-						fy = y+cy-1;
+						fy = y+cy+abslines-1;
 						dy = -1;
 					} else {
 						fy = y;
@@ -300,6 +300,9 @@ unsigned gdispGetDisplayCount(void);
  *
  * @return	The width of the display
  *
+ * @note	This and the other display state queries below don't lock the display so they never
+ * 			wait for drawing in other threads to finish.
+ *
  * @api
  */
 coord_t gdispGGetWidth(GDisplay *g);
@@ -365,6 +368,26 @@ uint8_t gdispGGetBacklight(GDisplay *g);
 uint8_t gdispGGetContrast(GDisplay *g);
 #define gdispGetContrast()							gdispGGetContrast(GDISP)
 
+#if (GDISP_NEED_MULTITHREAD && GDISP_MULTITHREAD_STATS) || defined(__DOXYGEN__)
+	/**
+	 * @brief   Get the locking statistics for a display.
+	 *
+	 * @param[in] g 		The display to use
+	 * @param[out] plocks	How many times a thread has taken the display lock. May be NULL.
+	 * @param[out] pwaits	How many times a thread found the display already locked by another thread
+	 * 						and had to wait (the contention count). May be NULL.
+	 *
+	 * @pre		GDISP_NEED_MULTITHREAD and GDISP_MULTITHREAD_STATS must be TRUE in your gfxconf.h
+	 *
+	 * @note	The counters are approximate and may occasionally miss a contended lock. They are
+	 * 			intended for profiling. Compare values read at two different times to get a rate.
+	 *
+	 * @api
+	 */
+	void gdispGGetLockStats(GDisplay *g, uint32_t *plocks, uint32_t *pwaits);
+	#define gdispGetLockStats(plocks, pwaits)			gdispGGetLockStats(GDISP, plocks, pwaits)
+#endif
+
 /* Drawing Functions */
 
 /**
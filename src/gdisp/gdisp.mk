@@ -7,6 +7,7 @@ GFXSRC +=   $(GFXLIB)/src/gdisp/gdisp.c \
 			$(GFXLIB)/src/gdisp/gdisp_fonts.c \
 			$(GFXLIB)/src/gdisp/gdisp_pixmap.c \
 			$(GFXLIB)/src/gdisp/gdisp_image.c \
+			$(GFXLIB)/src/gdisp/gdisp_image_async.c \
 			$(GFXLIB)/src/gdisp/gdisp_image_native.c \
 			$(GFXLIB)/src/gdisp/gdisp_image_gif.c \
 			$(GFXLIB)/src/gdisp/gdisp_image_bmp.c \
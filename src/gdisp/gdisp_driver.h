@@ -339,6 +339,11 @@ struct GDisplay {
 	// Multithread Mutex
 	#if GDISP_NEED_MULTITHREAD
 		gfxMutex				mutex;
+		#if GDISP_MULTITHREAD_STATS
+			volatile bool_t		locked;				// The mutex is currently held
+			uint32_t			lockcount;			// How many times the mutex has been taken
+			uint32_t			lockwaits;			// How many times a thread found the mutex already held
+		#endif
 	#endif
 
 	// Software clipping
@@ -11,12 +11,19 @@
 
 #include "gdisp_image_support.h"
 
+#if GDISP_NEED_IMAGE_SCALE
+	#include <string.h>							// Required for memcpy
+#endif
+
 #if GDISP_NEED_IMAGE_NATIVE
 	extern gdispImageError gdispImageOpen_NATIVE(gdispImage *img);
 	extern void gdispImageClose_NATIVE(gdispImage *img);
 	extern gdispImageError gdispImageCache_NATIVE(gdispImage *img);
 	extern gdispImageError gdispGImageDraw_NATIVE(GDisplay *g, gdispImage *img, coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t sx, coord_t sy);
 	extern delaytime_t gdispImageNext_NATIVE(gdispImage *img);
+	#if GDISP_NEED_IMAGE_SCALE
+		extern gdispImageError gdispImageScale_NATIVE(gdispImage *img, gdispImageScaler *s);
+	#endif
 #endif
 
 #if GDISP_NEED_IMAGE_GIF
@@ -52,6 +59,9 @@
 	extern gdispImageError gdispImageCache_PNG(gdispImage *img);
 	extern gdispImageError gdispGImageDraw_PNG(GDisplay *g, gdispImage *img, coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t sx, coord_t sy);
 	extern delaytime_t gdispImageNext_PNG(gdispImage *img);
+	#if GDISP_NEED_IMAGE_SCALE
+		extern gdispImageError gdispImageScale_PNG(gdispImage *img, gdispImageScaler *s);
+	#endif
 #endif
 
 /* The structure defining the routines for image drawing */
@@ -68,6 +78,9 @@ typedef struct gdispImageHandlers {
 	uint16_t		(*getPaletteSize)(gdispImage *img);			/* Retrieve the size of the palette (number of entries) */
 	color_t			(*getPalette)(gdispImage *img, uint16_t index);							/* Retrieve a specific color value of the palette */
 	bool_t			(*adjustPalette)(gdispImage *img, uint16_t index, color_t newColor);	/* Replace a color value in the palette */
+	#if GDISP_NEED_IMAGE_SCALE
+		gdispImageError	(*scale)(gdispImage *img, gdispImageScaler *s);		/* Feed the needed rows to the scaler (optional) */
+	#endif
 } gdispImageHandlers;
 
 static gdispImageHandlers ImageHandlers[] = {
@@ -75,30 +88,45 @@ static gdispImageHandlers ImageHandlers[] = {
 		{	gdispImageOpen_NATIVE,	gdispImageClose_NATIVE,
 			gdispImageCache_NATIVE,	gdispGImageDraw_NATIVE,	gdispImageNext_NATIVE,
 			0,						0,						0
+			#if GDISP_NEED_IMAGE_SCALE
+				,					gdispImageScale_NATIVE
+			#endif
 		},
 	#endif
 	#if GDISP_NEED_IMAGE_GIF
 		{	gdispImageOpen_GIF,		gdispImageClose_GIF,
 			gdispImageCache_GIF,	gdispGImageDraw_GIF,	gdispImageNext_GIF,
 			0,						0,						0
+			#if GDISP_NEED_IMAGE_SCALE
+				,					0
+			#endif
 		},
 	#endif
 	#if GDISP_NEED_IMAGE_BMP
 		{	gdispImageOpen_BMP,				gdispImageClose_BMP,
 			gdispImageCache_BMP,			gdispGImageDraw_BMP,		gdispImageNext_BMP,
 			gdispImageGetPaletteSize_BMP,	gdispImageGetPalette_BMP,	gdispImageAdjustPalette_BMP
+			#if GDISP_NEED_IMAGE_SCALE
+				,					0
+			#endif
 		},
 	#endif
 	#if GDISP_NEED_IMAGE_JPG
 		{	gdispImageOpen_JPG,		gdispImageClose_JPG,
 			gdispImageCache_JPG,	gdispGImageDraw_JPG,	gdispImageNext_JPG,
 			0,						0,						0
+			#if GDISP_NEED_IMAGE_SCALE
+				,					0
+			#endif
 		},
 	#endif
 	#if GDISP_NEED_IMAGE_PNG
 		{	gdispImageOpen_PNG,		gdispImageClose_PNG,
 			gdispImageCache_PNG,	gdispGImageDraw_PNG,	gdispImageNext_PNG,
 			0,						0,						0
+			#if GDISP_NEED_IMAGE_SCALE
+				,					gdispImageScale_PNG
+			#endif
 		},
 	#endif
 };
@@ -114,6 +142,10 @@ gdispImageError gdispImageOpenGFile(gdispImage *img, GFILE *f) {
 		return GDISP_IMAGE_ERR_NOSUCHFILE;
 	img->f = f;
 	img->bgcolor = White;
+	#if GDISP_NEED_IMAGE_ACCOUNTING
+		img->memused = 0;
+		img->maxmemused = 0;
+	#endif
 	for(img->fns = ImageHandlers; img->fns < ImageHandlers+sizeof(ImageHandlers)/sizeof(ImageHandlers[0]); img->fns++) {
 		err = img->fns->open(img);
 		if (err != GDISP_IMAGE_ERR_BADFORMAT) {
@@ -178,6 +210,306 @@ gdispImageError gdispGImageDraw(GDisplay *g, gdispImage *img, coord_t x, coord_t
 	return img->fns->draw(g, img, x, y, cx, cy, sx, sy);
 }
 
+#if GDISP_NEED_IMAGE_SCALE
+	// Effectively infinite fixed point bounds for scaleRange()
+	#define SCALE_INFINITY		(((long long)1)<<60)
+
+	static long long scaleDivFloor(long long a, long long b) {
+		long long	q;
+
+		q = a / b;
+		if ((a % b) && ((a < 0) != (b < 0)))
+			q--;
+		return q;
+	}
+
+	// Restrict the range [*pa, *pb) to those values of p where lo <= a*p + b < hi
+	static void scaleRange(long long a, long long b, long long lo, long long hi, coord_t *pa, coord_t *pb) {
+		long long	l, h;
+
+		if (!a) {
+			if (b < lo || b >= hi)
+				*pb = *pa;
+			return;
+		}
+		if (a > 0) {
+			l = -scaleDivFloor(b - lo, a);
+			h = -scaleDivFloor(b - hi, a);
+		} else {
+			l = scaleDivFloor(hi - b, a) + 1;
+			h = scaleDivFloor(lo - b, a) + 1;
+		}
+		if (l > *pa)
+			*pa = l > *pb ? *pb : (coord_t)l;
+		if (h < *pb)
+			*pb = h < *pa ? *pa : (coord_t)h;
+	}
+
+	// Get the fixed point image row range [*lo, *hi) of the screen pixels that can be drawn once image row y arrives
+	static void scaleTrigger(gdispImageScaler *s, coord_t y, long long *lo, long long *hi) {
+		if (s->filter == GDISP_IMAGE_FILTER_BILINEAR) {
+			// A bilinear pixel needs the image rows either side of its center
+			*lo = y <= s->sy ? FIXED(s->sy) : FIXED(y-1) + FIXED0_5 + 1;
+			*hi = y >= s->sy+s->scy-1 ? FIXED(s->sy+s->scy) : FIXED(y) + FIXED0_5 + 1;
+		} else {
+			*lo = FIXED(y);
+			*hi = FIXED(y+1);
+		}
+	}
+
+	// Get the screen rows [*pa, *pb) that may contain pixels drawn when image row y arrives
+	static void scaleRows(gdispImageScaler *s, coord_t y, coord_t *pa, coord_t *pb) {
+		long long	lo, hi, mn, mx;
+
+		// The image row changes across a screen line by between mn and mx
+		scaleTrigger(s, y, &lo, &hi);
+		if (s->va < 0) {
+			mn = s->va * (s->x1 - 1);
+			mx = s->va * s->x0;
+		} else {
+			mn = s->va * s->x0;
+			mx = s->va * (s->x1 - 1);
+		}
+		*pa = s->y0;
+		*pb = s->y1;
+		scaleRange(s->vb, s->vc + mn, -SCALE_INFINITY, hi, pa, pb);
+		scaleRange(s->vb, s->vc + mx, lo, SCALE_INFINITY, pa, pb);
+	}
+
+	// Find the next image row needed starting at row y
+	static void scaleNext(gdispImageScaler *s, coord_t y) {
+		coord_t		pa, pb;
+
+		for(; y < s->sy + s->scy; y++) {
+			scaleRows(s, y, &pa, &pb);
+			if (pa < pb)
+				break;
+
+			// For bilinear filtering the row may also be needed as the top half of the next row's pixels
+			if (s->filter == GDISP_IMAGE_FILTER_BILINEAR && y+1 < s->sy + s->scy) {
+				scaleRows(s, y+1, &pa, &pb);
+				if (pa < pb)
+					break;
+			}
+		}
+		s->nexty = y;
+	}
+
+	bool_t gdispImageScaleRow(gdispImageScaler *s, coord_t y, const pixel_t *row) {
+		coord_t		py, pye, px, pxe, cnt, iu;
+		long long	lo, hi, u, v, t;
+		uint8_t		fu;
+		pixel_t		c, cp;
+
+		// Ignore rows we don't need
+		if (y < s->nexty)
+			return TRUE;
+
+		scaleTrigger(s, y, &lo, &hi);
+		scaleRows(s, y, &py, &pye);
+		for(; py < pye; py++) {
+			// Find the screen pixels on this line that are drawn from this image row
+			px = s->x0;
+			pxe = s->x1;
+			scaleRange(s->ua, s->ub * py + s->uc, FIXED(s->sx), FIXED(s->sx+s->scx), &px, &pxe);
+			scaleRange(s->va, s->vb * py + s->vc, lo, hi, &px, &pxe);
+			if (px >= pxe)
+				continue;
+
+			u = s->ua * px + s->ub * py + s->uc;
+			v = s->va * px + s->vb * py + s->vc;
+			for(cnt = 0; px < pxe; ) {
+				if (s->filter == GDISP_IMAGE_FILTER_BILINEAR) {
+					// Blend horizontally within the row
+					t = u - FIXED0_5;
+					if (t < FIXED(s->sx))				t = FIXED(s->sx);
+					if (t > FIXED(s->sx+s->scx-1))		t = FIXED(s->sx+s->scx-1);
+					iu = (coord_t)(t >> 16) - s->sx;
+					fu = (uint8_t)(t >> 8);
+					c = row[iu];
+					if (fu)
+						c = gdispBlendColor(row[iu+1], c, fu);
+
+					// Blend vertically with the previous row
+					t = v - FIXED0_5;
+					if (t < FIXED(s->sy))				t = FIXED(s->sy);
+					if (t > FIXED(s->sy+s->scy-1))		t = FIXED(s->sy+s->scy-1);
+					if ((coord_t)(t >> 16) != y) {
+						cp = s->prev[iu];
+						if (fu)
+							cp = gdispBlendColor(s->prev[iu+1], cp, fu);
+						c = (uint8_t)(t >> 8) ? gdispBlendColor(c, cp, (uint8_t)(t >> 8)) : cp;
+					}
+				} else
+					c = row[(coord_t)(u >> 16) - s->sx];
+
+				s->buf[cnt++] = c;
+				px++;
+				u += s->ua;
+				v += s->va;
+				if (cnt >= GDISP_IMAGE_SCALE_BLIT_BUFFER_SIZE || px >= pxe) {
+					gdispGBlitArea(s->g, px-cnt, py, cnt, 1, 0, 0, cnt, s->buf);
+					cnt = 0;
+				}
+			}
+		}
+
+		// Work out what we need next
+		scaleNext(s, y+1);
+		if (s->prev && s->nexty == y+1)
+			memcpy(s->prev, row, s->scx * sizeof(pixel_t));
+		return s->nexty < s->sy + s->scy;
+	}
+
+	static gdispImageError scaleDraw(gdispImage *img, gdispImageScaler *s) {
+		gdispImageError	err;
+
+		// Is there anything to draw
+		if (s->x0 >= s->x1 || s->y0 >= s->y1)
+			return GDISP_IMAGE_ERR_OK;
+		scaleNext(s, s->sy);
+		if (s->nexty >= s->sy + s->scy)
+			return GDISP_IMAGE_ERR_OK;
+
+		// Bilinear filtering needs to remember the previous row
+		s->prev = 0;
+		if (s->filter == GDISP_IMAGE_FILTER_BILINEAR) {
+			if (!(s->prev = (pixel_t *)gdispImageAlloc(img, s->scx * sizeof(pixel_t))))
+				return GDISP_IMAGE_ERR_NOMEMORY;
+		}
+
+		if (img->fns->scale)
+			err = img->fns->scale(img, s);
+		else {
+			#if GDISP_NEED_PIXMAP
+				GDisplay *	pix;
+				pixel_t *	bits;
+
+				// Decode the image area into a temporary pixmap and scale from that
+				if ((pix = gdispPixmapCreate(s->scx, s->scy))) {
+					gdispGFillArea(pix, 0, 0, s->scx, s->scy, img->bgcolor);
+					err = img->fns->draw(pix, img, 0, 0, s->scx, s->scy, s->sx, s->sy);
+					if (!(err & GDISP_IMAGE_ERR_UNRECOVERABLE)) {
+						bits = gdispPixmapGetBits(pix);
+						while(gdispImageScaleRow(s, s->nexty, bits + (size_t)(s->nexty - s->sy) * s->scx));
+					}
+					gdispPixmapDelete(pix);
+				} else
+					err = GDISP_IMAGE_ERR_NOMEMORY;
+			#else
+				err = GDISP_IMAGE_ERR_UNSUPPORTED;
+			#endif
+		}
+
+		if (s->prev)
+			gdispImageFree(img, (void *)s->prev, s->scx * sizeof(pixel_t));
+		return err;
+	}
+
+	gdispImageError gdispGImageDrawScaled(GDisplay *g, gdispImage *img, coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t sx, coord_t sy, coord_t scx, coord_t scy, gdispImageFilter filter) {
+		gdispImageScaler	s;
+
+		if (!img->fns) return GDISP_IMAGE_ERR_BADFORMAT;
+
+		// Check on window
+		if (cx <= 0 || cy <= 0 || scx <= 0 || scy <= 0) return GDISP_IMAGE_ERR_OK;
+		if (sx < 0) sx = 0;
+		if (sy < 0) sy = 0;
+		if (sx >= img->width || sy >= img->height) return GDISP_IMAGE_ERR_OK;
+		if (sx + scx > img->width)  scx = img->width - sx;
+		if (sy + scy > img->height) scy = img->height - sy;
+
+		// Map the center of each screen pixel onto the image area
+		s.g = g;
+		s.filter = filter;
+		s.sx = sx;
+		s.sy = sy;
+		s.scx = scx;
+		s.scy = scy;
+		s.ua = FIXED(scx) / cx;
+		s.ub = 0;
+		s.uc = FIXED(sx) - s.ua * x + s.ua / 2;
+		s.va = 0;
+		s.vb = FIXED(scy) / cy;
+		s.vc = FIXED(sy) - s.vb * y + s.vb / 2;
+
+		// Only visit the part of the area that is on the display
+		s.x0 = x < 0 ? 0 : x;
+		s.y0 = y < 0 ? 0 : y;
+		s.x1 = x + cx > gdispGGetWidth(g) ? gdispGGetWidth(g) : x + cx;
+		s.y1 = y + cy > gdispGGetHeight(g) ? gdispGGetHeight(g) : y + cy;
+
+		return scaleDraw(img, &s);
+	}
+
+	#if GFX_USE_GMISC && GMISC_NEED_MATRIXFIXED2D
+		gdispImageError gdispGImageDrawTransformed(GDisplay *g, gdispImage *img, coord_t x, coord_t y, coord_t cx, coord_t cy, const MatrixFixed2D *m, gdispImageFilter filter) {
+			gdispImageScaler	s;
+			long long			det, i00, i01, i10, i11, t;
+			long long			mnx, mxx, mny, mxy;
+			int					i;
+
+			if (!img->fns) return GDISP_IMAGE_ERR_BADFORMAT;
+			if (cx <= 0 || cy <= 0) return GDISP_IMAGE_ERR_OK;
+
+			// Invert the matrix
+			det = (long long)m->a00 * m->a11 - (long long)m->a01 * m->a10;
+			if (!det) return GDISP_IMAGE_ERR_UNSUPPORTED;
+			i00 = (long long)m->a11 * ((long long)1 << 32) / det;
+			i01 = -(long long)m->a01 * ((long long)1 << 32) / det;
+			i10 = -(long long)m->a10 * ((long long)1 << 32) / det;
+			i11 = (long long)m->a00 * ((long long)1 << 32) / det;
+
+			// Map the center of each screen pixel back onto the image
+			s.g = g;
+			s.filter = filter;
+			s.sx = 0;
+			s.sy = 0;
+			s.scx = img->width;
+			s.scy = img->height;
+			s.ua = i00;
+			s.ub = i01;
+			s.uc = scaleDivFloor(i00 * (FIXED0_5 - m->a02) + i01 * (FIXED0_5 - m->a12), 65536);
+			s.va = i10;
+			s.vb = i11;
+			s.vc = scaleDivFloor(i10 * (FIXED0_5 - m->a02) + i11 * (FIXED0_5 - m->a12), 65536);
+
+			// Find the screen bounding box of the image corners
+			mnx = mny = SCALE_INFINITY;
+			mxx = mxy = -SCALE_INFINITY;
+			for(i = 0; i < 4; i++) {
+				t = (long long)m->a00 * ((i & 1) ? img->width : 0) + (long long)m->a01 * ((i & 2) ? img->height : 0) + m->a02;
+				if (t < mnx) mnx = t;
+				if (t > mxx) mxx = t;
+				t = (long long)m->a10 * ((i & 1) ? img->width : 0) + (long long)m->a11 * ((i & 2) ? img->height : 0) + m->a12;
+				if (t < mny) mny = t;
+				if (t > mxy) mxy = t;
+			}
+			mnx = scaleDivFloor(mnx, 65536);
+			mny = scaleDivFloor(mny, 65536);
+			mxx = -scaleDivFloor(-mxx, 65536);
+			mxy = -scaleDivFloor(-mxy, 65536);
+
+			// Only visit the part of the bounding box that is in the area and on the display
+			if (mnx < x) mnx = x;
+			if (mny < y) mny = y;
+			if (mxx > x + cx) mxx = x + cx;
+			if (mxy > y + cy) mxy = y + cy;
+			if (mnx < 0) mnx = 0;
+			if (mny < 0) mny = 0;
+			if (mxx > gdispGGetWidth(g)) mxx = gdispGGetWidth(g);
+			if (mxy > gdispGGetHeight(g)) mxy = gdispGGetHeight(g);
+			if (mnx >= mxx || mny >= mxy) return GDISP_IMAGE_ERR_OK;
+			s.x0 = (coord_t)mnx;
+			s.y0 = (coord_t)mny;
+			s.x1 = (coord_t)mxx;
+			s.y1 = (coord_t)mxy;
+
+			return scaleDraw(img, &s);
+		}
+	#endif
+#endif
+
 delaytime_t gdispImageNext(gdispImage *img) {
 	if (!img->fns) return GDISP_IMAGE_ERR_BADFORMAT;
 	return img->fns->next(img);
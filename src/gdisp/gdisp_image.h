@@ -52,6 +52,13 @@ typedef uint16_t	gdispImageFlags;
 	#define GDISP_IMAGE_FLG_ANIMATED			0x0002	/* The image has animation */
 	#define GDISP_IMAGE_FLG_MULTIPAGE			0x0004	/* The image has multiple pages */
 
+/**
+ * @brief	The resampling filter used when drawing a scaled or transformed image
+ */
+typedef uint8_t		gdispImageFilter;
+	#define GDISP_IMAGE_FILTER_NEAREST			0		/* Use the nearest source pixel */
+	#define GDISP_IMAGE_FILTER_BILINEAR			1		/* Blend the four nearest source pixels */
+
 /**
  * @brief	The structure for an image
  */
@@ -68,6 +75,55 @@ typedef struct gdispImage {
 	const struct gdispImageHandlers *	fns;				/* @< Don't mess with this! */
 	void *								priv;				/* @< Don't mess with this! */
 } gdispImage;
+
+#if GDISP_NEED_IMAGE_ASYNC || defined(__DOXYGEN__)
+	/**
+	 * @brief	An image decode priority
+	 * @note	Higher priority jobs are decoded first. Jobs with the same priority are decoded in the order they were requested.
+	 */
+	typedef uint8_t		gdispImagePriority;
+		#define GDISP_IMAGE_PRIORITY_PREFETCH		0		/* An image that may be needed soon */
+		#define GDISP_IMAGE_PRIORITY_VISIBLE		128		/* An image that is waiting to be displayed */
+
+	/**
+	 * @brief	The structure for an asynchronous image decode request
+	 */
+	typedef struct gdispImageJob {
+		struct gdispImageJob *				next;				/* @< Don't mess with this! */
+		gdispImage *						img;				/* @< The image being decoded */
+		GDisplay *							pixmap;				/* @< The decoded image (when the job is done) */
+		gdispImageError						err;				/* @< The decode result (when the job is done) */
+		gdispImagePriority					priority;			/* @< The job priority */
+		volatile uint8_t					state;				/* @< The job state */
+			#define GDISP_IMAGE_JOB_IDLE			0			/* Not requested or cancelled */
+			#define GDISP_IMAGE_JOB_QUEUED			1			/* Waiting for a decode thread */
+			#define GDISP_IMAGE_JOB_DECODING		2			/* Being decoded */
+			#define GDISP_IMAGE_JOB_DONE			3			/* Decoded (or failed) */
+		uint8_t								flags;				/* @< Don't mess with this! */
+		void								(*fn)(struct gdispImageJob *job, void *param);	/* @< The completion callback (may be NULL) */
+		void *								param;				/* @< The completion callback parameter */
+		gfxSem *							waiter;				/* @< Don't mess with this! */
+		gfxThreadHandle						notifier;			/* @< Don't mess with this! */
+	} gdispImageJob;
+
+	/**
+	 * @brief	A function called by the decode thread when a job is done
+	 */
+	typedef void (*gdispImageJobCallback)(gdispImageJob *job, void *param);
+
+	#if GFX_USE_GEVENT || defined(__DOXYGEN__)
+		#define GEVENT_IMAGE_DECODED		(GEVENT_GDISP_FIRST+0)
+
+		/**
+		 * @brief	The event sent when an asynchronous image decode job is done
+		 */
+		typedef struct GEventImageDecoded {
+			GEventType						type;				/* @< The type of this event (GEVENT_IMAGE_DECODED) */
+			gdispImageJob *					job;				/* @< The job that is done */
+			gdispImageError					err;				/* @< The decode result */
+		} GEventImageDecoded;
+	#endif
+#endif
 	
 #ifdef __cplusplus
 extern "C" {
@@ -227,6 +283,59 @@ extern "C" {
 	gdispImageError gdispGImageDraw(GDisplay *g, gdispImage *img, coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t sx, coord_t sy);
 	#define gdispImageDraw(img,x,y,cx,cy,sx,sy)		gdispGImageDraw(GDISP,img,x,y,cx,cy,sx,sy)
 
+	#if GDISP_NEED_IMAGE_SCALE || defined(__DOXYGEN__)
+		/**
+		 * @brief	Draw part of the image scaled to fit a screen area
+		 * @return	GDISP_IMAGE_ERR_OK (0) on success or an error code.
+		 *
+		 * @param[in] g   		The display to draw on
+		 * @param[in] img   	The image structure
+		 * @param[in] x,y		The screen location to draw the image
+		 * @param[in] cx,cy		The area on the screen to draw
+		 * @param[in] sx,sy		The image position to start drawing from
+		 * @param[in] scx,scy	The size of the image area to scale into the screen area
+		 * @param[in] filter	The resampling filter (GDISP_IMAGE_FILTER_NEAREST or GDISP_IMAGE_FILTER_BILINEAR)
+		 *
+		 * @pre		gdispImageOpen() must have returned successfully.
+		 * @pre		GDISP_NEED_IMAGE_SCALE must be TRUE
+		 *
+		 * @note	The image area is clipped to the image before it is scaled.
+		 * @note	Only the source rows and columns needed are decoded (where the decoder allows it)
+		 * 			so drawing a large image shrunk onto a small area is much cheaper than decoding it all.
+		 * @note	Transparent pixels are drawn using the image background color.
+		 * @note	Decoders that can't resample while decoding (eg GIF and BMP) are decoded into a
+		 * 			temporary pixmap first. This requires GDISP_NEED_PIXMAP otherwise
+		 * 			GDISP_IMAGE_ERR_UNSUPPORTED is returned.
+		 */
+		gdispImageError gdispGImageDrawScaled(GDisplay *g, gdispImage *img, coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t sx, coord_t sy, coord_t scx, coord_t scy, gdispImageFilter filter);
+		#define gdispImageDrawScaled(img,x,y,cx,cy,sx,sy,scx,scy,filter)		gdispGImageDrawScaled(GDISP,img,x,y,cx,cy,sx,sy,scx,scy,filter)
+
+		#if (GFX_USE_GMISC && GMISC_NEED_MATRIXFIXED2D) || defined(__DOXYGEN__)
+			/**
+			 * @brief	Draw the image using an affine transform (eg rotated, scaled or sheared)
+			 * @return	GDISP_IMAGE_ERR_OK (0) on success or an error code.
+			 *
+			 * @param[in] g   		The display to draw on
+			 * @param[in] img   	The image structure
+			 * @param[in] x,y		The top left of the screen area to draw in
+			 * @param[in] cx,cy		The size of the screen area to draw in
+			 * @param[in] m			The matrix that transforms image coordinates into screen coordinates
+			 * @param[in] filter	The resampling filter (GDISP_IMAGE_FILTER_NEAREST or GDISP_IMAGE_FILTER_BILINEAR)
+			 *
+			 * @pre		gdispImageOpen() must have returned successfully.
+			 * @pre		GDISP_NEED_IMAGE_SCALE, GFX_USE_GMISC and GMISC_NEED_MATRIXFIXED2D must be TRUE
+			 *
+			 * @note	Nothing outside the screen area is drawn. Screen pixels that don't map onto the image
+			 * 			are left untouched.
+			 * @note	The matrix must be invertible (ie not squash the image to a line) otherwise
+			 * 			GDISP_IMAGE_ERR_UNSUPPORTED is returned.
+			 * @note	See gdispGImageDrawScaled() for the notes on transparency and decoder support.
+			 */
+			gdispImageError gdispGImageDrawTransformed(GDisplay *g, gdispImage *img, coord_t x, coord_t y, coord_t cx, coord_t cy, const MatrixFixed2D *m, gdispImageFilter filter);
+			#define gdispImageDrawTransformed(img,x,y,cx,cy,m,filter)		gdispGImageDrawTransformed(GDISP,img,x,y,cx,cy,m,filter)
+		#endif
+	#endif
+
 	/**
 	 * @brief	Prepare for the next frame/page in the image file.
 	 * @return	A time in milliseconds to keep displaying the current frame before trying to draw
@@ -283,7 +392,71 @@ extern "C" {
 	 * @note	This function will return @p FALSE if the index is out of bounds or if the image doesn't use a color palette.
 	 */
 	bool_t gdispImageAdjustPalette(gdispImage *img, uint16_t index, color_t newColor);
-	
+
+	#if GDISP_NEED_IMAGE_ASYNC || defined(__DOXYGEN__)
+		/**
+		 * @brief	Initialise an asynchronous image decode job
+		 *
+		 * @param[in] job		The job structure to initialise
+		 * @param[in] fn		A function to call when the job is done (may be NULL)
+		 * @param[in] param		A parameter to pass to the function
+		 *
+		 * @note	The callback is called by the decode thread. It may resubmit its own job with
+		 * 			@p gdispImageDecodeAsync() (eg. to decode the next image) or cancel it. It must not free the job.
+		 */
+		void gdispImageJobInit(gdispImageJob *job, gdispImageJobCallback fn, void *param);
+
+		/**
+		 * @brief	Request that an image be decoded into a pixmap by a background decode thread
+		 * @return	GDISP_IMAGE_ERR_OK (0) if the job was queued or an error code.
+		 *
+		 * @param[in] job		The job structure
+		 * @param[in] img		The image to decode
+		 * @param[in] priority	The job priority
+		 *
+		 * @pre		gdispImageOpen() must have returned successfully and the job must have been initialised.
+		 *
+		 * @note	Any previous result for this job is thrown away first.
+		 * @note	When the job is done the job callback is called and a GEVENT_IMAGE_DECODED event is
+		 * 			sent to any listeners on @p gdispImageDecodeGetSource(). The result is then in job->pixmap
+		 * 			and job->err.
+		 * @note	No event is sent if the job callback resubmits or cancels the job.
+		 * @note	The image must not be drawn, cached or closed while the job is queued or decoding.
+		 * @note	The pixmap uses width * height pixels of RAM. Only the first frame of an animation is decoded.
+		 */
+		gdispImageError gdispImageDecodeAsync(gdispImageJob *job, gdispImage *img, gdispImagePriority priority);
+
+		/**
+		 * @brief	Change the priority of a queued decode job
+		 *
+		 * @param[in] job		The job structure
+		 * @param[in] priority	The new job priority
+		 *
+		 * @note	This is useful for moving a prefetch job in front of the queue when it becomes visible.
+		 * 			It does nothing if the job is not waiting in the queue.
+		 */
+		void gdispImageDecodeSetPriority(gdispImageJob *job, gdispImagePriority priority);
+
+		/**
+		 * @brief	Cancel a decode job and throw away any result
+		 *
+		 * @param[in] job		The job structure
+		 *
+		 * @note	A queued job is simply removed from the queue. If the job is being decoded this waits for
+		 * 			the decode to finish (decoders can't be interrupted) and then throws away the result.
+		 * @note	On return the job is idle so it, and its image, may be freed or reused.
+		 */
+		void gdispImageDecodeCancel(gdispImageJob *job);
+
+		#if GFX_USE_GEVENT || defined(__DOXYGEN__)
+			/**
+			 * @brief	Get the source handle for asynchronous image decode events
+			 * @return	The source handle
+			 */
+			GSourceHandle gdispImageDecodeGetSource(void);
+		#endif
+	#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,286 @@
+/*
+ * This file is subject to the terms of the GFX License. If a copy of
+ * the license was not distributed with this file, you can obtain one at:
+ *
+ *              http://ugfx.org/license.html
+ */
+
+#include "../../gfx.h"
+
+#if GFX_USE_GDISP && GDISP_NEED_IMAGE && GDISP_NEED_IMAGE_ASYNC
+
+#define JOB_FLG_CANCEL		0x01			// The job has been cancelled while it was decoding
+#define JOB_FLG_NOTIFY		0x02			// The decode thread is still telling everyone the job is done
+#define JOB_FLG_REQUEUE		0x04			// The job callback has resubmitted the job. It is queued when the callback returns.
+
+/* This mutex protects access to the job queue and the job states */
+static gfxMutex			jobMutex;
+static gfxSem			jobSem;
+static gdispImageJob	*jobHead;
+static unsigned			jobThreads;
+static gfxThreadHandle	jobThread[GDISP_IMAGE_ASYNC_THREADS];
+static bool_t			jobStop;
+
+// Remove a job from the queue. Must be called with the mutex held.
+static void jobUnqueue(gdispImageJob *job) {
+	gdispImageJob	**pp;
+
+	for(pp = &jobHead; *pp; pp = &(*pp)->next) {
+		if (*pp == job) {
+			*pp = job->next;
+			break;
+		}
+	}
+}
+
+// Add a job to the queue after any jobs of the same or higher priority. Must be called with the mutex held.
+static void jobQueue(gdispImageJob *job) {
+	gdispImageJob	**pp;
+
+	for(pp = &jobHead; *pp && (*pp)->priority >= job->priority; pp = &(*pp)->next);
+	job->next = *pp;
+	*pp = job;
+	job->state = GDISP_IMAGE_JOB_QUEUED;
+}
+
+static DECLARE_THREAD_FUNCTION(ImageDecodeThread, arg) {
+	gdispImageJob *		job;
+	GDisplay *			pix;
+	gdispImageError		err;
+	#if GFX_USE_GEVENT
+		GSourceListener		*psl;
+		GEventImageDecoded	*pe;
+	#endif
+	(void)				arg;
+
+	while(1) {
+		/* Wait for work to do */
+		gfxSemWait(&jobSem, TIME_INFINITE);
+
+		/* Take the highest priority job (it may have been cancelled already) */
+		gfxMutexEnter(&jobMutex);
+		if (jobStop) {
+			gfxMutexExit(&jobMutex);
+			break;
+		}
+		if (!(job = jobHead)) {
+			gfxMutexExit(&jobMutex);
+			continue;
+		}
+		jobHead = job->next;
+		job->state = GDISP_IMAGE_JOB_DECODING;
+		gfxMutexExit(&jobMutex);
+
+		/* Decode the image into a new pixmap */
+		if ((pix = gdispPixmapCreate(job->img->width, job->img->height))) {
+			gdispGFillArea(pix, 0, 0, job->img->width, job->img->height, job->img->bgcolor);
+			err = gdispGImageDraw(pix, job->img, 0, 0, job->img->width, job->img->height, 0, 0);
+			if ((err & GDISP_IMAGE_ERR_UNRECOVERABLE)) {
+				gdispPixmapDelete(pix);
+				pix = 0;
+			}
+		} else
+			err = GDISP_IMAGE_ERR_NOMEMORY;
+
+		/* Save the result unless the job was cancelled while we were decoding */
+		gfxMutexEnter(&jobMutex);
+		if ((job->flags & JOB_FLG_CANCEL)) {
+			if (pix)
+				gdispPixmapDelete(pix);
+			job->flags = 0;
+			job->state = GDISP_IMAGE_JOB_IDLE;
+			if (job->waiter)
+				gfxSemSignal(job->waiter);
+			gfxMutexExit(&jobMutex);
+			continue;
+		}
+		job->pixmap = pix;
+		job->err = err;
+		job->state = GDISP_IMAGE_JOB_DONE;
+		job->flags = JOB_FLG_NOTIFY;
+		job->notifier = gfxThreadMe();
+		gfxMutexExit(&jobMutex);
+
+		/* Tell everyone. Other threads can't cancel the job until we are finished with it. */
+		if (job->fn)
+			job->fn(job, job->param);
+		#if GFX_USE_GEVENT
+			psl = 0;
+			while (job->state == GDISP_IMAGE_JOB_DONE && (psl = geventGetSourceListener((GSourceHandle)&jobSem, psl))) {
+				if (!(pe = (GEventImageDecoded *)geventGetEventBuffer(psl)))
+					continue;
+				pe->type = GEVENT_IMAGE_DECODED;
+				pe->job = job;
+				pe->err = err;
+				geventSendEvent(psl);
+			}
+		#endif
+
+		gfxMutexEnter(&jobMutex);
+		if (job->waiter)
+			// Someone else is cancelling the job. That wins over any resubmit by the callback.
+			gfxSemSignal(job->waiter);
+		else if ((job->flags & JOB_FLG_REQUEUE)) {
+			// The callback resubmitted the job
+			jobQueue(job);
+			gfxSemSignal(&jobSem);
+		}
+		job->flags = 0;
+		gfxMutexExit(&jobMutex);
+	}
+	THREAD_RETURN(0);
+}
+
+void _gdispImageAsyncInit(void) {
+	gfxMutexInit(&jobMutex);
+	gfxSemInit(&jobSem, 0, MAX_SEMAPHORE_COUNT);
+	jobHead = 0;
+	jobThreads = 0;
+	jobStop = FALSE;
+}
+
+void _gdispImageAsyncDeinit(void) {
+	gdispImageJob	*job;
+	unsigned		i;
+
+	// Stop the decode threads. Any job that is decoding is finished first.
+	gfxMutexEnter(&jobMutex);
+	jobStop = TRUE;
+	gfxMutexExit(&jobMutex);
+	for(i = 0; i < jobThreads; i++)
+		gfxSemSignal(&jobSem);
+	for(i = 0; i < jobThreads; i++)
+		gfxThreadWait(jobThread[i]);
+	jobThreads = 0;
+
+	// Discard any jobs that haven't been started
+	while((job = jobHead)) {
+		jobHead = job->next;
+		job->next = 0;
+		job->state = GDISP_IMAGE_JOB_IDLE;
+	}
+
+	gfxSemDestroy(&jobSem);
+	gfxMutexDestroy(&jobMutex);
+}
+
+void gdispImageJobInit(gdispImageJob *job, gdispImageJobCallback fn, void *param) {
+	job->next = 0;
+	job->img = 0;
+	job->pixmap = 0;
+	job->err = GDISP_IMAGE_ERR_OK;
+	job->priority = GDISP_IMAGE_PRIORITY_PREFETCH;
+	job->state = GDISP_IMAGE_JOB_IDLE;
+	job->flags = 0;
+	job->fn = fn;
+	job->param = param;
+	job->waiter = 0;
+	job->notifier = 0;
+}
+
+gdispImageError gdispImageDecodeAsync(gdispImageJob *job, gdispImage *img, gdispImagePriority priority) {
+	gfxThreadHandle		hThread;
+
+	if (!img->fns)
+		return GDISP_IMAGE_ERR_BADFORMAT;
+
+	// Throw away any previous result
+	gdispImageDecodeCancel(job);
+
+	gfxMutexEnter(&jobMutex);
+
+	// Start the decode threads if they haven't been started yet
+	while(jobThreads < GDISP_IMAGE_ASYNC_THREADS) {
+		if (!(hThread = gfxThreadCreate(0, GDISP_IMAGE_ASYNC_THREAD_WORKAREA_SIZE, GDISP_IMAGE_ASYNC_THREAD_PRIORITY, ImageDecodeThread, 0)))
+			break;
+		jobThread[jobThreads++] = hThread;		// Kept so the threads can be stopped by _gdispImageAsyncDeinit()
+	}
+	if (!jobThreads) {
+		gfxMutexExit(&jobMutex);
+		return GDISP_IMAGE_ERR_NOMEMORY;
+	}
+
+	job->img = img;
+	job->priority = priority;
+	job->err = GDISP_IMAGE_ERR_OK;
+
+	// If we are the job's own callback the decode thread queues it when we return
+	if ((job->flags & JOB_FLG_NOTIFY) && job->notifier == gfxThreadMe()) {
+		job->flags |= JOB_FLG_REQUEUE;
+		job->state = GDISP_IMAGE_JOB_QUEUED;
+		gfxMutexExit(&jobMutex);
+		return GDISP_IMAGE_ERR_OK;
+	}
+
+	jobQueue(job);
+	gfxMutexExit(&jobMutex);
+
+	gfxSemSignal(&jobSem);
+	return GDISP_IMAGE_ERR_OK;
+}
+
+void gdispImageDecodeSetPriority(gdispImageJob *job, gdispImagePriority priority) {
+	gfxMutexEnter(&jobMutex);
+	if (job->state == GDISP_IMAGE_JOB_QUEUED) {
+		job->priority = priority;
+
+		// A job resubmitted by its callback isn't on the queue yet
+		if (!(job->flags & JOB_FLG_REQUEUE)) {
+			jobUnqueue(job);
+			jobQueue(job);
+		}
+	}
+	gfxMutexExit(&jobMutex);
+}
+
+void gdispImageDecodeCancel(gdispImageJob *job) {
+	gfxSem		waitsem;
+
+	gfxMutexEnter(&jobMutex);
+
+	switch(job->state) {
+	case GDISP_IMAGE_JOB_QUEUED:
+		// Just take it off the queue. The decode thread ignores the extra semaphore count.
+		jobUnqueue(job);
+		job->flags &= ~JOB_FLG_REQUEUE;
+		job->state = GDISP_IMAGE_JOB_IDLE;
+		break;
+
+	case GDISP_IMAGE_JOB_DECODING:
+	case GDISP_IMAGE_JOB_DONE:
+		if (job->state == GDISP_IMAGE_JOB_DONE && !(job->flags & JOB_FLG_NOTIFY))
+			break;
+
+		// The job's own callback can't wait for itself
+		if (job->state == GDISP_IMAGE_JOB_DONE && job->notifier == gfxThreadMe())
+			break;
+
+		// Wait for the decode thread to finish with the job
+		gfxSemInit(&waitsem, 0, 1);
+		if (job->state == GDISP_IMAGE_JOB_DECODING)
+			job->flags |= JOB_FLG_CANCEL;
+		job->waiter = &waitsem;
+		gfxMutexExit(&jobMutex);
+		gfxSemWait(&waitsem, TIME_INFINITE);
+		gfxMutexEnter(&jobMutex);
+		job->waiter = 0;
+		gfxSemDestroy(&waitsem);
+		break;
+	}
+
+	// Throw away any result
+	if (job->state == GDISP_IMAGE_JOB_DONE && job->pixmap)
+		gdispPixmapDelete(job->pixmap);
+	job->pixmap = 0;
+	job->state = GDISP_IMAGE_JOB_IDLE;
+
+	gfxMutexExit(&jobMutex);
+}
+
+#if GFX_USE_GEVENT
+	GSourceHandle gdispImageDecodeGetSource(void) {
+		return (GSourceHandle)&jobSem;
+	}
+#endif
+
+#endif /* GFX_USE_GDISP && GDISP_NEED_IMAGE && GDISP_NEED_IMAGE_ASYNC */
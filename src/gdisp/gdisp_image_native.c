@@ -11,6 +11,10 @@
 
 #include "gdisp_image_support.h"
 
+#if GDISP_NEED_IMAGE_NATIVE_COMPRESSED
+	#include <string.h>							// Required for memcpy
+#endif
+
 /**
  * How big a pixel array to allocate for blitting
  * Bigger is faster but uses more RAM.
@@ -20,6 +24,21 @@
 #define HEADER_SIZE_NATIVE			8
 #define FRAME0POS_NATIVE			(HEADER_SIZE_NATIVE)
 
+/**
+ * The compressed native format ("NC") is the native header followed by...
+ *		byte 8		The number of bytes per pixel (must match sizeof(pixel_t))
+ *		byte 9		The number of pixel rows compressed together as a block
+ *		byte 10-11	Reserved (0)
+ *		byte 12		A table of (blocks+1) 32 bit big endian offsets (relative to the end of the table)
+ *					giving the start of each compressed block. The last entry is the total data length.
+ * Each block is independently compressed using LZ4 style sequences of
+ *		token (literal count << 4 | (match length - 4)), [literal count extension bytes], literals,
+ *		16 bit little endian match offset, [match length extension bytes]
+ * Runs of a repeated pixel are encoded as a match with an offset of one pixel.
+ */
+#define HEADER_SIZE_NATIVE_COMPRESSED	12
+#define MINMATCH_NATIVE_COMPRESSED		4
+
 /**
  * Helper Routines Needed
  */
@@ -28,9 +47,143 @@ void gdispImageFree(gdispImage *img, void *ptr, size_t sz);
 
 typedef struct gdispImagePrivate_NATIVE {
 	pixel_t		*frame0cache;
+	#if GDISP_NEED_IMAGE_NATIVE_COMPRESSED
+		pixel_t		*block;						// The decompressed block buffer
+		coord_t		blockrows;					// The number of rows in each compressed block (0 = not compressed)
+		coord_t		blocknum;					// The block currently in the block buffer (-1 = none)
+		size_t		fremain;					// The number of compressed bytes not yet read into fbuf
+		uint16_t	fpos, flen;					// The current position and the number of valid bytes in fbuf
+		uint8_t		fbuf[GDISP_IMAGE_NATIVE_FILE_BUFFER_SIZE];
+	#endif
 	pixel_t		buf[BLIT_BUFFER_SIZE_NATIVE];
 	} gdispImagePrivate_NATIVE;
 
+#if GDISP_NEED_IMAGE_NATIVE_COMPRESSED
+	#define NC_BLOCKS(img, priv)	(((img)->height + (priv)->blockrows - 1) / (priv)->blockrows)
+	#define NC_BLOCKROWS(img, priv)	((priv)->blockrows < (img)->height ? (priv)->blockrows : (img)->height)	// A block never has more rows than the image
+	#define NC_BLOCKSIZE(img, priv)	((size_t)(img)->width * NC_BLOCKROWS(img, priv) * sizeof(pixel_t))
+
+	// Get the next compressed byte. Returns -1 on end of data.
+	static int NCGetByte(gdispImage *img) {
+		gdispImagePrivate_NATIVE *	priv;
+
+		priv = (gdispImagePrivate_NATIVE *)img->priv;
+		if (priv->fpos >= priv->flen) {
+			if (!priv->fremain)
+				return -1;
+			priv->flen = gfileRead(img->f, priv->fbuf, priv->fremain > GDISP_IMAGE_NATIVE_FILE_BUFFER_SIZE ? GDISP_IMAGE_NATIVE_FILE_BUFFER_SIZE : priv->fremain);
+			if (!priv->flen)
+				return -1;
+			priv->fremain -= priv->flen;
+			priv->fpos = 0;
+		}
+		return priv->fbuf[priv->fpos++];
+	}
+
+	// Get an LZ4 style length extension. Returns (size_t)-1 on end of data.
+	static size_t NCGetLength(gdispImage *img, size_t len) {
+		int		b;
+
+		do {
+			if ((b = NCGetByte(img)) < 0)
+				return (size_t)-1;
+			len += b;
+		} while(b == 255);
+		return len;
+	}
+
+	// Decompress a block of rows into the output buffer
+	static gdispImageError NCDecodeBlock(gdispImage *img, coord_t blk, uint8_t *out) {
+		gdispImagePrivate_NATIVE *	priv;
+		uint8_t		*p, *pend, *m;
+		size_t		len, n;
+		unsigned	off;
+		int			tok, b;
+		uint8_t		hdr[8];
+
+		priv = (gdispImagePrivate_NATIVE *)img->priv;
+
+		// Find the block in the offset table
+		gfileSetPos(img->f, HEADER_SIZE_NATIVE_COMPRESSED + blk * 4);
+		if (gfileRead(img->f, hdr, 8) != 8)
+			return GDISP_IMAGE_ERR_BADDATA;
+		off = gdispImageGetAlignedBE32(hdr, 0);
+		len = gdispImageGetAlignedBE32(hdr, 4);
+		if (len < off)
+			return GDISP_IMAGE_ERR_BADDATA;
+		gfileSetPos(img->f, HEADER_SIZE_NATIVE_COMPRESSED + (NC_BLOCKS(img, priv)+1) * 4 + off);
+		priv->fremain = len - off;
+		priv->fpos = priv->flen = 0;
+
+		// How many rows in this block - the last block may be short
+		n = img->height - blk * priv->blockrows;
+		if (n > (size_t)priv->blockrows)
+			n = priv->blockrows;
+		p = out;
+		pend = out + n * img->width * sizeof(pixel_t);
+
+		while(p < pend) {
+			if ((tok = NCGetByte(img)) < 0)
+				return GDISP_IMAGE_ERR_BADDATA;
+
+			// Copy the literals
+			len = tok >> 4;
+			if (len == 15 && (len = NCGetLength(img, len)) == (size_t)-1)
+				return GDISP_IMAGE_ERR_BADDATA;
+			if (len > (size_t)(pend - p))
+				return GDISP_IMAGE_ERR_BADDATA;
+			if (len) {
+				// Firstly, anything already in the file buffer
+				n = priv->flen - priv->fpos;
+				if (n > len)
+					n = len;
+				memcpy(p, priv->fbuf+priv->fpos, n);
+				priv->fpos += n;
+				p += n;
+				len -= n;
+
+				// Then read the rest directly
+				if (len) {
+					if (len > priv->fremain || gfileRead(img->f, p, len) != len)
+						return GDISP_IMAGE_ERR_BADDATA;
+					priv->fremain -= len;
+					p += len;
+				}
+			}
+
+			// The block may end with literals
+			if (p >= pend)
+				break;
+
+			// Get the match offset and length
+			if ((b = NCGetByte(img)) < 0)
+				return GDISP_IMAGE_ERR_BADDATA;
+			off = b;
+			if ((b = NCGetByte(img)) < 0)
+				return GDISP_IMAGE_ERR_BADDATA;
+			off |= b << 8;
+			len = tok & 0x0F;
+			if (len == 15 && (len = NCGetLength(img, len)) == (size_t)-1)
+				return GDISP_IMAGE_ERR_BADDATA;
+			len += MINMATCH_NATIVE_COMPRESSED;
+			if (!off || off > (size_t)(p - out) || len > (size_t)(pend - p))
+				return GDISP_IMAGE_ERR_BADDATA;
+
+			// Copy the match (which may overlap the output for runs)
+			m = p - off;
+			if (off >= len) {
+				memcpy(p, m, len);
+				p += len;
+			} else {
+				while(len--)
+					*p++ = *m++;
+			}
+		}
+
+		return GDISP_IMAGE_ERR_OK;
+	}
+#endif
+
 void gdispImageClose_NATIVE(gdispImage *img) {
 	gdispImagePrivate_NATIVE *	priv;
 
@@ -38,24 +191,45 @@ void gdispImageClose_NATIVE(gdispImage *img) {
 	if (priv) {
 		if (priv->frame0cache)
 			gdispImageFree(img, (void *)priv->frame0cache, img->width * img->height * sizeof(pixel_t));
+		#if GDISP_NEED_IMAGE_NATIVE_COMPRESSED
+			if (priv->block)
+				gdispImageFree(img, (void *)priv->block, NC_BLOCKSIZE(img, priv));
+		#endif
 		gdispImageFree(img, (void *)priv, sizeof(gdispImagePrivate_NATIVE));
 		img->priv = 0;
 	}
 }
 
 gdispImageError gdispImageOpen_NATIVE(gdispImage *img) {
-	uint8_t		hdr[HEADER_SIZE_NATIVE];
+	gdispImagePrivate_NATIVE *	priv;
+	uint8_t		hdr[HEADER_SIZE_NATIVE_COMPRESSED];
 
 	/* Read the 8 byte header */
 	if (gfileRead(img->f, hdr, 8) != 8)
 		return GDISP_IMAGE_ERR_BADFORMAT;		// It can't be us
 
-	if (hdr[0] != 'N' || hdr[1] != 'I')
+	#if GDISP_NEED_IMAGE_NATIVE_COMPRESSED
+		if (hdr[0] != 'N' || (hdr[1] != 'I' && hdr[1] != 'C'))
+	#else
+		if (hdr[0] != 'N' || hdr[1] != 'I')
+	#endif
 		return GDISP_IMAGE_ERR_BADFORMAT;		// It can't be us
 
 	if (hdr[6] != GDISP_PIXELFORMAT/256 || hdr[7] != (GDISP_PIXELFORMAT & 0xFF))
 		return GDISP_IMAGE_ERR_UNSUPPORTED;		// Unsupported pixel format
 
+	#if GDISP_NEED_IMAGE_NATIVE_COMPRESSED
+		/* Read the extra compressed header */
+		if (hdr[1] == 'C') {
+			if (gfileRead(img->f, hdr+8, 4) != 4)
+				return GDISP_IMAGE_ERR_BADDATA;
+			if (hdr[8] != sizeof(pixel_t))
+				return GDISP_IMAGE_ERR_UNSUPPORTED;	// Our pixel_t is a different size
+			if (!hdr[9])
+				return GDISP_IMAGE_ERR_BADDATA;
+		}
+	#endif
+
 	/* We know we are a native format image */
 	img->flags = 0;
 	img->width = (((uint16_t)hdr[2])<<8) | (hdr[3]);
@@ -64,7 +238,13 @@ gdispImageError gdispImageOpen_NATIVE(gdispImage *img) {
 		return GDISP_IMAGE_ERR_BADDATA;
 	if (!(img->priv = gdispImageAlloc(img, sizeof(gdispImagePrivate_NATIVE))))
 		return GDISP_IMAGE_ERR_NOMEMORY;
-	((gdispImagePrivate_NATIVE *)(img->priv))->frame0cache = 0;
+	priv = (gdispImagePrivate_NATIVE *)img->priv;
+	priv->frame0cache = 0;
+	#if GDISP_NEED_IMAGE_NATIVE_COMPRESSED
+		priv->block = 0;
+		priv->blockrows = hdr[1] == 'C' ? hdr[9] : 0;
+		priv->blocknum = -1;
+	#endif
 
 	img->type = GDISP_IMAGE_TYPE_NATIVE;
 	return GDISP_IMAGE_ERR_OK;
@@ -85,6 +265,24 @@ gdispImageError gdispImageCache_NATIVE(gdispImage *img) {
 	if (!priv->frame0cache)
 		return GDISP_IMAGE_ERR_NOMEMORY;
 
+	#if GDISP_NEED_IMAGE_NATIVE_COMPRESSED
+		/* Decompress every block straight into the cache */
+		if (priv->blockrows) {
+			gdispImageError	err;
+			coord_t			blk;
+
+			for(blk = 0; blk < NC_BLOCKS(img, priv); blk++) {
+				err = NCDecodeBlock(img, blk, (uint8_t *)(priv->frame0cache + (size_t)blk * priv->blockrows * img->width));
+				if (err) {
+					gdispImageFree(img, (void *)priv->frame0cache, len);
+					priv->frame0cache = 0;
+					return err;
+				}
+			}
+			return GDISP_IMAGE_ERR_OK;
+		}
+	#endif
+
 	/* Read the entire bitmap into cache */
 	gfileSetPos(img->f, FRAME0POS_NATIVE);
 	if (gfileRead(img->f, priv->frame0cache, len) != len)
@@ -111,6 +309,37 @@ gdispImageError gdispGImageDraw_NATIVE(GDisplay *g, gdispImage *img, coord_t x,
 		return GDISP_IMAGE_ERR_OK;
 	}
 
+	#if GDISP_NEED_IMAGE_NATIVE_COMPRESSED
+		/* Decompress a block at a time and blit the rows we need straight out of the block buffer */
+		if (priv->blockrows) {
+			gdispImageError	err;
+			coord_t			blk, by, bcy;
+
+			if (!priv->block) {
+				if (!(priv->block = (pixel_t *)gdispImageAlloc(img, NC_BLOCKSIZE(img, priv))))
+					return GDISP_IMAGE_ERR_NOMEMORY;
+			}
+			while(cy > 0) {
+				blk = sy / priv->blockrows;
+				if (blk != priv->blocknum) {
+					priv->blocknum = -1;
+					if ((err = NCDecodeBlock(img, blk, (uint8_t *)priv->block)))
+						return err;
+					priv->blocknum = blk;
+				}
+				by = sy - blk * priv->blockrows;
+				bcy = priv->blockrows - by;
+				if (bcy > cy)
+					bcy = cy;
+				gdispGBlitArea(g, x, y, cx, bcy, sx, by, img->width, priv->block);
+				y += bcy;
+				sy += bcy;
+				cy -= bcy;
+			}
+			return GDISP_IMAGE_ERR_OK;
+		}
+	#endif
+
 	/* For this image decoder we cheat and just seek straight to the region we want to display */
 	pos = FRAME0POS_NATIVE + (img->width * sy + sx) * sizeof(pixel_t);
 
@@ -140,6 +369,60 @@ gdispImageError gdispGImageDraw_NATIVE(GDisplay *g, gdispImage *img, coord_t x,
 	return GDISP_IMAGE_ERR_OK;
 }
 
+#if GDISP_NEED_IMAGE_SCALE
+	gdispImageError gdispImageScale_NATIVE(gdispImage *img, gdispImageScaler *s) {
+		gdispImageError	err;
+		pixel_t *		row;
+		size_t			len;
+		gdispImagePrivate_NATIVE *	priv;
+
+		priv = (gdispImagePrivate_NATIVE *)img->priv;
+
+		/* Feed rows straight from the image cache - if it exists */
+		if (priv->frame0cache) {
+			while(gdispImageScaleRow(s, s->nexty, priv->frame0cache + (size_t)s->nexty * img->width + s->sx));
+			return GDISP_IMAGE_ERR_OK;
+		}
+
+		#if GDISP_NEED_IMAGE_NATIVE_COMPRESSED
+			/* Decompress only the blocks containing rows we need */
+			if (priv->blockrows) {
+				coord_t			blk;
+
+				if (!priv->block) {
+					if (!(priv->block = (pixel_t *)gdispImageAlloc(img, NC_BLOCKSIZE(img, priv))))
+						return GDISP_IMAGE_ERR_NOMEMORY;
+				}
+				do {
+					blk = s->nexty / priv->blockrows;
+					if (blk != priv->blocknum) {
+						priv->blocknum = -1;
+						if ((err = NCDecodeBlock(img, blk, (uint8_t *)priv->block)))
+							return err;
+						priv->blocknum = blk;
+					}
+				} while(gdispImageScaleRow(s, s->nexty, priv->block + (size_t)(s->nexty - blk * priv->blockrows) * img->width + s->sx));
+				return GDISP_IMAGE_ERR_OK;
+			}
+		#endif
+
+		/* Seek straight to the part of each row we need */
+		len = s->scx * sizeof(pixel_t);
+		if (!(row = (pixel_t *)gdispImageAlloc(img, len)))
+			return GDISP_IMAGE_ERR_NOMEMORY;
+		err = GDISP_IMAGE_ERR_OK;
+		do {
+			gfileSetPos(img->f, FRAME0POS_NATIVE + ((size_t)img->width * s->nexty + s->sx) * sizeof(pixel_t));
+			if (gfileRead(img->f, row, len) != len) {
+				err = GDISP_IMAGE_ERR_BADDATA;
+				break;
+			}
+		} while(gdispImageScaleRow(s, s->nexty, row));
+		gdispImageFree(img, (void *)row, len);
+		return err;
+	}
+#endif
+
 delaytime_t gdispImageNext_NATIVE(gdispImage *img) {
 	(void) img;
 
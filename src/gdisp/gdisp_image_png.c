@@ -11,6 +11,10 @@
 
 #include "gdisp_image_support.h"
 
+#if GDISP_NEED_IMAGE_SCALE
+	#include <string.h>							// Required for memcpy
+#endif
+
 /*-----------------------------------------------------------------
  * Structure definitions
  *---------------------------------------------------------------*/
@@ -70,6 +74,9 @@ typedef struct PNG_output {
 	coord_t		sx, sy;
 	coord_t		ix, iy;
 	unsigned	cnt;
+	#if GDISP_NEED_IMAGE_SCALE
+		pixel_t	*row;					// If set, output goes to this row buffer instead of the display
+	#endif
 	pixel_t		buf[GDISP_IMAGE_PNG_BLIT_BUFFER_SIZE];
 	} PNG_output;
 
@@ -208,10 +215,21 @@ static void PNG_oInit(PNG_output *o, GDisplay *g, coord_t x, coord_t y, coord_t
 	o->sy = sy;
 	o->ix = o->iy = 0;
 	o->cnt = 0;
+	#if GDISP_NEED_IMAGE_SCALE
+		o->row = 0;
+	#endif
 }
 
 // Flush the output buffer to the display
 static void PNG_oFlush(PNG_output *o) {
+	#if GDISP_NEED_IMAGE_SCALE
+		if (o->row) {
+			memcpy(o->row+o->ix-o->sx, o->buf, o->cnt*sizeof(pixel_t));
+			o->ix += o->cnt;
+			o->cnt = 0;
+			return;
+		}
+	#endif
 	switch(o->cnt) {
 	case 0:		return;
 	case 1:		gdispGDrawPixel(o->g, o->x+o->ix-o->sx, o->y+o->iy-o->sy, o->buf[0]); 						break;
@@ -1542,6 +1560,72 @@ exit_baddata:
 	return GDISP_IMAGE_ERR_BADDATA;
 }
 
+#if GDISP_NEED_IMAGE_SCALE
+	gdispImageError gdispImageScale_PNG(gdispImage *img, gdispImageScaler *s) {
+		PNG_info 	*pinfo;
+		PNG_decode	*d;
+		pixel_t		*row;
+		coord_t		y, i;
+
+		// Allocate the space to decode with including space for 2 full scan lines for filtering.
+		pinfo = (PNG_info *)img->priv;
+		if (!(d = gdispImageAlloc(img, sizeof(PNG_decode) + (img->width * pinfo->bpp + 7) / 4)))
+			return GDISP_IMAGE_ERR_NOMEMORY;
+		if (!(row = gdispImageAlloc(img, s->scx * sizeof(pixel_t)))) {
+			gdispImageFree(img, d, sizeof(PNG_decode) + (img->width * pinfo->bpp + 7) / 4);
+			return GDISP_IMAGE_ERR_NOMEMORY;
+		}
+
+		// Initialise the decoder with the output going to the row buffer
+		d->img = img;
+		d->pinfo = pinfo;
+		PNG_iInit(d);
+		PNG_oInit(&d->o, 0, 0, 0, s->scx, s->scy, s->sx, s->sy);
+		d->o.row = row;
+		PNG_zInit(&d->z);
+
+		// Process the zlib inflate header
+		if (!PNG_zGetHeader(d))
+			goto exit_baddata;
+
+		#if GDISP_NEED_IMAGE_PNG_INTERLACED
+			if ((pinfo->flags & PNG_FLG_INTERLACE)) {
+				// Interlaced decoding
+				#error "PNG Decoder: Interlaced PNG's are not supported yet!"
+			} else
+		#endif
+		{
+			// Non-interlaced decoding. Every row must be inflated and unfiltered but only
+			//	the rows the scaler needs are converted to pixels.
+			PNG_fInit(&d->f, (uint8_t *)(d+1), (pinfo->bpp + 7) / 8, (img->width * pinfo->bpp + 7) / 8);
+			for(y = 0; ; PNG_fNext(&d->f), y++) {
+				if (!PNG_unfilter_type0(d))
+					goto exit_baddata;
+				if (y == s->nexty) {
+					// Transparent pixels are left as the background color
+					for(i = 0; i < s->scx; i++)
+						row[i] = img->bgcolor;
+					PNG_oStartY(&d->o, y);
+					pinfo->out(d);
+					PNG_oFlush(&d->o);
+					if (!gdispImageScaleRow(s, y, row))
+						break;
+				}
+			}
+		}
+
+		// Clean up
+		gdispImageFree(img, row, s->scx * sizeof(pixel_t));
+		gdispImageFree(img, d, sizeof(PNG_decode) + (img->width * pinfo->bpp + 7) / 4);
+		return GDISP_IMAGE_ERR_OK;
+
+exit_baddata:
+		gdispImageFree(img, row, s->scx * sizeof(pixel_t));
+		gdispImageFree(img, d, sizeof(PNG_decode) + (img->width * pinfo->bpp + 7) / 4);
+		return GDISP_IMAGE_ERR_BADDATA;
+	}
+#endif
+
 gdispImageError gdispImageCache_PNG(gdispImage *img) {
 	PNG_info 	*pinfo;
 	unsigned	chunknext;
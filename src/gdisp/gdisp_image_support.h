@@ -119,6 +119,27 @@
 	#define gdispImageMakeBE32(dw)			{ dw = gdispImageH32toBE32(dw); }
 #endif
 
+#if GDISP_NEED_IMAGE_SCALE
+	/*
+	 * The state used by a decoder to feed source rows to the image scaler.
+	 *	The decoder passes each needed row to gdispImageScaleRow() in increasing row order.
+	 *	Each row passed starts at image column sx and is scx pixels wide.
+	 *	Rows before nexty are not needed and may be skipped without decoding them to pixels.
+	 */
+	typedef struct gdispImageScaler {
+		coord_t				sx, sy;			// The image area being scaled
+		coord_t				scx, scy;
+		coord_t				nexty;			// The next image row needed
+		// Private
+		GDisplay *			g;
+		gdispImageFilter	filter;
+		coord_t				x0, y0, x1, y1;	// The screen area being drawn (x1,y1 are exclusive)
+		long long			ua, ub, uc;		// Screen pixel to image column (fixed point) = ua*x + ub*y + uc
+		long long			va, vb, vc;		// Screen pixel to image row (fixed point) = va*x + vb*y + vc
+		pixel_t *			prev;			// The previous image row (bilinear filtering only)
+		pixel_t				buf[GDISP_IMAGE_SCALE_BLIT_BUFFER_SIZE];
+	} gdispImageScaler;
+#endif
 
 	
 #ifdef __cplusplus
@@ -128,6 +149,10 @@ extern "C" {
 	void *gdispImageAlloc(gdispImage *img, size_t sz);
 	void gdispImageFree(gdispImage *img, void *ptr, size_t sz);
 
+	#if GDISP_NEED_IMAGE_SCALE
+		bool_t gdispImageScaleRow(gdispImageScaler *s, coord_t y, const pixel_t *row);
+	#endif
+
 	#if GFX_CPU_ENDIAN == GFX_CPU_ENDIAN_UNKNOWN
 		extern const uint8_t gdispImageEndianArray[4];
 	#endif
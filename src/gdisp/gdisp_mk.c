@@ -22,6 +22,7 @@
 #include "gdisp_fonts.c"
 #include "gdisp_pixmap.c"
 #include "gdisp_image.c"
+#include "gdisp_image_async.c"
 #include "gdisp_image_native.c"
 #include "gdisp_image_gif.c"
 #include "gdisp_image_bmp.c"
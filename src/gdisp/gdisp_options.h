@@ -205,6 +205,16 @@
 	#ifndef GDISP_NEED_MULTITHREAD
 		#define GDISP_NEED_MULTITHREAD			FALSE
 	#endif
+	/**
+	 * @brief   Count how often threads have to wait for a display.
+	 * @details	Defaults to FALSE
+	 * @note	Use gdispGGetLockStats() to read the counters. This is useful for finding out whether
+	 * 			threads drawing on the same display are holding each other up.
+	 * @note	Only has an effect if GDISP_NEED_MULTITHREAD is TRUE.
+	 */
+	#ifndef GDISP_MULTITHREAD_STATS
+		#define GDISP_MULTITHREAD_STATS			FALSE
+	#endif
 /**
  * @}
  *
@@ -325,6 +335,79 @@
 	#ifndef GDISP_NEED_IMAGE_ACCOUNTING
 		#define GDISP_NEED_IMAGE_ACCOUNTING		FALSE
 	#endif
+	/**
+	 * @brief   Is scaled and transformed image drawing required.
+	 * @details	Defaults to FALSE
+	 * @note	Adds gdispGImageDrawScaled() and (if GMISC_NEED_MATRIXFIXED2D is also TRUE)
+	 * 			gdispGImageDrawTransformed().
+	 * @note	Image decoders that can't resample while decoding are first decoded into a
+	 * 			temporary pixmap. This requires GDISP_NEED_PIXMAP.
+	 */
+	#ifndef GDISP_NEED_IMAGE_SCALE
+		#define GDISP_NEED_IMAGE_SCALE			FALSE
+	#endif
+	/**
+	 * @brief   The scaled image blit buffer size in pixels.
+	 * @details	Defaults to 32
+	 * @note 	Bigger is faster but requires more RAM.
+	 */
+	#ifndef GDISP_IMAGE_SCALE_BLIT_BUFFER_SIZE
+		#define GDISP_IMAGE_SCALE_BLIT_BUFFER_SIZE	32
+	#endif
+	/**
+	 * @brief   Is background image decoding required.
+	 * @details	Defaults to FALSE
+	 * @note	Adds gdispImageDecodeAsync() which decodes images into pixmaps using a pool of
+	 * 			decode threads. This requires GDISP_NEED_PIXMAP and GDISP_NEED_MULTITHREAD.
+	 */
+	#ifndef GDISP_NEED_IMAGE_ASYNC
+		#define GDISP_NEED_IMAGE_ASYNC			FALSE
+	#endif
+	/**
+	 * @brief   The number of background image decode threads.
+	 * @details	Defaults to 1
+	 * @note	The threads are only started when the first decode is requested.
+	 */
+	#ifndef GDISP_IMAGE_ASYNC_THREADS
+		#define GDISP_IMAGE_ASYNC_THREADS		1
+	#endif
+	/**
+	 * @brief   The priority of the background image decode threads.
+	 * @details	Defaults to LOW_PRIORITY
+	 */
+	#ifndef GDISP_IMAGE_ASYNC_THREAD_PRIORITY
+		#define GDISP_IMAGE_ASYNC_THREAD_PRIORITY	LOW_PRIORITY
+	#endif
+	/**
+	 * @brief   The stack size of each background image decode thread.
+	 * @details	Defaults to 2048
+	 */
+	#ifndef GDISP_IMAGE_ASYNC_THREAD_WORKAREA_SIZE
+		#define GDISP_IMAGE_ASYNC_THREAD_WORKAREA_SIZE	2048
+	#endif
+/**
+ * @}
+ *
+ * @name    GDISP NATIVE Image Options
+ * @pre		GDISP_NEED_IMAGE and GDISP_NEED_IMAGE_NATIVE must be TRUE
+ * @{
+ */
+	/**
+	 * @brief   Is decoding of compressed native images ("NC" format) required.
+	 * @details	Defaults to FALSE
+	 * @note	Compressed native images are created using the -z option of the file2c tool.
+	 */
+	#ifndef GDISP_NEED_IMAGE_NATIVE_COMPRESSED
+		#define GDISP_NEED_IMAGE_NATIVE_COMPRESSED	FALSE
+	#endif
+	/**
+	 * @brief   The compressed native image input file buffer size in bytes.
+	 * @details	Defaults to 32
+	 * @note 	Bigger is faster but requires more RAM.
+	 */
+	#ifndef GDISP_IMAGE_NATIVE_FILE_BUFFER_SIZE
+		#define GDISP_IMAGE_NATIVE_FILE_BUFFER_SIZE	32
+	#endif
 /**
  * @}
  *
@@ -622,6 +705,22 @@
 	#ifndef GDISP_NEED_PIXMAP_IMAGE
 		#define GDISP_NEED_PIXMAP_IMAGE			FALSE
 	#endif
+	/**
+	 * @brief	Should support for palette indexed pixmaps be included.
+	 * @details	Defaults to FALSE
+	 * @note	Indexed pixmaps use 1, 2, 4 or 8 bits per pixel instead of a full color_t.
+	 */
+	#ifndef GDISP_NEED_PIXMAP_INDEXED
+		#define GDISP_NEED_PIXMAP_INDEXED		FALSE
+	#endif
+	/**
+	 * @brief	The number of pixels expanded through the palette for each blit of an indexed pixmap.
+	 * @details	Defaults to 32
+	 * @note	This buffer is on the stack so larger values need a larger thread stack.
+	 */
+	#ifndef GDISP_PIXMAP_INDEXED_BLIT_BUFFER_SIZE
+		#define GDISP_PIXMAP_INDEXED_BLIT_BUFFER_SIZE	32
+	#endif
 /**
  * @}
  *
@@ -42,7 +42,15 @@
 #include "gdisp_driver.h"
 #include "../gdriver/gdriver.h"
 
+#if GDISP_NEED_PIXMAP_INDEXED
+	#include <string.h>				// Required for memcpy() & memset()
+#endif
+
 typedef struct pixmap {
+	#if GDISP_NEED_PIXMAP_INDEXED
+		color_t		*palette;			// The palette for an indexed pixmap (NULL for a normal pixmap)
+		size_t		bpp;				// The bits per pixel for an indexed pixmap (pointer sized so imghdr stays against pixels)
+	#endif
 	#if GDISP_NEED_PIXMAP_IMAGE
 		uint8_t		imghdr[8];			// This field must come just before the data member.
 	#endif
@@ -62,6 +70,10 @@ GDisplay *gdispPixmapCreate(coord_t width, coord_t height) {
 	// Allocate the pixmap
 	if (!(p = gfxAlloc(i+sizeof(pixmap)-sizeof(p->pixels))))
 		return 0;
+	#if GDISP_NEED_PIXMAP_INDEXED
+		p->palette = 0;
+		p->bpp = 0;
+	#endif
 
 	// Fill in the image header (if required)
 	#if GDISP_NEED_PIXMAP_IMAGE
@@ -86,6 +98,134 @@ GDisplay *gdispPixmapCreate(coord_t width, coord_t height) {
 	return g;
 }
 
+#if GDISP_NEED_PIXMAP_INDEXED
+	GDisplay *gdispPixmapCreateIndexed(coord_t width, coord_t height, uint8_t bpp, const color_t *palette) {
+		GDisplay	*g;
+		pixmap		*p;
+		unsigned	i;
+		coord_t		wh[2];
+
+		if (bpp != 1 && bpp != 2 && bpp != 4 && bpp != 8)
+			return 0;
+
+		// Calculate the size of the display surface in bytes (rounded up so the palette is aligned)
+		i = (((width*height*bpp+7)>>3) + sizeof(color_t)-1) & ~(sizeof(color_t)-1);
+		if (i < 2*sizeof(coord_t))
+			i = 2*sizeof(coord_t);
+
+		// Allocate the pixmap with the palette following the display surface
+		if (!(p = gfxAlloc(i+sizeof(pixmap)-sizeof(p->pixels) + (sizeof(color_t)<<bpp))))
+			return 0;
+		p->bpp = bpp;
+		p->palette = (color_t *)((uint8_t *)p->pixels + i);
+		if (palette)
+			memcpy(p->palette, palette, sizeof(color_t)<<bpp);
+		else
+			memset(p->palette, 0, sizeof(color_t)<<bpp);
+
+		// Save the width and height so the driver can retrieve it.
+		wh[0] = width;
+		wh[1] = height;
+		memcpy(p->pixels, wh, sizeof(wh));
+
+		// Register the driver
+		g = (GDisplay *)gdriverRegister(&GDISPVMT_pixmap->d, p);
+		if (!g) {
+			gfxFree(p);
+			return 0;
+		}
+
+		// Registering cleared it to GDISP_STARTUP_COLOR but index 0 makes more sense
+		gdispGClear(g, 0);
+		return g;
+	}
+
+	void gdispPixmapSetPalette(GDisplay *g, uint16_t start, uint16_t count, const color_t *colors) {
+		pixmap	*p;
+
+		if (gvmt(g) != GDISPVMT_pixmap || !(p = (pixmap *)g->priv)->palette || start >= (1U<<p->bpp))
+			return;
+		if (count > (1U<<p->bpp) - start)
+			count = (1U<<p->bpp) - start;
+		memcpy(p->palette+start, colors, count*sizeof(color_t));
+	}
+
+	color_t *gdispPixmapGetPalette(GDisplay *g) {
+		if (gvmt(g) != GDISPVMT_pixmap)
+			return 0;
+		return ((pixmap *)g->priv)->palette;
+	}
+
+	void gdispGPixmapBlit(GDisplay *g, coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t srcx, coord_t srcy, GDisplay *pix) {
+		pixmap			*p;
+		const uint8_t	*src;
+		coord_t			srccx, srccy, rows, i, j;
+		unsigned		pos, mask, shift;
+		color_t			buf[GDISP_PIXMAP_INDEXED_BLIT_BUFFER_SIZE];
+		color_t			*pb;
+
+		if (gvmt(pix) != GDISPVMT_pixmap)
+			return;
+		p = (pixmap *)pix->priv;
+
+		// The surface is stored in the unrotated orientation
+		srccx = pix->g.Width;
+		srccy = pix->g.Height;
+		#if GDISP_NEED_CONTROL
+			if (pix->g.Orientation == GDISP_ROTATE_90 || pix->g.Orientation == GDISP_ROTATE_270) {
+				srccx = pix->g.Height;
+				srccy = pix->g.Width;
+			}
+		#endif
+
+		// Clip to the source surface
+		if (srcx < 0) { x -= srcx; cx += srcx; srcx = 0; }
+		if (srcy < 0) { y -= srcy; cy += srcy; srcy = 0; }
+		if (srcx+cx > srccx) cx = srccx - srcx;
+		if (srcy+cy > srccy) cy = srccy - srcy;
+		if (cx <= 0 || cy <= 0)
+			return;
+
+		// A normal pixmap can be blitted directly
+		if (!p->palette) {
+			gdispGBlitArea(g, x, y, cx, cy, srcx, srcy, srccx, p->pixels);
+			return;
+		}
+
+		// Expand the indices through the palette into our buffer a block of whole lines at a time
+		//	(or a part of a line at a time if the line is too long for the buffer).
+		src = (const uint8_t *)p->pixels;
+		mask = (1U << p->bpp) - 1;
+		shift = 8 - p->bpp;
+		for(; cy > 0; srcy += rows, y += rows, cy -= rows) {
+			if (cx <= GDISP_PIXMAP_INDEXED_BLIT_BUFFER_SIZE) {
+				rows = GDISP_PIXMAP_INDEXED_BLIT_BUFFER_SIZE / cx;
+				if (rows > cy)
+					rows = cy;
+				for(pb = buf, j = 0; j < rows; j++) {
+					pos = (srcy+j) * srccx + srcx;
+					if (p->bpp == 8) {
+						for(i = 0; i < cx; i++, pos++)
+							*pb++ = p->palette[src[pos]];
+					} else {
+						for(i = 0; i < cx; i++, pos++)
+							*pb++ = p->palette[(src[(pos*p->bpp)>>3] >> (shift - ((pos*p->bpp)&7))) & mask];
+					}
+				}
+				gdispGBlitArea(g, x, y, cx, rows, 0, 0, cx, buf);
+			} else {
+				rows = 1;
+				for(j = 0; j < cx; j += i) {
+					pos = srcy * srccx + srcx + j;
+					for(pb = buf, i = 0; i < GDISP_PIXMAP_INDEXED_BLIT_BUFFER_SIZE && j+i < cx; i++, pos++)
+						*pb++ = p->palette[(src[(pos*p->bpp)>>3] >> (shift - ((pos*p->bpp)&7))) & mask];
+					gdispGBlitArea(g, x+j, y, i, 1, 0, 0, i, buf);
+				}
+			}
+		}
+	}
+#endif
+
 void gdispPixmapDelete(GDisplay *g) {
 	if (gvmt(g) != GDISPVMT_pixmap)
 		return;
@@ -102,6 +242,11 @@ pixel_t	*gdispPixmapGetBits(GDisplay *g) {
 	void *gdispPixmapGetMemoryImage(GDisplay *g) {
 		if (gvmt(g) != GDISPVMT_pixmap)
 			return 0;
+		#if GDISP_NEED_PIXMAP_INDEXED
+			// There is no native image format for an indexed pixmap
+			if (((pixmap *)g->priv)->palette)
+				return 0;
+		#endif
 		return ((pixmap *)g->priv)->imghdr;
 	}
 #endif
@@ -156,6 +301,20 @@ LLDSPEC void gdisp_lld_draw_pixel(GDisplay *g) {
 		pos = g->p.y * g->g.Width + g->p.x;
 	#endif
 
+	#if GDISP_NEED_PIXMAP_INDEXED
+		if (((pixmap *)(g)->priv)->palette) {
+			uint8_t		*pb;
+			unsigned	bpp, mask;
+
+			// The color is really a palette index
+			bpp = ((pixmap *)(g)->priv)->bpp;
+			pb = (uint8_t *)((pixmap *)(g)->priv)->pixels + ((pos*bpp)>>3);
+			mask = ((1U << bpp) - 1) << (8 - bpp - ((pos*bpp)&7));
+			*pb = (uint8_t)((*pb & ~mask) | (((unsigned)g->p.color << (8 - bpp - ((pos*bpp)&7))) & mask));
+			return;
+		}
+	#endif
+
 	((pixmap *)(g)->priv)->pixels[pos] = g->p.color;
 }
 
@@ -182,6 +341,15 @@ LLDSPEC	color_t gdisp_lld_get_pixel_color(GDisplay *g) {
 		pos = g->p.y * g->g.Width + g->p.x;
 	#endif
 
+	#if GDISP_NEED_PIXMAP_INDEXED
+		if (((pixmap *)(g)->priv)->palette) {
+			unsigned	bpp;
+
+			bpp = ((pixmap *)(g)->priv)->bpp;
+			return (color_t)((((uint8_t *)((pixmap *)(g)->priv)->pixels)[(pos*bpp)>>3] >> (8 - bpp - ((pos*bpp)&7))) & ((1U << bpp) - 1));
+		}
+	#endif
+
 	return ((pixmap *)(g)->priv)->pixels[pos];
 }
 
@@ -62,9 +62,72 @@ extern "C" {
 	 * 			by the application code. For any one particular pixmap the pointer will not change over the life of the pixmap
 	 * 			(although different pixmaps will have different pixel pointers). Once a pixmap is deleted, the pixel pointer
 	 * 			should not be used by the application.
+	 * @note	For an indexed pixmap the pixels are packed palette indexes with the first pixel in the most significant bits
+	 * 			and no padding at the end of each line.
 	 */
 	pixel_t	*gdispPixmapGetBits(GDisplay *g);
 
+	#if GDISP_NEED_PIXMAP_INDEXED || defined(__DOXYGEN__)
+		/**
+		 * @brief	Create an off-screen pixmap that stores palette indexes rather than colors
+		 * @pre		GDISP_NEED_PIXMAP_INDEXED must be TRUE in your gfxconf.h
+		 *
+		 * @param[in] width  	The width of the pixmap to be created
+		 * @param[in] height  	The height of the pixmap to be created
+		 * @param[in] bpp		The bits per pixel. This must be 1, 2, 4 or 8.
+		 * @param[in] palette	The initial palette of (1 << bpp) colors. It is copied. Pass NULL to start with all Black.
+		 *
+		 * @return 	The created GDisplay representing the pixmap or NULL if it could not be created
+		 *
+		 * @note	The color passed to any drawing call on an indexed pixmap is taken to be the palette index and
+		 * 			reading a pixel returns the palette index. Anti-aliasing and alpha blending are therefore not meaningful.
+		 * @note	Use @p gdispGPixmapBlit() to copy it to a real display. The indexes are converted through the
+		 * 			palette as they are copied.
+		 * @note	The pixmap starts cleared to index 0.
+		 * @note	A 100x100 pixmap at 4 bits per pixel is 5K of RAM plus 16 palette entries (plus some overheads).
+		 */
+		GDisplay *gdispPixmapCreateIndexed(coord_t width, coord_t height, uint8_t bpp, const color_t *palette);
+
+		/**
+		 * @brief	Change some of the palette entries of an indexed pixmap
+		 * @pre		GDISP_NEED_PIXMAP_INDEXED must be TRUE in your gfxconf.h
+		 *
+		 * @param[in] g  		The indexed pixmap virtual display
+		 * @param[in] start		The first palette index to change
+		 * @param[in] count		The number of palette entries to change
+		 * @param[in] colors	The new colors
+		 *
+		 * @note	Nothing already drawn needs to be redrawn. The new colors are used on the next @p gdispGPixmapBlit().
+		 */
+		void gdispPixmapSetPalette(GDisplay *g, uint16_t start, uint16_t count, const color_t *colors);
+
+		/**
+		 * @brief	Get a pointer to the palette of an indexed pixmap
+		 * @return	The pointer to the (1 << bpp) palette entries or NULL if this display is not an indexed pixmap.
+		 * @pre		GDISP_NEED_PIXMAP_INDEXED must be TRUE in your gfxconf.h
+		 *
+		 * @param[in] g  	The pixmap virtual display
+		 */
+		color_t *gdispPixmapGetPalette(GDisplay *g);
+
+		/**
+		 * @brief	Copy part of a pixmap to a display
+		 * @pre		GDISP_NEED_PIXMAP_INDEXED must be TRUE in your gfxconf.h
+		 *
+		 * @param[in] g 		The display to copy to
+		 * @param[in] x,y		The position on the display
+		 * @param[in] cx,cy		The size of the area to copy
+		 * @param[in] srcx,srcy	The position in the pixmap to copy from
+		 * @param[in] pix		The pixmap to copy from
+		 *
+		 * @note	For an indexed pixmap each index is looked up in the palette and the colors are blitted in blocks of
+		 * 			GDISP_PIXMAP_INDEXED_BLIT_BUFFER_SIZE pixels. A normal pixmap is just passed to @p gdispGBlitArea().
+		 * @note	The area is clipped to the pixmap's unrotated size.
+		 */
+		void gdispGPixmapBlit(GDisplay *g, coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t srcx, coord_t srcy, GDisplay *pix);
+		#define gdispPixmapBlit(x,y,cx,cy,srcx,srcy,pix)		gdispGPixmapBlit(GDISP,x,y,cx,cy,srcx,srcy,pix)
+	#endif
+
 	#if GDISP_NEED_PIXMAP_IMAGE || defined(__DOXYGEN__)
 		/**
 		 * @brief	Get a pointer to a native format gdispImage.
@@ -78,6 +141,7 @@ extern "C" {
 		 * @note	The pointer returned can be passed to @p gdispImageOpenMemory() or to @p gfileOpenMemory().
 		 * @note	If you are just wanting to copy to a real display it is more efficient to use @p gdispGetPixmapBits() and @p gdispGBlitArea().
 		 * @note	Like @p gdispGetPixmapBits(), the pointer returned is valid for the life of the pixmap.
+		 * @note	An indexed pixmap has no native image format so NULL is returned.
 		 */
 		void *gdispPixmapGetMemoryImage(GDisplay *g);
 	#endif
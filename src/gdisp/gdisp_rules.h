@@ -82,6 +82,22 @@
 			#undef GFX_USE_GFILE
 			#define GFX_USE_GFILE	TRUE
 		#endif
+		#if GDISP_NEED_IMAGE_ASYNC
+			#if !GDISP_NEED_PIXMAP
+				#if GFX_DISPLAY_RULE_WARNINGS
+					#warning "GDISP: GDISP_NEED_PIXMAP is required when GDISP_NEED_IMAGE_ASYNC is TRUE. It has been turned on for you."
+				#endif
+				#undef GDISP_NEED_PIXMAP
+				#define GDISP_NEED_PIXMAP	TRUE
+			#endif
+			#if !GDISP_NEED_MULTITHREAD
+				#if GFX_DISPLAY_RULE_WARNINGS
+					#warning "GDISP: GDISP_NEED_MULTITHREAD is required when GDISP_NEED_IMAGE_ASYNC is TRUE. It has been turned on for you."
+				#endif
+				#undef GDISP_NEED_MULTITHREAD
+				#define GDISP_NEED_MULTITHREAD	TRUE
+			#endif
+		#endif
 	#endif
 #endif
 
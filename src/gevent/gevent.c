@@ -9,6 +9,8 @@
 
 #if GFX_USE_GEVENT || defined(__DOXYGEN__)
 
+#include <string.h>					// Required for memset()
+
 #if GEVENT_ASSERT_NO_RESOURCE
 	#define GEVENT_ASSERT(x)		assert(x)
 #else
@@ -18,6 +20,14 @@
 /* Flags in the listener structure */
 #define GLISTENER_WITHLISTENER		0x0001			// The listener is current using the buffer
 #define GLISTENER_WITHSOURCE		0x0002			// The source is currently using the buffer
+#define GLISTENER_QUEUED			0x0004			// The buffer the source is using is the next free queue slot
+
+#if GEVENT_NEED_LISTENER_QUEUE
+	/* Is the listener using its queue */
+	#define queueMode(pl)			((pl)->queue && !(pl)->callback)
+	/* Get the queue slot that is n events from the oldest queued event */
+	#define queueSlot(pl, n)		(&(pl)->queue[((pl)->qhead + (n)) % (pl)->qsize])
+#endif
 
 /* This mutex protects access to our tables */
 static gfxMutex	geventMutex;
@@ -25,9 +35,45 @@ static gfxMutex	geventMutex;
 /* Our table of listener/source pairs */
 static GSourceListener		Assignments[GEVENT_MAX_SOURCE_LISTENERS];
 
+/* Extra tables allocated when the first one is full */
+#if GEVENT_SOURCE_LISTENERS_GROW
+	typedef struct AssignmentBlock {
+		struct AssignmentBlock	*next;
+		GSourceListener			entries[GEVENT_MAX_SOURCE_LISTENERS];
+	} AssignmentBlock;
+	static AssignmentBlock		*ExtraAssignments;
+#endif
+
+/* The listener/source pairs in use are linked into a chain for their source's hash bucket (in the order they were attached) */
+/*	A pair detached by its listener stays in the chain as dying (no listener but still a source) as the source may be part way through
+	walking the chain. It is unlinked and freed when its source next starts walking the chain. */
+static GSourceListener		*SourceHash[GEVENT_SOURCE_HASH_SIZE];
+#define sourceHash(gsh)			((((size_t)(gsh) >> 2) ^ ((size_t)(gsh) >> 8)) & (GEVENT_SOURCE_HASH_SIZE-1))
+
 /* Send an exit event if possible. */
 /* We already have the geventMutex */
 static void doExitEvent(GListener *pl) {
+	#if GEVENT_NEED_LISTENER_QUEUE
+		if (queueMode(pl)) {
+			// Don't do the exit if a source is currently filling the next queue slot
+			if ((pl->flags & GLISTENER_WITHSOURCE))
+				return;
+
+			// If the queue is full the exit replaces the newest event
+			if (pl->qcount >= pl->qsize-1) {
+				queueSlot(pl, pl->qcount-1)->type = GEVENT_EXIT;
+				pl->lastsrc = 0;
+				pl->dropped++;
+				return;
+			}
+			queueSlot(pl, pl->qcount)->type = GEVENT_EXIT;
+			pl->qcount++;
+			pl->lastsrc = 0;
+			gfxSemSignal(&pl->waitqueue);
+			return;
+		}
+	#endif
+
 	// Don't do the exit if someone else currently is using the buffer
 	if (!(pl->flags & GLISTENER_WITHLISTENER)) {
 		pl->event.type = GEVENT_EXIT;								// Set up the EXIT event
@@ -36,28 +82,144 @@ static void doExitEvent(GListener *pl) {
 	}
 }
 
-/* Loop through the assignment table deleting this listener/source pair. */
+/* Delete the listener/source pairs from one hash chain. */
+/*	Null is treated as a wildcard. */
+/*	Pairs deleted for a listener are left dying in the chain. Pairs deleted for a source are freed straight away. */
+/* We already have the geventMutex */
+static void deleteChainAssignments(GSourceListener **pchain, GListener *pl, GSourceHandle gsh) {
+	GSourceListener *psl;
+
+	while((psl = *pchain)) {
+		if (psl->pSource && (!pl || psl->pListener == pl) && (!gsh || psl->pSource == gsh)) {
+			if (psl->pListener) {
+				doExitEvent(psl->pListener);
+				psl->pListener = 0;
+			}
+			if (pl) {
+				pchain = &psl->next;
+				continue;
+			}
+			*pchain = psl->next;
+			psl->pSource = 0;
+		} else
+			pchain = &psl->next;
+	}
+}
+
+/* Unlink and free the dying pairs of a source. */
+/*	The source has just started walking the chain again so it can't be holding any of them. */
+/* We already have the geventMutex */
+static void freeDyingAssignments(GSourceHandle gsh) {
+	GSourceListener *psl, **pchain;
+
+	pchain = &SourceHash[sourceHash(gsh)];
+	while((psl = *pchain)) {
+		if (!psl->pListener && psl->pSource == gsh) {
+			*pchain = psl->next;
+			psl->pSource = 0;
+		} else
+			pchain = &psl->next;
+	}
+}
+
+/* Loop through the assignments deleting this listener/source pair. */
 /*	Null is treated as a wildcard. */
 /* We already have the geventMutex */
 static void deleteAssignments(GListener *pl, GSourceHandle gsh) {
+	unsigned	i;
+
+	if (gsh) {
+		deleteChainAssignments(&SourceHash[sourceHash(gsh)], pl, gsh);
+		return;
+	}
+	for(i = 0; i < GEVENT_SOURCE_HASH_SIZE; i++)
+		deleteChainAssignments(&SourceHash[i], pl, gsh);
+}
+
+/* Find an unused listener/source pair. */
+/* We already have the geventMutex */
+static GSourceListener *freeAssignment(void) {
 	GSourceListener *psl;
 
 	for(psl = Assignments; psl < Assignments+GEVENT_MAX_SOURCE_LISTENERS; psl++) {
-		if ((!pl || psl->pListener == pl) && (!gsh || psl->pSource == gsh)) {
-			doExitEvent(psl->pListener);
-			psl->pListener = 0;
-			psl->pSource = 0;
-		}
+		if (!psl->pListener && !psl->pSource)
+			return psl;
 	}
+
+	#if GEVENT_SOURCE_LISTENERS_GROW
+		{
+			AssignmentBlock	*pb;
+
+			for(pb = ExtraAssignments; pb; pb = pb->next) {
+				for(psl = pb->entries; psl < pb->entries+GEVENT_MAX_SOURCE_LISTENERS; psl++) {
+					if (!psl->pListener && !psl->pSource)
+						return psl;
+				}
+			}
+
+			// Add another table
+			if (!(pb = gfxAlloc(sizeof(AssignmentBlock))))
+				return 0;
+			memset(pb, 0, sizeof(AssignmentBlock));
+			pb->next = ExtraAssignments;
+			ExtraAssignments = pb;
+			return pb->entries;
+		}
+	#else
+		return 0;
+	#endif
 }
 
+#if GEVENT_NEED_LISTENER_QUEUE
+	/* Add the event the source has put in the next free queue slot to the queue. */
+	/* We already have the geventMutex */
+	static void queueEvent(GListener *pl, GSourceHandle gsh, bool_t mergeable) {
+		GEvent	*pe;
+
+		pe = queueSlot(pl, pl->qcount);
+
+		// Can we merge it with the newest queued event
+		if (mergeable && pl->qcount && pl->lastsrc == gsh) {
+			*queueSlot(pl, pl->qcount-1) = *pe;
+			pl->merged++;
+			return;
+		}
+
+		// If we are full a mergeable event can make way for one that isn't
+		if (pl->qcount >= pl->qsize-1) {
+			if (!mergeable && pl->lastsrc) {
+				*queueSlot(pl, pl->qcount-1) = *pe;
+				pl->lastsrc = 0;
+			}
+			pl->dropped++;
+			return;
+		}
+
+		pl->qcount++;
+		pl->lastsrc = mergeable ? gsh : 0;
+		gfxSemSignal(&pl->waitqueue);
+	}
+#endif
+
 void _geventInit(void)
 {
+	memset(Assignments, 0, sizeof(Assignments));
+	memset(SourceHash, 0, sizeof(SourceHash));
 	gfxMutexInit(&geventMutex);
 }
 
 void _geventDeinit(void)
 {
+	#if GEVENT_SOURCE_LISTENERS_GROW
+		AssignmentBlock	*pb;
+
+		while((pb = ExtraAssignments)) {
+			ExtraAssignments = pb->next;
+			gfxFree(pb);
+		}
+	#endif
+	memset(Assignments, 0, sizeof(Assignments));
+	memset(SourceHash, 0, sizeof(SourceHash));
 	gfxMutexDestroy(&geventMutex);	
 }
 
@@ -66,10 +228,33 @@ void geventListenerInit(GListener *pl) {
 	pl->callback = 0;										// No callback active
 	pl->event.type = GEVENT_NULL;							// Always safety
 	pl->flags = 0;
+	#if GEVENT_NEED_LISTENER_QUEUE
+		pl->queue = 0;										// No queue
+		pl->lastsrc = 0;
+		pl->qsize = pl->qhead = pl->qcount = 0;
+		pl->dropped = pl->merged = 0;
+	#endif
 }
 
+#if GEVENT_NEED_LISTENER_QUEUE
+	void geventListenerSetQueue(GListener *pl, GEvent *buf, unsigned num) {
+		// Safety first
+		if (!pl || (buf && num < 2)) {
+			GEVENT_ASSERT(FALSE);
+			return;
+		}
+
+		gfxMutexEnter(&geventMutex);
+		pl->queue = buf;
+		pl->qsize = num;
+		pl->qhead = pl->qcount = 0;
+		pl->lastsrc = 0;
+		gfxMutexExit(&geventMutex);
+	}
+#endif
+
 bool_t geventAttachSource(GListener *pl, GSourceHandle gsh, uint32_t flags) {
-	GSourceListener *psl, *pslfree;
+	GSourceListener *psl, **pchain;
 
 	// Safety first
 	if (!pl || !gsh) {
@@ -79,30 +264,28 @@ bool_t geventAttachSource(GListener *pl, GSourceHandle gsh, uint32_t flags) {
 
 	gfxMutexEnter(&geventMutex);
 
-	// Check if this pair is already in the table (scan for a free slot at the same time)
-	pslfree = 0;
-	for(psl = Assignments; psl < Assignments+GEVENT_MAX_SOURCE_LISTENERS; psl++) {
-		
+	// Check if this pair is already in the source's chain (and find the end of the chain at the same time)
+	for(pchain = &SourceHash[sourceHash(gsh)]; (psl = *pchain); pchain = &psl->next) {
 		if (pl == psl->pListener && gsh == psl->pSource) {
 			// Just update the flags
 			psl->listenflags = flags;
 			gfxMutexExit(&geventMutex);
 			return TRUE;
 		}
-		if (!pslfree && !psl->pListener)
-			pslfree = psl;
 	}
-	
-	// A free slot was found - allocate it
-	if (pslfree) {
-		pslfree->pListener = pl;
-		pslfree->pSource = gsh;
-		pslfree->listenflags = flags;
-		pslfree->srcflags = 0;
+
+	// Allocate a free slot and add it to the end of the chain
+	if ((psl = freeAssignment())) {
+		psl->pListener = pl;
+		psl->pSource = gsh;
+		psl->listenflags = flags;
+		psl->srcflags = 0;
+		psl->next = 0;
+		*pchain = psl;
 	}
 	gfxMutexExit(&geventMutex);
-	GEVENT_ASSERT(pslfree != 0);
-	return pslfree != 0;
+	GEVENT_ASSERT(psl != 0);
+	return psl != 0;
 }
 
 void geventDetachSource(GListener *pl, GSourceHandle gsh) {
@@ -140,6 +323,21 @@ GEvent *geventEventWait(GListener *pl, delaytime_t timeout) {
 	if (!gfxSemWait(&pl->waitqueue, timeout))
 		return 0;				// Timeout
 
+	#if GEVENT_NEED_LISTENER_QUEUE
+		// Take the oldest event off the queue
+		if (pl->queue) {
+			gfxMutexEnter(&geventMutex);
+			if (pl->qcount) {
+				pl->event = *queueSlot(pl, 0);
+				pl->qhead = (pl->qhead + 1) % pl->qsize;
+				if (!--pl->qcount)
+					pl->lastsrc = 0;
+			}
+			pl->flags |= GLISTENER_WITHLISTENER;
+			gfxMutexExit(&geventMutex);
+		}
+	#endif
+
 	return &pl->event;
 }
 
@@ -171,11 +369,15 @@ GSourceListener *geventGetSourceListener(GSourceHandle gsh, GSourceListener *las
 
 	// Unlock the last listener event buffer if it wasn't used.
 	if (lastlr && lastlr->pListener && (lastlr->pListener->flags & GLISTENER_WITHSOURCE))
-		lastlr->pListener->flags &= ~GLISTENER_WITHSOURCE;
-		
-	// Loop through the table looking for attachments to this source
-	for(psl = lastlr ? (lastlr+1) : Assignments; psl < Assignments+GEVENT_MAX_SOURCE_LISTENERS; psl++) {
-		if (gsh == psl->pSource) {
+		lastlr->pListener->flags &= ~(GLISTENER_WITHSOURCE|GLISTENER_QUEUED);
+
+	// Starting a new walk - nothing can be holding our dying pairs any more
+	if (!lastlr)
+		freeDyingAssignments(gsh);
+
+	// Walk the source's hash chain looking for attachments to this source
+	for(psl = lastlr ? lastlr->next : SourceHash[sourceHash(gsh)]; psl; psl = psl->next) {
+		if (gsh == psl->pSource && psl->pListener) {
 			gfxMutexExit(&geventMutex);
 			return psl;
 		}
@@ -186,7 +388,18 @@ GSourceListener *geventGetSourceListener(GSourceHandle gsh, GSourceListener *las
 
 GEvent *geventGetEventBuffer(GSourceListener *psl) {
 	gfxMutexEnter(&geventMutex);
+	#if GEVENT_NEED_LISTENER_QUEUE
+		// Allocate the next free queue slot to the source
+		if (queueMode(psl->pListener) && !(psl->pListener->flags & GLISTENER_WITHSOURCE)) {
+			psl->pListener->flags |= GLISTENER_WITHSOURCE|GLISTENER_QUEUED;
+			gfxMutexExit(&geventMutex);
+			return queueSlot(psl->pListener, psl->pListener->qcount);
+		}
+	#endif
 	if ((psl->pListener->flags & (GLISTENER_WITHLISTENER|GLISTENER_WITHSOURCE))) {
+		#if GEVENT_NEED_LISTENER_QUEUE
+			psl->pListener->dropped++;
+		#endif
 		gfxMutexExit(&geventMutex);
 		return 0;
 	}
@@ -197,8 +410,18 @@ GEvent *geventGetEventBuffer(GSourceListener *psl) {
 	return &psl->pListener->event;
 }
 
-void geventSendEvent(GSourceListener *psl) {
+static void sendEvent(GSourceListener *psl, bool_t mergeable) {
 	gfxMutexEnter(&geventMutex);
+	#if GEVENT_NEED_LISTENER_QUEUE
+		if ((psl->pListener->flags & GLISTENER_QUEUED)) {
+			psl->pListener->flags &= ~(GLISTENER_WITHSOURCE|GLISTENER_QUEUED);
+			queueEvent(psl->pListener, psl->pSource, mergeable);
+			gfxMutexExit(&geventMutex);
+			return;
+		}
+	#else
+		(void) mergeable;
+	#endif
 	if (psl->pListener->callback) {
 
 		// Mark it back as free and as sent. This is early to be marking as free but it protects
@@ -217,6 +440,14 @@ void geventSendEvent(GSourceListener *psl) {
 	}
 }
 
+void geventSendEvent(GSourceListener *psl) {
+	sendEvent(psl, FALSE);
+}
+
+void geventSendMergeableEvent(GSourceListener *psl) {
+	sendEvent(psl, TRUE);
+}
+
 void geventDetachSourceListeners(GSourceHandle gsh) {
 	gfxMutexEnter(&geventMutex);
 	deleteAssignments(0, gsh);
@@ -39,6 +39,7 @@ typedef uint16_t						GEventType;
 		#define GEVENT_GWIN_FIRST		0x0200				// GWIN events range from 0x0200 to 0x02FF
 		#define GEVENT_GADC_FIRST		0x0300				// GADC events range from 0x0300 to 0x033F
 		#define GEVENT_GAUDIO_FIRST		0x0340				// GAUDIO events range from 0x0340 to 0x037F
+		#define GEVENT_GDISP_FIRST		0x0380				// GDISP events range from 0x0380 to 0x03BF
 		#define GEVENT_USER_FIRST		0x8000				// Any application defined events start at 0x8000
 
 // This object can be typecast to any GEventXxxxx type to allow any sub-system (or the application) to create events.
@@ -60,6 +61,15 @@ typedef struct GListener {
 	GEventCallbackFn	callback;			// Private: Call back Function
 	void				*param;				// Private: Parameter for the callback function.
 	GEvent				event;				// Public:  The event object into which the event information is stored.
+	#if GEVENT_NEED_LISTENER_QUEUE
+		GEvent			*queue;				// Private: The event queue (NULL if the listener has no queue)
+		struct GSource_t *lastsrc;			// Private: The source of the newest queued event if it can be merged
+		unsigned		qsize;				// Private: The number of entries in the queue
+		unsigned		qhead;				// Private: The oldest queued event
+		unsigned		qcount;				// Private: The number of queued events
+		unsigned		dropped;			// Public:  The number of events that have been lost
+		unsigned		merged;				// Public:  The number of events that have been merged with an earlier event
+	#endif
 	} GListener;
 
 // The Source Object
@@ -71,6 +81,7 @@ typedef struct GSourceListener_t {
 	GSource			*pSource;			// The source
 	uint32_t		listenflags;		// The flags the listener passed when the source was assigned to it.
 	uint32_t		srcflags;			// For the source's exclusive use. Initialised as 0 for a new listener source assignment.
+	struct GSourceListener_t	*next;	// Private: The next assignment in the same hash chain
 	} GSourceListener;
 
 /*===========================================================================*/
@@ -117,6 +128,26 @@ extern "C" {
  */
 void geventListenerInit(GListener *pl);
 
+#if GEVENT_NEED_LISTENER_QUEUE || defined(__DOXYGEN__)
+	/**
+	 * @brief	Give a listener a queue of events
+	 * @details	Events that arrive while the application is busy with an earlier event are saved
+	 * 			in the queue rather than being lost.
+	 *
+	 * @param[in] pl	The listener
+	 * @param[in] buf	The queue storage
+	 * @param[in] num	The number of entries in buf. This must be at least 2.
+	 *
+	 * @note	Together with the event being processed this allows num events to be outstanding.
+	 * @note	When the queue is full a new mergeable event (see @p geventSendMergeableEvent()) is dropped.
+	 * 			Any other event replaces the newest queued event if that was mergeable or is otherwise dropped.
+	 * 			Events that can't be saved are counted in the listener's "dropped" field.
+	 * @note	Call this after @p geventListenerInit() and before any sources are attached.
+	 * 			Listeners using a callback ignore their queue.
+	 */
+	void geventListenerSetQueue(GListener *pl, GEvent *buf, unsigned num);
+#endif
+
 /**
  * @brief 	Attach a source to a listener
  * @details	Flags are interpreted by the source when generating events for each listener.
@@ -229,8 +260,21 @@ GEvent *geventGetEventBuffer(GSourceListener *psl);
  */
 void geventSendEvent(GSourceListener *psl);
 
+/**
+ * @brief	Called by a source to indicate the listener's event buffer has been filled with an event
+ * 			that may be merged with other events.
+ * @details	If the listener queues events and the newest event still in its queue is a mergeable
+ * 			event from the same source, that event is replaced by this one. Use this for events
+ * 			where only the latest state matters (eg. mouse moves).
+ * @details	After calling this function the source must not reference in fields in the @p GSourceListener or the event buffer.
+ *
+ * @param[in] psl	The source listener
+ */
+void geventSendMergeableEvent(GSourceListener *psl);
+
 /**
  * @brief	Detach any listener that has this source attached
+ * @note	The source must not be part way through sending an event when it calls this.
  *
  * @param[in] gsh	The source handle
  */
@@ -29,6 +29,17 @@
 	#ifndef GEVENT_ASSERT_NO_RESOURCE
 		#define GEVENT_ASSERT_NO_RESOURCE		FALSE
 	#endif
+	/**
+	 * @brief   Allow a listener to queue events.
+	 * @details	Defaults to FALSE.
+	 * @details	If TRUE a listener can be given a queue of events with @p geventListenerSetQueue()
+	 * 			so that events arriving while the application is busy are not lost. Consecutive
+	 * 			mergeable events (eg. mouse moves) are merged. Counters of dropped and merged
+	 * 			events are kept in each listener.
+	 */
+	#ifndef GEVENT_NEED_LISTENER_QUEUE
+		#define GEVENT_NEED_LISTENER_QUEUE		FALSE
+	#endif
 /**
  * @}
  *
@@ -49,6 +60,23 @@
 	#ifndef GEVENT_MAX_SOURCE_LISTENERS
 		#define GEVENT_MAX_SOURCE_LISTENERS		32
 	#endif
+	/**
+	 * @brief   Allocate more Source/Listener pairs when they run out.
+	 * @details	Defaults to FALSE
+	 * @details	If TRUE another table of GEVENT_MAX_SOURCE_LISTENERS pairs is allocated from the heap
+	 * 			each time the existing tables are full.
+	 */
+	#ifndef GEVENT_SOURCE_LISTENERS_GROW
+		#define GEVENT_SOURCE_LISTENERS_GROW	FALSE
+	#endif
+	/**
+	 * @brief   The number of hash buckets used to find the listeners for a source.
+	 * @details	Defaults to 16
+	 * @note	This must be a power of 2.
+	 */
+	#ifndef GEVENT_SOURCE_HASH_SIZE
+		#define GEVENT_SOURCE_HASH_SIZE			16
+	#endif
 /** @} */
 
 #endif /* _GEVENT_OPTIONS_H */
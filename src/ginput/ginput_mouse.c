@@ -98,7 +98,12 @@ static void SendMouseEvent(GSourceListener	*psl, GMouse *m, GMouseReading *r) {
 	pe->buttons = r->buttons | psl->srcflags;
 	psl->srcflags = 0;
 	pe->display = m->display;
-	geventSendEvent(psl);
+
+	// A plain move can be merged with an earlier plain move
+	if (!(pe->buttons & (GMETA_MASK|GINPUT_MISSED_MOUSE_EVENT)))
+		geventSendMergeableEvent(psl);
+	else
+		geventSendEvent(psl);
 }
 
 static void GetMouseReading(GMouse *m) {
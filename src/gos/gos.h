@@ -507,5 +507,9 @@
 	#error "Your operating system is not supported yet"
 #endif
 
+#if GFX_OS_NEED_WORKQUEUE || defined(__DOXYGEN__)
+	#include "gos_workqueue.h"
+#endif
+
 #endif /* _GOS_H */
 /** @} */
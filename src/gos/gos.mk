@@ -15,5 +15,6 @@ GFXSRC +=   $(GFXLIB)/src/gos/gos_chibios.c	\
 			$(GFXLIB)/src/gos/gos_cmsis.c \
 			$(GFXLIB)/src/gos/gos_nios.c \
 			$(GFXLIB)/src/gos/gos_x_threads.c \
-			$(GFXLIB)/src/gos/gos_x_heap.c
+			$(GFXLIB)/src/gos/gos_x_heap.c \
+			$(GFXLIB)/src/gos/gos_workqueue.c
 
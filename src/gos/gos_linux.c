@@ -109,6 +109,13 @@ systemticks_t gfxSystemTicks(void) {
 	return ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
 }
 
+uint32_t gfxSystemMicroseconds(void) {
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
 gfxThreadHandle gfxThreadCreate(void *stackarea, size_t stacksz, threadpriority_t prio, DECLARE_THREAD_FUNCTION((*fn),p), void *param) {
 	gfxThreadHandle		th;
 	(void)				stackarea;
@@ -137,6 +144,17 @@ threadreturn_t gfxThreadWait(gfxThreadHandle thread) {
 	return retval;
 }
 
+// Calculate the absolute time for a semaphore timeout
+static void linuxdeadline(struct timespec *tm, unsigned long secs, long nsecs) {
+	clock_gettime(CLOCK_REALTIME, tm);
+	tm->tv_sec += secs;
+	tm->tv_nsec += nsecs;
+	if (tm->tv_nsec >= 1000000000) {
+		tm->tv_nsec -= 1000000000;
+		tm->tv_sec++;
+	}
+}
+
 #if GFX_USE_POSIX_SEMAPHORES
 	void gfxSemInit(gfxSem *pSem, semcount_t val, semcount_t limit) {
 		pSem->max = limit;
@@ -157,9 +175,24 @@ threadreturn_t gfxThreadWait(gfxThreadHandle thread) {
 			{
 				struct timespec	tm;
 
-				clock_gettime(CLOCK_REALTIME, &tm);
-				tm.tv_sec += ms / 1000;
-				tm.tv_nsec += (ms % 1000) * 1000000;
+				linuxdeadline(&tm, ms / 1000, (ms % 1000) * 1000000);
+				return sem_timedwait(&pSem->sem, &tm) ? FALSE : TRUE;
+			}
+		}
+	}
+	bool_t gfxSemWaitMicroseconds(gfxSem *pSem, delaytime_t us) {
+		switch (us) {
+		case TIME_INFINITE:
+			return sem_wait(&pSem->sem) ? FALSE : TRUE;
+
+		case TIME_IMMEDIATE:
+			return sem_trywait(&pSem->sem) ? FALSE : TRUE;
+
+		default:
+			{
+				struct timespec	tm;
+
+				linuxdeadline(&tm, us / 1000000, (us % 1000000) * 1000);
 				return sem_timedwait(&pSem->sem, &tm) ? FALSE : TRUE;
 			}
 		}
@@ -188,47 +221,70 @@ threadreturn_t gfxThreadWait(gfxThreadHandle thread) {
 		pthread_mutex_destroy(&pSem->mtx);
 		pthread_cond_destroy(&pSem->cond);
 	}
-	bool_t gfxSemWait(gfxSem *pSem, delaytime_t ms) {
+	// Wait on the semaphore until an absolute time (or forever if tm is NULL)
+	static bool_t linuxsemwait(gfxSem *pSem, const struct timespec *tm) {
 		pthread_mutex_lock(&pSem->mtx);
 
-		switch (ms) {
-			case TIME_INFINITE:
-				while (!pSem->cnt)
-					pthread_cond_wait(&pSem->cond, &pSem->mtx);
-				break;
-
-			case TIME_IMMEDIATE:
-				if (!pSem->cnt) {
+		if (!tm) {
+			while (!pSem->cnt)
+				pthread_cond_wait(&pSem->cond, &pSem->mtx);
+		} else {
+			while (!pSem->cnt) {
+				// We used to test the return value for ETIMEDOUT. This doesn't
+				//	work in some current pthread libraries which return -1 instead
+				//	and set errno to ETIMEDOUT. So, we will return FALSE on any error
+				//	including a ETIMEDOUT.
+				if (pthread_cond_timedwait(&pSem->cond, &pSem->mtx, tm)) {
 					pthread_mutex_unlock(&pSem->mtx);
 					return FALSE;
 				}
-				break;
-
-			default:
-				{
-					struct timespec	tm;
-
-					clock_gettime(CLOCK_REALTIME, &tm);
-					tm.tv_sec += ms / 1000;
-					tm.tv_nsec += (ms % 1000) * 1000000;
-					while (!pSem->cnt) {
-						// We used to test the return value for ETIMEDOUT. This doesn't
-						//	work in some current pthread libraries which return -1 instead
-						//	and set errno to ETIMEDOUT. So, we will return FALSE on any error
-						//	including a ETIMEDOUT.
-						if (pthread_cond_timedwait(&pSem->cond, &pSem->mtx, &tm)) {
-							pthread_mutex_unlock(&pSem->mtx);
-							return FALSE;
-						}
-					}
-				}
-				break;
+			}
 		}
 
 		pSem->cnt--;
 		pthread_mutex_unlock(&pSem->mtx);
 		return TRUE;
 	}
+	static bool_t linuxsemtrywait(gfxSem *pSem) {
+		pthread_mutex_lock(&pSem->mtx);
+		if (!pSem->cnt) {
+			pthread_mutex_unlock(&pSem->mtx);
+			return FALSE;
+		}
+		pSem->cnt--;
+		pthread_mutex_unlock(&pSem->mtx);
+		return TRUE;
+	}
+	bool_t gfxSemWait(gfxSem *pSem, delaytime_t ms) {
+		struct timespec	tm;
+
+		switch (ms) {
+			case TIME_INFINITE:
+				return linuxsemwait(pSem, 0);
+
+			case TIME_IMMEDIATE:
+				return linuxsemtrywait(pSem);
+
+			default:
+				linuxdeadline(&tm, ms / 1000, (ms % 1000) * 1000000);
+				return linuxsemwait(pSem, &tm);
+		}
+	}
+	bool_t gfxSemWaitMicroseconds(gfxSem *pSem, delaytime_t us) {
+		struct timespec	tm;
+
+		switch (us) {
+			case TIME_INFINITE:
+				return linuxsemwait(pSem, 0);
+
+			case TIME_IMMEDIATE:
+				return linuxsemtrywait(pSem);
+
+			default:
+				linuxdeadline(&tm, us / 1000000, (us % 1000000) * 1000);
+				return linuxsemwait(pSem, &tm);
+		}
+	}
 	void gfxSemSignal(gfxSem *pSem) {
 		pthread_mutex_lock(&pSem->mtx);
 
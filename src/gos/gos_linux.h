@@ -60,6 +60,9 @@ typedef pthread_mutex_t		gfxMutex;
 #define NORMAL_PRIORITY				0
 #define HIGH_PRIORITY				-10
 
+// This port provides microsecond timing for high resolution GTIMER timers
+#define GOS_HAS_MICROSECONDS		TRUE
+
 #if GFX_USE_POSIX_SEMAPHORES
 	typedef struct gfxSem {
 		sem_t			sem;
@@ -89,11 +92,13 @@ void gfxHalt(const char *msg);
 void gfxSleepMilliseconds(delaytime_t ms);
 void gfxSleepMicroseconds(delaytime_t ms);
 systemticks_t gfxSystemTicks(void);
+uint32_t gfxSystemMicroseconds(void);
 void gfxSystemLock(void);
 void gfxSystemUnlock(void);
 void gfxSemInit(gfxSem *psem, semcount_t val, semcount_t limit);
 void gfxSemDestroy(gfxSem *psem);
 bool_t gfxSemWait(gfxSem *psem, delaytime_t ms);
+bool_t gfxSemWaitMicroseconds(gfxSem *psem, delaytime_t us);
 void gfxSemSignal(gfxSem *psem);
 semcount_t gfxSemCounter(gfxSem *pSem);
 gfxThreadHandle gfxThreadCreate(void *stackarea, size_t stacksz, threadpriority_t prio, DECLARE_THREAD_FUNCTION((*fn),p), void *param);
@@ -18,3 +18,4 @@
 #include "gos_nios.c"
 #include "gos_x_threads.c"
 #include "gos_x_heap.c"
+#include "gos_workqueue.c"
@@ -156,6 +156,34 @@
  	 * 					#define GFX_OS_EXTRA_DEINIT_FUNCTION myOSDeInitRoutine
  	 */
     //#define GFX_OS_EXTRA_DEINIT_FUNCTION             myOSDeInitRoutine
+ 	/**
+ 	 * @name	GFX_OS_IDLE_FUNCTION
+ 	 * @brief	A macro that defines a function that the uGFX cooperative scheduler calls when no thread is ready to run
+ 	 * @details	Defaults to undefined
+ 	 * @note	Only used by the internal uGFX scheduler (GFX_USE_OS_RAW32, GFX_USE_OS_ARDUINO, GFX_USE_OS_NIOS).
+ 	 * 			If not defined a WFI instruction is used on the Cortex-M CPUs and nothing is done for other CPUs.
+ 	 * @note	The function is called with interrupts disabled (by INTERRUPTS_OFF()) and must return as soon as
+ 	 * 			an interrupt is pending as that may make a thread ready. The interrupt is serviced after the function
+ 	 * 			returns. A Cortex-M WFI instruction does this when interrupts are disabled using PRIMASK.
+ 	 * @note	Eg. In your source:
+ 	 * 					void myIdleRoutine(void);
+ 	 * 				In gfxconf.h:
+ 	 * 					#define GFX_OS_IDLE_FUNCTION myIdleRoutine
+ 	 */
+    //#define GFX_OS_IDLE_FUNCTION                     myIdleRoutine
+ 	/**
+ 	 * @name	GFX_OS_THREAD_TRACE_FUNCTION
+ 	 * @brief	A macro that defines a function that the uGFX cooperative scheduler calls on every thread switch
+ 	 * @details	Defaults to undefined
+ 	 * @note	Only used by the internal uGFX scheduler (GFX_USE_OS_RAW32, GFX_USE_OS_ARDUINO, GFX_USE_OS_NIOS).
+ 	 * @note	The function is called with interrupts disabled just before switching and must not call any
+ 	 * 			uGFX functions. The handles are those returned by gfxThreadCreate() and gfxThreadMe().
+ 	 * @note	Eg. In your source:
+ 	 * 					void myTraceRoutine(gfxThreadHandle from, gfxThreadHandle to);
+ 	 * 				In gfxconf.h:
+ 	 * 					#define GFX_OS_THREAD_TRACE_FUNCTION myTraceRoutine
+ 	 */
+    //#define GFX_OS_THREAD_TRACE_FUNCTION             myTraceRoutine
  	/**
  	 * @brief	Should uGFX avoid initializing the operating system
  	 * @details	Defaults to FALSE
@@ -239,6 +267,38 @@
 	#ifndef GFX_EMULATE_MALLOC
 		#define GFX_EMULATE_MALLOC	FALSE
 	#endif
+ 	/**
+ 	 * @brief	Use the POSIX ucontext functions to switch threads in the uGFX cooperative scheduler
+ 	 * @details	Defaults to FALSE
+ 	 * @note	Only used by the internal uGFX scheduler (GFX_USE_OS_RAW32, GFX_USE_OS_ARDUINO, GFX_USE_OS_NIOS).
+ 	 * @note	This allows a GFX_USE_OS_RAW32 build to run as a normal process on a host operating system
+ 	 * 			such as Linux. The same scheduler is used as on bare metal hardware so it can be used to
+ 	 * 			simulate and profile an embedded application.
+ 	 * @note	With GFX_USE_OS_RAW32 the gfxSystemTicks() and gfxMillisecondsToTicks() functions are
+ 	 * 			supplied automatically (a tick is 1 millisecond) and the scheduler idles using nanosleep().
+ 	 * @note	Thread stacks are always at least 64K bytes as the host C library needs lots of stack.
+ 	 */
+	#ifndef GFX_OS_UCONTEXT
+		#define GFX_OS_UCONTEXT		FALSE
+	#endif
+ 	/**
+ 	 * @brief	Collect thread switching and cpu usage statistics in the uGFX cooperative scheduler
+ 	 * @details	Defaults to FALSE
+ 	 * @note	Only used by the internal uGFX scheduler (GFX_USE_OS_RAW32, GFX_USE_OS_ARDUINO, GFX_USE_OS_NIOS).
+ 	 * @note	If TRUE the gfxThreadGetStats() function is added.
+ 	 */
+	#ifndef GFX_OS_THREAD_STATS
+		#define GFX_OS_THREAD_STATS	FALSE
+	#endif
+ 	/**
+ 	 * @brief	Include the work queue functions
+ 	 * @details	Defaults to FALSE
+ 	 * @note	If TRUE the gfxWorkQueue functions are added. A work queue runs functions on a pool
+ 	 * 			of worker threads with support for priorities, delays and cancellation.
+ 	 */
+	#ifndef GFX_OS_NEED_WORKQUEUE
+		#define GFX_OS_NEED_WORKQUEUE	FALSE
+	#endif
 /** @} */
 
 #endif /* _GOS_OPTIONS_H */
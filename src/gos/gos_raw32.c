@@ -68,6 +68,18 @@ void _gosDeinit(void)
 	#include <stdio.h>
 	systemticks_t gfxSystemTicks(void)						{ return GetTickCount(); }
 	systemticks_t gfxMillisecondsToTicks(delaytime_t ms)	{ return ms; }
+#elif GFX_OS_UCONTEXT
+	// Running as a process on a host operating system
+	#include <stdio.h>
+	#include <stdlib.h>
+	#include <time.h>
+	systemticks_t gfxSystemTicks(void) {
+		struct timespec	ts;
+
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+	}
+	systemticks_t gfxMillisecondsToTicks(delaytime_t ms)	{ return ms; }
 #endif
 
 /*********************************************************
@@ -78,6 +90,9 @@ void gfxHalt(const char *msg) {
 	#if defined(WIN32)
 		fprintf(stderr, "%s\n", msg);
 		ExitProcess(1);
+	#elif GFX_OS_UCONTEXT
+		fprintf(stderr, "%s\n", msg);
+		exit(1);
 	#else
 		volatile uint32_t	dummy;
 		(void)				msg;
@@ -90,6 +105,8 @@ void gfxHalt(const char *msg) {
 void gfxExit(void) {
 	#if defined(WIN32)
 		ExitProcess(0);
+	#elif GFX_OS_UCONTEXT
+		exit(0);
 	#else
 		volatile uint32_t	dummy;
 
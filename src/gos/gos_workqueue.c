@@ -0,0 +1,225 @@
+/*
+ * This file is subject to the terms of the GFX License. If a copy of
+ * the license was not distributed with this file, you can obtain one at:
+ *
+ *              http://ugfx.org/license.html
+ */
+
+#include "../../gfx.h"
+
+#if GFX_OS_NEED_WORKQUEUE
+
+#define WORK_FLG_READY		0x01		// The item is on the ready list
+#define WORK_FLG_DELAYED	0x02		// The item is on the delayed list
+
+/* Remove an item from a list. Returns TRUE if it was found */
+/* We already have the mutex */
+static bool_t workRemove(gfxWorkItem **plist, gfxWorkItem *pw) {
+	for(; *plist; plist = &(*plist)->next) {
+		if (*plist == pw) {
+			*plist = pw->next;
+			pw->next = 0;
+			return TRUE;
+		}
+	}
+	return FALSE;
+}
+
+/* Take an item out of whichever list it is in */
+/* We already have the mutex */
+static void workUnqueue(gfxWorkQueue *wq, gfxWorkItem *pw) {
+	if ((pw->flags & WORK_FLG_READY))
+		workRemove(&wq->ready, pw);
+	else if ((pw->flags & WORK_FLG_DELAYED))
+		workRemove(&wq->delayed, pw);
+	pw->flags &= ~(WORK_FLG_READY|WORK_FLG_DELAYED);
+}
+
+/* Add an item to the ready list after any items of the same or higher priority */
+/* We already have the mutex */
+static void workAddReady(gfxWorkQueue *wq, gfxWorkItem *pw) {
+	gfxWorkItem	**plist;
+
+	for(plist = &wq->ready; *plist && (*plist)->prio >= pw->prio; plist = &(*plist)->next);
+	pw->next = *plist;
+	*plist = pw;
+	pw->flags |= WORK_FLG_READY;
+}
+
+/* How long (in ticks) until a delayed item is due */
+static systemticks_t workRemaining(gfxWorkItem *pw, systemticks_t now) {
+	systemticks_t	elapsed;
+
+	elapsed = now - pw->start;
+	return elapsed < pw->delay ? pw->delay - elapsed : 0;
+}
+
+/* Move any delayed items that are now due to the ready list */
+/* Returns how long (in ticks) until the next delayed item is due */
+/* We already have the mutex */
+static systemticks_t workCheckDelayed(gfxWorkQueue *wq) {
+	gfxWorkItem		*pw;
+	systemticks_t	now, nxt;
+
+	now = gfxSystemTicks();
+	while((pw = wq->delayed)) {
+		if ((nxt = workRemaining(pw, now)))
+			return nxt;
+		wq->delayed = pw->next;
+		pw->flags &= ~WORK_FLG_DELAYED;
+		workAddReady(wq, pw);
+	}
+	return 0;
+}
+
+static DECLARE_THREAD_FUNCTION(WorkerThread, param) {
+	gfxWorkQueue	*wq;
+	gfxWorkItem		*pw;
+	gfxWorkFunction	fn;
+	void			*fnparam;
+	systemticks_t	nxt, ticks2ms;
+	delaytime_t		wait;
+
+	wq = (gfxWorkQueue *)param;
+	if (!(ticks2ms = gfxMillisecondsToTicks(1)))
+		ticks2ms = 1;
+
+	gfxMutexEnter(&wq->mutex);
+	while(!wq->stop) {
+		nxt = workCheckDelayed(wq);
+
+		// Run the highest priority ready item
+		if ((pw = wq->ready)) {
+			wq->ready = pw->next;
+			pw->next = 0;
+			pw->flags &= ~WORK_FLG_READY;
+			fn = pw->fn;
+			fnparam = pw->param;
+			gfxMutexExit(&wq->mutex);
+
+			// The item now belongs to the caller again. It may be freed or resubmitted while it runs.
+			fn(fnparam);
+
+			gfxMutexEnter(&wq->mutex);
+			continue;
+		}
+
+		// Wait for more work or until the next delayed item is due
+		wait = wq->delayed ? (delaytime_t)((nxt + ticks2ms - 1) / ticks2ms) : TIME_INFINITE;
+		gfxMutexExit(&wq->mutex);
+		gfxSemWait(&wq->sem, wait);
+		gfxMutexEnter(&wq->mutex);
+	}
+	gfxMutexExit(&wq->mutex);
+	THREAD_RETURN(0);
+}
+
+bool_t gfxWorkQueueInit(gfxWorkQueue *wq, unsigned nthreads, size_t stacksize, threadpriority_t prio) {
+	gfxMutexInit(&wq->mutex);
+	gfxSemInit(&wq->sem, 0, MAX_SEMAPHORE_COUNT);
+	wq->ready = wq->delayed = 0;
+	wq->stop = FALSE;
+	wq->nthreads = 0;
+	if (!(wq->threads = gfxAlloc(nthreads * sizeof(gfxThreadHandle))))
+		goto failed;
+	for(; wq->nthreads < nthreads; wq->nthreads++) {
+		if (!(wq->threads[wq->nthreads] = gfxThreadCreate(0, stacksize, prio, WorkerThread, wq)))
+			goto failed;
+	}
+	return TRUE;
+
+failed:
+	gfxWorkQueueDeinit(wq);
+	return FALSE;
+}
+
+void gfxWorkQueueDeinit(gfxWorkQueue *wq) {
+	gfxWorkItem	*pw;
+	unsigned	i;
+
+	// Stop the worker threads
+	wq->stop = TRUE;
+	for(i = 0; i < wq->nthreads; i++)
+		gfxSemSignal(&wq->sem);
+	for(i = 0; i < wq->nthreads; i++)
+		gfxThreadWait(wq->threads[i]);
+	if (wq->threads)
+		gfxFree(wq->threads);
+	wq->threads = 0;
+	wq->nthreads = 0;
+
+	// Discard any work that hasn't been run
+	while((pw = wq->ready)) {
+		wq->ready = pw->next;
+		pw->next = 0;
+		pw->flags = 0;
+	}
+	while((pw = wq->delayed)) {
+		wq->delayed = pw->next;
+		pw->next = 0;
+		pw->flags = 0;
+	}
+
+	gfxSemDestroy(&wq->sem);
+	gfxMutexDestroy(&wq->mutex);
+}
+
+void gfxWorkInit(gfxWorkItem *pw) {
+	pw->next = 0;
+	pw->flags = 0;
+}
+
+void gfxWorkSubmit(gfxWorkQueue *wq, gfxWorkItem *pw, gfxWorkFunction fn, void *param, uint8_t prio) {
+	gfxMutexEnter(&wq->mutex);
+	workUnqueue(wq, pw);
+	pw->fn = fn;
+	pw->param = param;
+	pw->prio = prio;
+	workAddReady(wq, pw);
+	gfxMutexExit(&wq->mutex);
+	gfxSemSignal(&wq->sem);
+}
+
+void gfxWorkSubmitDelayed(gfxWorkQueue *wq, gfxWorkItem *pw, gfxWorkFunction fn, void *param, uint8_t prio, delaytime_t delay) {
+	gfxWorkItem		**plist;
+	systemticks_t	now;
+
+	if (delay == TIME_IMMEDIATE) {
+		gfxWorkSubmit(wq, pw, fn, param, prio);
+		return;
+	}
+
+	gfxMutexEnter(&wq->mutex);
+	workUnqueue(wq, pw);
+	pw->fn = fn;
+	pw->param = param;
+	pw->prio = prio;
+	pw->start = now = gfxSystemTicks();
+	pw->delay = gfxMillisecondsToTicks(delay);
+
+	// Keep the delayed list in the order the items are due
+	for(plist = &wq->delayed; *plist && workRemaining(*plist, now) <= pw->delay; plist = &(*plist)->next);
+	pw->next = *plist;
+	*plist = pw;
+	pw->flags |= WORK_FLG_DELAYED;
+	gfxMutexExit(&wq->mutex);
+
+	// Wake a worker so it recalculates how long to wait
+	gfxSemSignal(&wq->sem);
+}
+
+bool_t gfxWorkCancel(gfxWorkQueue *wq, gfxWorkItem *pw) {
+	bool_t	res;
+
+	gfxMutexEnter(&wq->mutex);
+	res = (pw->flags & (WORK_FLG_READY|WORK_FLG_DELAYED)) != 0;
+	workUnqueue(wq, pw);
+	gfxMutexExit(&wq->mutex);
+	return res;
+}
+
+bool_t gfxWorkIsPending(gfxWorkItem *pw) {
+	return (pw->flags & (WORK_FLG_READY|WORK_FLG_DELAYED)) != 0;
+}
+
+#endif /* GFX_OS_NEED_WORKQUEUE */
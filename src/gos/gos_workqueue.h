@@ -0,0 +1,169 @@
+/*
+ * This file is subject to the terms of the GFX License. If a copy of
+ * the license was not distributed with this file, you can obtain one at:
+ *
+ *              http://ugfx.org/license.html
+ */
+
+/**
+ * @file    src/gos/gos_workqueue.h
+ * @brief   GOS - Work queues.
+ *
+ * @addtogroup GOS
+ *
+ * @details	A work queue runs short functions (work items) on a pool of worker threads.
+ * 			This allows code to do background work without creating threads of its own and
+ * 			without holding up other users of a shared thread (eg. the GTIMER thread).
+ * 			Work items are run in priority order and can be delayed or cancelled.
+ * 			The work queue is built on the GOS thread and semaphore functions so it works
+ * 			with every operating system port.
+ * @pre		GFX_OS_NEED_WORKQUEUE must be TRUE in your gfxconf.h
+ * @{
+ */
+
+#ifndef _GOS_WORKQUEUE_H
+#define _GOS_WORKQUEUE_H
+
+/*===========================================================================*/
+/* Type definitions                                                          */
+/*===========================================================================*/
+
+/**
+ * @brief	A work function
+ */
+typedef void (*gfxWorkFunction)(void *param);
+
+/**
+ * @brief	A work item
+ * @note	This structure is owned by the caller. It must remain valid until the work has been cancelled or its
+ *			function has been called. The work function may free or resubmit its own work item.
+ */
+typedef struct gfxWorkItem {
+	struct gfxWorkItem	*next;		// @< Private: The next item in the queue
+	gfxWorkFunction		fn;			// @< Private: The function to call
+	void				*param;		// @< Private: The parameter to pass to the function
+	systemticks_t		start;		// @< Private: When a delayed item was submitted
+	systemticks_t		delay;		// @< Private: How long to delay the item (in ticks)
+	uint8_t				prio;		// @< Private: The priority of the work (higher runs first)
+	uint8_t				flags;		// @< Private: Flags
+} gfxWorkItem;
+
+/**
+ * @brief	A work queue
+ */
+typedef struct gfxWorkQueue {
+	gfxMutex			mutex;		// @< Private: Protects the queue
+	gfxSem				sem;		// @< Private: Used to wake the worker threads
+	gfxWorkItem			*ready;		// @< Private: The items ready to run (in priority order)
+	gfxWorkItem			*delayed;	// @< Private: The delayed items (in order of when they are due)
+	gfxThreadHandle		*threads;	// @< Private: The worker threads
+	unsigned			nthreads;	// @< Private: The number of worker threads
+	volatile bool_t		stop;		// @< Private: The worker threads should exit
+} gfxWorkQueue;
+
+/*===========================================================================*/
+/* Function declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+	/**
+	 * @brief	Create a work queue and start its worker threads
+	 * @return	FALSE if the threads could not be created
+	 *
+	 * @param[in] wq			The work queue
+	 * @param[in] nthreads		The number of worker threads
+	 * @param[in] stacksize		The stack size for each worker thread
+	 * @param[in] prio			The priority of the worker threads
+	 *
+	 * @api
+	 */
+	bool_t gfxWorkQueueInit(gfxWorkQueue *wq, unsigned nthreads, size_t stacksize, threadpriority_t prio);
+
+	/**
+	 * @brief	Stop the worker threads and destroy a work queue
+	 *
+	 * @param[in] wq	The work queue
+	 *
+	 * @note	This waits for any work that is currently running to finish. Work that has not started is discarded.
+	 * @note	This must not be called from one of the work queue's own work functions.
+	 *
+	 * @api
+	 */
+	void gfxWorkQueueDeinit(gfxWorkQueue *wq);
+
+	/**
+	 * @brief	Initialise a work item
+	 *
+	 * @param[in] pw	The work item
+	 *
+	 * @note	This must be called once before the work item is first used.
+	 *
+	 * @api
+	 */
+	void gfxWorkInit(gfxWorkItem *pw);
+
+	/**
+	 * @brief	Submit work to a work queue
+	 *
+	 * @param[in] wq		The work queue
+	 * @param[in] pw		The work item
+	 * @param[in] fn		The function to run
+	 * @param[in] param		The parameter to pass to the function
+	 * @param[in] prio		The priority of the work. Higher priority work is run first.
+	 * 						Work of the same priority is run in the order it is submitted.
+	 *
+	 * @note	If the work item is already waiting in a queue it is removed from that queue first.
+	 * @note	A work item that is currently running can be resubmitted (even by its own work function).
+	 *
+	 * @api
+	 */
+	void gfxWorkSubmit(gfxWorkQueue *wq, gfxWorkItem *pw, gfxWorkFunction fn, void *param, uint8_t prio);
+
+	/**
+	 * @brief	Submit work to a work queue to be run after a delay
+	 *
+	 * @param[in] wq		The work queue
+	 * @param[in] pw		The work item
+	 * @param[in] fn		The function to run
+	 * @param[in] param		The parameter to pass to the function
+	 * @param[in] prio		The priority of the work once the delay is over
+	 * @param[in] delay		The delay in milliseconds
+	 *
+	 * @note	If the work item is already waiting in a queue it is removed from that queue first.
+	 *
+	 * @api
+	 */
+	void gfxWorkSubmitDelayed(gfxWorkQueue *wq, gfxWorkItem *pw, gfxWorkFunction fn, void *param, uint8_t prio, delaytime_t delay);
+
+	/**
+	 * @brief	Cancel work
+	 * @return	TRUE if the work was removed from the queue before it started running
+	 *
+	 * @param[in] wq	The work queue
+	 * @param[in] pw	The work item
+	 *
+	 * @note	This does not wait for work that is already running.
+	 *
+	 * @api
+	 */
+	bool_t gfxWorkCancel(gfxWorkQueue *wq, gfxWorkItem *pw);
+
+	/**
+	 * @brief	Is work waiting in a queue to be run
+	 * @return	TRUE if the work item has been submitted and has not yet started running
+	 *
+	 * @param[in] pw	The work item
+	 *
+	 * @api
+	 */
+	bool_t gfxWorkIsPending(gfxWorkItem *pw);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _GOS_WORKQUEUE_H */
+/** @} */
@@ -26,68 +26,77 @@ void gfxSystemUnlock(void) {
 	INTERRUPTS_ON();
 }
 
+// The scheduler interface used by the semaphores, mutexes and sleep functions (see below).
+// These must all be called with interrupts off.
+static bool_t BlockMe(_gfxThreadQ *q, systemticks_t delay);
+static struct _gfxThread *WakeFirst(_gfxThreadQ *q);
+static void Preempt(void);
+static void InheritFromMe(struct _gfxThread *owner);
+static void InheritFromWaiters(struct _gfxThread *owner, _gfxThreadQ *q);
+static void Disinherit(void);
+
 void gfxMutexInit(gfxMutex *pmutex) {
-	pmutex[0] = 0;
+	pmutex->owner = 0;
+	pmutex->waitq.head = pmutex->waitq.tail = 0;
 }
 
 void gfxMutexEnter(gfxMutex *pmutex) {
 	INTERRUPTS_OFF();
-	while (pmutex[0]) {
-		INTERRUPTS_ON();
-		gfxYield();
-		INTERRUPTS_OFF();
-	}
-	pmutex[0] = 1;
+	if (pmutex->owner) {
+		// Wait for the owner to hand it to us. It runs at our priority until then.
+		InheritFromMe(pmutex->owner);
+		BlockMe(&pmutex->waitq, TIME_INFINITE);
+	} else
+		pmutex->owner = (struct _gfxThread *)gfxThreadMe();
 	INTERRUPTS_ON();
 }
 
 void gfxMutexExit(gfxMutex *pmutex) {
-	pmutex[0] = 0;
+	INTERRUPTS_OFF();
+	Disinherit();
+
+	// Pass it straight on to the highest priority waiting thread (it stays locked)
+	if (pmutex->waitq.head) {
+		pmutex->owner = WakeFirst(&pmutex->waitq);
+		InheritFromWaiters(pmutex->owner, &pmutex->waitq);
+		Preempt();
+	} else
+		pmutex->owner = 0;
+	INTERRUPTS_ON();
 }
 
 void gfxSemInit(gfxSem *psem, semcount_t val, semcount_t limit) {
 	psem->cnt = val;
 	psem->limit = limit;
+	psem->waitq.head = psem->waitq.tail = 0;
 }
 
 bool_t gfxSemWait(gfxSem *psem, delaytime_t ms) {
-	systemticks_t	starttm, delay;
+	systemticks_t	delay;
+	bool_t			ret;
 
 	// Convert our delay to ticks
-	starttm = 0;
 	switch (ms) {
 	case TIME_IMMEDIATE:
-		delay = TIME_IMMEDIATE;
-		break;
 	case TIME_INFINITE:
-		delay = TIME_INFINITE;
+		delay = ms;
 		break;
 	default:
 		delay = gfxMillisecondsToTicks(ms);
 		if (!delay) delay = 1;
-		starttm = gfxSystemTicks();
 	}
 
 	INTERRUPTS_OFF();
-	while (psem->cnt <= 0) {
-		INTERRUPTS_ON();
-		// Check if we have exceeded the defined delay
-		switch (delay) {
-		case TIME_IMMEDIATE:
-			return FALSE;
-		case TIME_INFINITE:
-			break;
-		default:
-			if (gfxSystemTicks() - starttm >= delay)
-				return FALSE;
-			break;
-		}
-		gfxYield();
-		INTERRUPTS_OFF();
-	}
-	psem->cnt--;
+	if (psem->cnt > 0) {
+		psem->cnt--;
+		ret = TRUE;
+	} else if (delay == TIME_IMMEDIATE)
+		ret = FALSE;
+	else
+		// Wait until the semaphore is signaled to us or we time out
+		ret = BlockMe(&psem->waitq, delay);
 	INTERRUPTS_ON();
-	return TRUE;
+	return ret;
 }
 
 bool_t gfxSemWaitI(gfxSem *psem) {
@@ -100,11 +109,15 @@ bool_t gfxSemWaitI(gfxSem *psem) {
 void gfxSemSignal(gfxSem *psem) {
 	INTERRUPTS_OFF();
 	gfxSemSignalI(psem);
+	Preempt();
 	INTERRUPTS_ON();
 }
 
 void gfxSemSignalI(gfxSem *psem) {
-	if (psem->cnt < psem->limit)
+	// A waiting thread gets the count directly
+	if (psem->waitq.head)
+		WakeFirst(&psem->waitq);
+	else if (psem->cnt < psem->limit)
 		psem->cnt++;
 }
 
@@ -113,47 +126,43 @@ void gfxSemSignalI(gfxSem *psem) {
  *********************************************************/
 
 void gfxSleepMilliseconds(delaytime_t ms) {
-	systemticks_t	starttm, delay;
+	systemticks_t	delay;
 
 	// Safety first
 	switch (ms) {
 	case TIME_IMMEDIATE:
 		return;
 	case TIME_INFINITE:
-		while(1)
-			gfxYield();
-		return;
+		delay = TIME_INFINITE;
+		break;
+	default:
+		delay = gfxMillisecondsToTicks(ms);
+		break;
 	}
 
-	// Convert our delay to ticks
-	delay = gfxMillisecondsToTicks(ms);
-	starttm = gfxSystemTicks();
-
-	do {
-		gfxYield();
-	} while (gfxSystemTicks() - starttm < delay);
+	INTERRUPTS_OFF();
+	BlockMe(0, delay);
+	INTERRUPTS_ON();
 }
 
 void gfxSleepMicroseconds(delaytime_t ms) {
-	systemticks_t	starttm, delay;
+	systemticks_t	delay;
 
 	// Safety first
 	switch (ms) {
 	case TIME_IMMEDIATE:
 		return;
 	case TIME_INFINITE:
-		while(1)
-			gfxYield();
-		return;
+		delay = TIME_INFINITE;
+		break;
+	default:
+		delay = gfxMillisecondsToTicks(ms/1000);
+		break;
 	}
 
-	// Convert our delay to ticks
-	delay = gfxMillisecondsToTicks(ms/1000);
-	starttm = gfxSystemTicks();
-
-	do {
-		gfxYield();
-	} while (gfxSystemTicks() - starttm < delay);
+	INTERRUPTS_OFF();
+	BlockMe(0, delay);
+	INTERRUPTS_ON();
 }
 
 /*********************************************************
@@ -168,32 +177,52 @@ void gfxSleepMicroseconds(delaytime_t ms) {
  *
  */
 
-typedef struct thread {
-	struct thread *	next;					// Next thread
+typedef struct _gfxThread {
+	struct _gfxThread *	next;				// Next thread in the ready queue or wait queue
 	int				flags;					// Flags
 		#define FLG_THD_ALLOC	0x0001
 		#define FLG_THD_MAIN	0x0002
 		#define FLG_THD_DEAD	0x0004
 		#define FLG_THD_WAIT	0x0008
+		#define FLG_THD_SLEEP	0x0010		// The thread is in the sleep list
+		#define FLG_THD_TIMEOUT	0x0020		// The thread was woken by its timeout rather than its wait queue
+		#define FLG_THD_READY	0x0040		// The thread is in a ready queue
 	size_t			size;					// Size of the thread stack (including this structure)
 	threadreturn_t	(*fn)(void *param);		// Thread function
 	void *			param;					// Parameter for the thread function
 	void *			cxt;					// The current thread context.
+	threadreturn_t	(*userfn)(void *param);	// The user's thread function (fn is the thread start-up code)
+	threadpriority_t	prio;				// The current priority (may be inherited from a mutex waiter)
+	threadpriority_t	baseprio;			// The priority the thread was created with
+	#if GFX_OS_THREAD_STATS
+		uint32_t	switches;				// How many times we have switched to the thread
+		uint32_t	cputime;				// The cpu time used by the thread
+		uint32_t	runstart;				// When the thread last started running
+	#endif
+	_gfxThreadQ *	waitq;					// The wait queue the thread is blocked on (if any)
+	struct _gfxThread *	snext;				// Next thread in the sleep list
+	systemticks_t	sleepstart;				// When the thread went to sleep
+	systemticks_t	sleepdelay;				// How long the thread is sleeping for
+	struct _gfxThread *	waiter;				// A thread waiting for this thread to exit
 	} thread;
 
-typedef struct threadQ {
-	thread *head;
-	thread *tail;
-} threadQ;
+typedef _gfxThreadQ threadQ;
+
+#define PRIORITIES			(HIGH_PRIORITY-LOW_PRIORITY+1)
 
-static threadQ		readyQ;					// The list of ready threads
+static threadQ		readyQ[PRIORITIES];		// The lists of ready threads for each priority
+static unsigned		readyMask;				// Which priorities have ready threads
 static threadQ		deadQ;					// Where we put threads waiting to be deallocated
+static thread *		sleepList;				// Sleeping threads ordered by when they wake up
+static unsigned		threadCount;			// How many threads are still alive
 thread *			_gfxCurrentThread;		// The current running thread - unfortunately this has to be non-static for the keil compiler
 static thread		mainthread;				// The main thread context
 
 #undef GFX_THREADS_DONE
 
-#if GFX_CPU == GFX_CPU_CORTEX_M0 || GFX_CPU == GFX_CPU_CORTEX_M1
+#if GFX_OS_UCONTEXT
+	#include "gos_x_threads_ucontext.h"
+#elif GFX_CPU == GFX_CPU_CORTEX_M0 || GFX_CPU == GFX_CPU_CORTEX_M1
 	#include "gos_x_threads_cortexm01.h"
 #elif GFX_CPU == GFX_CPU_CORTEX_M3 || GFX_CPU == GFX_CPU_CORTEX_M4 || GFX_CPU == GFX_CPU_CORTEX_M7
 	#include "gos_x_threads_cortexm347.h"
@@ -420,6 +449,37 @@ static thread		mainthread;				// The main thread context
 #endif
 #undef GFX_THREADS_DONE
 
+// What to do when there are no threads ready to run
+#if defined(GFX_OS_IDLE_FUNCTION)
+	extern void GFX_OS_IDLE_FUNCTION(void);
+	#define IDLE()		GFX_OS_IDLE_FUNCTION()
+#elif defined(_gfxThreadsIdle)
+	#define IDLE()		_gfxThreadsIdle()
+#else
+	#define IDLE()
+#endif
+
+// The smallest stack a thread can have
+#ifndef _gfxThreadsMinStack
+	#define _gfxThreadsMinStack		(sizeof(thread)+64)
+#endif
+
+#ifdef GFX_OS_THREAD_TRACE_FUNCTION
+	extern void GFX_OS_THREAD_TRACE_FUNCTION(gfxThreadHandle from, gfxThreadHandle to);
+#endif
+
+#if GFX_OS_THREAD_STATS
+	// The clock used to measure cpu time
+	#ifdef _gfxThreadsClock
+		#define STATS_CLOCK()		_gfxThreadsClock()
+	#else
+		#define STATS_CLOCK()		gfxSystemTicks()
+	#endif
+
+	static uint32_t		switchCount;		// The total number of thread switches
+	static uint32_t		idleTime;			// The time spent idle
+#endif
+
 static void Qinit(threadQ * q) {
 	q->head = q->tail = 0;
 }
@@ -434,7 +494,7 @@ static void Qadd(threadQ * q, thread *t) {
 }
 
 static thread *Qpop(threadQ * q) {
-	struct thread * t;
+	struct _gfxThread * t;
 
 	if (!q->head)
 		return 0;
@@ -443,14 +503,280 @@ static thread *Qpop(threadQ * q) {
 	return t;
 }
 
+static void Qremove(threadQ * q, thread *t) {
+	thread **	pp;
+	thread *	prev;
+
+	for(pp = &q->head, prev = 0; *pp; prev = *pp, pp = &(*pp)->next) {
+		if (*pp == t) {
+			*pp = t->next;
+			if (q->tail == t)
+				q->tail = prev;
+			return;
+		}
+	}
+}
+
+// Add a thread to a wait queue after any threads of the same or higher priority
+static void QaddPrio(threadQ * q, thread *t) {
+	thread **	pp;
+
+	for(pp = &q->head; *pp && (*pp)->prio >= t->prio; pp = &(*pp)->next);
+	t->next = *pp;
+	*pp = t;
+	if (!t->next)
+		q->tail = t;
+}
+
+/**
+ * The ready queues. There is one per priority and a bit mask of the non-empty ones
+ * so finding the highest priority ready thread doesn't depend on the number of threads.
+ * All these routines must be called with interrupts off.
+ */
+static void ReadyAdd(thread *t) {
+	Qadd(&readyQ[t->prio-LOW_PRIORITY], t);
+	readyMask |= 1 << (t->prio-LOW_PRIORITY);
+	t->flags |= FLG_THD_READY;
+}
+
+static void ReadyRemove(thread *t) {
+	threadQ *	q;
+
+	q = &readyQ[t->prio-LOW_PRIORITY];
+	Qremove(q, t);
+	if (!q->head)
+		readyMask &= ~(1 << (t->prio-LOW_PRIORITY));
+	t->flags &= ~FLG_THD_READY;
+}
+
+// Returns the highest priority that has a ready thread. Returns -1 if there are none.
+static int ReadyPrio(void) {
+	int		p;
+
+	for(p = PRIORITIES-1; p >= 0 && !(readyMask & (1 << p)); p--);
+	return p < 0 ? -1 : p+LOW_PRIORITY;
+}
+
+static thread *ReadyPop(void) {
+	thread *	t;
+	int			p;
+
+	if ((p = ReadyPrio()) < 0)
+		return 0;
+	p -= LOW_PRIORITY;
+	t = Qpop(&readyQ[p]);
+	if (!readyQ[p].head)
+		readyMask &= ~(1 << p);
+	t->flags &= ~FLG_THD_READY;
+	return t;
+}
+
+/**
+ * The sleep list is kept in wake-up order. The time remaining for each sleeping thread
+ * is only compared while none of them have expired as the tick counter may wrap.
+ * All these routines must be called with interrupts off.
+ */
+static void SleepRemove(thread *t) {
+	thread **	pp;
+
+	for(pp = &sleepList; *pp; pp = &(*pp)->snext) {
+		if (*pp == t) {
+			*pp = t->snext;
+			break;
+		}
+	}
+	t->flags &= ~FLG_THD_SLEEP;
+}
+
+// Move any threads whose sleep has expired onto the ready queue
+static void SleepWake(systemticks_t now) {
+	thread *	t;
+
+	while ((t = sleepList) && now - t->sleepstart >= t->sleepdelay) {
+		sleepList = t->snext;
+		t->flags &= ~FLG_THD_SLEEP;
+
+		// If it was waiting on something it has now timed out
+		if (t->waitq) {
+			Qremove(t->waitq, t);
+			t->waitq = 0;
+			t->flags |= FLG_THD_TIMEOUT;
+		}
+		ReadyAdd(t);
+	}
+}
+
+static void SleepAdd(thread *t, systemticks_t delay) {
+	thread **		pp;
+	systemticks_t	now;
+
+	// Get rid of anything that has expired so the remaining times can be compared
+	now = gfxSystemTicks();
+	SleepWake(now);
+
+	t->sleepstart = now;
+	t->sleepdelay = delay;
+	for(pp = &sleepList; *pp && (*pp)->sleepdelay - (now - (*pp)->sleepstart) <= delay; pp = &(*pp)->snext);
+	t->snext = *pp;
+	*pp = t;
+	t->flags |= FLG_THD_SLEEP;
+}
+
+/**
+ * Run the next ready thread. The current thread must already be on the ready queue, a wait queue or
+ * the sleep list if it is to run again. If nothing is ready we wait in the idle function.
+ * Must be called with interrupts off and returns with interrupts off.
+ */
+static void Reschedule(void) {
+	thread	*me;
+	thread	*t;
+	#if GFX_OS_THREAD_STATS
+		uint32_t	now;
+	#endif
+
+	me = _gfxCurrentThread;
+	#if GFX_OS_THREAD_STATS
+		now = STATS_CLOCK();
+		me->cputime += now - me->runstart;
+	#endif
+	while(1) {
+		if (sleepList)
+			SleepWake(gfxSystemTicks());
+		if ((t = ReadyPop()))
+			break;
+
+		// Wait for an interrupt to make something ready. Interrupts stay off until we are
+		// waiting so one that arrives just before can't be slept through. It runs once they are on.
+		IDLE();
+		INTERRUPTS_ON();
+		INTERRUPTS_OFF();
+	}
+	#if GFX_OS_THREAD_STATS
+		t->runstart = STATS_CLOCK();
+		idleTime += t->runstart - now;
+	#endif
+
+	// We may have been woken up ourselves while idling
+	_gfxCurrentThread = t;
+	if (t != me) {
+		#if GFX_OS_THREAD_STATS
+			t->switches++;
+			switchCount++;
+		#endif
+		#ifdef GFX_OS_THREAD_TRACE_FUNCTION
+			GFX_OS_THREAD_TRACE_FUNCTION(me, t);
+		#endif
+		// No interrupt can switch threads so it is safe to turn them on before switching
+		INTERRUPTS_ON();
+		_gfxTaskSwitch(me, t);
+		INTERRUPTS_OFF();
+	}
+}
+
+// Block the current thread on a wait queue (if any) for up to delay ticks.
+// Returns FALSE if the delay expired. Must be called with interrupts off.
+static bool_t BlockMe(threadQ *q, systemticks_t delay) {
+	thread	*me;
+
+	me = _gfxCurrentThread;
+	me->flags &= ~FLG_THD_TIMEOUT;
+	if (q) {
+		QaddPrio(q, me);
+		me->waitq = q;
+	}
+	if (!delay && !q)
+		ReadyAdd(me);				// A zero length sleep is just a yield
+	else if (delay != TIME_INFINITE)
+		SleepAdd(me, delay);
+	Reschedule();
+	return !(me->flags & FLG_THD_TIMEOUT);
+}
+
+// Make a blocked thread ready to run. Must be called with interrupts off.
+static void Wake(thread *t) {
+	if (t->waitq) {
+		Qremove(t->waitq, t);
+		t->waitq = 0;
+	}
+	if ((t->flags & FLG_THD_SLEEP))
+		SleepRemove(t);
+	ReadyAdd(t);
+}
+
+// Wake the highest priority thread on a wait queue and return it
+static thread *WakeFirst(threadQ *q) {
+	thread *	t;
+
+	t = q->head;
+	Wake(t);
+	return t;
+}
+
+// Let a higher priority ready thread run. Must be called with interrupts off.
+static void Preempt(void) {
+	if (ReadyPrio() > _gfxCurrentThread->prio) {
+		ReadyAdd(_gfxCurrentThread);
+		Reschedule();
+	}
+}
+
+// Change the priority of a thread keeping any queue it is on in order
+static void SetPrio(thread *t, threadpriority_t prio) {
+	if ((t->flags & FLG_THD_READY)) {
+		ReadyRemove(t);
+		t->prio = prio;
+		ReadyAdd(t);
+	} else if (t->waitq) {
+		Qremove(t->waitq, t);
+		t->prio = prio;
+		QaddPrio(t->waitq, t);
+	} else
+		t->prio = prio;
+}
+
+/**
+ * Priority inheritance for mutexes. The owner of a mutex runs at the priority of the
+ * highest priority thread waiting for it. Inheritance is not passed along chains of mutexes
+ * and a thread drops back to its own priority when it releases any mutex.
+ * All these routines must be called with interrupts off.
+ */
+static void InheritFromMe(thread *owner) {
+	if (owner->prio < _gfxCurrentThread->prio)
+		SetPrio(owner, _gfxCurrentThread->prio);
+}
+
+static void InheritFromWaiters(thread *owner, threadQ *q) {
+	if (q->head && owner->prio < q->head->prio)
+		SetPrio(owner, q->head->prio);
+}
+
+static void Disinherit(void) {
+	_gfxCurrentThread->prio = _gfxCurrentThread->baseprio;
+}
+
 void _gosThreadsInit(void) {
-	Qinit(&readyQ);
+	int		i;
+
+	for(i = 0; i < PRIORITIES; i++)
+		Qinit(&readyQ[i]);
+	readyMask = 0;
+	Qinit(&deadQ);
+	sleepList = 0;
+	threadCount = 1;
 
 	mainthread.next = 0;
 	mainthread.size = sizeof(thread);
 	mainthread.flags = FLG_THD_MAIN;
 	mainthread.fn = 0;
 	mainthread.param = 0;
+	mainthread.waitq = 0;
+	mainthread.waiter = 0;
+	mainthread.prio = mainthread.baseprio = NORMAL_PRIORITY;
+	#if GFX_OS_THREAD_STATS
+		mainthread.switches = mainthread.cputime = 0;
+		mainthread.runstart = STATS_CLOCK();
+		switchCount = idleTime = 0;
+	#endif
 
 	_gfxThreadsInit();
 
@@ -461,6 +787,24 @@ gfxThreadHandle gfxThreadMe(void) {
 	return (gfxThreadHandle)_gfxCurrentThread;
 }
 
+#if GFX_OS_THREAD_STATS
+	void gfxThreadGetStats(gfxThreadHandle th, gfxThreadStats *pstats) {
+		thread *	t;
+
+		INTERRUPTS_OFF();
+		if (!(t = th)) {
+			pstats->switches = switchCount;
+			pstats->cputime = idleTime;
+		} else {
+			pstats->switches = t->switches;
+			pstats->cputime = t->cputime;
+			if (t == _gfxCurrentThread)
+				pstats->cputime += STATS_CLOCK() - t->runstart;
+		}
+		INTERRUPTS_ON();
+	}
+#endif
+
 // Check if there are dead processes to deallocate
 static void cleanUpDeadThreads(void) {
 	thread *p;
@@ -470,24 +814,28 @@ static void cleanUpDeadThreads(void) {
 }
 
 void gfxYield(void) {
-	thread	*me;
-
 	// Clean up zombies
 	cleanUpDeadThreads();
 
-	// Is there another thread to run?
-	if (!readyQ.head)
-		return;
+	INTERRUPTS_OFF();
+
+	// Is there another thread of the same or higher priority to run?
+	if (sleepList)
+		SleepWake(gfxSystemTicks());
+	if (ReadyPrio() >= _gfxCurrentThread->prio) {
+		ReadyAdd(_gfxCurrentThread);
+		Reschedule();
+	}
 
-	Qadd(&readyQ, me = _gfxCurrentThread);
-	_gfxCurrentThread = Qpop(&readyQ);
-	_gfxTaskSwitch(me, _gfxCurrentThread);
+	INTERRUPTS_ON();
 }
 
 // This routine is not currently public - but it could be.
 void gfxThreadExit(threadreturn_t ret) {
 	thread	*me;
 
+	INTERRUPTS_OFF();
+
 	// Save the results in case someone is waiting
 	me = _gfxCurrentThread;
 	me->param = (void *)ret;
@@ -497,25 +845,44 @@ void gfxThreadExit(threadreturn_t ret) {
 	// If someone is waiting on the thread they will do the cleanup.
 	if ((me->flags & (FLG_THD_ALLOC|FLG_THD_WAIT)) == FLG_THD_ALLOC)
 		Qadd(&deadQ, me);
+	if (me->waiter)
+		Wake(me->waiter);
 
-	// Set the next thread. Exit if it was the last thread
-	if (!(_gfxCurrentThread = Qpop(&readyQ)))
+	// Exit if it was the last thread
+	if (!--threadCount) {
+		INTERRUPTS_ON();
 		gfxExit();
+	}
 
-	// Switch to the new thread
-	_gfxTaskSwitch(me, _gfxCurrentThread);
+	// Switch to the next thread
+	Reschedule();
 
 	// We never get back here as we didn't re-queue ourselves
 }
 
+// Every thread starts here. A new thread always runs first so the thread switching code can build its context.
+static DECLARE_THREAD_FUNCTION(ThreadStart, param) {
+	// Let our creator carry on first if it is more important than us
+	INTERRUPTS_OFF();
+	Preempt();
+	INTERRUPTS_ON();
+
+	return _gfxCurrentThread->userfn(param);
+}
+
 gfxThreadHandle gfxThreadCreate(void *stackarea, size_t stacksz, threadpriority_t prio, DECLARE_THREAD_FUNCTION((*fn),p), void *param) {
 	thread *	t;
 	thread *	me;
-	(void)		prio;
+
+	// We only have a limited number of priorities
+	if (prio < LOW_PRIORITY)
+		prio = LOW_PRIORITY;
+	else if (prio > HIGH_PRIORITY)
+		prio = HIGH_PRIORITY;
 
 	// Ensure we have a minimum stack size
-	if (stacksz < sizeof(thread)+64) {
-		stacksz = sizeof(thread)+64;
+	if (stacksz < _gfxThreadsMinStack) {
+		stacksz = _gfxThreadsMinStack;
 		stackarea = 0;
 	}
 
@@ -529,13 +896,32 @@ gfxThreadHandle gfxThreadCreate(void *stackarea, size_t stacksz, threadpriority_
 		t->flags = FLG_THD_ALLOC;
 	}
 	t->size = stacksz;
-	t->fn = fn;
+	t->fn = ThreadStart;
 	t->param = param;
+	t->userfn = fn;
+	t->waitq = 0;
+	t->waiter = 0;
+	t->prio = t->baseprio = prio;
+	#if GFX_OS_THREAD_STATS
+		t->switches = t->cputime = 0;
+	#endif
 
 	// Add the current thread to the queue because we are starting a new thread.
+	INTERRUPTS_OFF();
 	me = _gfxCurrentThread;
-	Qadd(&readyQ, me);
+	ReadyAdd(me);
 	_gfxCurrentThread = t;
+	threadCount++;
+	#if GFX_OS_THREAD_STATS
+		t->runstart = STATS_CLOCK();
+		me->cputime += t->runstart - me->runstart;
+		t->switches++;
+		switchCount++;
+	#endif
+	#ifdef GFX_OS_THREAD_TRACE_FUNCTION
+		GFX_OS_THREAD_TRACE_FUNCTION(me, t);
+	#endif
+	INTERRUPTS_ON();
 
 	_gfxStartThread(me, t);
 
@@ -545,27 +931,38 @@ gfxThreadHandle gfxThreadCreate(void *stackarea, size_t stacksz, threadpriority_
 
 threadreturn_t gfxThreadWait(gfxThreadHandle th) {
 	thread *		t;
+	threadreturn_t	ret;
 
 	t = th;
 	if (t == _gfxCurrentThread)
 		return -1;
 
+	INTERRUPTS_OFF();
+
+	// If it has already died it may be waiting for deallocation - we will do that instead
+	if ((t->flags & (FLG_THD_DEAD|FLG_THD_ALLOC|FLG_THD_WAIT)) == (FLG_THD_DEAD|FLG_THD_ALLOC))
+		Qremove(&deadQ, t);
+
 	// Mark that we are waiting
 	t->flags |= FLG_THD_WAIT;
 
 	// Wait for the thread to die
-	while(!(t->flags & FLG_THD_DEAD))
-		gfxYield();
+	if (!(t->flags & FLG_THD_DEAD)) {
+		t->waiter = _gfxCurrentThread;
+		BlockMe(0, TIME_INFINITE);
+	}
 
 	// Unmark
 	t->flags &= ~FLG_THD_WAIT;
 
-	// Clean up resources if needed
+	INTERRUPTS_ON();
+
+	// Get the status left by the dead process and clean up resources if needed
+	ret = (threadreturn_t)t->param;
 	if (t->flags & FLG_THD_ALLOC)
 		gfxFree(t);
 
-	// Return the status left by the dead process
-	return (threadreturn_t)t->param;
+	return ret;
 }
 
 #endif /* GFX_USE_OS_RAW32 */
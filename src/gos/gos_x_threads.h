@@ -18,6 +18,17 @@
  * 	You must also define the following routines in your own code so that timing functions will work...
  * 		systemticks_t gfxSystemTicks(void);
  *		systemticks_t gfxMillisecondsToTicks(delaytime_t ms);
+ *
+ *	The highest priority ready thread always runs. Threads of equal priority share the CPU when they
+ *	call gfxYield() or block. As switching is cooperative a thread made ready by an interrupt only gets
+ *	to run at the next scheduling point. Thread priorities are limited to LOW_PRIORITY to HIGH_PRIORITY.
+ *	A thread holding a mutex inherits the priority of any higher priority thread waiting for it.
+ *
+ *	Threads waiting on a semaphore, a mutex or a timeout are not scheduled until they can run.
+ *	When no thread is ready the idle function is called repeatedly (with interrupts off).
+ *	It defaults to a WFI instruction on the Cortex-M CPUs and can be replaced by defining
+ *	GFX_OS_IDLE_FUNCTION. It must return whenever an interrupt is pending. The interrupt is
+ *	serviced when the scheduler turns interrupts back on.
  */
 #ifndef _GOS_X_THREADS_H
 #define _GOS_X_THREADS_H
@@ -41,14 +52,33 @@ typedef int				threadpriority_t;
 #define NORMAL_PRIORITY				1
 #define HIGH_PRIORITY				2
 
+// A queue of threads blocked on a semaphore or mutex. The thread structure itself is private.
+struct _gfxThread;
+typedef struct _gfxThreadQ {
+	struct _gfxThread *	head;
+	struct _gfxThread *	tail;
+} _gfxThreadQ;
+
 typedef struct {
 	semcount_t		cnt;
 	semcount_t		limit;
+	_gfxThreadQ		waitq;
 } gfxSem;
 
-typedef uint32_t		gfxMutex;
+typedef struct {
+	struct _gfxThread *	owner;
+	_gfxThreadQ		waitq;
+} gfxMutex;
+
 typedef void *			gfxThreadHandle;
 
+#if GFX_OS_THREAD_STATS
+	typedef struct gfxThreadStats {
+		uint32_t		switches;			// How many times the thread has been switched to
+		uint32_t		cputime;			// The cpu time the thread has used
+	} gfxThreadStats;
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -96,6 +126,15 @@ extern "C" {
 	 */
 	void gfxThreadExit(threadreturn_t ret);
 
+	#if GFX_OS_THREAD_STATS
+		/**
+		 * Get the scheduling statistics for a thread. Passing a NULL thread gets the total number of
+		 * thread switches and the time spent idle. The cpu time is measured in microseconds when
+		 * GFX_OS_UCONTEXT is TRUE and otherwise in system ticks. The values wrap around.
+		 */
+		void gfxThreadGetStats(gfxThreadHandle thread, gfxThreadStats *pstats);
+	#endif
+
 #ifdef __cplusplus
 }
 #endif
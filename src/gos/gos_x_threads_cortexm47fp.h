@@ -15,6 +15,7 @@
 #if GFX_COMPILER == GFX_COMPILER_GCC || GFX_COMPILER == GFX_COMPILER_CYGWIN || GFX_COMPILER == GFX_COMPILER_MINGW32 || GFX_COMPILER == GFX_COMPILER_MINGW64
 	#define GFX_THREADS_DONE
 	#define _gfxThreadsInit()
+	#define _gfxThreadsIdle()	__asm__ volatile ("wfi")
 
 	static __attribute__((pcs("aapcs-vfp"),naked)) void _gfxTaskSwitch(thread *oldt, thread *newt) {
 		__asm__ volatile (	"push	{r4, r5, r6, r7, r8, r9, r10, r11, lr}	\n\t"
@@ -45,6 +46,7 @@
 #elif GFX_COMPILER == GFX_COMPILER_KEIL || GFX_COMPILER == GFX_COMPILER_ARMCC
 	#define GFX_THREADS_DONE
 	#define _gfxThreadsInit()
+	#define _gfxThreadsIdle()	__wfi()
 
 	static __asm void _gfxTaskSwitch(thread *oldt, thread *newt) {
 		PRESERVE8
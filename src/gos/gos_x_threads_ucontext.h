@@ -0,0 +1,70 @@
+/*
+ * This file is subject to the terms of the GFX License. If a copy of
+ * the license was not distributed with this file, you can obtain one at:
+ *
+ *              http://ugfx.org/license.html
+ */
+
+/**
+ * Thread Switching Functions using the POSIX ucontext functions
+ *
+ * This allows the scheduler to run as a normal process on a host operating system eg. Linux.
+ * The context is saved directly after the thread structure and is followed by the thread stack.
+ * There are no interrupts to wake up an idle scheduler so it sleeps for short periods instead.
+ */
+
+#include <ucontext.h>
+#include <time.h>
+
+#define GFX_THREADS_DONE
+
+static ucontext_t		maincxt;
+
+// The host C library needs a lot more stack than embedded code
+#define _gfxThreadsMinStack		(sizeof(thread) + 16 + sizeof(ucontext_t) + 65536)
+
+#define _gfxThreadsInit()		(mainthread.cxt = &maincxt)
+#define _gfxThreadsIdle()		_gfxUContextIdle()
+#define _gfxThreadsClock()		_gfxUContextClock()
+
+static void _gfxUContextIdle(void) {
+	struct timespec	ts;
+
+	ts.tv_sec = 0;
+	ts.tv_nsec = 100000;
+	nanosleep(&ts, 0);
+}
+
+#if GFX_OS_THREAD_STATS
+	// A microsecond clock for the thread statistics
+	static uint32_t _gfxUContextClock(void) {
+		struct timespec	ts;
+
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return (uint32_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+	}
+#endif
+
+static void _gfxTaskSwitch(thread *oldt, thread *newt) {
+	swapcontext((ucontext_t *)oldt->cxt, (ucontext_t *)newt->cxt);
+}
+
+static void _gfxUContextRun(void) {
+	// Run the users function
+	gfxThreadExit(_gfxCurrentThread->fn(_gfxCurrentThread->param));
+}
+
+static void _gfxStartThread(thread *oldt, thread *newt) {
+	ucontext_t *	uc;
+
+	// Build the new context on a 16 byte boundary after the thread structure
+	uc = (ucontext_t *)(((size_t)(newt+1) + 15) & ~(size_t)15);
+	getcontext(uc);
+	uc->uc_stack.ss_sp = uc+1;
+	uc->uc_stack.ss_size = (char *)newt + newt->size - (char *)(uc+1);
+	uc->uc_link = 0;
+	makecontext(uc, _gfxUContextRun, 0);
+	newt->cxt = uc;
+
+	swapcontext((ucontext_t *)oldt->cxt, uc);
+}
@@ -10,13 +10,13 @@
 #if GFX_USE_GQUEUE
 
 #if GQUEUE_NEED_BUFFERS
-	static gfxQueueGSync	bufferFreeList;
+	static GDataBufferPool	bufferDefaultPool;
 #endif
 
 void _gqueueInit(void)
 {
 	#if GQUEUE_NEED_BUFFERS
-		gfxQueueGSyncInit(&bufferFreeList);
+		gfxBufferPoolInit(&bufferDefaultPool, "default");
 	#endif
 }
 
@@ -429,8 +429,199 @@ void _gqueueDeinit(void)
 	}
 #endif
 
+#if GQUEUE_NEED_RING
+	/*
+	 * Each slot has a sequence number (as in Dmitry Vyukov's bounded queue).
+	 * For the put at position pos the slot is free when seq == pos. Once the item is in the
+	 * slot seq becomes pos+1 which tells the consumer it can be taken. The consumer then sets
+	 * seq to pos+num to hand the slot back for the next time around the ring.
+	 * A producer that is interrupted part way through a put therefore only holds up its own
+	 * slot - nobody ever spins waiting for it.
+	 */
+	#if defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_4)
+		#define RING_HAS_CAS		TRUE
+		#define RING_CAS(p, o, n)	__sync_bool_compare_and_swap((p), (o), (n))
+	#else
+		#define RING_HAS_CAS		FALSE
+		#define RING_CAS(p, o, n)	((*(p) == (o)) ? (*(p) = (n), TRUE) : FALSE)
+	#endif
+
+	// RING_FENCE() is a full barrier. RING_ACQUIRE() and RING_RELEASE() can be lighter if the compiler knows how.
+	#if defined(__ATOMIC_SEQ_CST)
+		#define RING_FENCE()		__atomic_thread_fence(__ATOMIC_SEQ_CST)
+		#define RING_ACQUIRE()		__atomic_thread_fence(__ATOMIC_ACQUIRE)
+		#define RING_RELEASE()		__atomic_thread_fence(__ATOMIC_RELEASE)
+	#else
+		#if RING_HAS_CAS
+			#define RING_FENCE()	__sync_synchronize()
+		#elif defined(__GNUC__)
+			#define RING_FENCE()	__asm__ __volatile__ ("" ::: "memory")
+		#else
+			#define RING_FENCE()
+		#endif
+		#define RING_ACQUIRE()		RING_FENCE()
+		#define RING_RELEASE()		RING_FENCE()
+	#endif
+
+	void gfxQueueRingInit(gfxQueueRing *pqueue, gfxQueueRingSlot *slots, unsigned num) {
+		unsigned	i;
+
+		for(i = 0; i < num; i++)
+			slots[i].seq = i;
+		pqueue->slots = slots;
+		pqueue->mask = num-1;
+		pqueue->head = pqueue->tail = 0;
+		pqueue->waiting = FALSE;
+		gfxSemInit(&pqueue->sem, 0, 1);
+	}
+	void gfxQueueRingDeinit(gfxQueueRing *pqueue) {
+		(void) pqueue;
+		gfxSemDestroy(&pqueue->sem);
+	}
+
+	void *gfxQueueRingGet(gfxQueueRing *pqueue, delaytime_t ms) {
+		void	*pitem;
+
+		while(!(pitem = gfxQueueRingGetI(pqueue))) {
+			if (ms == TIME_IMMEDIATE)
+				return 0;
+
+			// Tell the producers we want waking and then check again in case we just missed an item
+			pqueue->waiting = TRUE;
+			RING_FENCE();
+			if ((pitem = gfxQueueRingGetI(pqueue))) {
+				pqueue->waiting = FALSE;
+				break;
+			}
+			if (!gfxSemWait(&pqueue->sem, ms)) {
+				pqueue->waiting = FALSE;
+				return gfxQueueRingGetI(pqueue);
+			}
+		}
+		return pitem;
+	}
+	void *gfxQueueRingGetI(gfxQueueRing *pqueue) {
+		gfxQueueRingSlot	*ps;
+		unsigned			pos;
+		void				*pitem;
+
+		pos = pqueue->head;
+		ps = &pqueue->slots[pos & pqueue->mask];
+		if (ps->seq != pos+1)
+			return 0;
+		RING_ACQUIRE();
+		pitem = ps->item;
+		RING_RELEASE();
+		ps->seq = pos + pqueue->mask + 1;
+		pqueue->head = pos+1;
+		return pitem;
+	}
+
+	// Returns TRUE if the consumer needs waking
+	static bool_t RingPublish(gfxQueueRing *pqueue, gfxQueueRingSlot *ps, unsigned pos, void *pitem) {
+		ps->item = pitem;
+		RING_RELEASE();
+		ps->seq = pos+1;
+		RING_FENCE();
+		if (!pqueue->waiting)
+			return FALSE;
+		pqueue->waiting = FALSE;
+		return TRUE;
+	}
+
+	bool_t gfxQueueRingPut(gfxQueueRing *pqueue, void *pitem) {
+		gfxQueueRingSlot	*ps;
+		unsigned			pos;
+
+		if (!pitem) return FALSE;				// Safety
+		pos = pqueue->tail;
+		ps = &pqueue->slots[pos & pqueue->mask];
+		if (ps->seq != pos)
+			return FALSE;
+		pqueue->tail = pos+1;
+		if (RingPublish(pqueue, ps, pos, pitem))
+			gfxSemSignal(&pqueue->sem);
+		return TRUE;
+	}
+	bool_t gfxQueueRingPutI(gfxQueueRing *pqueue, void *pitem) {
+		gfxQueueRingSlot	*ps;
+		unsigned			pos;
+
+		if (!pitem) return FALSE;				// Safety
+		pos = pqueue->tail;
+		ps = &pqueue->slots[pos & pqueue->mask];
+		if (ps->seq != pos)
+			return FALSE;
+		pqueue->tail = pos+1;
+		if (RingPublish(pqueue, ps, pos, pitem))
+			gfxSemSignalI(&pqueue->sem);
+		return TRUE;
+	}
+
+	// Claim the next free slot. Returns NULL if the queue is full.
+	static gfxQueueRingSlot *RingClaim(gfxQueueRing *pqueue, unsigned *ppos) {
+		gfxQueueRingSlot	*ps;
+		unsigned			pos;
+		int					dif;
+
+		while(1) {
+			pos = pqueue->tail;
+			ps = &pqueue->slots[pos & pqueue->mask];
+			dif = (int)(ps->seq - pos);
+			if (dif < 0)
+				return 0;
+			// If someone else got in first - just try again
+			if (!dif && RING_CAS(&pqueue->tail, pos, pos+1)) {
+				*ppos = pos;
+				return ps;
+			}
+		}
+	}
+
+	bool_t gfxQueueRingPutMulti(gfxQueueRing *pqueue, void *pitem) {
+		#if RING_HAS_CAS
+			gfxQueueRingSlot	*ps;
+			unsigned			pos;
+
+			if (!pitem) return FALSE;				// Safety
+			if (!(ps = RingClaim(pqueue, &pos)))
+				return FALSE;
+			if (RingPublish(pqueue, ps, pos, pitem))
+				gfxSemSignal(&pqueue->sem);
+			return TRUE;
+		#else
+			bool_t	res;
+
+			gfxSystemLock();
+			res = gfxQueueRingPutMultiI(pqueue, pitem);
+			gfxSystemUnlock();
+			return res;
+		#endif
+	}
+	bool_t gfxQueueRingPutMultiI(gfxQueueRing *pqueue, void *pitem) {
+		gfxQueueRingSlot	*ps;
+		unsigned			pos;
+
+		if (!pitem) return FALSE;				// Safety
+		if (!(ps = RingClaim(pqueue, &pos)))
+			return FALSE;
+		if (RingPublish(pqueue, ps, pos, pitem))
+			gfxSemSignalI(&pqueue->sem);
+		return TRUE;
+	}
+#endif
+
 #if GQUEUE_NEED_BUFFERS
-	bool_t gfxBufferAlloc(unsigned num, size_t size) {
+	void gfxBufferPoolInit(GDataBufferPool *pool, const char *name) {
+		gfxQueueGSyncInit(&pool->freelist);
+		pool->name = name;
+		pool->size = 0;
+		pool->lowwater = 0;
+		pool->lowfn = 0;
+		pool->count = pool->free = pool->minfree = pool->fails = 0;
+	}
+
+	bool_t gfxBufferPoolAlloc(GDataBufferPool *pool, unsigned num, size_t size) {
 		GDataBuffer *pd;
 
 		if (num < 1)
@@ -439,25 +630,103 @@ void _gqueueDeinit(void)
 		// Round up to a multiple of 4 to prevent problems with structure alignment
 		size = (size + 3) & ~0x03;
 
+		// Named pools have a single buffer size
+		if (pool && pool->size && pool->size != size)
+			return FALSE;
+
 		// Allocate the memory
 		if (!(pd = gfxAlloc((size+sizeof(GDataBuffer)) * num)))
 			return FALSE;
 
-		// Add each of them to our free list
+		// Add each of them to the pool
 		for(;num--; pd = (GDataBuffer *)((char *)(pd+1)+size)) {
 			pd->size = size;
-			gfxBufferRelease(pd);
+			gfxBufferPoolAdd(pool, pd);
 		}
 
 		return TRUE;
 	}
 
-	void gfxBufferRelease(GDataBuffer *pd)		{ gfxQueueGSyncPut(&bufferFreeList, (gfxQueueGSyncItem *)pd); }
-	void gfxBufferReleaseI(GDataBuffer *pd)		{ gfxQueueGSyncPutI(&bufferFreeList, (gfxQueueGSyncItem *)pd); }
-	GDataBuffer *gfxBufferGet(delaytime_t ms)	{ return (GDataBuffer *)gfxQueueGSyncGet(&bufferFreeList, ms); }
-	GDataBuffer *gfxBufferGetI(void)			{ return (GDataBuffer *)gfxQueueGSyncGetI(&bufferFreeList); }
-	bool_t gfxBufferIsAvailable(void)			{ return bufferFreeList.head != 0; }
+	bool_t gfxBufferPoolAdd(GDataBufferPool *pool, GDataBuffer *pd) {
+		GDataBufferPool *pp;
+
+		pp = pool ? pool : &bufferDefaultPool;
+		if (pool) {
+			if (!pool->size)
+				pool->size = pd->size;
+			else if (pool->size > pd->size)
+				return FALSE;
+		}
+		pd->pool = pool;
+		gfxSystemLock();
+		pp->count++;
+		pp->minfree++;
+		pp->free++;
+		gfxQueueGSyncPutI(&pp->freelist, (gfxQueueGSyncItem *)pd);
+		gfxSystemUnlock();
+		return TRUE;
+	}
+
+	void gfxBufferPoolSetLowWater(GDataBufferPool *pool, unsigned lowwater, GDataBufferPoolCallback fn) {
+		if (!pool)
+			pool = &bufferDefaultPool;
+		gfxSystemLock();
+		pool->lowwater = lowwater;
+		pool->lowfn = fn;
+		gfxSystemUnlock();
+	}
+
+	bool_t gfxBufferPoolIsAvailable(GDataBufferPool *pool) {
+		return (pool ? pool : &bufferDefaultPool)->freelist.head != 0;
+	}
+
+	// Update the statistics once a buffer has been taken from the pool
+	static void BufferTakenI(GDataBufferPool *pool) {
+		if (--pool->free < pool->minfree)
+			pool->minfree = pool->free;
+		if (pool->free == pool->lowwater && pool->lowfn)
+			pool->lowfn(pool);
+	}
+
+	GDataBuffer *gfxBufferPoolGet(GDataBufferPool *pool, delaytime_t ms) {
+		GDataBuffer *pd;
+
+		if (!pool)
+			pool = &bufferDefaultPool;
+		pd = (GDataBuffer *)gfxQueueGSyncGet(&pool->freelist, ms);
+		gfxSystemLock();
+		if (pd)
+			BufferTakenI(pool);
+		else
+			pool->fails++;
+		gfxSystemUnlock();
+		return pd;
+	}
+	GDataBuffer *gfxBufferPoolGetI(GDataBufferPool *pool) {
+		GDataBuffer *pd;
+
+		if (!pool)
+			pool = &bufferDefaultPool;
+		if ((pd = (GDataBuffer *)gfxQueueGSyncGetI(&pool->freelist)))
+			BufferTakenI(pool);
+		else
+			pool->fails++;
+		return pd;
+	}
 
+	void gfxBufferRelease(GDataBuffer *pd) {
+		gfxSystemLock();
+		gfxBufferReleaseI(pd);
+		gfxSystemUnlock();
+	}
+	void gfxBufferReleaseI(GDataBuffer *pd) {
+		GDataBufferPool *pool;
+
+		// Buffers always go back to the pool they came from
+		pool = pd->pool ? pd->pool : &bufferDefaultPool;
+		pool->free++;
+		gfxQueueGSyncPutI(&pool->freelist, (gfxQueueGSyncItem *)pd);
+	}
 #endif
 
 
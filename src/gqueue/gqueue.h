@@ -24,6 +24,10 @@
  * 			optimizations. Efficiency IS important to use (particularly RAM efficiency).
  * 			In practice we only implement ASync, GSync and FSync queues as PSync queues are of dubious value.
  * 			<br>
+ * 			We also provide bounded Ring Queues. These hold pointers in a fixed array of slots rather than linking
+ * 			the items together. They never turn interrupts off on the data path which makes them suitable for
+ * 			passing data from an ISR to a thread at high rates.
+ * 			<br>
  * 			We also define GDataBuffer which is a data buffer that supports being queued.
  * @{
  */
@@ -69,6 +73,29 @@ typedef struct gfxQueueFSync {
 } gfxQueueFSync;
 /** @} */
 
+/**
+ * @brief	A ring queue slot
+ * @note	An array of these (with a power of 2 number of entries) provides the storage for a ring queue.
+ */
+typedef struct gfxQueueRingSlot {
+	volatile unsigned	seq;		// @< Hands the slot between the producers and the consumer
+	void *				item;		// @< The item in the slot
+} gfxQueueRingSlot;
+
+/**
+ * @brief	A bounded ring queue
+ */
+typedef struct gfxQueueRing {
+	gfxQueueRingSlot *	slots;		// @< The slot array
+	unsigned			mask;		// @< The number of slots - 1
+	volatile unsigned	head;		// @< The next position to get from
+	volatile unsigned	tail;		// @< The next position to put to
+	volatile bool_t		waiting;	// @< The consumer is blocked waiting for an item
+	gfxSem				sem;		// @< Used to wake the consumer
+} gfxQueueRing;
+
+struct GDataBufferPool;
+
 /**
  * @brief	A Data Buffer Queue
  * @note	This structure is followed immediately by the data itself.
@@ -76,11 +103,37 @@ typedef struct gfxQueueFSync {
  * 			at the beginning of the buffer.
  */
 typedef struct GDataBuffer {
-	gfxQueueGSyncItem	next;		// @< Used for queueing the buffers
-	size_t				size;		// @< The size of the buffer area following this structure (in bytes)
-	size_t				len;		// @< The length of the data in the buffer area (in bytes)
+	gfxQueueGSyncItem		next;		// @< Used for queueing the buffers
+	size_t					size;		// @< The size of the buffer area following this structure (in bytes)
+	size_t					len;		// @< The length of the data in the buffer area (in bytes)
+	struct GDataBufferPool	*pool;		// @< The pool the buffer belongs to (NULL for the default pool)
 } GDataBuffer;
 
+/**
+ * @brief	A low watermark callback function for a buffer pool
+ * @note	It is called in an I-class context (possibly from an ISR) so keep it short
+ */
+typedef void (*GDataBufferPoolCallback)(struct GDataBufferPool *pool);
+
+/**
+ * @brief	A pool of Data Buffers
+ * @details	Buffers always return to the pool they came from when they are released. This means a buffer
+ * 			can be handed from one user to another (eg. recorded, processed and then played) without
+ * 			copying the data.
+ * @note	The statistics fields may be read by the application at any time but should not be written.
+ */
+typedef struct GDataBufferPool {
+	gfxQueueGSync			freelist;	// @< The free buffers
+	const char *			name;		// @< The name of the pool (for debugging)
+	size_t					size;		// @< The size of each buffer in the pool (0 for mixed sizes)
+	unsigned				lowwater;	// @< The low watermark
+	GDataBufferPoolCallback	lowfn;		// @< Called when the number of free buffers drops to the low watermark
+	unsigned				count;		// @< Statistics: The number of buffers in the pool
+	unsigned				free;		// @< Statistics: The number of buffers currently free
+	unsigned				minfree;	// @< Statistics: The lowest number of free buffers seen
+	unsigned				fails;		// @< Statistics: The number of times a buffer was requested but none was free
+} GDataBufferPool;
+
 /*===========================================================================*/
 /* Function declarations.                                                    */
 /*===========================================================================*/
@@ -346,42 +399,98 @@ bool_t gfxQueueFSyncIsInI(gfxQueueFSync *pqueue, const gfxQueueFSyncItem *pitem)
 /** @} */
 
 /**
- * @name		BufferAlloc() Functions
- * @brief		Allocate some buffers and put them on the free list
- * @return		TRUE is it succeeded. FALSE on allocation failure.
+ * @name		BufferPoolInit() Functions
+ * @brief		Initialise a named buffer pool
+ *
+ * @param[in] pool	The pool to initialise
+ * @param[in] name	The name of the pool
+ *
+ * @note		The buffer size of the pool is set by the first call to @p gfxBufferPoolAlloc() or @p gfxBufferPoolAdd().
+ * 				All buffers in a named pool must then have that size.
+ * @note		Buffers allocated with @p gfxBufferAlloc() go in the default pool which allows mixed buffer sizes.
+ *
+ * @api
+ * @{
+ */
+void gfxBufferPoolInit(GDataBufferPool *pool, const char *name);
+/** @} */
+
+/**
+ * @name		BufferPoolAlloc() Functions
+ * @brief		Allocate some buffers and put them into a pool
+ * @return		TRUE is it succeeded. FALSE on allocation failure or if the size doesn't match the pool.
  *
+ * @param[in] pool	The pool. NULL means the default pool.
  * @param[in] num	The number of buffers to allocate
  * @param[in] size	The size (in bytes) of each buffer
  *
  * @api
  * @{
  */
-bool_t gfxBufferAlloc(unsigned num, size_t size);
+bool_t gfxBufferPoolAlloc(GDataBufferPool *pool, unsigned num, size_t size);
+#define gfxBufferAlloc(num, size)		gfxBufferPoolAlloc(0, (num), (size))
+/** @} */
+
+/**
+ * @name		BufferPoolAdd() Functions
+ * @brief		Add a buffer that the application has allocated itself to a pool
+ * @return		FALSE if the buffer is smaller than the buffer size of the pool
+ *
+ * @param[in] pool	The pool. NULL means the default pool.
+ * @param[in] pd	The buffer. The "size" field must be filled in first.
+ *
+ * @note		This replaces putting a new buffer onto the free-list with @p gfxBufferRelease().
+ *
+ * @api
+ * @{
+ */
+bool_t gfxBufferPoolAdd(GDataBufferPool *pool, GDataBuffer *pd);
 /** @} */
 
 /**
- * @name		BufferIsAvailable() Functions
- * @brief		Is there one or more buffers currently available on the free list
- * @return		TRUE if there are buffers in the free list
+ * @name		BufferPoolSetLowWater() Functions
+ * @brief		Set the low watermark for a pool
+ *
+ * @param[in] pool		The pool. NULL means the default pool.
+ * @param[in] lowwater	The number of free buffers that triggers the callback
+ * @param[in] fn		The callback function. It is called (in an I-class context) each time a get
+ * 						reduces the number of free buffers to the low watermark. NULL turns it off.
  *
  * @api
  * @{
  */
-bool_t gfxBufferIsAvailable(void);
+void gfxBufferPoolSetLowWater(GDataBufferPool *pool, unsigned lowwater, GDataBufferPoolCallback fn);
 /** @} */
 
 /**
- * @name		BufferGet() Functions
- * @brief		Get a buffer from the free list
+ * @name		BufferPoolIsAvailable() Functions
+ * @brief		Is there one or more buffers currently available in a pool
+ * @return		TRUE if there are free buffers in the pool
+ *
+ * @param[in] pool	The pool. NULL means the default pool.
+ *
+ * @api
+ * @{
+ */
+bool_t gfxBufferPoolIsAvailable(GDataBufferPool *pool);
+#define gfxBufferIsAvailable()			gfxBufferPoolIsAvailable(0)
+/** @} */
+
+/**
+ * @name		BufferPoolGet() Functions
+ * @brief		Get a buffer from a pool
  * @return		A GDataBuffer pointer or NULL if the timeout is exceeded
  *
+ * @param[in] pool	The pool. NULL means the default pool.
  * @param[in] ms	The maximum amount of time in milliseconds to wait for a buffer if one is not available.
  *
  * @api
  * @{
  */
-GDataBuffer *gfxBufferGet(delaytime_t ms);
-GDataBuffer *gfxBufferGetI(void);
+GDataBuffer *gfxBufferPoolGet(GDataBufferPool *pool, delaytime_t ms);
+GDataBuffer *gfxBufferPoolGetI(GDataBufferPool *pool);
+#define gfxBufferGet(ms)				gfxBufferPoolGet(0, (ms))
+#define gfxBufferGetI()					gfxBufferPoolGetI(0)
 /** @} */
 
 /**
@@ -391,9 +500,10 @@ GDataBuffer *gfxBufferGetI(void);
  * @param[in] pd		The buffer to put (back) on the free-list.
  *
  * @note		This call should be used to return any buffers that were taken from
- * 				the free-list once they have been finished with. It can also be used
- * 				to put new buffers onto the free-list. Just make sure the "size" field
- * 				of the GDataBuffer structure has been filled in first.
+ * 				the free-list once they have been finished with. The buffer always goes back
+ * 				to the pool it was allocated from.
+ * @note		It must not be used to put new buffers onto the free-list as a new buffer has no pool yet.
+ * 				Use @p gfxBufferPoolAdd() instead (with a NULL pool for the default free-list).
  *
  * @api
  * @{
@@ -402,6 +512,43 @@ void gfxBufferRelease(GDataBuffer *pd);
 void gfxBufferReleaseI(GDataBuffer *pd);
 /** @} */
 
+/**
+ * @name	Ring Queue Functions
+ * @brief	Bounded single consumer ring queues.
+ * @details	Any number of producers (threads or ISR's) can put to a ring queue but there must only be
+ * 			one consumer. Items are pointers; a NULL pointer can not be queued.
+ * @details	gfxQueueRingPut() and gfxQueueRingPutI() may only be used when there is a single producer.
+ * 			When there are multiple producers use gfxQueueRingPutMulti() and gfxQueueRingPutMultiI() instead.
+ * 			Neither the consumer nor a single producer ever turn interrupts off. Multiple producers
+ * 			claim a slot using a compare-and-swap instruction if the compiler can generate one for the
+ * 			target CPU (GCC/Clang on most 32 bit CPU's). Otherwise gfxQueueRingPutMulti() claims the slot with
+ * 			interrupts off and ISR's calling gfxQueueRingPutMultiI() on the same queue must not be able
+ * 			to interrupt each other.
+ * @note	Put operations never block. They return FALSE if the queue is full.
+ * @note	Get operations return NULL if the timeout expires before an item is available.
+ * @note	The routines ending in "I" are interrupt/system/iclass level routines.
+ *
+ * @param[in]	pqueue	A pointer to the ring queue
+ * @param[in]	slots	The slot array for the queue
+ * @param[in]	num		The number of slots. This must be a power of 2.
+ * @param[in]	pitem	The item to put
+ * @param[in]	ms		The maximum time to wait for an item
+ *
+ * @api
+ * @{
+ */
+void gfxQueueRingInit(gfxQueueRing *pqueue, gfxQueueRingSlot *slots, unsigned num);
+void gfxQueueRingDeinit(gfxQueueRing *pqueue);
+void *gfxQueueRingGet(gfxQueueRing *pqueue, delaytime_t ms);
+void *gfxQueueRingGetI(gfxQueueRing *pqueue);
+bool_t gfxQueueRingPut(gfxQueueRing *pqueue, void *pitem);
+bool_t gfxQueueRingPutI(gfxQueueRing *pqueue, void *pitem);
+bool_t gfxQueueRingPutMulti(gfxQueueRing *pqueue, void *pitem);
+bool_t gfxQueueRingPutMultiI(gfxQueueRing *pqueue, void *pitem);
+#define gfxQueueRingIsEmpty(pqueue)		((pqueue)->slots[(pqueue)->head & (pqueue)->mask].seq != (pqueue)->head+1)
+#define gfxQueueRingIsEmptyI(pqueue)	((pqueue)->slots[(pqueue)->head & (pqueue)->mask].seq != (pqueue)->head+1)
+/** @} */
+
 
 #ifdef __cplusplus
 }
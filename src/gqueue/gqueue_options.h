@@ -47,6 +47,13 @@
 	#ifndef GQUEUE_NEED_BUFFERS
 		#define GQUEUE_NEED_BUFFERS		FALSE
 	#endif
+	/**
+	 * @brief	Enable bounded Ring Queues
+	 * @details	Defaults to FALSE
+	 */
+	#ifndef GQUEUE_NEED_RING
+		#define GQUEUE_NEED_RING		FALSE
+	#endif
 /**
  * @}
  *
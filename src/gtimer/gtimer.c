@@ -13,6 +13,13 @@
 #define GTIMER_FLG_INFINITE		0x0002
 #define GTIMER_FLG_JABBED		0x0004
 #define GTIMER_FLG_SCHEDULED	0x0008
+#define GTIMER_FLG_HIRES		0x0010
+
+#if GTIMER_NEED_HIRES && !GOS_HAS_MICROSECONDS
+	// Fall back to the system tick. The unsigned arithmetic still wraps correctly.
+	#define gfxSystemMicroseconds()				((uint32_t)gfxSystemTicks() * (uint32_t)(1000000 / gfxMillisecondsToTicks(1000)))
+	#define gfxSemWaitMicroseconds(psem, us)	gfxSemWait((psem), ((us)+999)/1000)
+#endif
 
 /* Don't rework this macro to use a ternary operator - the gcc compiler stuffs it up */
 #define TimeIsWithin(x, start, end)	((end >= start && x >= start && x <= end) || (end < start && (x >= start || x <= end)))
@@ -29,6 +36,80 @@ static DECLARE_THREAD_STACK(waTimerThread, GTIMER_THREAD_WORKAREA_SIZE);
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+/* Take a timer off the timers list */
+/* We already have the mutex */
+static void timerUnlink(GTimer *pt) {
+	if (pt->next == pt)
+		pTimerHead = 0;
+	else {
+		pt->next->prev = pt->prev;
+		pt->prev->next = pt->next;
+		if (pTimerHead == pt)
+			pTimerHead = pt->next;
+	}
+}
+
+#if GTIMER_NEED_HIRES
+	#define NO_HIRES_TIMEOUT	((uint32_t)-1)
+
+	/* Find the high resolution timer to run next - the one whose deadline passed the longest time ago */
+	/* If none are due *pnxt is set to the microseconds until the next one is */
+	/* We already have the mutex */
+	static GTimer *hiresNext(uint32_t now, uint32_t *pnxt) {
+		GTimer		*pt, *pdue;
+		int32_t		late, duelate;
+
+		pdue = 0;
+		duelate = 0;
+		*pnxt = NO_HIRES_TIMEOUT;
+		if (!(pt = pTimerHead))
+			return 0;
+		do {
+			if ((pt->flags & GTIMER_FLG_HIRES)) {
+				late = (int32_t)(now - pt->uwhen);
+				if (late >= 0 || (pt->flags & GTIMER_FLG_JABBED)) {
+					if (!pdue || late > duelate) {
+						pdue = pt;
+						duelate = late;
+					}
+				} else if ((uint32_t)-late < *pnxt)
+					*pnxt = (uint32_t)-late;
+			}
+			pt = pt->next;
+		} while(pt != pTimerHead);
+		return pdue;
+	}
+
+	/* Update a high resolution timer that is about to be called */
+	/* We already have the mutex */
+	static void hiresFired(GTimer *pt, uint32_t now) {
+		uint32_t	late;
+
+		// Record how late we are unless it has been jabbed early
+		late = now - pt->uwhen;
+		if ((int32_t)late >= 0) {
+			pt->late = late;
+			if (late > pt->maxlate)
+				pt->maxlate = late;
+		}
+
+		// Is this timer periodic?
+		if ((pt->flags & GTIMER_FLG_PERIODIC) && pt->uperiod) {
+			// Yes - The next deadline is relative to the last one so we don't drift.
+			//	Skip any periods we have missed completely.
+			if ((int32_t)late >= 0)
+				pt->uwhen += (late / pt->uperiod + 1) * pt->uperiod;
+
+			// We are definitely no longer jabbed
+			pt->flags &= ~GTIMER_FLG_JABBED;
+		} else {
+			// No - get us off the timers list
+			timerUnlink(pt);
+			pt->flags = 0;
+		}
+	}
+#endif
+
 static DECLARE_THREAD_FUNCTION(GTimerThreadHandler, arg) {
 	GTimer			*pt;
 	systemticks_t	tm;
@@ -36,13 +117,28 @@ static DECLARE_THREAD_FUNCTION(GTimerThreadHandler, arg) {
 	systemticks_t	lastTime;
 	GTimerFunction	fn;
 	void			*param;
+	#if GTIMER_NEED_HIRES
+		uint32_t	now;
+		uint32_t	nxtMicro;
+	#endif
 	(void)			arg;
 
 	nxtTimeout = TIME_INFINITE;
 	lastTime = 0;
+	#if GTIMER_NEED_HIRES
+		nxtMicro = NO_HIRES_TIMEOUT;
+	#endif
 	while(1) {
 		/* Wait for work to do. */
 		gfxYield();					// Give someone else a go no matter how busy we are
+		#if GTIMER_NEED_HIRES
+			// Sleep exactly until the next high resolution deadline (if that is sooner than the normal timers)
+			if (nxtMicro != NO_HIRES_TIMEOUT) {
+				if (nxtTimeout != TIME_INFINITE && nxtTimeout < nxtMicro / 1000)
+					nxtMicro = nxtTimeout * 1000;
+				gfxSemWaitMicroseconds(&waitsem, nxtMicro);
+			} else
+		#endif
 		gfxSemWait(&waitsem, nxtTimeout);
 		
 	restartTimerChecks:
@@ -54,9 +150,32 @@ static DECLARE_THREAD_FUNCTION(GTimerThreadHandler, arg) {
 		/* We need to obtain the mutex */
 		gfxMutexEnter(&mutex);
 
+		#if GTIMER_NEED_HIRES
+			// High resolution timers take precedence
+			now = gfxSystemMicroseconds();
+			if ((pt = hiresNext(now, &nxtMicro))) {
+				hiresFired(pt, now);
+
+				// Call the callback function
+				fn = pt->fn;
+				param = pt->param;
+				gfxMutexExit(&mutex);
+				fn(param);
+				goto restartTimerChecks;
+			}
+		#endif
+
 		if (pTimerHead) {
 			pt = pTimerHead;
 			do {
+				#if GTIMER_NEED_HIRES
+					// High resolution timers have already been handled
+					if ((pt->flags & GTIMER_FLG_HIRES)) {
+						pt = pt->next;
+						continue;
+					}
+				#endif
+
 				// Do we have something to do for this timer?
 				if ((pt->flags & GTIMER_FLG_JABBED) || (!(pt->flags & GTIMER_FLG_INFINITE) && TimeIsWithin(pt->when, lastTime, tm))) {
 				
@@ -76,14 +195,7 @@ static DECLARE_THREAD_FUNCTION(GTimerThreadHandler, arg) {
 						
 					} else {
 						// No - get us off the timers list
-						if (pt->next == pt)
-							pTimerHead = 0;
-						else {
-							pt->next->prev = pt->prev;
-							pt->prev->next = pt->next;
-							if (pTimerHead == pt)
-								pTimerHead = pt->next;
-						}
+						timerUnlink(pt);
 						pt->flags = 0;
 					}
 					
@@ -112,6 +224,25 @@ static DECLARE_THREAD_FUNCTION(GTimerThreadHandler, arg) {
 	THREAD_RETURN(0);
 }
 
+/* Start the timer thread (if needed) and put a timer on the end of the timers list */
+/* We already have the mutex */
+static void timerLink(GTimer *pt) {
+	// Start our thread if not already going
+	if (!hThread) {
+		hThread = gfxThreadCreate(waTimerThread, GTIMER_THREAD_WORKAREA_SIZE, GTIMER_THREAD_PRIORITY, GTimerThreadHandler, 0);
+		if (hThread) {gfxThreadClose(hThread);}		// We never really need the handle again
+	}
+
+	// Just pop it on the end of the queue
+	if (pTimerHead) {
+		pt->next = pTimerHead;
+		pt->prev = pTimerHead->prev;
+		pt->prev->next = pt;
+		pt->next->prev = pt;
+	} else
+		pt->next = pt->prev = pTimerHead = pt;
+}
+
 void _gtimerInit(void)
 {
 	gfxSemInit(&waitsem, 0, 1);
@@ -139,23 +270,10 @@ void gtimerDeinit(GTimer* pt)
 void gtimerStart(GTimer *pt, GTimerFunction fn, void *param, bool_t periodic, delaytime_t millisec) {
 	gfxMutexEnter(&mutex);
 	
-	// Start our thread if not already going
-	if (!hThread) {
-		hThread = gfxThreadCreate(waTimerThread, GTIMER_THREAD_WORKAREA_SIZE, GTIMER_THREAD_PRIORITY, GTimerThreadHandler, 0);
-		if (hThread) {gfxThreadClose(hThread);}		// We never really need the handle again
-	}
-
 	// Is this already scheduled?
 	if (pt->flags & GTIMER_FLG_SCHEDULED) {
 		// Cancel it!
-		if (pt->next == pt)
-			pTimerHead = 0;
-		else {
-			pt->next->prev = pt->prev;
-			pt->prev->next = pt->next;
-			if (pTimerHead == pt)
-				pTimerHead = pt->next;
-		}
+		timerUnlink(pt);
 	}
 	
 	// Set up the timer structure
@@ -173,13 +291,7 @@ void gtimerStart(GTimer *pt, GTimerFunction fn, void *param, bool_t periodic, de
 	}
 
 	// Just pop it on the end of the queue
-	if (pTimerHead) {
-		pt->next = pTimerHead;
-		pt->prev = pTimerHead->prev;
-		pt->prev->next = pt;
-		pt->next->prev = pt;
-	} else
-		pt->next = pt->prev = pTimerHead = pt;
+	timerLink(pt);
 
 	// Bump the thread
 	if (!(pt->flags & GTIMER_FLG_INFINITE))
@@ -187,18 +299,40 @@ void gtimerStart(GTimer *pt, GTimerFunction fn, void *param, bool_t periodic, de
 	gfxMutexExit(&mutex);
 }
 
+#if GTIMER_NEED_HIRES
+	void gtimerStartMicro(GTimer *pt, GTimerFunction fn, void *param, bool_t periodic, uint32_t microsec) {
+		gfxMutexEnter(&mutex);
+
+		// Is this already scheduled?
+		if (pt->flags & GTIMER_FLG_SCHEDULED) {
+			// Cancel it!
+			timerUnlink(pt);
+		}
+
+		// Set up the timer structure
+		pt->fn = fn;
+		pt->param = param;
+		pt->flags = GTIMER_FLG_SCHEDULED|GTIMER_FLG_HIRES;
+		if (periodic)
+			pt->flags |= GTIMER_FLG_PERIODIC;
+		pt->uperiod = microsec;
+		pt->uwhen = gfxSystemMicroseconds() + microsec;
+		pt->late = pt->maxlate = 0;
+
+		// Just pop it on the end of the queue
+		timerLink(pt);
+
+		// Bump the thread
+		gfxSemSignal(&waitsem);
+		gfxMutexExit(&mutex);
+	}
+#endif
+
 void gtimerStop(GTimer *pt) {
 	gfxMutexEnter(&mutex);
 	if (pt->flags & GTIMER_FLG_SCHEDULED) {
 		// Cancel it!
-		if (pt->next == pt)
-			pTimerHead = 0;
-		else {
-			pt->next->prev = pt->prev;
-			pt->prev->next = pt->next;
-			if (pTimerHead == pt)
-				pTimerHead = pt->next;
-		}
+		timerUnlink(pt);
 		// Make sure we know the structure is dead!
 		pt->flags = 0;
 	}
@@ -38,7 +38,11 @@
 /*===========================================================================*/
 
 /* Data part of a static GTimer initialiser */
-#define _GTIMER_DATA() {0,0,0,0,0,0,0}
+#if GTIMER_NEED_HIRES
+	#define _GTIMER_DATA() {0,0,0,0,0,0,0,0,0,0,0}
+#else
+	#define _GTIMER_DATA() {0,0,0,0,0,0,0}
+#endif
 
 /* Static GTimer initialiser */
 #define GTIMER_DECL(name) GTimer name = _GTIMER_DATA()
@@ -57,6 +61,12 @@ typedef struct GTimer_t {
 	uint16_t			flags;
 	struct GTimer_t		*next;
 	struct GTimer_t		*prev;
+	#if GTIMER_NEED_HIRES || defined(__DOXYGEN__)
+		uint32_t		uwhen;			// @< Private: When a high resolution timer is next due (microseconds)
+		uint32_t		uperiod;		// @< Private: The high resolution timer period (microseconds)
+		uint32_t		late;			// @< How late (in microseconds) the last high resolution callback was
+		uint32_t		maxlate;		// @< The latest (in microseconds) any high resolution callback has been
+	#endif
 } GTimer;
 
 /*===========================================================================*/
@@ -116,6 +126,35 @@ void gtimerDeinit(GTimer* pt);
  */
 void gtimerStart(GTimer *pt, GTimerFunction fn, void *param, bool_t periodic, delaytime_t millisec);
 
+#if GTIMER_NEED_HIRES || defined(__DOXYGEN__)
+	/**
+	 * @brief   Set a high resolution timer going or alter its properties if it is already going.
+	 *
+	 * @param[in] pt		Pointer to a GTimer structure
+	 * @param[in] fn		The callback function
+	 * @param[in] param		The parameter to pass to the callback function
+	 * @param[in] periodic	Is the timer a periodic timer? FALSE is a once-only timer.
+	 * @param[in] microsec	The timer period in microseconds. 0 causes the callback function to be called asap.
+	 *						A periodic timer with this value will fire once only.
+	 *
+	 * @pre					GTIMER_NEED_HIRES must be TRUE in your gfxconf.h
+	 *
+	 * @note				This is the same as gtimerStart() except for the units of the period.
+	 * 						The period must be less than 2^31 microseconds (about 35 minutes).
+	 * @note				The deadlines of a periodic timer don't drift. If the callback is late the next
+	 * 						deadline is still one period after the previous deadline. Whole periods that are
+	 * 						missed completely are skipped.
+	 * @note				High resolution timers that are due are called before normal timers.
+	 * 						If several are due they are called in the order of their deadlines.
+	 * @note				Each time the callback function is called the GTimer late field is set to how many
+	 * 						microseconds after the deadline the callback was called and the maxlate field records
+	 * 						the largest value seen. The application may reset maxlate to 0 at any time.
+	 *
+	 * @api
+	 */
+	void gtimerStartMicro(GTimer *pt, GTimerFunction fn, void *param, bool_t periodic, uint32_t microsec);
+#endif
+
 /**
  * @brief   Stop a timer (periodic or otherwise)
  *
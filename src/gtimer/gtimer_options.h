@@ -20,6 +20,18 @@
  * @name    GTIMER Functionality to be included
  * @{
  */
+	/**
+	 * @brief	Should high resolution (microsecond) timers be included.
+	 * @details	Defaults to FALSE
+	 * @note	This adds gtimerStartMicro(). The timer thread then sleeps exactly until the
+	 * 			next high resolution timer is due rather than to the nearest system tick.
+	 * @note	The operating system port should provide gfxSystemMicroseconds() and gfxSemWaitMicroseconds()
+	 * 			(and define GOS_HAS_MICROSECONDS). If it doesn't the system tick is used instead and
+	 * 			the timers are only as accurate as the tick.
+	 */
+	#ifndef GTIMER_NEED_HIRES
+		#define GTIMER_NEED_HIRES				FALSE
+	#endif
 /**
  * @}
  *
@@ -95,6 +95,10 @@ GHandle _gwindowCreate(GDisplay *g, GWindowObject *pgw, const GWindowInit *pInit
 	
 	// Initialise all basic fields
 	pgw->display = g;
+	#if (GWIN_NEED_WINDOWMANAGER && GWIN_NEED_COMPOSITOR) || (GWIN_NEED_WIDGET && GWIN_WIDGET_CACHE)
+		pgw->drawdisplay = 0;
+		pgw->drawdx = pgw->drawdy = 0;
+	#endif
 	pgw->vmt = vmt;
 	pgw->color = defaultFgColor;
 	pgw->bgcolor = defaultBgColor;
@@ -230,7 +234,7 @@ void gwinClear(GHandle gh) {
 	 * need this to clear internal buffers or similar
 	 */
 	if (_gwinDrawStart(gh)) {
-		gdispGFillArea(gh->display, gh->x, gh->y, gh->width, gh->height, gh->bgcolor);
+		gdispGFillArea(gwinGetDrawDisplay(gh), gwinGetDrawX(gh), gwinGetDrawY(gh), gh->width, gh->height, gh->bgcolor);
 		_gwinDrawEnd(gh);
 	}
 	if (gh->vmt->AfterClear)
@@ -239,44 +243,44 @@ void gwinClear(GHandle gh) {
 
 void gwinDrawPixel(GHandle gh, coord_t x, coord_t y) {
 	if (!_gwinDrawStart(gh)) return;
-	gdispGDrawPixel(gh->display, gh->x+x, gh->y+y, gh->color);
+	gdispGDrawPixel(gwinGetDrawDisplay(gh), gwinGetDrawX(gh)+x, gwinGetDrawY(gh)+y, gh->color);
 	_gwinDrawEnd(gh);
 }
 
 void gwinDrawLine(GHandle gh, coord_t x0, coord_t y0, coord_t x1, coord_t y1) {
 	if (!_gwinDrawStart(gh)) return;
-	gdispGDrawLine(gh->display, gh->x+x0, gh->y+y0, gh->x+x1, gh->y+y1, gh->color);
+	gdispGDrawLine(gwinGetDrawDisplay(gh), gwinGetDrawX(gh)+x0, gwinGetDrawY(gh)+y0, gwinGetDrawX(gh)+x1, gwinGetDrawY(gh)+y1, gh->color);
 	_gwinDrawEnd(gh);
 }
 
 void gwinDrawBox(GHandle gh, coord_t x, coord_t y, coord_t cx, coord_t cy) {
 	if (!_gwinDrawStart(gh)) return;
-	gdispGDrawBox(gh->display, gh->x+x, gh->y+y, cx, cy, gh->color);
+	gdispGDrawBox(gwinGetDrawDisplay(gh), gwinGetDrawX(gh)+x, gwinGetDrawY(gh)+y, cx, cy, gh->color);
 	_gwinDrawEnd(gh);
 }
 
 void gwinFillArea(GHandle gh, coord_t x, coord_t y, coord_t cx, coord_t cy) {
 	if (!_gwinDrawStart(gh)) return;
-	gdispGFillArea(gh->display, gh->x+x, gh->y+y, cx, cy, gh->color);
+	gdispGFillArea(gwinGetDrawDisplay(gh), gwinGetDrawX(gh)+x, gwinGetDrawY(gh)+y, cx, cy, gh->color);
 	_gwinDrawEnd(gh);
 }
 
 void gwinBlitArea(GHandle gh, coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t srcx, coord_t srcy, coord_t srccx, const pixel_t *buffer) {
 	if (!_gwinDrawStart(gh)) return;
-	gdispGBlitArea(gh->display, gh->x+x, gh->y+y, cx, cy, srcx, srcy, srccx, buffer);
+	gdispGBlitArea(gwinGetDrawDisplay(gh), gwinGetDrawX(gh)+x, gwinGetDrawY(gh)+y, cx, cy, srcx, srcy, srccx, buffer);
 	_gwinDrawEnd(gh);
 }
 
 #if GDISP_NEED_CIRCLE
 	void gwinDrawCircle(GHandle gh, coord_t x, coord_t y, coord_t radius) {
 		if (!_gwinDrawStart(gh)) return;
-		gdispGDrawCircle(gh->display, gh->x+x, gh->y+y, radius, gh->color);
+		gdispGDrawCircle(gwinGetDrawDisplay(gh), gwinGetDrawX(gh)+x, gwinGetDrawY(gh)+y, radius, gh->color);
 		_gwinDrawEnd(gh);
 	}
 
 	void gwinFillCircle(GHandle gh, coord_t x, coord_t y, coord_t radius) {
 		if (!_gwinDrawStart(gh)) return;
-		gdispGFillCircle(gh->display, gh->x+x, gh->y+y, radius, gh->color);
+		gdispGFillCircle(gwinGetDrawDisplay(gh), gwinGetDrawX(gh)+x, gwinGetDrawY(gh)+y, radius, gh->color);
 		_gwinDrawEnd(gh);
 	}
 #endif
@@ -284,7 +288,7 @@ void gwinBlitArea(GHandle gh, coord_t x, coord_t y, coord_t cx, coord_t cy, coor
 #if GDISP_NEED_DUALCIRCLE
 	void gwinFillDualCircle(GHandle gh, coord_t x, coord_t y, coord_t radius1, coord_t radius2) {
 		if (!_gwinDrawStart(gh)) return;
-		gdispGFillDualCircle(gh->display, gh->x+x, gh->y+y, radius1, gh->bgcolor, radius2, gh->color);
+		gdispGFillDualCircle(gwinGetDrawDisplay(gh), gwinGetDrawX(gh)+x, gwinGetDrawY(gh)+y, radius1, gh->bgcolor, radius2, gh->color);
 		_gwinDrawEnd(gh);
 	}
 #endif
@@ -292,13 +296,13 @@ void gwinBlitArea(GHandle gh, coord_t x, coord_t y, coord_t cx, coord_t cy, coor
 #if GDISP_NEED_ELLIPSE
 	void gwinDrawEllipse(GHandle gh, coord_t x, coord_t y, coord_t a, coord_t b) {
 		if (!_gwinDrawStart(gh)) return;
-		gdispGDrawEllipse(gh->display, gh->x+x, gh->y+y, a, b, gh->color);
+		gdispGDrawEllipse(gwinGetDrawDisplay(gh), gwinGetDrawX(gh)+x, gwinGetDrawY(gh)+y, a, b, gh->color);
 		_gwinDrawEnd(gh);
 	}
 
 	void gwinFillEllipse(GHandle gh, coord_t x, coord_t y, coord_t a, coord_t b) {
 		if (!_gwinDrawStart(gh)) return;
-		gdispGFillEllipse(gh->display, gh->x+x, gh->y+y, a, b, gh->color);
+		gdispGFillEllipse(gwinGetDrawDisplay(gh), gwinGetDrawX(gh)+x, gwinGetDrawY(gh)+y, a, b, gh->color);
 		_gwinDrawEnd(gh);
 	}
 #endif
@@ -306,19 +310,19 @@ void gwinBlitArea(GHandle gh, coord_t x, coord_t y, coord_t cx, coord_t cy, coor
 #if GDISP_NEED_ARC
 	void gwinDrawArc(GHandle gh, coord_t x, coord_t y, coord_t radius, coord_t startangle, coord_t endangle) {
 		if (!_gwinDrawStart(gh)) return;
-		gdispGDrawArc(gh->display, gh->x+x, gh->y+y, radius, startangle, endangle, gh->color);
+		gdispGDrawArc(gwinGetDrawDisplay(gh), gwinGetDrawX(gh)+x, gwinGetDrawY(gh)+y, radius, startangle, endangle, gh->color);
 		_gwinDrawEnd(gh);
 	}
 
 	void gwinFillArc(GHandle gh, coord_t x, coord_t y, coord_t radius, coord_t startangle, coord_t endangle) {
 		if (!_gwinDrawStart(gh)) return;
-		gdispGFillArc(gh->display, gh->x+x, gh->y+y, radius, startangle, endangle, gh->color);
+		gdispGFillArc(gwinGetDrawDisplay(gh), gwinGetDrawX(gh)+x, gwinGetDrawY(gh)+y, radius, startangle, endangle, gh->color);
 		_gwinDrawEnd(gh);
 	}
 
 	void gwinDrawThickArc(GHandle gh, coord_t x, coord_t y, coord_t startradius, coord_t endradius, coord_t startangle, coord_t endangle) {
 		if (!_gwinDrawStart(gh)) return;
-		gdispGDrawThickArc(gh->display, gh->x+x, gh->y+y, startradius, endradius, startangle, endangle, gh->color);
+		gdispGDrawThickArc(gwinGetDrawDisplay(gh), gwinGetDrawX(gh)+x, gwinGetDrawY(gh)+y, startradius, endradius, startangle, endangle, gh->color);
 		_gwinDrawEnd(gh);
 	}
 #endif
@@ -326,13 +330,13 @@ void gwinBlitArea(GHandle gh, coord_t x, coord_t y, coord_t cx, coord_t cy, coor
 #if GDISP_NEED_ARCSECTORS
 	void gwinDrawArcSectors(GHandle gh, coord_t x, coord_t y, coord_t radius, uint8_t sectors) {
 		if (!_gwinDrawStart(gh)) return;
-		gdispGDrawArcSectors(gh->display, gh->x+x, gh->y+y, radius, sectors, gh->color);
+		gdispGDrawArcSectors(gwinGetDrawDisplay(gh), gwinGetDrawX(gh)+x, gwinGetDrawY(gh)+y, radius, sectors, gh->color);
 		_gwinDrawEnd(gh);
 	}
 
 	void gwinFillArcSectors(GHandle gh, coord_t x, coord_t y, coord_t radius, uint8_t sectors) {
 		if (!_gwinDrawStart(gh)) return;
-		gdispGFillArcSectors(gh->display, gh->x+x, gh->y+y, radius, sectors, gh->color);
+		gdispGFillArcSectors(gwinGetDrawDisplay(gh), gwinGetDrawX(gh)+x, gwinGetDrawY(gh)+y, radius, sectors, gh->color);
 		_gwinDrawEnd(gh);
 	}
 #endif
@@ -340,7 +344,7 @@ void gwinBlitArea(GHandle gh, coord_t x, coord_t y, coord_t cx, coord_t cy, coor
 #if GDISP_NEED_PIXELREAD
 	color_t gwinGetPixelColor(GHandle gh, coord_t x, coord_t y) {
 		if (!_gwinDrawStart(gh)) return (color_t)0;
-		return gdispGGetPixelColor(gh->display, gh->x+x, gh->y+y);
+		return gdispGGetPixelColor(gwinGetDrawDisplay(gh), gwinGetDrawX(gh)+x, gwinGetDrawY(gh)+y);
 		_gwinDrawEnd(gh);
 	}
 #endif
@@ -348,37 +352,37 @@ void gwinBlitArea(GHandle gh, coord_t x, coord_t y, coord_t cx, coord_t cy, coor
 #if GDISP_NEED_TEXT
 	void gwinDrawChar(GHandle gh, coord_t x, coord_t y, char c) {
 		if (!gh->font || !_gwinDrawStart(gh)) return;
-		gdispGDrawChar(gh->display, gh->x+x, gh->y+y, c, gh->font, gh->color);
+		gdispGDrawChar(gwinGetDrawDisplay(gh), gwinGetDrawX(gh)+x, gwinGetDrawY(gh)+y, c, gh->font, gh->color);
 		_gwinDrawEnd(gh);
 	}
 
 	void gwinFillChar(GHandle gh, coord_t x, coord_t y, char c) {
 		if (!gh->font || !_gwinDrawStart(gh)) return;
-		gdispGFillChar(gh->display, gh->x+x, gh->y+y, c, gh->font, gh->color, gh->bgcolor);
+		gdispGFillChar(gwinGetDrawDisplay(gh), gwinGetDrawX(gh)+x, gwinGetDrawY(gh)+y, c, gh->font, gh->color, gh->bgcolor);
 		_gwinDrawEnd(gh);
 	}
 
 	void gwinDrawString(GHandle gh, coord_t x, coord_t y, const char *str) {
 		if (!gh->font || !_gwinDrawStart(gh)) return;
-		gdispGDrawString(gh->display, gh->x+x, gh->y+y, str, gh->font, gh->color);
+		gdispGDrawString(gwinGetDrawDisplay(gh), gwinGetDrawX(gh)+x, gwinGetDrawY(gh)+y, str, gh->font, gh->color);
 		_gwinDrawEnd(gh);
 	}
 
 	void gwinFillString(GHandle gh, coord_t x, coord_t y, const char *str) {
 		if (!gh->font || !_gwinDrawStart(gh)) return;
-		gdispGFillString(gh->display, gh->x+x, gh->y+y, str, gh->font, gh->color, gh->bgcolor);
+		gdispGFillString(gwinGetDrawDisplay(gh), gwinGetDrawX(gh)+x, gwinGetDrawY(gh)+y, str, gh->font, gh->color, gh->bgcolor);
 		_gwinDrawEnd(gh);
 	}
 
 	void gwinDrawStringBox(GHandle gh, coord_t x, coord_t y, coord_t cx, coord_t cy, const char* str, justify_t justify) {
 		if (!gh->font || !_gwinDrawStart(gh)) return;
-		gdispGDrawStringBox(gh->display, gh->x+x, gh->y+y, cx, cy, str, gh->font, gh->color, justify);
+		gdispGDrawStringBox(gwinGetDrawDisplay(gh), gwinGetDrawX(gh)+x, gwinGetDrawY(gh)+y, cx, cy, str, gh->font, gh->color, justify);
 		_gwinDrawEnd(gh);
 	}
 
 	void gwinFillStringBox(GHandle gh, coord_t x, coord_t y, coord_t cx, coord_t cy, const char* str, justify_t justify) {
 		if (!gh->font || !_gwinDrawStart(gh)) return;
-		gdispGFillStringBox(gh->display, gh->x+x, gh->y+y, cx, cy, str, gh->font, gh->color, gh->bgcolor, justify);
+		gdispGFillStringBox(gwinGetDrawDisplay(gh), gwinGetDrawX(gh)+x, gwinGetDrawY(gh)+y, cx, cy, str, gh->font, gh->color, gh->bgcolor, justify);
 		_gwinDrawEnd(gh);
 	}
 #endif
@@ -386,18 +390,18 @@ void gwinBlitArea(GHandle gh, coord_t x, coord_t y, coord_t cx, coord_t cy, coor
 #if GDISP_NEED_CONVEX_POLYGON
 	void gwinDrawPoly(GHandle gh, coord_t tx, coord_t ty, const point *pntarray, unsigned cnt) {
 		if (!_gwinDrawStart(gh)) return;
-		gdispGDrawPoly(gh->display, tx+gh->x, ty+gh->y, pntarray, cnt, gh->color);
+		gdispGDrawPoly(gwinGetDrawDisplay(gh), tx+gwinGetDrawX(gh), ty+gwinGetDrawY(gh), pntarray, cnt, gh->color);
 		_gwinDrawEnd(gh);
 	}
 
 	void gwinFillConvexPoly(GHandle gh, coord_t tx, coord_t ty, const point *pntarray, unsigned cnt) {
 		if (!_gwinDrawStart(gh)) return;
-		gdispGFillConvexPoly(gh->display, tx+gh->x, ty+gh->y, pntarray, cnt, gh->color);
+		gdispGFillConvexPoly(gwinGetDrawDisplay(gh), tx+gwinGetDrawX(gh), ty+gwinGetDrawY(gh), pntarray, cnt, gh->color);
 		_gwinDrawEnd(gh);
 	}
 	void gwinDrawThickLine(GHandle gh, coord_t x0, coord_t y0, coord_t x1, coord_t y1, coord_t width, bool_t round) {
 		if (!_gwinDrawStart(gh)) return;
-		gdispGDrawThickLine(gh->display, gh->x+x0, gh->y+y0, gh->x+x1, gh->y+y1, gh->color, width, round);
+		gdispGDrawThickLine(gwinGetDrawDisplay(gh), gwinGetDrawX(gh)+x0, gwinGetDrawY(gh)+y0, gwinGetDrawX(gh)+x1, gwinGetDrawY(gh)+y1, gh->color, width, round);
 		_gwinDrawEnd(gh);
 	}
 #endif
@@ -407,7 +411,7 @@ void gwinBlitArea(GHandle gh, coord_t x, coord_t y, coord_t cx, coord_t cy, coor
 		gdispImageError		ret;
 
 		if (!_gwinDrawStart(gh)) return GDISP_IMAGE_ERR_OK;
-		ret = gdispGImageDraw(gh->display, img, gh->x+x, gh->y+y, cx, cy, sx, sy);
+		ret = gdispGImageDraw(gwinGetDrawDisplay(gh), img, gwinGetDrawX(gh)+x, gwinGetDrawY(gh)+y, cx, cy, sx, sy);
 		_gwinDrawEnd(gh);
 		return ret;
 	}
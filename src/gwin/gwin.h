@@ -57,6 +57,23 @@ typedef struct GWindowObject {
 	#if GWIN_NEED_CONTAINERS
 		GHandle				parent;				/**< The parent window */
 	#endif
+	#if GWIN_NEED_WINDOWMANAGER
+		coord_t				dirtyx, dirtyy;		/**< The top left of the area waiting to be redrawn (relative to the window) */
+		coord_t				dirtycx, dirtycy;	/**< The size of the area waiting to be redrawn. A width of 0 means the whole window. */
+	#endif
+	#if GWIN_NEED_WINDOWMANAGER && GWIN_NEED_SPATIAL_INDEX
+		uint32_t			zorder;				/**< The z-order of the window in the spatial index (higher is on top) */
+		uint16_t			icx0, icy0;			/**< The first spatial index cell covered by this window */
+		uint16_t			icx1, icy1;			/**< The last spatial index cell covered by this window */
+	#endif
+	#if GWIN_NEED_WINDOWMANAGER && GWIN_NEED_COMPOSITOR
+		GDisplay *			backbuf;			/**< The pixmap a top level window is drawn into by the compositing window manager */
+		uint8_t				opacity;			/**< The opacity of a top level window (255 is opaque) */
+	#endif
+	#if (GWIN_NEED_WINDOWMANAGER && GWIN_NEED_COMPOSITOR) || (GWIN_NEED_WIDGET && GWIN_WIDGET_CACHE)
+		GDisplay *			drawdisplay;		/**< Where the window is currently being drawn (NULL for its own display) */
+		coord_t				drawdx, drawdy;		/**< The position of @p drawdisplay on the screen */
+	#endif
 } GWindowObject, * GHandle;
 /** @} */
 
@@ -116,6 +133,46 @@ extern "C" {
 	 * @api
 	 */
 	void gwinSetWindowManager(struct GWindowManager *gwm);
+
+	#if GWIN_NEED_COMPOSITOR || defined(__DOXYGEN__)
+		/**
+		 * @brief	The compositing window manager
+		 * @details	Pass this to @p gwinSetWindowManager() to use it.
+		 * @note	Each visible top level window is drawn into its own pixmap and the display is built
+		 * 			from those pixmaps. Moving, raising, hiding or changing the opacity of a top level
+		 * 			window then only copies pixels instead of redrawing the windows it uncovers.
+		 * @note	Drawing onto a window only updates its pixmap. The display is updated by the next
+		 * 			redraw pass (immediately if @p GWIN_REDRAW_IMMEDIATE is TRUE).
+		 * @note	A top level window that can't get a pixmap is drawn directly on the display as it is
+		 * 			without a window manager.
+		 */
+		extern struct GWindowManager	GCompositingWindowManager;
+
+		/**
+		 * @brief   Set the opacity of a top level window
+		 *
+		 * @param[in] gh		The window handle
+		 * @param[in] alpha		The opacity from 0 (invisible) to 255 (opaque)
+		 *
+		 * @note	This only has an effect on top level windows when the compositing window manager is in use.
+		 * 			The window is blended with whatever is underneath it.
+		 * @note	Windows are opaque by default.
+		 *
+		 * @api
+		 */
+		void gwinSetOpacity(GHandle gh, uint8_t alpha);
+
+		/**
+		 * @brief   Get the opacity of a window
+		 *
+		 * @param[in] gh		The window handle
+		 *
+		 * @return	The opacity from 0 (invisible) to 255 (opaque)
+		 *
+		 * @api
+		 */
+		#define gwinGetOpacity(gh)		((gh)->opacity)
+	#endif
 #endif
 
 /*-------------------------------------------------
@@ -266,6 +323,44 @@ extern "C" {
 	 */
 	#define gwinGetScreenY(gh)			((gh)->y)
 
+	#if (GWIN_NEED_WINDOWMANAGER && GWIN_NEED_COMPOSITOR) || (GWIN_NEED_WIDGET && GWIN_WIDGET_CACHE) || defined(__DOXYGEN__)
+		/**
+		 * @brief	Get the display the window is currently being drawn on
+		 * @details	This is normally the window's own display but it is an off-screen pixmap
+		 *			while a widget cache or the compositing window manager is drawing the window.
+		 *
+		 * @param[in] gh	The window
+		 *
+		 * @note	Drawing code (including custom widget draw functions) should use this with @p gwinGetDrawX()
+		 *			and @p gwinGetDrawY() rather than the display and screen position of the window.
+		 *
+		 * @api
+		 */
+		#define gwinGetDrawDisplay(gh)		((gh)->drawdisplay ? (gh)->drawdisplay : (gh)->display)
+
+		/**
+		 * @brief	Get the X coordinate of the origin of the window on the display it is being drawn on
+		 *
+		 * @param[in] gh	The window
+		 *
+		 * @api
+		 */
+		#define gwinGetDrawX(gh)			((gh)->x - (gh)->drawdx)
+
+		/**
+		 * @brief	Get the Y coordinate of the origin of the window on the display it is being drawn on
+		 *
+		 * @param[in] gh	The window
+		 *
+		 * @api
+		 */
+		#define gwinGetDrawY(gh)			((gh)->y - (gh)->drawdy)
+	#else
+		#define gwinGetDrawDisplay(gh)		((gh)->display)
+		#define gwinGetDrawX(gh)			((gh)->x)
+		#define gwinGetDrawY(gh)			((gh)->y)
+	#endif
+
 	/**
 	 * @brief	Get the width of the window
 	 *
@@ -474,6 +569,24 @@ extern "C" {
 	 */
 	void gwinRedraw(GHandle gh);
 
+	/**
+	 * @brief	Mark part of a window as needing to be redrawn
+	 *
+	 * @param[in] gh				The window
+	 * @param[in] x, y				The top left corner of the area relative to the window
+	 * @param[in] cx, cy			The size of the area
+	 *
+	 * @note	The redraw happens asynchronously. Areas invalidated before the redraw happens
+	 * 			are merged into their bounding rectangle and the window's redraw routine is
+	 * 			called with the clipping region set to that rectangle.
+	 * @note	A window or widget redraw routine must still draw the complete window. Drawing
+	 * 			outside the invalidated area is simply clipped away.
+	 * @note	Without a window manager the whole window is redrawn.
+	 *
+	 * @api
+	 */
+	void gwinInvalidateRect(GHandle gh, coord_t x, coord_t y, coord_t cx, coord_t cy);
+
 	#if GWIN_NEED_WINDOWMANAGER || defined (__DOXYGEN__)
 		/**
 		 * @brief	Redraw a display
@@ -554,6 +667,20 @@ extern "C" {
 		 */
 		GHandle gwinGetNextWindow(GHandle gh);
 
+		/**
+		 * @brief	Find the top-most visible window at a point on a display
+		 * @return	The window or NULL if there is no visible window at that point
+		 *
+		 * @param[in] g			The display
+		 * @param[in] x,y		The screen relative point
+		 *
+		 * @note	With GWIN_NEED_SPATIAL_INDEX this only examines the windows that overlap
+		 * 			the point. Otherwise every window in the system is tested.
+		 *
+		 * @api
+		 */
+		GHandle gwinFindWindowAt(GDisplay *g, coord_t x, coord_t y);
+
 		/**
 		 * @brief	Set a window or widget to flash
 		 *
@@ -171,9 +171,9 @@ static const GColorSet *getButtonColors(GWidgetObject *gw) {
 		if (gw->g.vmt != (gwinVMT *)&buttonVMT)	return;
 		pcol = getButtonColors(gw);
 
-		gdispGFillStringBox(gw->g.display, gw->g.x, gw->g.y, gw->g.width-1, gw->g.height-1, gw->text, gw->g.font, pcol->text, pcol->fill, justifyCenter);
-		gdispGDrawLine(gw->g.display, gw->g.x+gw->g.width-1, gw->g.y, gw->g.x+gw->g.width-1, gw->g.y+gw->g.height-1, pcol->edge);
-		gdispGDrawLine(gw->g.display, gw->g.x, gw->g.y+gw->g.height-1, gw->g.x+gw->g.width-2, gw->g.y+gw->g.height-1, pcol->edge);
+		gdispGFillStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw->g.width-1, gw->g.height-1, gw->text, gw->g.font, pcol->text, pcol->fill, justifyCenter);
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+gw->g.width-1, gwinGetDrawY(&gw->g), gwinGetDrawX(&gw->g)+gw->g.width-1, gwinGetDrawY(&gw->g)+gw->g.height-1, pcol->edge);
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g)+gw->g.height-1, gwinGetDrawX(&gw->g)+gw->g.width-2, gwinGetDrawY(&gw->g)+gw->g.height-1, pcol->edge);
 
 		// Render highlighted border if focused
 		_gwidgetDrawFocusRect(gw, 1, 1, gw->g.width-2, gw->g.height-2);
@@ -196,11 +196,11 @@ static const GColorSet *getButtonColors(GWidgetObject *gw) {
 		bcol = gdispBlendColor(Black, pcol->fill, BTN_BOTTOM_FADE);
 		dalpha = FIXED(255)/gw->g.height;
 		for(alpha = 0, i = 0; i < gw->g.height; i++, alpha += dalpha)
-			gdispGDrawLine(gw->g.display, gw->g.x, gw->g.y+i, gw->g.x+gw->g.width-2, gw->g.y+i, gdispBlendColor(bcol, tcol, NONFIXED(alpha)));
+			gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g)+i, gwinGetDrawX(&gw->g)+gw->g.width-2, gwinGetDrawY(&gw->g)+i, gdispBlendColor(bcol, tcol, NONFIXED(alpha)));
 
-		gdispGDrawStringBox(gw->g.display, gw->g.x, gw->g.y, gw->g.width-1, gw->g.height-1, gw->text, gw->g.font, pcol->text, justifyCenter);
-		gdispGDrawLine(gw->g.display, gw->g.x+gw->g.width-1, gw->g.y, gw->g.x+gw->g.width-1, gw->g.y+gw->g.height-1, pcol->edge);
-		gdispGDrawLine(gw->g.display, gw->g.x, gw->g.y+gw->g.height-1, gw->g.x+gw->g.width-2, gw->g.y+gw->g.height-1, pcol->edge);
+		gdispGDrawStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw->g.width-1, gw->g.height-1, gw->text, gw->g.font, pcol->text, justifyCenter);
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+gw->g.width-1, gwinGetDrawY(&gw->g), gwinGetDrawX(&gw->g)+gw->g.width-1, gwinGetDrawY(&gw->g)+gw->g.height-1, pcol->edge);
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g)+gw->g.height-1, gwinGetDrawX(&gw->g)+gw->g.width-2, gwinGetDrawY(&gw->g)+gw->g.height-1, pcol->edge);
 
 		// Render highlighted border if focused
 		_gwidgetDrawFocusRect(gw, 0, 0, gw->g.width-1, gw->g.height-1);
@@ -216,14 +216,14 @@ static const GColorSet *getButtonColors(GWidgetObject *gw) {
 		if (gw->g.vmt != (gwinVMT *)&buttonVMT)	return;
 		pcol = getButtonColors(gw);
 
-		gdispGFillArea(gw->g.display, gw->g.x, gw->g.y, gw->g.width, gw->g.height, gw->pstyle->background);
+		gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw->g.width, gw->g.height, gw->pstyle->background);
 		if (gw->g.width >= 2*BTN_CNR_SIZE+10) {
-			gdispGFillRoundedBox(gw->g.display, gw->g.x+1, gw->g.y+1, gw->g.width-2, gw->g.height-2, BTN_CNR_SIZE-1, pcol->fill);
-			gdispGDrawStringBox(gw->g.display, gw->g.x+1, gw->g.y+BTN_CNR_SIZE, gw->g.width-2, gw->g.height-(2*BTN_CNR_SIZE), gw->text, gw->g.font, pcol->text, justifyCenter);
-			gdispGDrawRoundedBox(gw->g.display, gw->g.x, gw->g.y, gw->g.width, gw->g.height, BTN_CNR_SIZE, pcol->edge);
+			gdispGFillRoundedBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+1, gwinGetDrawY(&gw->g)+1, gw->g.width-2, gw->g.height-2, BTN_CNR_SIZE-1, pcol->fill);
+			gdispGDrawStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+1, gwinGetDrawY(&gw->g)+BTN_CNR_SIZE, gw->g.width-2, gw->g.height-(2*BTN_CNR_SIZE), gw->text, gw->g.font, pcol->text, justifyCenter);
+			gdispGDrawRoundedBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw->g.width, gw->g.height, BTN_CNR_SIZE, pcol->edge);
 		} else {
-			gdispGFillStringBox(gw->g.display, gw->g.x+1, gw->g.y+1, gw->g.width-2, gw->g.height-2, gw->text, gw->g.font, pcol->text, pcol->fill, justifyCenter);
-			gdispGDrawBox(gw->g.display, gw->g.x, gw->g.y, gw->g.width, gw->g.height, pcol->edge);
+			gdispGFillStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+1, gwinGetDrawY(&gw->g)+1, gw->g.width-2, gw->g.height-2, gw->text, gw->g.font, pcol->text, pcol->fill, justifyCenter);
+			gdispGDrawBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw->g.width, gw->g.height, pcol->edge);
 		}
 	}
 #endif
@@ -237,10 +237,10 @@ static const GColorSet *getButtonColors(GWidgetObject *gw) {
 		if (gw->g.vmt != (gwinVMT *)&buttonVMT)	return;
 		pcol = getButtonColors(gw);
 
-		gdispGFillArea(gw->g.display, gw->g.x, gw->g.y, gw->g.width, gw->g.height, gw->pstyle->background);
-		gdispGFillEllipse(gw->g.display, gw->g.x+gw->g.width/2, gw->g.y+gw->g.height/2, gw->g.width/2-2, gw->g.height/2-2, pcol->fill);
-		gdispGDrawStringBox(gw->g.display, gw->g.x+1, gw->g.y+1, gw->g.width-2, gw->g.height-2, gw->text, gw->g.font, pcol->text, justifyCenter);
-		gdispGDrawEllipse(gw->g.display, gw->g.x+gw->g.width/2, gw->g.y+gw->g.height/2, gw->g.width/2-1, gw->g.height/2-1, pcol->edge);
+		gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw->g.width, gw->g.height, gw->pstyle->background);
+		gdispGFillEllipse(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+gw->g.width/2, gwinGetDrawY(&gw->g)+gw->g.height/2, gw->g.width/2-2, gw->g.height/2-2, pcol->fill);
+		gdispGDrawStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+1, gwinGetDrawY(&gw->g)+1, gw->g.width-2, gw->g.height-2, gw->text, gw->g.font, pcol->text, justifyCenter);
+		gdispGDrawEllipse(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+gw->g.width/2, gwinGetDrawY(&gw->g)+gw->g.height/2, gw->g.width/2-1, gw->g.height/2-1, pcol->edge);
 	}
 #endif
 
@@ -290,10 +290,10 @@ static const GColorSet *getButtonColors(GWidgetObject *gw) {
 		/* arw[6].x set */											arw[6].y = arw[1].y;
 
 		// Draw
-		gdispGFillArea(gw->g.display, gw->g.x, gw->g.y, gw->g.width, gw->g.height, gw->pstyle->background);
-		gdispGFillConvexPoly(gw->g.display, gw->g.x, gw->g.y, arw, 7, pcol->fill);
-		gdispGDrawPoly(gw->g.display, gw->g.x, gw->g.y, arw, 7, pcol->edge);
-		gdispGDrawStringBox(gw->g.display, gw->g.x+1, gw->g.y+1, gw->g.width-2, gw->g.height-2, gw->text, gw->g.font, pcol->text, justifyCenter);
+		gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw->g.width, gw->g.height, gw->pstyle->background);
+		gdispGFillConvexPoly(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), arw, 7, pcol->fill);
+		gdispGDrawPoly(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), arw, 7, pcol->edge);
+		gdispGDrawStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+1, gwinGetDrawY(&gw->g)+1, gw->g.width-2, gw->g.height-2, gw->text, gw->g.font, pcol->text, justifyCenter);
 	}
 
 	void gwinButtonDraw_ArrowDown(GWidgetObject *gw, void *param) {
@@ -341,10 +341,10 @@ static const GColorSet *getButtonColors(GWidgetObject *gw) {
 		/* arw[6].x set */											arw[6].y = arw[1].y;
 
 		// Draw
-		gdispGFillArea(gw->g.display, gw->g.x, gw->g.y, gw->g.width, gw->g.height, gw->pstyle->background);
-		gdispGFillConvexPoly(gw->g.display, gw->g.x, gw->g.y, arw, 7, pcol->fill);
-		gdispGDrawPoly(gw->g.display, gw->g.x, gw->g.y, arw, 7, pcol->edge);
-		gdispGDrawStringBox(gw->g.display, gw->g.x+1, gw->g.y+1, gw->g.width-2, gw->g.height-2, gw->text, gw->g.font, pcol->text, justifyCenter);
+		gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw->g.width, gw->g.height, gw->pstyle->background);
+		gdispGFillConvexPoly(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), arw, 7, pcol->fill);
+		gdispGDrawPoly(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), arw, 7, pcol->edge);
+		gdispGDrawStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+1, gwinGetDrawY(&gw->g)+1, gw->g.width-2, gw->g.height-2, gw->text, gw->g.font, pcol->text, justifyCenter);
 	}
 
 	void gwinButtonDraw_ArrowLeft(GWidgetObject *gw, void *param) {
@@ -392,10 +392,10 @@ static const GColorSet *getButtonColors(GWidgetObject *gw) {
 		arw[6].x = arw[1].x;										/* arw[6].y set */
 
 		// Draw
-		gdispGFillArea(gw->g.display, gw->g.x, gw->g.y, gw->g.width, gw->g.height, gw->pstyle->background);
-		gdispGFillConvexPoly(gw->g.display, gw->g.x, gw->g.y, arw, 7, pcol->fill);
-		gdispGDrawPoly(gw->g.display, gw->g.x, gw->g.y, arw, 7, pcol->edge);
-		gdispGDrawStringBox(gw->g.display, gw->g.x+1, gw->g.y+1, gw->g.width-2, gw->g.height-2, gw->text, gw->g.font, pcol->text, justifyCenter);
+		gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw->g.width, gw->g.height, gw->pstyle->background);
+		gdispGFillConvexPoly(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), arw, 7, pcol->fill);
+		gdispGDrawPoly(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), arw, 7, pcol->edge);
+		gdispGDrawStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+1, gwinGetDrawY(&gw->g)+1, gw->g.width-2, gw->g.height-2, gw->text, gw->g.font, pcol->text, justifyCenter);
 	}
 
 	void gwinButtonDraw_ArrowRight(GWidgetObject *gw, void *param) {
@@ -443,10 +443,10 @@ static const GColorSet *getButtonColors(GWidgetObject *gw) {
 		arw[6].x = arw[1].x;										/* arw[6].y set */
 
 		// Draw
-		gdispGFillArea(gw->g.display, gw->g.x, gw->g.y, gw->g.width, gw->g.height, gw->pstyle->background);
-		gdispGFillConvexPoly(gw->g.display, gw->g.x, gw->g.y, arw, 7, pcol->fill);
-		gdispGDrawPoly(gw->g.display, gw->g.x, gw->g.y, arw, 7, pcol->edge);
-		gdispGDrawStringBox(gw->g.display, gw->g.x+1, gw->g.y+1, gw->g.width-2, gw->g.height-2, gw->text, gw->g.font, pcol->text, justifyCenter);
+		gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw->g.width, gw->g.height, gw->pstyle->background);
+		gdispGFillConvexPoly(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), arw, 7, pcol->fill);
+		gdispGDrawPoly(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), arw, 7, pcol->edge);
+		gdispGDrawStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+1, gwinGetDrawY(&gw->g)+1, gw->g.width-2, gw->g.height-2, gw->text, gw->g.font, pcol->text, justifyCenter);
 	}
 #endif
 
@@ -466,8 +466,8 @@ static const GColorSet *getButtonColors(GWidgetObject *gw) {
 			sy = 0;
 		}
 
-		gdispGImageDraw(gw->g.display, (gdispImage *)param, gw->g.x, gw->g.y, gw->g.width, gw->g.height, 0, sy);
-		gdispGDrawStringBox(gw->g.display, gw->g.x+1, gw->g.y+1, gw->g.width-2, gw->g.height-2, gw->text, gw->g.font, pcol->text, justifyCenter);
+		gdispGImageDraw(gwinGetDrawDisplay(&gw->g), (gdispImage *)param, gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw->g.width, gw->g.height, 0, sy);
+		gdispGDrawStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+1, gwinGetDrawY(&gw->g)+1, gw->g.width-2, gw->g.height-2, gw->text, gw->g.font, pcol->text, justifyCenter);
 	}
 #endif
 
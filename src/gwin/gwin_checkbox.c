@@ -184,19 +184,19 @@ void gwinCheckboxDraw_CheckOnLeft(GWidgetObject *gw, void *param) {
 	ld = gw->g.width < gw->g.height ? gw->g.width : gw->g.height;
 
 	// Draw the empty check box
-	gdispGFillArea(gw->g.display, gw->g.x+1, gw->g.y+1, ld, ld-2, gw->pstyle->background);
-	gdispGDrawBox(gw->g.display, gw->g.x, gw->g.y, ld, ld, pcol->edge);
+	gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+1, gwinGetDrawY(&gw->g)+1, ld, ld-2, gw->pstyle->background);
+	gdispGDrawBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), ld, ld, pcol->edge);
 
 	// Draw the check
 	df = ld < 4 ? 1 : 2;
 	if (gw->g.flags & GCHECKBOX_FLG_CHECKED)
-		gdispGFillArea(gw->g.display, gw->g.x+df, gw->g.y+df, ld-2*df, ld-2*df, pcol->fill);
+		gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+df, gwinGetDrawY(&gw->g)+df, ld-2*df, ld-2*df, pcol->fill);
 
 	// Render highlighted border if focused
 	_gwidgetDrawFocusRect(gw, 1, 1, ld-2, ld-2);
 
 	// Draw the text
-	gdispGFillStringBox(gw->g.display, gw->g.x+ld+1, gw->g.y, gw->g.width-ld-1, gw->g.height, gw->text, gw->g.font, pcol->text, gw->pstyle->background, justifyLeft);
+	gdispGFillStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+ld+1, gwinGetDrawY(&gw->g), gw->g.width-ld-1, gw->g.height, gw->text, gw->g.font, pcol->text, gw->pstyle->background, justifyLeft);
 	#undef gcw
 }
 
@@ -216,19 +216,19 @@ void gwinCheckboxDraw_CheckOnRight(GWidgetObject *gw, void *param) {
 	ep = gw->g.width-ld;
 
 	// Draw the empty check box
-	gdispGFillArea(gw->g.display, gw->g.x+ep-1, gw->g.y+1, ld, ld-2, gw->pstyle->background);
-	gdispGDrawBox(gw->g.display, gw->g.x+ep, gw->g.y, ld, ld, pcol->edge);
+	gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+ep-1, gwinGetDrawY(&gw->g)+1, ld, ld-2, gw->pstyle->background);
+	gdispGDrawBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+ep, gwinGetDrawY(&gw->g), ld, ld, pcol->edge);
 
 	// Draw the check
 	df = ld < 4 ? 1 : 2;
 	if (gw->g.flags & GCHECKBOX_FLG_CHECKED)
-		gdispGFillArea(gw->g.display, gw->g.x+ep+df, gw->g.y+df, ld-2*df, ld-2*df, pcol->fill);
+		gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+ep+df, gwinGetDrawY(&gw->g)+df, ld-2*df, ld-2*df, pcol->fill);
 
 	// Render highlighted border if focused
 	_gwidgetDrawFocusRect(gw, ep+1, 1, ld-2, ld-2);
 
 	// Draw the text
-	gdispGFillStringBox(gw->g.display, gw->g.x, gw->g.y, ep-1, gw->g.height, gw->text, gw->g.font, pcol->text, gw->pstyle->background, justifyRight);
+	gdispGFillStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), ep-1, gw->g.height, gw->text, gw->g.font, pcol->text, gw->pstyle->background, justifyRight);
 	#undef gcw
 }
 
@@ -245,9 +245,9 @@ void gwinCheckboxDraw_CheckOnRight(GWidgetObject *gw, void *param) {
 			pcol = _gwinGetFlashedColor(gw, pcol, TRUE);
 		#endif
 
-		gdispGFillStringBox(gw->g.display, gw->g.x, gw->g.y, gw->g.width-1, gw->g.height-1, gw->text, gw->g.font, pcol->text, pcol->fill, justifyCenter);
-		gdispGDrawLine(gw->g.display, gw->g.x+gw->g.width-1, gw->g.y, gw->g.x+gw->g.width-1, gw->g.y+gw->g.height-1, pcol->edge);
-		gdispGDrawLine(gw->g.display, gw->g.x, gw->g.y+gw->g.height-1, gw->g.x+gw->g.width-2, gw->g.y+gw->g.height-1, pcol->edge);
+		gdispGFillStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw->g.width-1, gw->g.height-1, gw->text, gw->g.font, pcol->text, pcol->fill, justifyCenter);
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+gw->g.width-1, gwinGetDrawY(&gw->g), gwinGetDrawX(&gw->g)+gw->g.width-1, gwinGetDrawY(&gw->g)+gw->g.height-1, pcol->edge);
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g)+gw->g.height-1, gwinGetDrawX(&gw->g)+gw->g.width-2, gwinGetDrawY(&gw->g)+gw->g.height-1, pcol->edge);
 	}
 #else
 	void gwinCheckboxDraw_Button(GWidgetObject *gw, void *param) {
@@ -271,11 +271,11 @@ void gwinCheckboxDraw_CheckOnRight(GWidgetObject *gw, void *param) {
 		bcol = gdispBlendColor(Black, pcol->fill, CHK_BOTTOM_FADE);
 		dalpha = FIXED(255)/gw->g.height;
 		for(alpha = 0, i = 0; i < gw->g.height; i++, alpha += dalpha)
-			gdispGDrawLine(gw->g.display, gw->g.x, gw->g.y+i, gw->g.x+gw->g.width-2, gw->g.y+i, gdispBlendColor(bcol, tcol, NONFIXED(alpha)));
+			gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g)+i, gwinGetDrawX(&gw->g)+gw->g.width-2, gwinGetDrawY(&gw->g)+i, gdispBlendColor(bcol, tcol, NONFIXED(alpha)));
 
-		gdispGDrawStringBox(gw->g.display, gw->g.x, gw->g.y, gw->g.width-1, gw->g.height-1, gw->text, gw->g.font, pcol->text, justifyCenter);
-		gdispGDrawLine(gw->g.display, gw->g.x+gw->g.width-1, gw->g.y, gw->g.x+gw->g.width-1, gw->g.y+gw->g.height-1, pcol->edge);
-		gdispGDrawLine(gw->g.display, gw->g.x, gw->g.y+gw->g.height-1, gw->g.x+gw->g.width-2, gw->g.y+gw->g.height-1, pcol->edge);
+		gdispGDrawStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw->g.width-1, gw->g.height-1, gw->text, gw->g.font, pcol->text, justifyCenter);
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+gw->g.width-1, gwinGetDrawY(&gw->g), gwinGetDrawX(&gw->g)+gw->g.width-1, gwinGetDrawY(&gw->g)+gw->g.height-1, pcol->edge);
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g)+gw->g.height-1, gwinGetDrawX(&gw->g)+gw->g.width-2, gwinGetDrawY(&gw->g)+gw->g.height-1, pcol->edge);
 	}
 #endif
 
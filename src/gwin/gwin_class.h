@@ -44,8 +44,9 @@
 #define GWIN_FLG_MAXIMIZED				0x00200000			/**< The window is maximized */
 #define GWIN_FLG_MOUSECAPTURE			0x00400000			/**< The window has captured the mouse */
 #define GWIN_FLG_FLASHING				0x00800000			/**< The window is flashing - see the _gwinFlashState boolean */
-#define GWIN_FIRST_WM_FLAG				0x01000000			/**< 8 bits free for the window manager to use */
-#define GWIN_LAST_WM_FLAG				0x80000000			/**< 8 bits free for the window manager to use */
+#define GWIN_FIRST_WM_FLAG				0x01000000			/**< 7 bits free for the window manager to use */
+#define GWIN_LAST_WM_FLAG				0x40000000			/**< 7 bits free for the window manager to use */
+#define GWIN_FLG_CACHED					0x80000000			/**< The widget is drawn from an off-screen copy (see @p gwinSetCached()) */
 /** @} */
 
 /**
@@ -161,6 +162,8 @@ typedef struct gwinVMT {
 		void (*Move)		(GHandle gh, coord_t x, coord_t y);		/**< A window wants to be moved */
 		void (*Raise)		(GHandle gh);							/**< A window wants to be on top */
 		void (*MinMax)		(GHandle gh, GWindowMinMax minmax);		/**< A window wants to be minimized/maximised */
+		void (*DrawStart)	(GHandle gh);							/**< A window is about to be drawn on outside a redraw (optional) */
+		void (*DrawEnd)		(GHandle gh);							/**< A window has finished being drawn on outside a redraw (optional) */
 	} gwmVMT;
 	/** @} */
 
@@ -204,6 +207,42 @@ GHandle _gwindowCreate(GDisplay *g, GWindowObject *pgw, const GWindowInit *pInit
  */
 void _gwinUpdate(GHandle gh);
 
+#if GWIN_NEED_WINDOWMANAGER || defined(__DOXYGEN__)
+	/**
+	 * @brief	Redraw part of a window after a status change.
+	 *
+	 * @param[in]	gh		The window to redraw
+	 * @param[in]	x, y	The top left of the area that has changed (relative to the window)
+	 * @param[in]	cx, cy	The size of the area that has changed
+	 *
+	 * @note	Mark part of a window for redraw. Areas marked before the window is redrawn
+	 * 			are merged into one area that covers them all.
+	 * @note	The window will get redrawn at some later time with the clip set to the area.
+	 * @note	This call is designed to be fast and non-blocking
+	 *
+	 * @notapi
+	 */
+	void _gwinUpdateArea(GHandle gh, coord_t x, coord_t y, coord_t cx, coord_t cy);
+#else
+	#define _gwinUpdateArea(gh, x, y, cx, cy)		_gwinUpdate(gh)
+#endif
+
+#if (GWIN_NEED_WIDGET && GWIN_WIDGET_CACHE) || defined(__DOXYGEN__)
+	/**
+	 * @brief	Note that the content of a window has changed so any cached rendering is out of date.
+	 *
+	 * @param[in]	gh		The window. Nothing is done if it is not a widget.
+	 *
+	 * @note	This is done for you by @p _gwinUpdate(), @p gwinRedraw() and @p _gwinDrawStart().
+	 * 			It only needs to be called by code that draws a widget in some other way.
+	 *
+	 * @notapi
+	 */
+	void _gwinCacheInvalidate(GHandle gh);
+#else
+	#define _gwinCacheInvalidate(gh)
+#endif
+
 /**
  * @brief	How to flush the redraws
  * @notes	REDRAW_WAIT			- Wait for a drawing session to be available
@@ -268,6 +307,55 @@ void _gwinDestroy(GHandle gh, GRedrawMethod how);
  */
 bool_t _gwinWMAdd(GHandle gh, const GWindowInit *pInit);
 
+#if (GWIN_NEED_WINDOWMANAGER && GWIN_NEED_SPATIAL_INDEX) || defined(__DOXYGEN__)
+	/**
+	 * @brief	Place a window in the spatial index (or update its position in the index)
+	 *
+	 * @param[in]	gh		The window
+	 *
+	 * @note	A window manager must call this when a window is added and whenever its position or size changes.
+	 * @note	A newly placed window goes on top of the z-order.
+	 *
+	 * @notapi
+	 */
+	void _gwinIndexUpdate(GHandle gh);
+
+	/**
+	 * @brief	Move a window to the top of the z-order in the spatial index
+	 *
+	 * @param[in]	gh		The window
+	 *
+	 * @note	A window manager must call this in the same order it raises windows in its window list.
+	 *
+	 * @notapi
+	 */
+	void _gwinIndexRaise(GHandle gh);
+
+	/**
+	 * @brief	Remove a window from the spatial index
+	 *
+	 * @param[in]	gh		The window
+	 *
+	 * @notapi
+	 */
+	void _gwinIndexRemove(GHandle gh);
+
+	/**
+	 * @brief	Get the next visible window (in z-order, bottom to top) that overlaps an area
+	 * @return	The next window or NULL if no more windows
+	 *
+	 * @param[in]	g		The display
+	 * @param[in]	x,y		The top left corner of the area
+	 * @param[in]	cx,cy	The size of the area
+	 * @param[in]	gh		The previous window or NULL to get the first window
+	 *
+	 * @note	Windows that just touch the edge of the area are included.
+	 *
+	 * @notapi
+	 */
+	GHandle _gwinIndexNextOverlap(GDisplay *g, coord_t x, coord_t y, coord_t cx, coord_t cy, GHandle gh);
+#endif
+
 #if GWIN_NEED_WIDGET || defined(__DOXYGEN__)
 	/**
 	 * @brief	Initialise (and allocate if necessary) the base Widget object
@@ -364,6 +452,26 @@ bool_t _gwinWMAdd(GHandle gh, const GWindowInit *pInit);
 		#define _gwidgetDrawFocusRect(gh,x,y,cx,cy)
 	#endif
 
+	#if GWIN_NEED_TEXTEDIT || defined(__DOXYGEN__)
+		/**
+		 * @brief	Close the gap in the text of a TextEdit widget so the text is a normal string.
+		 *
+		 * @param[in]	gh		The window. Nothing is done if it is not a TextEdit widget.
+		 *
+		 * @notapi
+		 */
+		void _gwinTexteditCloseGap(GHandle gh);
+
+		/**
+		 * @brief	Tell a TextEdit widget that its text has been replaced.
+		 *
+		 * @param[in]	gh		The window. Nothing is done if it is not a TextEdit widget.
+		 *
+		 * @notapi
+		 */
+		void _gwinTexteditNewText(GHandle gh);
+	#endif
+
 	#if GWIN_NEED_FLASHING || defined(__DOXYGEN__)
 		/**
 		 * @brief	Convert a chosen style color set pressed/enabled etc if flashing
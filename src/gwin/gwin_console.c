@@ -20,11 +20,29 @@
 
 #define GWIN_CONSOLE_USE_CLEAR_LINES			TRUE			// Clear each line before using it
 #define GWIN_CONSOLE_USE_FILLED_CHARS			FALSE			// Use filled characters instead of drawn characters
-#define GWIN_CONSOLE_BUFFER_SCROLLING			TRUE			// Use the history buffer to scroll when it is available
+#if GDISP_NEED_SCROLL
+	#define GWIN_CONSOLE_BUFFER_SCROLLING		FALSE			// Move the pixels already on the display and only draw the new line
+#else
+	#define GWIN_CONSOLE_BUFFER_SCROLLING		TRUE			// Use the history buffer to scroll when it is available
+#endif
 
 // Our control flags
-#define GCONSOLE_FLG_NOSTORE					(GWIN_FIRST_CONTROL_FLAG<<0)
-#define GCONSOLE_FLG_OVERRUN					(GWIN_FIRST_CONTROL_FLAG<<1)
+#define GCONSOLE_FLG_OVERRUN					(GWIN_FIRST_CONTROL_FLAG<<0)
+#define GCONSOLE_FLG_DEFERRED					(GWIN_FIRST_CONTROL_FLAG<<1)
+
+/*
+ * When rendering is deferred the history is shared with the render timer.
+ * Lock order is always the window draw lock first and then the history.
+ */
+#if GWIN_CONSOLE_DEFERRED_RENDER
+	#define Deferred(gh)			((gh)->flags & GCONSOLE_FLG_DEFERRED)
+	#define DeferLock(gcw)			gfxMutexEnter(&(gcw)->defermutex)
+	#define DeferUnlock(gcw)		gfxMutexExit(&(gcw)->defermutex)
+#else
+	#define Deferred(gh)			FALSE
+	#define DeferLock(gcw)
+	#define DeferUnlock(gcw)
+#endif
 
 // Meaning of our attribute bits.
 #define	ESC_REDBIT		0x01
@@ -139,13 +157,58 @@
 	#define ESCPrintColor(gcw)		((gcw)->g.color)
 #endif
 
+/**
+ * Draw a character at the cursor using the current attributes.
+ * The caller must already have a draw session.
+ */
+static void drawChar(GConsoleObject *gcw, char c, uint8_t width, uint8_t fy) {
+	#define gh		(&gcw->g)
+
+	#if GWIN_CONSOLE_USE_FILLED_CHARS
+		gdispGFillChar(gwinGetDrawDisplay(gh), gwinGetDrawX(gh) + gcw->cx, gwinGetDrawY(gh) + gcw->cy, c, gh->font, ESCPrintColor(gcw), gh->bgcolor);
+	#else
+		gdispGDrawChar(gwinGetDrawDisplay(gh), gwinGetDrawX(gh) + gcw->cx, gwinGetDrawY(gh) + gcw->cy, c, gh->font, ESCPrintColor(gcw));
+	#endif
+
+	#if GWIN_CONSOLE_ESCSEQ
+		// Draw the underline
+		if ((gcw->currattr & ESC_UNDERLINE))
+			gdispGDrawLine(gwinGetDrawDisplay(gh), gwinGetDrawX(gh) + gcw->cx, gwinGetDrawY(gh) + gcw->cy + fy - gdispGetFontMetric(gh->font, fontDescendersHeight),
+										gwinGetDrawX(gh) + gcw->cx + width + gdispGetFontMetric(gh->font, fontCharPadding), gwinGetDrawY(gh) + gcw->cy + fy - gdispGetFontMetric(gh->font, fontDescendersHeight),
+										ESCPrintColor(gcw));
+		// Bold (very crude)
+		if ((gcw->currattr & ESC_BOLD))
+			gdispGDrawChar(gwinGetDrawDisplay(gh), gwinGetDrawX(gh) + gcw->cx + 1, gwinGetDrawY(gh) + gcw->cy, c, gh->font, ESCPrintColor(gcw));
+	#else
+		(void) width;
+		(void) fy;
+	#endif
+
+	#undef gh
+}
+
 #if GWIN_CONSOLE_USE_HISTORY
+	/**
+	 * The history is a ring of chars (bufstart, buflen) together with a ring of lines (linefirst, linecnt).
+	 * Each line records how many chars it uses and the attributes in effect at its start so
+	 * dropping the oldest line is O(1) and a redraw can start on any line.
+	 * Lines are not separated by a newline char in the buffer - the line ring tracks them.
+	 */
+	#define LineEntry(gcw, i)		(((gcw)->linefirst + (i)) % (gcw)->linemax)
+	#define LastLine(gcw)			LineEntry(gcw, (gcw)->linecnt-1)
+
 	static void HistoryDestroy(GWindowObject *gh) {
 		#define gcw		((GConsoleObject *)gh)
 
-		// Deallocate the history buffer if required.
+		#if GWIN_CONSOLE_DEFERRED_RENDER
+			gtimerStop(&gcw->defertimer);
+			gtimerDeinit(&gcw->defertimer);
+			gfxMutexDestroy(&gcw->defermutex);
+		#endif
+
+		// Deallocate the history buffer if required (the line ring is the start of the allocation).
 		if (gcw->buffer) {
-			gfxFree(gcw->buffer);
+			gfxFree(gcw->linelen);
 			gcw->buffer = 0;
 		}
 
@@ -153,94 +216,172 @@
 	}
 
 	/**
-	 * Scroll the history buffer by one line
+	 * Remove the oldest line from the history buffer
 	 */
-	static void scrollBuffer(GConsoleObject *gcw) {
-		char	*p, *ep;
-		size_t	dp;
+	static void dropLine(GConsoleObject *gcw) {
+		size_t	n;
+
+		// Every line on the display moves up by one line (deferred rendering catches up later)
+		#if GWIN_CONSOLE_DEFERRED_RENDER
+			if (gcw->scrolled < gcw->linemax)
+				gcw->scrolled++;
+			if (gcw->dirtyline)
+				gcw->dirtyline--;
+		#endif
 
-		// Only scroll if we need to
-		if (!gcw->buffer || (gcw->g.flags & GCONSOLE_FLG_NOSTORE))
+		// Drop everything if there is only one line
+		if (gcw->linecnt <= 1) {
+			gcw->buflen = 0;
+			gcw->linelen[gcw->linefirst] = 0;
 			return;
+		}
+
+		n = gcw->linelen[gcw->linefirst];
+		gcw->bufstart += n;
+		if (gcw->bufstart >= gcw->bufsize)
+			gcw->bufstart -= gcw->bufsize;
+		gcw->buflen -= n;
+		if (++gcw->linefirst >= gcw->linemax)
+			gcw->linefirst = 0;
+		gcw->linecnt--;
+	}
+
+	/**
+	 * Remove the oldest char from the history buffer (an escape sequence counts as one char)
+	 */
+	static void dropChar(GConsoleObject *gcw) {
+		size_t	n;
 
-		// If a buffer overrun has been marked don't scroll as we have already
-		if ((gcw->g.flags & GCONSOLE_FLG_OVERRUN)) {
-			gcw->g.flags &= ~GCONSOLE_FLG_OVERRUN;
+		if (!(n = gcw->linelen[gcw->linefirst]))
 			return;
+
+		#if GWIN_CONSOLE_ESCSEQ
+			// Fold a dropped escape sequence into the line start attributes
+			if (gcw->buffer[gcw->bufstart] == 27 && n > 1) {
+				ESCtoAttr(gcw->buffer[gcw->bufstart+1 < gcw->bufsize ? gcw->bufstart+1 : 0], &gcw->lineattr[gcw->linefirst]);
+				if (++gcw->bufstart >= gcw->bufsize)
+					gcw->bufstart = 0;
+				gcw->buflen--;
+				n--;
+			}
+		#endif
+
+		if (++gcw->bufstart >= gcw->bufsize)
+			gcw->bufstart = 0;
+		gcw->buflen--;
+		gcw->linelen[gcw->linefirst] = n-1;
+	}
+
+	#if GDISP_NEED_SCROLL
+		/**
+		 * Scroll the history buffer by one line
+		 */
+		static void scrollBuffer(GConsoleObject *gcw) {
+			// Only scroll if we need to
+			if (!gcw->buffer)
+				return;
+
+			// If a buffer overrun has been marked don't scroll as we have already
+			if ((gcw->g.flags & GCONSOLE_FLG_OVERRUN)) {
+				gcw->g.flags &= ~GCONSOLE_FLG_OVERRUN;
+				return;
+			}
+
+			dropLine(gcw);
 		}
+	#endif
 
-		// Remove one line from the start
-		ep = gcw->buffer+gcw->bufpos;
-		for(p = gcw->buffer; p < ep && *p != '\n'; p++) {
+	/**
+	 * Render the lines from line number "from" onwards straight from the ring.
+	 * The caller must already have a draw session.
+	 */
+	static void drawLines(GConsoleObject *gcw, unsigned from) {
+		#define gh		(&gcw->g)
+		uint8_t		fy, width;
+		unsigned	i, ln;
+		size_t		pos, n;
+		char		c;
+
+		// Find the start of the first line
+		fy = gdispGetFontMetric(gh->font, fontHeight);
+		pos = gcw->bufstart;
+		for(i = 0; i < from; i++)
+			pos += gcw->linelen[LineEntry(gcw, i)];
+		if (pos >= gcw->bufsize)
+			pos -= gcw->bufsize;
+
+		gcw->cy = from * fy;
+		for(i = from; i < gcw->linecnt; i++, gcw->cy += fy) {
+			ln = LineEntry(gcw, i);
+			gcw->cx = 0;
 			#if GWIN_CONSOLE_ESCSEQ
-				if (*p == 27)
-					ESCtoAttr(p[1], &gcw->startattr);
+				gcw->currattr = gcw->lineattr[ln];
 			#endif
-		}
 
-		// Was there a newline, if not delete everything.
-		if (*p != '\n') {
-			gcw->bufpos = 0;
-			return;
+			// Clear the line
+			if (gcw->cy < gh->height)
+				gdispGFillArea(gwinGetDrawDisplay(gh), gwinGetDrawX(gh), gwinGetDrawY(gh) + gcw->cy, gh->width, fy, gh->bgcolor);
+
+			for(n = gcw->linelen[ln]; n; n--) {
+				c = gcw->buffer[pos];
+				if (++pos >= gcw->bufsize)
+					pos = 0;
+
+				#if GWIN_CONSOLE_ESCSEQ
+					if (c == 27 && n > 1) {
+						ESCtoAttr(gcw->buffer[pos], &gcw->currattr);
+						if (++pos >= gcw->bufsize)
+							pos = 0;
+						n--;
+						continue;
+					}
+				#endif
+
+				// Only chars with a width are ever stored
+				width = gdispGetCharWidth(c, gh->font);
+				#if GWIN_CONSOLE_ESCSEQ
+					if ((gcw->currattr & ESC_BOLD))
+						width++;
+				#endif
+				if (gcw->cy < gh->height)
+					drawChar(gcw, c, width, fy);
+				gcw->cx += width + gdispGetFontMetric(gh->font, fontCharPadding);
+			}
 		}
 
-		// Delete the data
-		dp = ++p - gcw->buffer;						// Calculate the amount to to be removed
-		gcw->bufpos -= dp;							// Calculate the new size
-		if (gcw->bufpos)
-			memcpy(gcw->buffer, p, gcw->bufpos);	// Move the rest of the data
+		// Leave the cursor at the end of the last line and clear the remaining space
+		if (gcw->cy < gh->height)
+			gdispGFillArea(gwinGetDrawDisplay(gh), gwinGetDrawX(gh), gwinGetDrawY(gh) + gcw->cy, gh->width, gh->height - gcw->cy, gh->bgcolor);
+		gcw->cy -= fy;
+
+		#undef gh
 	}
 
 	static void HistoryRedraw(GWindowObject *gh) {
 		#define gcw		((GConsoleObject *)gh)
-		coord_t fy;
+		coord_t		fy;
 
 		// No redrawing if there is no history
 		if (!gcw->buffer)
 			return;
 
-		// Handle vertical size decrease - We have to scroll out first lines of the log 
-		fy = gdispGetFontMetric(gh->font, fontHeight);
-		while (gcw->cy > gh->height) {
-			scrollBuffer(gcw);
-			gcw->cy -= fy;
-		}
-
-		// We are printing the buffer - don't store it again
-		gh->flags |= GCONSOLE_FLG_NOSTORE;
+		DeferLock(gcw);
 
-		#if !GWIN_CONSOLE_USE_CLEAR_LINES
-			// Clear the screen
-			gdispGFillArea(gh->display, gh->x, gh->y, gh->width, gh->height, gh->bgcolor);
-		#endif
-
-		// Reset the cursor
-		gcw->cx = 0;
-		gcw->cy = 0;
-
-		// Reset the current attributes
-		#if GWIN_CONSOLE_ESCSEQ
-			gcw->currattr = gcw->startattr;
-		#endif
-
-		// Print the buffer
-		gwinPutCharArray(gh, gcw->buffer, gcw->bufpos);
+		// Handle vertical size decrease - We have to scroll out first lines of the log
+		fy = gdispGetFontMetric(gh->font, fontHeight);
+		while (gcw->linecnt > 1 && (coord_t)((gcw->linecnt-1)*fy) > gh->height)
+			dropLine(gcw);
 
-		#if GWIN_CONSOLE_USE_CLEAR_LINES
-			// Clear the remaining space
-			{
-				coord_t		y;
+		drawLines(gcw, 0);
 
-				y = gcw->cy;
-				if (gcw->cx)
-					y += gdispGetFontMetric(gh->font, fontHeight);
-				if (y < gh->height)
-					gdispGFillArea(gh->display, gh->x, gh->y+y, gh->width, gh->height-y, gh->bgcolor);
-			}
+		// The display now matches the history exactly
+		#if GWIN_CONSOLE_DEFERRED_RENDER
+			gcw->dirty = FALSE;
+			gcw->scrolled = 0;
+			gcw->dirtyline = gcw->linecnt-1;
 		#endif
 
-		// Turn back on storing of buffer contents
-		gh->flags &= ~GCONSOLE_FLG_NOSTORE;
+		DeferUnlock(gcw);
 
 		#undef gcw
 	}
@@ -249,15 +390,14 @@
 	 * Put a character into our history buffer
 	 */
 	static void putCharInBuffer(GConsoleObject *gcw, char c) {
+		size_t	pos;
+
 		// Only store if we need to
-		if (!gcw->buffer || (gcw->g.flags & GCONSOLE_FLG_NOSTORE))
+		if (!gcw->buffer)
 			return;
 
 		// Do we have enough space in the buffer
-		if (gcw->bufpos >= gcw->bufsize) {
-			char	*p, *ep;
-			size_t	dp;
-
+		while (gcw->buflen >= gcw->bufsize) {
 			/**
 			 * This should never really happen except if the user has changed the window
 			 * size without turning off and then on the buffer. Even then it is unlikely
@@ -268,31 +408,42 @@
 			 * than one line will lead to some interesting scrolling and refreshing
 			 * effects.
 			 */
+			if (gcw->linecnt > 1) {
+				dropLine(gcw);
+				gcw->g.flags |= GCONSOLE_FLG_OVERRUN;
+			} else
+				dropChar(gcw);				// Oops - only one line, just delete one char
+		}
 
-			// Remove one line from the start
-			ep = gcw->buffer+gcw->bufpos;
-			for(p = gcw->buffer; p < ep && *p != '\n'; p++) {
-				#if GWIN_CONSOLE_ESCSEQ
-					if (*p == 27)
-						ESCtoAttr(p[1], &gcw->startattr);
-				#endif
-			}
+		// Save the character
+		pos = gcw->bufstart + gcw->buflen++;
+		if (pos >= gcw->bufsize)
+			pos -= gcw->bufsize;
+		gcw->buffer[pos] = c;
+		gcw->linelen[LastLine(gcw)]++;
+	}
 
-			// Was there a newline?
-			if (*p != '\n')
-				p = gcw->buffer;						// Oops - no newline, just delete one char
-			else
-				gcw->g.flags |= GCONSOLE_FLG_OVERRUN;	// Mark the overrun
+	/**
+	 * Start a new line in our history buffer
+	 */
+	static void newLineInBuffer(GConsoleObject *gcw) {
+		unsigned	ln;
 
-			// Delete the data
-			dp = ++p - gcw->buffer;						// Calculate the amount to to be removed
-			gcw->bufpos -= dp;							// Calculate the new size
-			if (gcw->bufpos)
-				memcpy(gcw->buffer, p, gcw->bufpos);	// Move the rest of the data
+		// Only store if we need to
+		if (!gcw->buffer)
+			return;
+
+		// Do we have enough lines - see the overrun comment above
+		if (gcw->linecnt >= gcw->linemax) {
+			dropLine(gcw);
+			gcw->g.flags |= GCONSOLE_FLG_OVERRUN;
 		}
 
-		// Save the character
-		gcw->buffer[gcw->bufpos++] = c;
+		ln = LineEntry(gcw, gcw->linecnt++);
+		gcw->linelen[ln] = 0;
+		#if GWIN_CONSOLE_ESCSEQ
+			gcw->lineattr[ln] = gcw->currattr;
+		#endif
 	}
 
 	/**
@@ -301,14 +452,56 @@
 	static void clearBuffer(GConsoleObject *gcw) {
 
 		// Only clear if we need to
-		if (!gcw->buffer || (gcw->g.flags & GCONSOLE_FLG_NOSTORE))
+		if (!gcw->buffer)
 			return;
 
-		gcw->bufpos = 0;
+		gcw->buflen = 0;
+		gcw->linecnt = 1;
+		gcw->linelen[gcw->linefirst] = 0;
+		#if GWIN_CONSOLE_ESCSEQ
+			gcw->lineattr[gcw->linefirst] = gcw->currattr;
+		#endif
+
+		// Deferred rendering must redraw everything
+		#if GWIN_CONSOLE_DEFERRED_RENDER
+			gcw->scrolled = gcw->linemax;
+			gcw->dirtyline = 0;
+		#endif
 	}
 
+	#if GWIN_CONSOLE_DEFERRED_RENDER
+		static void DeferTimerFn(void *param) {
+			gwinConsoleFlush((GHandle)param);
+		}
+
+		/**
+		 * Note that the last line has changed and make sure it gets rendered
+		 */
+		static void markDirty(GConsoleObject *gcw) {
+			if (gcw->dirty)
+				return;
+			gcw->dirty = TRUE;
+			gtimerStart(&gcw->defertimer, DeferTimerFn, gcw, FALSE, GWIN_CONSOLE_DEFERRED_PERIOD);
+		}
+	#else
+		#define markDirty(gcw)
+	#endif
+
+	#if GWIN_CONSOLE_ESCSEQ
+		/**
+		 * Record the current attributes as the start attributes of the current line
+		 */
+		static void attrInBuffer(GConsoleObject *gcw) {
+			if (gcw->buffer)
+				gcw->lineattr[LastLine(gcw)] = gcw->currattr;
+		}
+	#endif
+
 #else
+	#define markDirty(gcw)
 	#define putCharInBuffer(gcw, c)
+	#define newLineInBuffer(gcw)
+	#define attrInBuffer(gcw)
 	#define scrollBuffer(gcw)
 	#define clearBuffer(gcw)
 #endif
@@ -318,9 +511,6 @@ static void AfterClear(GWindowObject *gh) {
 	gcw->cx = 0;
 	gcw->cy = 0;
 	clearBuffer(gcw);
-	#if GWIN_CONSOLE_ESCSEQ
-		gcw->startattr = gcw->currattr;
-	#endif
 	#undef gcw		
 }
 
@@ -345,21 +535,25 @@ GHandle gwinGConsoleCreate(GDisplay *g, GConsoleObject *gc, const GWindowInit *p
 		gc->stream.vmt = &GWindowConsoleVMT;
 	#endif
 
-	#if GWIN_CONSOLE_USE_HISTORY
-		gc->buffer = 0;
-		#if GWIN_CONSOLE_HISTORY_ATCREATE
-			gwinConsoleSetBuffer(&gc->g, TRUE);
-		#endif
-	#endif
-
 	gc->cx = 0;
 	gc->cy = 0;
 
 	#if GWIN_CONSOLE_ESCSEQ
-		gc->startattr = gc->currattr = 0;
+		gc->currattr = 0;
 		gc->escstate = 0;
 	#endif
 
+	#if GWIN_CONSOLE_USE_HISTORY
+		gc->buffer = 0;
+		#if GWIN_CONSOLE_DEFERRED_RENDER
+			gfxMutexInit(&gc->defermutex);
+			gtimerInit(&gc->defertimer);
+		#endif
+		#if GWIN_CONSOLE_HISTORY_ATCREATE
+			gwinConsoleSetBuffer(&gc->g, TRUE);
+		#endif
+	#endif
+
 	gwinSetVisible((GHandle)gc, pInit->show);
 	_gwinFlushRedraws(REDRAW_WAIT);
 
@@ -385,7 +579,10 @@ GHandle gwinGConsoleCreate(GDisplay *g, GConsoleObject *gc, const GWindowInit *p
 		// Do we want the buffer turned off?
 		if (!onoff) {
 			if (gcw->buffer) {
-				gfxFree(gcw->buffer);
+				#if GWIN_CONSOLE_DEFERRED_RENDER
+					gwinConsoleSetDeferred(gh, FALSE);
+				#endif
+				gfxFree(gcw->linelen);
 				gcw->buffer = 0;
 			}
 			return FALSE;
@@ -401,43 +598,122 @@ GHandle gwinGConsoleCreate(GDisplay *g, GConsoleObject *gc, const GWindowInit *p
 		#else
 			gcw->bufsize = gh->width / gdispGetFontMetric(gh->font, fontMinWidth);
 		#endif
-		gcw->bufsize++;				// Allow space for a newline on each line.
+		gcw->bufsize++;				// Allow a little space for escape sequences on each line.
 
-		// Multiply by the number of lines
-		gcw->bufsize *= gh->height / gdispGetFontMetric(gh->font, fontHeight);
+		// Multiply by the number of lines. One extra line entry is needed for the lazy scroll.
+		gcw->linemax = gh->height / gdispGetFontMetric(gh->font, fontHeight);
+		gcw->bufsize *= gcw->linemax;
+		gcw->linemax++;
+		if (!gcw->bufsize)
+			return FALSE;
 
-		// Allocate the buffer
-		if (!(gcw->buffer = gfxAlloc(gcw->bufsize)))
+		// Allocate the line ring and the buffer in one block
+		if (!(gcw->linelen = gfxAlloc(gcw->linemax * sizeof(size_t) + gcw->linemax + gcw->bufsize)))
 			return FALSE;
+		#if GWIN_CONSOLE_ESCSEQ
+			gcw->lineattr = (uint8_t *)(gcw->linelen + gcw->linemax);
+			gcw->buffer = (char *)(gcw->lineattr + gcw->linemax);
+		#else
+			gcw->buffer = (char *)(gcw->linelen + gcw->linemax);
+		#endif
 
 		// All good!
 		gh->flags &= ~GCONSOLE_FLG_OVERRUN;
-		gcw->bufpos = 0;
+		gcw->bufstart = 0;
+		gcw->linefirst = 0;
+		clearBuffer(gcw);
 		return TRUE;
 		
 		#undef gcw
 	}
+
+	#if GWIN_CONSOLE_DEFERRED_RENDER
+		bool_t gwinConsoleSetDeferred(GHandle gh, bool_t deferred) {
+			#define gcw		((GConsoleObject *)gh)
+
+			if (gh->vmt != &consoleVMT)
+				return FALSE;
+
+			// Do we want immediate rendering?
+			if (!deferred) {
+				if ((gh->flags & GCONSOLE_FLG_DEFERRED)) {
+					gwinConsoleFlush(gh);
+					gh->flags &= ~GCONSOLE_FLG_DEFERRED;
+					gtimerStop(&gcw->defertimer);
+				}
+				return FALSE;
+			}
+
+			// We need the history to render from
+			if (!gcw->buffer)
+				return FALSE;
+
+			// The display currently shows the history
+			if (!(gh->flags & GCONSOLE_FLG_DEFERRED)) {
+				DeferLock(gcw);
+				gcw->dirty = FALSE;
+				gcw->scrolled = 0;
+				gcw->dirtyline = gcw->linecnt-1;
+				DeferUnlock(gcw);
+				gh->flags |= GCONSOLE_FLG_DEFERRED;
+			}
+			return TRUE;
+
+			#undef gcw
+		}
+
+		void gwinConsoleFlush(GHandle gh) {
+			#define gcw		((GConsoleObject *)gh)
+			#if GDISP_NEED_SCROLL
+				coord_t		fy;
+			#endif
+
+			if (gh->vmt != &consoleVMT || !gcw->buffer)
+				return;
+
+			// If we are not visible we will be completely redrawn when we become visible
+			if (!_gwinDrawStart(gh)) {
+				DeferLock(gcw);
+				gcw->dirty = FALSE;
+				DeferUnlock(gcw);
+				return;
+			}
+
+			DeferLock(gcw);
+			if (gcw->dirty) {
+				gcw->dirty = FALSE;
+
+				// Move what is already on the display (if we can) so only the changed lines need drawing
+				if (gcw->scrolled) {
+					#if GDISP_NEED_SCROLL
+						fy = gdispGetFontMetric(gh->font, fontHeight);
+						if ((coord_t)(gcw->scrolled*fy) < gh->height)
+							gdispGVerticalScroll(gwinGetDrawDisplay(gh), gwinGetDrawX(gh), gwinGetDrawY(gh), gh->width, gh->height, gcw->scrolled*fy, gh->bgcolor);
+						else
+					#endif
+						gcw->dirtyline = 0;
+				}
+
+				drawLines(gcw, gcw->dirtyline);
+				gcw->scrolled = 0;
+				gcw->dirtyline = gcw->linecnt-1;
+			}
+			DeferUnlock(gcw);
+
+			_gwinDrawEnd(gh);
+
+			#undef gcw
+		}
+	#endif
 #endif
 
-/*
- *  We can get into gwinPutChar() 2 ways -
- *  	1. when the user calls us, and
- *  	2. when the redraw uses us to redraw the display.
- *  When called by option 2 we MUST not try to obtain a draw session
- *  as we already have one.
- *
- *  We use these macro's below to make sure we do that safely
+/**
+ * Put a character on the console (the caller has checked the window and taken any lock needed)
  */
-#define DrawStart(gh)		((gh->flags & GCONSOLE_FLG_NOSTORE) || _gwinDrawStart(gh))
-#define DrawEnd(gh)			{ if (!(gh->flags & GCONSOLE_FLG_NOSTORE)) _gwinDrawEnd(gh); }
-
-void gwinPutChar(GHandle gh, char c) {
+static void putChar(GHandle gh, char c) {
 	#define gcw		((GConsoleObject *)gh)
 	uint8_t			width, fy;
 
-	if (gh->vmt != &consoleVMT || !gh->font)
-		return;
-
 	fy = gdispGetFontMetric(gh->font, fontHeight);
 
 	#if GWIN_CONSOLE_ESCSEQ
@@ -457,8 +733,8 @@ void gwinPutChar(GHandle gh, char c) {
 		case 1:
 			gcw->escstate = 0;
 			if (ESCtoAttr(c, &gcw->currattr)) {
-				if (gcw->cx == 0 && gcw->cy == 0)
-					gcw->startattr = gcw->currattr;
+				if (gcw->cx == 0)
+					attrInBuffer(gcw);
 				else {
 					putCharInBuffer(gcw, 27);
 					putCharInBuffer(gcw, c);
@@ -468,13 +744,14 @@ void gwinPutChar(GHandle gh, char c) {
 				case 'J':
 					// Clear the console and reset the cursor
 					clearBuffer(gcw);
-					if (DrawStart(gh)) {
-						gdispGFillArea(gh->display, gh->x, gh->y, gh->width, gh->height, gh->bgcolor);
-						DrawEnd(gh);
+					if (Deferred(gh))
+						markDirty(gcw);
+					else if (_gwinDrawStart(gh)) {
+						gdispGFillArea(gwinGetDrawDisplay(gh), gwinGetDrawX(gh), gwinGetDrawY(gh), gh->width, gh->height, gh->bgcolor);
+						_gwinDrawEnd(gh);
 					}
 					gcw->cx = 0;
 					gcw->cy = 0;
-					gcw->startattr = gcw->currattr;
 					break;
 				}
 			}
@@ -496,15 +773,15 @@ void gwinPutChar(GHandle gh, char c) {
 	case '\n':
 		// clear to the end of the line
 		#if GWIN_CONSOLE_USE_CLEAR_LINES
-			if (gcw->cx == 0 && gcw->cy+fy < gh->height && DrawStart(gh)) {
-				gdispGFillArea(gh->display, gh->x, gh->y + gcw->cy, gh->width, fy, gh->bgcolor);
-				DrawEnd(gh);
+			if (gcw->cx == 0 && gcw->cy+fy < gh->height && !Deferred(gh) && _gwinDrawStart(gh)) {
+				gdispGFillArea(gwinGetDrawDisplay(gh), gwinGetDrawX(gh), gwinGetDrawY(gh) + gcw->cy, gh->width, fy, gh->bgcolor);
+				_gwinDrawEnd(gh);
 			}
 		#endif
 		// update the cursor
 		gcw->cx = 0;
 		gcw->cy += fy;
-		putCharInBuffer(gcw, '\n');
+		newLineInBuffer(gcw);
 		// We use lazy scrolling here and only scroll when the next char arrives
 		return;
 
@@ -533,32 +810,42 @@ void gwinPutChar(GHandle gh, char c) {
 	if (gcw->cx + width >= gh->width) {
 		gcw->cx = 0;
 		gcw->cy += fy;
-		putCharInBuffer(gcw, '\n');
+		newLineInBuffer(gcw);
 	}
 
 	// Do we need to scroll to fit this character?
 	if (gcw->cy + fy > gh->height) {
+		#if GWIN_CONSOLE_DEFERRED_RENDER
+			if (Deferred(gh)) {
+				// Just drop lines from the history - the display catches up when it is rendered
+				gh->flags &= ~GCONSOLE_FLG_OVERRUN;
+				while (gcw->linecnt > 1 && (coord_t)(gcw->linecnt*fy) > gh->height)
+					dropLine(gcw);
+				gcw->cx = 0;
+				gcw->cy = (gcw->linecnt-1)*fy;
+			} else
+		#endif
 		#if GWIN_CONSOLE_USE_HISTORY && GWIN_CONSOLE_BUFFER_SCROLLING
 			if (gcw->buffer) {
-				// If flag GCONSOLE_FLG_NOSTORE is set, then do not recursivly call HistoryRedraw - just drop the buffer
-				if (gh->flags & GCONSOLE_FLG_NOSTORE)
-					gcw->bufpos = 0;
-					
-				// Scroll the buffer and then redraw using the buffer
-				scrollBuffer(gcw);
-				if (DrawStart(gh)) {
+				// Scroll the buffer and then redraw using the buffer.
+				// The redraw makes the display match the buffer so any overrun is already accounted for.
+				gh->flags &= ~GCONSOLE_FLG_OVERRUN;
+				while (gcw->linecnt > 1 && (coord_t)(gcw->linecnt*fy) > gh->height)
+					dropLine(gcw);
+				if (_gwinDrawStart(gh)) {
 					HistoryRedraw(gh);
-					DrawEnd(gh);
+					_gwinDrawEnd(gh);
 				}
 			} else
 		#endif
 		#if GDISP_NEED_SCROLL
 			{
-				// Scroll the console using hardware
+				// Scroll the console pixels (using hardware if we have it).
+				// The history buffer is kept in step so a full redraw still shows the same thing.
 				scrollBuffer(gcw);
-				if (DrawStart(gh)) {
-					gdispGVerticalScroll(gh->display, gh->x, gh->y, gh->width, gh->height, fy, gh->bgcolor);
-					DrawEnd(gh);
+				if (_gwinDrawStart(gh)) {
+					gdispGVerticalScroll(gwinGetDrawDisplay(gh), gwinGetDrawX(gh), gwinGetDrawY(gh), gh->width, gh->height, fy, gh->bgcolor);
+					_gwinDrawEnd(gh);
 				}
 
 				// Set the cursor to the start of the last line
@@ -569,15 +856,12 @@ void gwinPutChar(GHandle gh, char c) {
 			{
 				// Clear the console and reset the cursor
 				clearBuffer(gcw);
-				if (DrawStart(gh)) {
-					gdispGFillArea(gh->display, gh->x, gh->y, gh->width, gh->height, gh->bgcolor);
-					DrawEnd(gh);
+				if (_gwinDrawStart(gh)) {
+					gdispGFillArea(gwinGetDrawDisplay(gh), gwinGetDrawX(gh), gwinGetDrawY(gh), gh->width, gh->height, gh->bgcolor);
+					_gwinDrawEnd(gh);
 				}
 				gcw->cx = 0;
 				gcw->cy = 0;
-				#if GWIN_CONSOLE_ESCSEQ
-					gcw->startattr = gcw->currattr;
-				#endif
 			}
 		#endif
 	}
@@ -586,32 +870,18 @@ void gwinPutChar(GHandle gh, char c) {
 	putCharInBuffer(gcw, c);
 
 	// Draw the character
-	if (DrawStart(gh)) {
+	if (Deferred(gh))
+		markDirty(gcw);
+	else if (_gwinDrawStart(gh)) {
 
 		// If we are at the beginning of a new line clear the line
 		#if GWIN_CONSOLE_USE_CLEAR_LINES
 			if (gcw->cx == 0)
-				gdispGFillArea(gh->display, gh->x, gh->y + gcw->cy, gh->width, fy, gh->bgcolor);
-		#endif
-
-		#if GWIN_CONSOLE_USE_FILLED_CHARS
-			gdispGFillChar(gh->display, gh->x + gcw->cx, gh->y + gcw->cy, c, gh->font, ESCPrintColor(gcw), gh->bgcolor);
-		#else
-			gdispGDrawChar(gh->display, gh->x + gcw->cx, gh->y + gcw->cy, c, gh->font, ESCPrintColor(gcw));
-		#endif
-
-		#if GWIN_CONSOLE_ESCSEQ
-			// Draw the underline
-			if ((gcw->currattr & ESC_UNDERLINE))
-				gdispGDrawLine(gh->display, gh->x + gcw->cx, gh->y + gcw->cy + fy - gdispGetFontMetric(gh->font, fontDescendersHeight),
-											gh->x + gcw->cx + width + gdispGetFontMetric(gh->font, fontCharPadding), gh->y + gcw->cy + fy - gdispGetFontMetric(gh->font, fontDescendersHeight),
-											ESCPrintColor(gcw));
-			// Bold (very crude)
-			if ((gcw->currattr & ESC_BOLD))
-				gdispGDrawChar(gh->display, gh->x + gcw->cx + 1, gh->y + gcw->cy, c, gh->font, ESCPrintColor(gcw));
+				gdispGFillArea(gwinGetDrawDisplay(gh), gwinGetDrawX(gh), gwinGetDrawY(gh) + gcw->cy, gh->width, fy, gh->bgcolor);
 		#endif
 
-		DrawEnd(gh);
+		drawChar(gcw, c, width, fy);
+		_gwinDrawEnd(gh);
 	}
 
 	// Update the cursor
@@ -620,14 +890,56 @@ void gwinPutChar(GHandle gh, char c) {
 	#undef gcw
 }
 
+/*
+ * When rendering is deferred the text is only stored in the history so the history lock
+ * is taken once for each call. Otherwise we draw as we go and the draw lock is used instead.
+ */
+#if GWIN_CONSOLE_DEFERRED_RENDER
+	static bool_t PutStart(GHandle gh) {
+		if (!Deferred(gh))
+			return FALSE;
+		DeferLock((GConsoleObject *)gh);
+		return TRUE;
+	}
+	#define PutEnd(gh, locked)		{ if (locked) DeferUnlock((GConsoleObject *)gh); }
+#else
+	#define PutStart(gh)			FALSE
+	#define PutEnd(gh, locked)		{ (void) locked; }
+#endif
+
+void gwinPutChar(GHandle gh, char c) {
+	bool_t	locked;
+
+	if (gh->vmt != &consoleVMT || !gh->font)
+		return;
+
+	locked = PutStart(gh);
+	putChar(gh, c);
+	PutEnd(gh, locked);
+}
+
 void gwinPutString(GHandle gh, const char *str) {
+	bool_t	locked;
+
+	if (gh->vmt != &consoleVMT || !gh->font)
+		return;
+
+	locked = PutStart(gh);
 	while(*str)
-		gwinPutChar(gh, *str++);
+		putChar(gh, *str++);
+	PutEnd(gh, locked);
 }
 
 void gwinPutCharArray(GHandle gh, const char *str, size_t n) {
+	bool_t	locked;
+
+	if (gh->vmt != &consoleVMT || !gh->font)
+		return;
+
+	locked = PutStart(gh);
 	while(n--)
-		gwinPutChar(gh, *str++);
+		putChar(gh, *str++);
+	PutEnd(gh, locked);
 }
 
 #include <stdarg.h>
@@ -678,6 +990,7 @@ void gwinPrintf(GHandle gh, const char *fmt, ...) {
 	int i, precision, width;
 	bool_t is_long, left_align;
 	long l;
+	bool_t locked;
 	#if GWIN_CONSOLE_USE_FLOAT
 		float f;
 		char tmpbuf[2*MAX_FILLER + 1];
@@ -688,15 +1001,17 @@ void gwinPrintf(GHandle gh, const char *fmt, ...) {
 	if (gh->vmt != &consoleVMT || !gh->font)
 		return;
 
+	locked = PutStart(gh);
 	va_start(ap, fmt);
 	while (TRUE) {
 		c = *fmt++;
 		if (c == 0) {
 			va_end(ap);
+			PutEnd(gh, locked);
 			return;
 		}
 		if (c != '%') {
-			gwinPutChar(gh, c);
+			putChar(gh, c);
 			continue;
 		}
 
@@ -812,17 +1127,17 @@ void gwinPrintf(GHandle gh, const char *fmt, ...) {
 			width = -width;
 		if (width < 0) {
 			if (*s == '-' && filler == '0') {
-				gwinPutChar(gh, *s++);
+				putChar(gh, *s++);
 				i--;
 			}
 			do {
-				gwinPutChar(gh, filler);
+				putChar(gh, filler);
 			} while (++width != 0);
 		}
 		while (--i >= 0)
-			gwinPutChar(gh, *s++);
+			putChar(gh, *s++);
 		while (width) {
-			gwinPutChar(gh, filler);
+			putChar(gh, filler);
 			width--;
 		}
 	}
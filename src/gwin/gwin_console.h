@@ -34,15 +34,29 @@ typedef struct GConsoleObject {
 	coord_t			cx, cy;			// Cursor position
 
 	#if GWIN_CONSOLE_ESCSEQ
-		uint8_t		startattr;		// ANSI-like escape sequences
-		uint8_t		currattr;
+		uint8_t		currattr;		// ANSI-like escape sequences
 		uint16_t	escstate;
 	#endif
 
 	#if GWIN_CONSOLE_USE_HISTORY
-		char *		buffer;			// buffer to store console content
+		char *		buffer;			// ring buffer to store console content
 		size_t		bufsize;		// size of buffer
-		size_t		bufpos;			// the position of the next char
+		size_t		bufstart;		// the position of the oldest char
+		size_t		buflen;			// the number of chars in the buffer
+		size_t *	linelen;		// the number of chars in each line (a ring of linemax entries)
+		#if GWIN_CONSOLE_ESCSEQ
+			uint8_t *	lineattr;	// the attributes at the start of each line
+		#endif
+		unsigned	linemax;		// the number of entries in the line ring
+		unsigned	linefirst;		// the ring entry of the oldest line
+		unsigned	linecnt;		// the number of lines (there is always at least one)
+		#if GWIN_CONSOLE_DEFERRED_RENDER
+			gfxMutex	defermutex;	// protects the history while rendering is deferred
+			GTimer		defertimer;	// renders the pending output
+			unsigned	dirtyline;	// the first line that needs rendering
+			unsigned	scrolled;	// the number of lines scrolled since the last render
+			bool_t		dirty;		// there is output waiting to be rendered
+		#endif
 	#endif
 
 	#if GFX_USE_OS_CHIBIOS && GWIN_CONSOLE_USE_BASESTREAM
@@ -111,6 +125,34 @@ GHandle gwinGConsoleCreate(GDisplay *g, GConsoleObject *gc, const GWindowInit *p
 	 * @return	TRUE if the history buffer is now turned on.
 	 */
 	bool_t gwinConsoleSetBuffer(GHandle gh, bool_t onoff);
+
+	#if GWIN_CONSOLE_DEFERRED_RENDER
+		/**
+		 * @brief	Defer the rendering of console output.
+		 * @pre		GWIN_CONSOLE_DEFERRED_RENDER must be set to TRUE in your gfxconf.h
+		 *
+		 * @param[in] gh		The window handle (must be a console window)
+		 * @param[in] deferred	If TRUE output is only stored in the history buffer and the display
+		 * 						is updated at most once every @p GWIN_CONSOLE_DEFERRED_PERIOD milliseconds.
+		 * 						If FALSE any pending output is rendered and each character is drawn as it arrives.
+		 * @note	The history buffer must already be turned on using @p gwinConsoleSetBuffer().
+		 * 			Turning the history buffer off also turns off deferred rendering.
+		 * @note	This is useful for high rate logging as the thread printing to the console only
+		 * 			stores the text. Only the lines that changed are drawn when the output is rendered.
+		 * @note	Do not change the mode while another thread is printing to the console.
+		 *
+		 * @return	TRUE if rendering is now deferred.
+		 */
+		bool_t gwinConsoleSetDeferred(GHandle gh, bool_t deferred);
+
+		/**
+		 * @brief	Render any deferred console output now.
+		 * @pre		GWIN_CONSOLE_DEFERRED_RENDER must be set to TRUE in your gfxconf.h
+		 *
+		 * @param[in] gh		The window handle (must be a console window)
+		 */
+		void gwinConsoleFlush(GHandle gh);
+	#endif
 #endif
 
 /**
@@ -151,7 +151,7 @@ void gwinContainerDraw_Transparent(GWidgetObject *gw, void *param) {
 		return;
 
 	if ((gw->g.flags & GWIN_CONTAINER_BORDER))
-		gdispGDrawBox(gw->g.display, gw->g.x, gw->g.y, gw->g.width, gw->g.height, (gw->g.flags & GWIN_FLG_SYSENABLED) ? gw->pstyle->enabled.edge : gw->pstyle->disabled.edge);
+		gdispGDrawBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw->g.width, gw->g.height, (gw->g.flags & GWIN_FLG_SYSENABLED) ? gw->pstyle->enabled.edge : gw->pstyle->disabled.edge);
 
 	// Don't touch the client area
 }
@@ -162,7 +162,7 @@ void gwinContainerDraw_Std(GWidgetObject *gw, void *param) {
 	if (gw->g.vmt != (gwinVMT *)&containerVMT)
 		return;
 
-	gdispGFillArea(gw->g.display, gw->g.x, gw->g.y, gw->g.width, gw->g.height, gw->pstyle->background);
+	gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw->g.width, gw->g.height, gw->pstyle->background);
 	gwinContainerDraw_Transparent(gw, param);
 }
 
@@ -178,9 +178,9 @@ void gwinContainerDraw_Std(GWidgetObject *gw, void *param) {
 		gwinContainerDraw_Transparent(gw, param);
 
 		// Draw the client area by tiling the image
-		mx = gw->g.x+gw->g.width;
-		my = gw->g.y+gw->g.height;
-		y = gw->g.y;
+		mx = gwinGetDrawX(&gw->g)+gw->g.width;
+		my = gwinGetDrawY(&gw->g)+gw->g.height;
+		y = gwinGetDrawY(&gw->g);
 		if ((gw->g.flags & GWIN_CONTAINER_BORDER)) {
 			mx--;
 			my--;
@@ -189,13 +189,13 @@ void gwinContainerDraw_Std(GWidgetObject *gw, void *param) {
 		for(ih=gi->height; y < my; y += ih) {
 			if (ih > my - y)
 				ih = my - y;
-			x = gw->g.x;
+			x = gwinGetDrawX(&gw->g);
 			if ((gw->g.flags & GWIN_CONTAINER_BORDER))
 				x++;
 			for(iw=gi->width; x < mx; x += iw) {
 				if (iw > mx - x)
 					iw = mx - x;
-				gdispGImageDraw(gw->g.display, gi, x, y, iw, ih, 0, 0);
+				gdispGImageDraw(gwinGetDrawDisplay(&gw->g), gi, x, y, iw, ih, 0, 0);
 			}
 		}
 
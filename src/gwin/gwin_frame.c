@@ -45,9 +45,13 @@ static coord_t FrameBorderSizeB(GHandle gh)	{ (void)gh; return FRM_BORDER_B; }
 static void forceFrameRedraw(GWidgetObject *gw) {
 	// Force a redraw of just the frame.
 	// This is a big naughty but who really cares.
+	// Drawing it as a direct drawing operation lets the window manager redirect it.
+	if (!_gwinDrawStart(&gw->g))
+		return;
 	gw->g.flags |= GWIN_FRAME_REDRAW_FRAME;
 	gw->fnDraw(gw, gw->fnParam);
 	gw->g.flags &= ~GWIN_FRAME_REDRAW_FRAME;
+	_gwinDrawEnd(&gw->g);
 }
 
 #if GINPUT_NEED_MOUSE
@@ -242,33 +246,33 @@ void gwinFrameDraw_Transparent(GWidgetObject *gw, void *param) {
 	btn = gdispBlendColor(pcol->edge, contrast, 128);
 
 	// Render the frame
-	gdispGFillStringBox(gw->g.display, gw->g.x, gw->g.y, gw->g.width, FRM_BORDER_T, gw->text, gw->g.font, contrast, pcol->edge, justifyCenter);
-	gdispGFillArea(gw->g.display, gw->g.x, gw->g.y+FRM_BORDER_T, FRM_BORDER_L, gw->g.height-(FRM_BORDER_T+FRM_BORDER_B), pcol->edge);
-	gdispGFillArea(gw->g.display, gw->g.x+gw->g.width-FRM_BORDER_R, gw->g.y+FRM_BORDER_T, FRM_BORDER_R, gw->g.height-(FRM_BORDER_T+FRM_BORDER_B), pcol->edge);
-	gdispGFillArea(gw->g.display, gw->g.x, gw->g.y+gw->g.height-FRM_BORDER_B, gw->g.width, FRM_BORDER_B, pcol->edge);
+	gdispGFillStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw->g.width, FRM_BORDER_T, gw->text, gw->g.font, contrast, pcol->edge, justifyCenter);
+	gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g)+FRM_BORDER_T, FRM_BORDER_L, gw->g.height-(FRM_BORDER_T+FRM_BORDER_B), pcol->edge);
+	gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+gw->g.width-FRM_BORDER_R, gwinGetDrawY(&gw->g)+FRM_BORDER_T, FRM_BORDER_R, gw->g.height-(FRM_BORDER_T+FRM_BORDER_B), pcol->edge);
+	gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g)+gw->g.height-FRM_BORDER_B, gw->g.width, FRM_BORDER_B, pcol->edge);
 
 	// Add the buttons
-	pos = gw->g.x+gw->g.width - (FRM_BORDER_R+FRM_BUTTON_X);
+	pos = gwinGetDrawX(&gw->g)+gw->g.width - (FRM_BORDER_R+FRM_BUTTON_X);
 
 	if ((gw->g.flags & GWIN_FRAME_CLOSE_BTN)) {
 		if ((gw->g.flags & GWIN_FRAME_CLOSE_PRESSED))
-			gdispFillArea(pos, gw->g.y+FRM_BUTTON_T, FRM_BUTTON_X, FRM_BUTTON_Y, btn);
-		gdispDrawLine(pos+FRM_BUTTON_I, gw->g.y+(FRM_BUTTON_T+FRM_BUTTON_I), pos+(FRM_BUTTON_X-FRM_BUTTON_I-1), gw->g.y+(FRM_BUTTON_T+FRM_BUTTON_Y-FRM_BUTTON_I-1), contrast);
-		gdispDrawLine(pos+(FRM_BUTTON_X-FRM_BUTTON_I-1), gw->g.y+(FRM_BUTTON_T+FRM_BUTTON_I), pos+FRM_BUTTON_I, gw->g.y+(FRM_BUTTON_T+FRM_BUTTON_Y-FRM_BUTTON_I-1), contrast);
+			gdispGFillArea(gwinGetDrawDisplay(&gw->g), pos, gwinGetDrawY(&gw->g)+FRM_BUTTON_T, FRM_BUTTON_X, FRM_BUTTON_Y, btn);
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), pos+FRM_BUTTON_I, gwinGetDrawY(&gw->g)+(FRM_BUTTON_T+FRM_BUTTON_I), pos+(FRM_BUTTON_X-FRM_BUTTON_I-1), gwinGetDrawY(&gw->g)+(FRM_BUTTON_T+FRM_BUTTON_Y-FRM_BUTTON_I-1), contrast);
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), pos+(FRM_BUTTON_X-FRM_BUTTON_I-1), gwinGetDrawY(&gw->g)+(FRM_BUTTON_T+FRM_BUTTON_I), pos+FRM_BUTTON_I, gwinGetDrawY(&gw->g)+(FRM_BUTTON_T+FRM_BUTTON_Y-FRM_BUTTON_I-1), contrast);
 		pos -= FRM_BUTTON_X;
 	}
 
 	if ((gw->g.flags & GWIN_FRAME_MINMAX_BTN)) {
 		if ((gw->g.flags & GWIN_FRAME_MAX_PRESSED))
-			gdispFillArea(pos, gw->g.y+FRM_BUTTON_T, FRM_BUTTON_X, FRM_BUTTON_Y, btn);
+			gdispGFillArea(gwinGetDrawDisplay(&gw->g), pos, gwinGetDrawY(&gw->g)+FRM_BUTTON_T, FRM_BUTTON_X, FRM_BUTTON_Y, btn);
 		// the symbol
-		gdispDrawBox(pos+FRM_BUTTON_I, gw->g.y+(FRM_BUTTON_T+FRM_BUTTON_I), FRM_BUTTON_X-2*FRM_BUTTON_I, FRM_BUTTON_Y-2*FRM_BUTTON_I, contrast);
-		gdispDrawLine(pos+(FRM_BUTTON_I+1), gw->g.y+(FRM_BUTTON_T+FRM_BUTTON_I+1), pos+(FRM_BUTTON_X-FRM_BUTTON_I-2), gw->g.y+(FRM_BUTTON_T+FRM_BUTTON_I+1), contrast);
-		gdispDrawLine(pos+(FRM_BUTTON_I+1), gw->g.y+(FRM_BUTTON_T+FRM_BUTTON_I+2), pos+(FRM_BUTTON_X-FRM_BUTTON_I-2), gw->g.y+(FRM_BUTTON_T+FRM_BUTTON_I+2), contrast);
+		gdispGDrawBox(gwinGetDrawDisplay(&gw->g), pos+FRM_BUTTON_I, gwinGetDrawY(&gw->g)+(FRM_BUTTON_T+FRM_BUTTON_I), FRM_BUTTON_X-2*FRM_BUTTON_I, FRM_BUTTON_Y-2*FRM_BUTTON_I, contrast);
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), pos+(FRM_BUTTON_I+1), gwinGetDrawY(&gw->g)+(FRM_BUTTON_T+FRM_BUTTON_I+1), pos+(FRM_BUTTON_X-FRM_BUTTON_I-2), gwinGetDrawY(&gw->g)+(FRM_BUTTON_T+FRM_BUTTON_I+1), contrast);
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), pos+(FRM_BUTTON_I+1), gwinGetDrawY(&gw->g)+(FRM_BUTTON_T+FRM_BUTTON_I+2), pos+(FRM_BUTTON_X-FRM_BUTTON_I-2), gwinGetDrawY(&gw->g)+(FRM_BUTTON_T+FRM_BUTTON_I+2), contrast);
 		pos -= FRM_BUTTON_X;
 		if ((gw->g.flags & GWIN_FRAME_MIN_PRESSED))
-			gdispFillArea(pos, gw->g.y+FRM_BUTTON_T, FRM_BUTTON_X, FRM_BUTTON_Y, btn);
-		gdispDrawLine(pos+FRM_BUTTON_I, gw->g.y+(FRM_BUTTON_T+FRM_BUTTON_Y-FRM_BUTTON_I-1), pos+(FRM_BUTTON_X-FRM_BUTTON_I-1), gw->g.y+(FRM_BUTTON_T+FRM_BUTTON_Y-FRM_BUTTON_I-1), contrast);
+			gdispGFillArea(gwinGetDrawDisplay(&gw->g), pos, gwinGetDrawY(&gw->g)+FRM_BUTTON_T, FRM_BUTTON_X, FRM_BUTTON_Y, btn);
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), pos+FRM_BUTTON_I, gwinGetDrawY(&gw->g)+(FRM_BUTTON_T+FRM_BUTTON_Y-FRM_BUTTON_I-1), pos+(FRM_BUTTON_X-FRM_BUTTON_I-1), gwinGetDrawY(&gw->g)+(FRM_BUTTON_T+FRM_BUTTON_Y-FRM_BUTTON_I-1), contrast);
 		pos -= FRM_BUTTON_X;
 	}
 
@@ -289,7 +293,7 @@ void gwinFrameDraw_Std(GWidgetObject *gw, void *param) {
 		return;
 
 	// Draw the client area
-	gdispGFillArea(gw->g.display, gw->g.x + FRM_BORDER_L, gw->g.y + FRM_BORDER_T, gw->g.width - (FRM_BORDER_L+FRM_BORDER_R), gw->g.height - (FRM_BORDER_T+FRM_BORDER_B), gw->pstyle->background);
+	gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g) + FRM_BORDER_L, gwinGetDrawY(&gw->g) + FRM_BORDER_T, gw->g.width - (FRM_BORDER_L+FRM_BORDER_R), gw->g.height - (FRM_BORDER_T+FRM_BORDER_B), gw->pstyle->background);
 }
 
 #if GDISP_NEED_IMAGE
@@ -308,15 +312,15 @@ void gwinFrameDraw_Std(GWidgetObject *gw, void *param) {
 			return;
 
 		// Draw the client area by tiling the image
-		mx = gw->g.x+gw->g.width - FRM_BORDER_R;
-		my = gw->g.y+gw->g.height - FRM_BORDER_B;
-		for(y = gw->g.y+FRM_BORDER_T, ih = gi->height; y < my; y += ih) {
+		mx = gwinGetDrawX(&gw->g)+gw->g.width - FRM_BORDER_R;
+		my = gwinGetDrawY(&gw->g)+gw->g.height - FRM_BORDER_B;
+		for(y = gwinGetDrawY(&gw->g)+FRM_BORDER_T, ih = gi->height; y < my; y += ih) {
 			if (ih > my - y)
 				ih = my - y;
-			for(x = gw->g.x+FRM_BORDER_L, iw = gi->width; x < mx; x += iw) {
+			for(x = gwinGetDrawX(&gw->g)+FRM_BORDER_L, iw = gi->width; x < mx; x += iw) {
 				if (iw > mx - x)
 					iw = mx - x;
-				gdispGImageDraw(gw->g.display, gi, x, y, iw, ih, 0, 0);
+				gdispGImageDraw(gwinGetDrawDisplay(&gw->g), gi, x, y, iw, ih, 0, 0);
 			}
 		}
 
@@ -42,26 +42,26 @@ static void pointto(GGraphObject *gg, coord_t x, coord_t y, const GGraphPointSty
 		return;
 
 	// Convert to device space. Note the y-axis is inverted.
-	x += gg->g.x + gg->xorigin;
-	y = gg->g.y + gg->g.height - 1 - gg->yorigin - y;
+	x += gwinGetDrawX(&gg->g) + gg->xorigin;
+	y = gwinGetDrawY(&gg->g) + gg->g.height - 1 - gg->yorigin - y;
 
 	if (style->size <= 1) {
-		gdispGDrawPixel(gg->g.display, x, y, style->color);
+		gdispGDrawPixel(gwinGetDrawDisplay(&gg->g), x, y, style->color);
 		return;
 	}
 
 	switch(style->type) {
 	case GGRAPH_POINT_SQUARE:
-		gdispGDrawBox(gg->g.display, x-style->size, y-style->size, 2*style->size, 2*style->size, style->color);
+		gdispGDrawBox(gwinGetDrawDisplay(&gg->g), x-style->size, y-style->size, 2*style->size, 2*style->size, style->color);
 		break;
 #if GDISP_NEED_CIRCLE
 	case GGRAPH_POINT_CIRCLE:
-		gdispGDrawCircle(gg->g.display, x, y, style->size, style->color);
+		gdispGDrawCircle(gwinGetDrawDisplay(&gg->g), x, y, style->size, style->color);
 		break;
 #endif
 	case GGRAPH_POINT_DOT:
 	default:
-		gdispGDrawPixel(gg->g.display, x, y, style->color);
+		gdispGDrawPixel(gwinGetDrawDisplay(&gg->g), x, y, style->color);
 		break;
 	}
 }
@@ -76,14 +76,14 @@ static void lineto(GGraphObject *gg, coord_t x0, coord_t y0, coord_t x1, coord_t
 		return;
 
 	// Convert to device space. Note the y-axis is inverted.
-	x0 += gg->g.x + gg->xorigin;
-	y0 = gg->g.y + gg->g.height - 1 - gg->yorigin - y0;
-	x1 += gg->g.x + gg->xorigin;
-	y1 = gg->g.y + gg->g.height - 1 - gg->yorigin - y1;
+	x0 += gwinGetDrawX(&gg->g) + gg->xorigin;
+	y0 = gwinGetDrawY(&gg->g) + gg->g.height - 1 - gg->yorigin - y0;
+	x1 += gwinGetDrawX(&gg->g) + gg->xorigin;
+	y1 = gwinGetDrawY(&gg->g) + gg->g.height - 1 - gg->yorigin - y1;
 
 	if (style->size <= 0) {
 		// Use the driver to draw a solid line
-		gdispGDrawLine(gg->g.display, x0, y0, x1, y1, style->color);
+		gdispGDrawLine(gwinGetDrawDisplay(&gg->g), x0, y0, x1, y1, style->color);
 		return;
 	}
 
@@ -101,7 +101,7 @@ static void lineto(GGraphObject *gg, coord_t x0, coord_t y0, coord_t x1, coord_t
 	case GGRAPH_LINE_SOLID:
 	default:
 		// Use the driver to draw a solid line
-		gdispGDrawLine(gg->g.display, x0, y0, x1, y1, style->color);
+		gdispGDrawLine(gwinGetDrawDisplay(&gg->g), x0, y0, x1, y1, style->color);
 		return;
 	}
 
@@ -131,7 +131,7 @@ static void lineto(GGraphObject *gg, coord_t x0, coord_t y0, coord_t x1, coord_t
 			if (run++ >= 0) {
 				if (run >= run_on)
 					run = run_off;
-				gdispGDrawPixel(gg->g.display, x0, y0, style->color);
+				gdispGDrawPixel(gwinGetDrawDisplay(&gg->g), x0, y0, style->color);
 			}
 			if (P < 0) {
 				P  += dy;
@@ -151,7 +151,7 @@ static void lineto(GGraphObject *gg, coord_t x0, coord_t y0, coord_t x1, coord_t
 			if (run++ >= 0) {
 				if (run >= run_on)
 					run = run_off;
-				gdispGDrawPixel(gg->g.display, x0, y0, style->color);
+				gdispGDrawPixel(gwinGetDrawDisplay(&gg->g), x0, y0, style->color);
 			}
 			if (P < 0) {
 				P  += dx;
@@ -19,6 +19,9 @@
 #define gw	((GImageObject *)gh)
 
 static void ImageDestroy(GWindowObject *gh) {
+	#if GDISP_NEED_IMAGE_ASYNC
+		gdispImageDecodeCancel(&gw->job);
+	#endif
 	if (gdispImageIsOpen(&gw->image))
 		gdispImageClose(&gw->image);
 }
@@ -29,6 +32,13 @@ static void ImageDestroy(GWindowObject *gh) {
 	}
 #endif
 
+#if GDISP_NEED_IMAGE_ASYNC
+	static void ImageDecoded(gdispImageJob *job, void *param) {
+		(void) job;
+		_gwinUpdate((GHandle)param);
+	}
+#endif
+
 static void ImageRedraw(GHandle gh) {
 	coord_t		x, y, w, h, dx, dy;
 	color_t		bg;
@@ -39,15 +49,15 @@ static void ImageRedraw(GHandle gh) {
 	// The default display area
 	dx = 0;
 	dy = 0;
-	x = gh->x;
-	y = gh->y;
+	x = gwinGetDrawX(gh);
+	y = gwinGetDrawY(gh);
 	w = gh->width;
 	h = gh->height;
 	bg = gwinGetDefaultBgColor();
 
 	// If the image isn't open just clear the area
 	if (!gdispImageIsOpen(&gw->image)) {
-		gdispGFillArea(gh->display, x, y, w, h, bg);
+		gdispGFillArea(gwinGetDrawDisplay(gh), x, y, w, h, bg);
 		return;
 	}
 
@@ -57,8 +67,8 @@ static void ImageRedraw(GHandle gh) {
 		dx = (gh->width-w)/2;
 		x += dx;
 		if (dx)
-			gdispGFillArea(gh->display, gh->x, y, dx, h, bg);
-		gdispGFillArea(gh->display, x+w, y, gh->width-dx-w, h, bg);
+			gdispGFillArea(gwinGetDrawDisplay(gh), gwinGetDrawX(gh), y, dx, h, bg);
+		gdispGFillArea(gwinGetDrawDisplay(gh), x+w, y, gh->width-dx-w, h, bg);
 		dx = 0;
 	}
 
@@ -73,8 +83,8 @@ static void ImageRedraw(GHandle gh) {
 		dy = (gh->height-h)/2;
 		y += dy;
 		if (dy)
-			gdispGFillArea(gh->display, x, gh->y, w, dy, bg);
-		gdispGFillArea(gh->display, x, y+h, w, gh->height-dy-h, bg);
+			gdispGFillArea(gwinGetDrawDisplay(gh), x, gwinGetDrawY(gh), w, dy, bg);
+		gdispGFillArea(gwinGetDrawDisplay(gh), x, y+h, w, gh->height-dy-h, bg);
 		dy = 0;
 	}
 
@@ -83,11 +93,29 @@ static void ImageRedraw(GHandle gh) {
 		dy = (gw->image.height - h)/2;
 	}
 
+	#if GDISP_NEED_IMAGE_ASYNC
+		// Use the background decode if one has been requested
+		switch(gw->job.state) {
+		case GDISP_IMAGE_JOB_QUEUED:
+		case GDISP_IMAGE_JOB_DECODING:
+			// Not ready yet - just clear the area
+			gdispGFillArea(gwinGetDrawDisplay(gh), x, y, w, h, bg);
+			return;
+		case GDISP_IMAGE_JOB_DONE:
+			if (gw->job.pixmap) {
+				gdispGBlitArea(gwinGetDrawDisplay(gh), x, y, w, h, dx, dy, gw->image.width, gdispPixmapGetBits(gw->job.pixmap));
+				return;
+			}
+			// The decode failed - try drawing it directly
+			break;
+		}
+	#endif
+
 	// Reset the background color in case it has changed
 	gdispImageSetBgColor(&gw->image, bg);
 
 	// Display the image
-	gdispGImageDraw(gh->display, &gw->image, x, y, w, h, dx, dy);
+	gdispGImageDraw(gwinGetDrawDisplay(gh), &gw->image, x, y, w, h, dx, dy);
 
 	#if GWIN_NEED_IMAGE_ANIMATION
 		// read the delay for the next frame
@@ -129,6 +157,11 @@ GHandle gwinGImageCreate(GDisplay *g, GImageObject *gobj, GWindowInit *pInit) {
 	#if GWIN_NEED_IMAGE_ANIMATION
 		gtimerInit(&gobj->timer);
 	#endif
+
+	// Initialise the background decode job
+	#if GDISP_NEED_IMAGE_ASYNC
+		gdispImageJobInit(&gobj->job, ImageDecoded, (void *)gobj);
+	#endif
 	
 	gwinSetVisible((GHandle)gobj, pInit->show);
 
@@ -140,6 +173,10 @@ bool_t gwinImageOpenGFile(GHandle gh, GFILE *f) {
 	if (gh->vmt != (gwinVMT *)&imageVMT)
 		return FALSE;
 
+	#if GDISP_NEED_IMAGE_ASYNC
+		gdispImageDecodeCancel(&gw->job);
+	#endif
+
 	if (gdispImageIsOpen(&gw->image))
 		gdispImageClose(&gw->image);
 
@@ -159,5 +196,30 @@ gdispImageError gwinImageCache(GHandle gh) {
 	return gdispImageCache(&gw->image);
 }
 
+#if GDISP_NEED_IMAGE_ASYNC
+	gdispImageError gwinImageDecodeAsync(GHandle gh, gdispImagePriority priority) {
+		gdispImageError	err;
+
+		// is it a valid handle?
+		if (gh->vmt != (gwinVMT *)&imageVMT)
+			return GDISP_IMAGE_ERR_BADFORMAT;
+
+		// Just change the priority if it hasn't started yet
+		if (gw->job.state == GDISP_IMAGE_JOB_QUEUED) {
+			gdispImageDecodeSetPriority(&gw->job, priority);
+			return GDISP_IMAGE_ERR_OK;
+		}
+
+		// Transparent areas are decoded using the window background color
+		gdispImageSetBgColor(&gw->image, gwinGetDefaultBgColor());
+		if ((err = gdispImageDecodeAsync(&gw->job, &gw->image, priority)))
+			return err;
+
+		// Show the window as waiting
+		_gwinUpdate(gh);
+		return GDISP_IMAGE_ERR_OK;
+	}
+#endif
+
 #undef gw
 #endif // GFX_USE_GWIN && GWIN_NEED_IMAGE
@@ -38,6 +38,9 @@ typedef struct GImageObject {
 	#if GWIN_NEED_IMAGE_ANIMATION
 		GTimer			timer;		// Timer used for animated images
 	#endif
+	#if GDISP_NEED_IMAGE_ASYNC
+		gdispImageJob	job;		// The background decode job
+	#endif
 } GImageObject;
 
 #ifdef __cplusplus
@@ -120,6 +123,28 @@ bool_t gwinImageOpenGFile(GHandle gh, GFILE *f);
  */
 gdispImageError gwinImageCache(GHandle gh);
 
+#if GDISP_NEED_IMAGE_ASYNC || defined(__DOXYGEN__)
+	/**
+	 * @brief				Decode the image in the background.
+	 * @details				Until the decode is done the window is drawn in its background color. When it is done
+	 *						the window redraws itself from the decoded frame.
+	 *
+	 * @param[in] gh		The widget (must be an image widget)
+	 * @param[in] priority	The decode priority eg. GDISP_IMAGE_PRIORITY_VISIBLE or GDISP_IMAGE_PRIORITY_PREFETCH
+	 *
+	 * @return				GDISP_IMAGE_ERR_OK (0) on success or an error code.
+	 *
+	 * @pre					GDISP_NEED_IMAGE_ASYNC must be TRUE
+	 *
+	 * @note				If the decode is still waiting to start, calling this again just changes its priority.
+	 * @note				Only the first frame of an animated image is decoded.
+	 * @note				The decode is cancelled if a new image is opened or the window is destroyed.
+	 *
+	 * @api
+	 */
+	gdispImageError gwinImageDecodeAsync(GHandle gh, gdispImagePriority priority);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -497,68 +497,68 @@ void gwinKeyboardDraw_Normal(GWidgetObject *gw, void *param) {
 			switch(*pcap) {
 
 			case  '\001':	// Shift (up-arrow)
-				gdispGFillArea(gw->g.display, gw->g.x+x, gw->g.y+y, cx, cy, pcol->fill);
+				gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x, gwinGetDrawY(&gw->g)+y, cx, cy, pcol->fill);
 
-				gdispGDrawLine(gw->g.display, gw->g.x+x    +cx/4, gw->g.y+y+cy/2, gw->g.x+x+cx/2, gw->g.y+y +cy/4, pcol->text);               /*    / \    */
-				gdispGDrawLine(gw->g.display, gw->g.x+x+cx -cx/4, gw->g.y+y+cy/2, gw->g.x+x+cx/2, gw->g.y+y +cy/4, pcol->text); 
-				gdispGDrawLine(gw->g.display, gw->g.x+x    +cx/4, gw->g.y+y+cy/2, gw->g.x+x+cx/2-cx/6, gw->g.y+y+cy/2, pcol->text);           /*    _ _    */
-				gdispGDrawLine(gw->g.display, gw->g.x+x+cx -cx/4, gw->g.y+y+cy/2, gw->g.x+x+cx/2+cx/6, gw->g.y+y+cy/2, pcol->text);
-				gdispGDrawLine(gw->g.display, gw->g.x+x+cx/2-cx/6, gw->g.y+y+cy/2, gw->g.x+x+cx/2-cx/6, gw->g.y+y+cy -cy/3, pcol->text);      /*    ||     */
-				gdispGDrawLine(gw->g.display, gw->g.x+x+cx/2+cx/6, gw->g.y+y+cy/2, gw->g.x+x+cx/2+cx/6, gw->g.y+y+cy -cy/3, pcol->text);
-				gdispGDrawLine(gw->g.display, gw->g.x+x+cx/2-cx/6, gw->g.y+y+cy -cy/3, gw->g.x+x+cx/2+cx/6, gw->g.y+y+cy -cy/3, pcol->text);  /*    _      */
+				gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x    +cx/4, gwinGetDrawY(&gw->g)+y+cy/2, gwinGetDrawX(&gw->g)+x+cx/2, gwinGetDrawY(&gw->g)+y +cy/4, pcol->text);               /*    / \    */
+				gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x+cx -cx/4, gwinGetDrawY(&gw->g)+y+cy/2, gwinGetDrawX(&gw->g)+x+cx/2, gwinGetDrawY(&gw->g)+y +cy/4, pcol->text); 
+				gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x    +cx/4, gwinGetDrawY(&gw->g)+y+cy/2, gwinGetDrawX(&gw->g)+x+cx/2-cx/6, gwinGetDrawY(&gw->g)+y+cy/2, pcol->text);           /*    _ _    */
+				gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x+cx -cx/4, gwinGetDrawY(&gw->g)+y+cy/2, gwinGetDrawX(&gw->g)+x+cx/2+cx/6, gwinGetDrawY(&gw->g)+y+cy/2, pcol->text);
+				gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x+cx/2-cx/6, gwinGetDrawY(&gw->g)+y+cy/2, gwinGetDrawX(&gw->g)+x+cx/2-cx/6, gwinGetDrawY(&gw->g)+y+cy -cy/3, pcol->text);      /*    ||     */
+				gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x+cx/2+cx/6, gwinGetDrawY(&gw->g)+y+cy/2, gwinGetDrawX(&gw->g)+x+cx/2+cx/6, gwinGetDrawY(&gw->g)+y+cy -cy/3, pcol->text);
+				gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x+cx/2-cx/6, gwinGetDrawY(&gw->g)+y+cy -cy/3, gwinGetDrawX(&gw->g)+x+cx/2+cx/6, gwinGetDrawY(&gw->g)+y+cy -cy/3, pcol->text);  /*    _      */
 
 				break;
 
 			case '\002':	// Shift locked (underlined up-arrow)
-				gdispGFillArea(gw->g.display, gw->g.x+x, gw->g.y+y, cx, cy, pcol->fill);
+				gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x, gwinGetDrawY(&gw->g)+y, cx, cy, pcol->fill);
 
-				gdispGDrawLine(gw->g.display, gw->g.x+x    +cx/4, gw->g.y+y+cy/2, gw->g.x+x+cx/2, gw->g.y+y +cy/4, pcol->text);               /*   / \     */
-				gdispGDrawLine(gw->g.display, gw->g.x+x+cx -cx/4, gw->g.y+y+cy/2, gw->g.x+x+cx/2, gw->g.y+y +cy/4, pcol->text);    
-				gdispGDrawLine(gw->g.display, gw->g.x+x    +cx/4, gw->g.y+y+cy/2, gw->g.x+x+cx/2-cx/6, gw->g.y+y+cy/2, pcol->text);           /*   _ _     */
-				gdispGDrawLine(gw->g.display, gw->g.x+x+cx -cx/4, gw->g.y+y+cy/2, gw->g.x+x+cx/2+cx/6, gw->g.y+y+cy/2, pcol->text);
-				gdispGDrawLine(gw->g.display, gw->g.x+x+cx/2-cx/6, gw->g.y+y+cy/2, gw->g.x+x+cx/2-cx/6, gw->g.y+y+cy -cy/3, pcol->text);      /*    ||     */
-				gdispGDrawLine(gw->g.display, gw->g.x+x+cx/2+cx/6, gw->g.y+y+cy/2, gw->g.x+x+cx/2+cx/6, gw->g.y+y+cy -cy/3, pcol->text);
-				gdispGDrawLine(gw->g.display, gw->g.x+x+cx/2-cx/6, gw->g.y+y+cy -cy/3, gw->g.x+x+cx/2+cx/6, gw->g.y+y+cy -cy/3, pcol->text);  /*     _     */
-				gdispGDrawLine(gw->g.display, gw->g.x+x+cx/2-cx/5, gw->g.y+y+cy -cy/4, gw->g.x+x+cx/2+cx/5, gw->g.y+y+cy -cy/4, pcol->text);  /*    ___    */
+				gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x    +cx/4, gwinGetDrawY(&gw->g)+y+cy/2, gwinGetDrawX(&gw->g)+x+cx/2, gwinGetDrawY(&gw->g)+y +cy/4, pcol->text);               /*   / \     */
+				gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x+cx -cx/4, gwinGetDrawY(&gw->g)+y+cy/2, gwinGetDrawX(&gw->g)+x+cx/2, gwinGetDrawY(&gw->g)+y +cy/4, pcol->text);    
+				gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x    +cx/4, gwinGetDrawY(&gw->g)+y+cy/2, gwinGetDrawX(&gw->g)+x+cx/2-cx/6, gwinGetDrawY(&gw->g)+y+cy/2, pcol->text);           /*   _ _     */
+				gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x+cx -cx/4, gwinGetDrawY(&gw->g)+y+cy/2, gwinGetDrawX(&gw->g)+x+cx/2+cx/6, gwinGetDrawY(&gw->g)+y+cy/2, pcol->text);
+				gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x+cx/2-cx/6, gwinGetDrawY(&gw->g)+y+cy/2, gwinGetDrawX(&gw->g)+x+cx/2-cx/6, gwinGetDrawY(&gw->g)+y+cy -cy/3, pcol->text);      /*    ||     */
+				gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x+cx/2+cx/6, gwinGetDrawY(&gw->g)+y+cy/2, gwinGetDrawX(&gw->g)+x+cx/2+cx/6, gwinGetDrawY(&gw->g)+y+cy -cy/3, pcol->text);
+				gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x+cx/2-cx/6, gwinGetDrawY(&gw->g)+y+cy -cy/3, gwinGetDrawX(&gw->g)+x+cx/2+cx/6, gwinGetDrawY(&gw->g)+y+cy -cy/3, pcol->text);  /*     _     */
+				gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x+cx/2-cx/5, gwinGetDrawY(&gw->g)+y+cy -cy/4, gwinGetDrawX(&gw->g)+x+cx/2+cx/5, gwinGetDrawY(&gw->g)+y+cy -cy/4, pcol->text);  /*    ___    */
 
 				break;
 
 			case '\t':	// Tabulator
-				gdispGFillArea(gw->g.display, gw->g.x+x, gw->g.y+y, cx, cy, pcol->fill);
+				gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x, gwinGetDrawY(&gw->g)+y, cx, cy, pcol->fill);
 
-				gdispGDrawLine(gw->g.display, gw->g.x+x+1, gw->g.y+y+1, gw->g.x+x+cx-1, gw->g.y+y+cy/2, pcol->text);
-				gdispGDrawLine(gw->g.display, gw->g.x+x+1, gw->g.y+y+cy-1, gw->g.x+x+cx-1, gw->g.y+y+cy/2, pcol->text);
-				gdispGDrawLine(gw->g.display, gw->g.x+x+cx-1, gw->g.y+y+1, gw->g.x+x+cx-1, gw->g.y+y+cy-1, pcol->text);
+				gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x+1, gwinGetDrawY(&gw->g)+y+1, gwinGetDrawX(&gw->g)+x+cx-1, gwinGetDrawY(&gw->g)+y+cy/2, pcol->text);
+				gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x+1, gwinGetDrawY(&gw->g)+y+cy-1, gwinGetDrawX(&gw->g)+x+cx-1, gwinGetDrawY(&gw->g)+y+cy/2, pcol->text);
+				gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x+cx-1, gwinGetDrawY(&gw->g)+y+1, gwinGetDrawX(&gw->g)+x+cx-1, gwinGetDrawY(&gw->g)+y+cy-1, pcol->text);
 
 				break;
 
 			case '\b': // Backspace
-				gdispGFillArea(gw->g.display, gw->g.x+x, gw->g.y+y, cx, cy, pcol->fill);
+				gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x, gwinGetDrawY(&gw->g)+y, cx, cy, pcol->fill);
 
-				gdispGDrawLine(gw->g.display, gw->g.x+x+ cx/8, gw->g.y+y+cy/2, gw->g.x+x+cx/2, gw->g.y+y    +cy/3, pcol->text);               /* /      */
-				gdispGDrawLine(gw->g.display, gw->g.x+x+ cx/8, gw->g.y+y+cy/2, gw->g.x+x+cx-cx/8, gw->g.y+y+cy/2, pcol->text);                /*  --    */
-				gdispGDrawLine(gw->g.display, gw->g.x+x+ cx/8, gw->g.y+y+cy/2, gw->g.x+x+cx/2, gw->g.y+y+cy -cy/3, pcol->text);               /* \      */
+				gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x+ cx/8, gwinGetDrawY(&gw->g)+y+cy/2, gwinGetDrawX(&gw->g)+x+cx/2, gwinGetDrawY(&gw->g)+y    +cy/3, pcol->text);               /* /      */
+				gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x+ cx/8, gwinGetDrawY(&gw->g)+y+cy/2, gwinGetDrawX(&gw->g)+x+cx-cx/8, gwinGetDrawY(&gw->g)+y+cy/2, pcol->text);                /*  --    */
+				gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x+ cx/8, gwinGetDrawY(&gw->g)+y+cy/2, gwinGetDrawX(&gw->g)+x+cx/2, gwinGetDrawY(&gw->g)+y+cy -cy/3, pcol->text);               /* \      */
 
 				break;
 
 			case '\r': // Enter
-				gdispGFillArea(gw->g.display, gw->g.x+x, gw->g.y+y, cx, cy, pcol->fill);
+				gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x, gwinGetDrawY(&gw->g)+y, cx, cy, pcol->fill);
 
-				gdispGDrawLine(gw->g.display, gw->g.x+x+(cx/3)*2, gw->g.y+y+cy/2, gw->g.x+x+(cx/3)*2, gw->g.y+y+cy/5, pcol->text);            /*      | */
-				gdispGDrawLine(gw->g.display, gw->g.x+x+ cx/3, gw->g.y+y+cy/2, gw->g.x+x+cx/3 +cx/8, gw->g.y+y+cy/3, pcol->text);             /* /      */
-				gdispGDrawLine(gw->g.display, gw->g.x+x+ cx/3, gw->g.y+y+cy/2, gw->g.x+x+(cx/3)*2, gw->g.y+y+cy/2, pcol->text);               /*  --    */
-				gdispGDrawLine(gw->g.display, gw->g.x+x+ cx/3, gw->g.y+y+cy/2, gw->g.x+x+cx/3 +cx/8, gw->g.y+y+cy -cy/3, pcol->text);         /* \      */
+				gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x+(cx/3)*2, gwinGetDrawY(&gw->g)+y+cy/2, gwinGetDrawX(&gw->g)+x+(cx/3)*2, gwinGetDrawY(&gw->g)+y+cy/5, pcol->text);            /*      | */
+				gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x+ cx/3, gwinGetDrawY(&gw->g)+y+cy/2, gwinGetDrawX(&gw->g)+x+cx/3 +cx/8, gwinGetDrawY(&gw->g)+y+cy/3, pcol->text);             /* /      */
+				gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x+ cx/3, gwinGetDrawY(&gw->g)+y+cy/2, gwinGetDrawX(&gw->g)+x+(cx/3)*2, gwinGetDrawY(&gw->g)+y+cy/2, pcol->text);               /*  --    */
+				gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x+ cx/3, gwinGetDrawY(&gw->g)+y+cy/2, gwinGetDrawX(&gw->g)+x+cx/3 +cx/8, gwinGetDrawY(&gw->g)+y+cy -cy/3, pcol->text);         /* \      */
 
 				break;
 
 			default:   // Regular character
-				gdispGFillStringBox(gw->g.display, gw->g.x+x, gw->g.y+y, cx, cy, pcap, gw->g.font, pcol->text, pcol->fill, justifyCenter);
+				gdispGFillStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x, gwinGetDrawY(&gw->g)+y, cx, cy, pcap, gw->g.font, pcol->text, pcol->fill, justifyCenter);
 				
 				break;
 			}
 			
 			// Draw the frame (border around the entire widget)
-			gdispGDrawBox(gw->g.display, gw->g.x+x, gw->g.y+y, cx, cy, pcol->edge);
+			gdispGDrawBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x, gwinGetDrawY(&gw->g)+y, cx, cy, pcol->edge);
 			
 			// If key up and we already cleared the previous key
 			if ( (gk->keyrow == GKEY_BAD_ROWCOL) && (gk->keycol == GKEY_BAD_ROWCOL) && (gk->lastkeyrow == row) && (gk->lastkeycol == col) ) {
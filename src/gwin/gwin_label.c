@@ -137,8 +137,8 @@ static void gwinLabelDraw(GWidgetObject *gw, justify_t justify) {
 	if (gw->g.vmt != (gwinVMT *)&labelVMT)
 		return;
 
-	w = (gw->g.flags & GLABEL_FLG_WAUTO) ? getwidth(gw->text, gw->g.font, gdispGGetWidth(gw->g.display) - gw->g.x) : gw->g.width;
-	h = (gw->g.flags & GLABEL_FLG_HAUTO) ? getheight(gw->text, gw->g.font, gdispGGetWidth(gw->g.display) - gw->g.x) : gw->g.height;
+	w = (gw->g.flags & GLABEL_FLG_WAUTO) ? getwidth(gw->text, gw->g.font, gdispGGetWidth(gwinGetDrawDisplay(&gw->g)) - gwinGetDrawX(&gw->g)) : gw->g.width;
+	h = (gw->g.flags & GLABEL_FLG_HAUTO) ? getheight(gw->text, gw->g.font, gdispGGetWidth(gwinGetDrawDisplay(&gw->g)) - gwinGetDrawX(&gw->g)) : gw->g.height;
 	c = (gw->g.flags & GWIN_FLG_SYSENABLED) ? gw->pstyle->enabled.text : gw->pstyle->disabled.text;
 
 	if (gw->g.width != w || gw->g.height != h) {
@@ -157,17 +157,17 @@ static void gwinLabelDraw(GWidgetObject *gw, justify_t justify) {
 
 	#if GWIN_LABEL_ATTRIBUTE
 		if (gw2obj->attr) {
-			gdispGFillStringBox(gw->g.display, gw->g.x, gw->g.y, gw2obj->tab, h, gw2obj->attr, gw->g.font, c, gw->pstyle->background, justify);
-			gdispGFillStringBox(gw->g.display, gw->g.x + gw2obj->tab, gw->g.y, w-gw2obj->tab, h, gw->text, gw->g.font, c, gw->pstyle->background, justify);
+			gdispGFillStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw2obj->tab, h, gw2obj->attr, gw->g.font, c, gw->pstyle->background, justify);
+			gdispGFillStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g) + gw2obj->tab, gwinGetDrawY(&gw->g), w-gw2obj->tab, h, gw->text, gw->g.font, c, gw->pstyle->background, justify);
 		} else
-			gdispGFillStringBox(gw->g.display, gw->g.x, gw->g.y, w, h, gw->text, gw->g.font, c, gw->pstyle->background, justify);
+			gdispGFillStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), w, h, gw->text, gw->g.font, c, gw->pstyle->background, justify);
 	#else
-		gdispGFillStringBox(gw->g.display, gw->g.x, gw->g.y, w, h, gw->text, gw->g.font, c, gw->pstyle->background, justify);
+		gdispGFillStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), w, h, gw->text, gw->g.font, c, gw->pstyle->background, justify);
 	#endif
 
 	// render the border (if any)
 	if (gw->g.flags & GLABEL_FLG_BORDER)
-		gdispGDrawBox(gw->g.display, gw->g.x, gw->g.y, w, h, (gw->g.flags & GWIN_FLG_SYSENABLED) ? gw->pstyle->enabled.edge : gw->pstyle->disabled.edge);
+		gdispGDrawBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), w, h, (gw->g.flags & GWIN_FLG_SYSENABLED) ? gw->pstyle->enabled.edge : gw->pstyle->disabled.edge);
 }
 
 void gwinLabelDrawJustifiedLeft(GWidgetObject *gw, void *param) {
@@ -24,6 +24,11 @@
 #define LST_HORIZ_PAD		5	// extra horizontal padding for text
 #define LST_VERT_PAD		2	// extra vertical padding for text
 
+// used for kinetic scrolling
+#define LST_KINETIC_DECAY	325	// time constant of the kinetic scrolling slow down (milliseconds)
+#define LST_KINETIC_MAXDT	100	// a longer gap between movements is treated as this (milliseconds)
+#define LST_KINETIC_MINVEL	8	// kinetic scrolling stops below this velocity (1/256 pixels per millisecond)
+
 // Macro's to assist in data type conversions
 #define gh2obj		((GListObject *)gh)
 #define gw2obj		((GListObject *)gw)
@@ -53,7 +58,261 @@ static void sendListEvent(GWidgetObject *gw, int item) {
 	}
 }
 
+#if GWIN_NEED_LIST_VIRTUAL
+	#define VSEL_GROW		8		// How many selected items to make room for at a time
+
+	// Find where an item is (or should be) in the selected items of a virtual list
+	static int vselFind(GListObject *gl, int item) {
+		int		lo, hi, mid;
+
+		for(lo = 0, hi = gl->vselcnt; lo < hi; ) {
+			mid = (lo + hi) >> 1;
+			if (gl->vsel[mid] < item)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		return lo;
+	}
+
+	static bool_t vselIsSelected(GListObject *gl, int item) {
+		int		i;
+
+		i = vselFind(gl, item);
+		return (i < gl->vselcnt && gl->vsel[i] == item) ? TRUE : FALSE;
+	}
+
+	static void vselSetSelected(GListObject *gl, int item, bool_t doSelect) {
+		int		i;
+		int *	p;
+
+		i = vselFind(gl, item);
+
+		// Is it already selected?
+		if (i < gl->vselcnt && gl->vsel[i] == item) {
+			if (!doSelect) {
+				gl->vselcnt--;
+				memmove(gl->vsel+i, gl->vsel+i+1, (gl->vselcnt-i)*sizeof(int));
+			}
+			return;
+		}
+		if (!doSelect)
+			return;
+
+		// Add it
+		if (gl->vselcnt >= gl->vselmax) {
+			if (!(p = gfxRealloc(gl->vsel, gl->vselmax*sizeof(int), (gl->vselmax+VSEL_GROW)*sizeof(int))))
+				return;
+			gl->vsel = p;
+			gl->vselmax += VSEL_GROW;
+		}
+		memmove(gl->vsel+i+1, gl->vsel+i, (gl->vselcnt-i)*sizeof(int));
+		gl->vsel[i] = item;
+		gl->vselcnt++;
+	}
+
+	// Get an item of a virtual list from the application
+	static ListItem *vGetItem(GListObject *gl, int item, ListItem *pli) {
+		pli->flags = vselIsSelected(gl, item) ? GLIST_FLG_SELECTED : 0;
+		pli->param = 0;
+		pli->text = "";
+		#if GWIN_NEED_LIST_IMAGES
+			pli->pimg = 0;
+		#endif
+		gl->vfn(&gl->w.g, item, pli, gl->vparam);
+		return pli;
+	}
+#endif
+
+// Draw the list items that fall in the window rows from ytop to ybot (not including ybot).
+// The rows must be inside the list frame.
+static void ListDrawItems(GWidgetObject *gw, const GColorSet *ps, coord_t x, coord_t iwidth, coord_t iheight, coord_t ytop, coord_t ybot) {
+	const gfxQueueASyncItem*	qi;
+	const ListItem*				pli;
+	int							i, n;
+	coord_t						y;
+	color_t						fill;
+	#if GWIN_NEED_LIST_IMAGES
+		coord_t					sy;
+	#endif
+	#if GWIN_NEED_LIST_VIRTUAL
+		ListItem				vli;
+	#endif
+
+	// Set the clipping region so we only draw the rows we have been asked for.
+	#if GDISP_NEED_CLIP
+		gdispGSetClip(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+1, gwinGetDrawY(&gw->g)+ytop, gw->g.width-2, ybot-ytop);
+	#endif
+
+	// Find the first item in the rows (a virtual list has no items to walk)
+	i = (gw2obj->top + ytop - 1) / iheight;
+	for (qi = gfxQueueASyncPeek(&gw2obj->list_head), n = 0; n < i && qi; qi = gfxQueueASyncNext(qi), n++);
+
+	// Draw until we run out of room or items
+	for (y = 1 + i*iheight - gw2obj->top; y < ybot && i < gw2obj->cnt; i++, y += iheight) {
+		#if GWIN_NEED_LIST_VIRTUAL
+			if (gw2obj->vfn) {
+				pli = vGetItem(gw2obj, i, &vli);
+				#if GWIN_NEED_LIST_IMAGES
+					// Make room for images (on the next redraw) if we didn't know there were any
+					if (pli->pimg && !(gw->g.flags & GLIST_FLG_HASIMAGES)) {
+						gw->g.flags |= GLIST_FLG_HASIMAGES;
+						_gwinUpdate(&gw->g);
+					}
+				#endif
+			} else
+		#endif
+		{
+			if (!qi)
+				break;
+			pli = qi2li;
+			qi = gfxQueueASyncNext(qi);
+		}
+		fill = (pli->flags & GLIST_FLG_SELECTED) ? ps->fill : gw->pstyle->background;
+		gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+1, gwinGetDrawY(&gw->g)+y, iwidth, iheight, fill);
+		#if GWIN_NEED_LIST_IMAGES
+			if ((gw->g.flags & GLIST_FLG_HASIMAGES)) {
+				// Clear the image area
+				if (pli->pimg && gdispImageIsOpen(pli->pimg)) {
+					// Calculate which image
+					sy = (pli->flags & GLIST_FLG_SELECTED) ? 0 : (iheight-LST_VERT_PAD);
+					if (!(gw->g.flags & GWIN_FLG_SYSENABLED))
+						sy += 2*(iheight-LST_VERT_PAD);
+					while (sy > pli->pimg->height)
+						sy -= iheight-LST_VERT_PAD;
+					// Draw the image
+					gdispImageSetBgColor(pli->pimg, fill);
+					gdispGImageDraw(gwinGetDrawDisplay(&gw->g), pli->pimg, gwinGetDrawX(&gw->g)+1, gwinGetDrawY(&gw->g)+y, iheight-LST_VERT_PAD, iheight-LST_VERT_PAD, 0, sy);
+				}
+			}
+		#endif
+		gdispGFillStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x+LST_HORIZ_PAD, gwinGetDrawY(&gw->g)+y, iwidth-LST_HORIZ_PAD, iheight, pli->text, gw->g.font, ps->text, fill, justifyLeft);
+	}
+
+	// Fill any remaining item space
+	if (y < ytop)
+		y = ytop;
+	if (y < ybot)
+		gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+1, gwinGetDrawY(&gw->g)+y, iwidth, ybot-y, gw->pstyle->background);
+}
+
+// Draw the position indicator of a smooth scrolling list
+static void ListDrawSmoothBar(GWidgetObject *gw, const GColorSet *ps, coord_t iheight) {
+	int		max_scroll_value, bar_height;
+
+	if (gw2obj->cnt <= 0)
+		return;
+	max_scroll_value = gw2obj->cnt * iheight - (gw->g.height-2);
+	if (max_scroll_value <= 0)
+		return;
+	bar_height = (gw->g.height-2) * (gw->g.height-2) / (gw2obj->cnt * iheight);
+	gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g) + gw->g.width-4, gwinGetDrawY(&gw->g) + 1, 2, gw->g.height-2, gw->pstyle->background);
+	gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g) + gw->g.width-4, gwinGetDrawY(&gw->g) + 1 + gw2obj->top * ((gw->g.height-2)-bar_height) / max_scroll_value, 2, bar_height, ps->edge);
+}
+
+// Change the viewing offset of the list.
+// When we can, the pixels already on the display are scrolled and only the newly exposed rows are drawn.
+static void ListSetTop(GWidgetObject *gw, int top) {
+	#if GDISP_NEED_SCROLL
+		const GColorSet *	ps;
+		coord_t				x, iheight, iwidth;
+		int					delta;
+	#endif
+
+	if (top == gw2obj->top)
+		return;
+
+	#if GDISP_NEED_SCROLL
+		delta = top - gw2obj->top;
+		if (gw->fnDraw == gwinListDefaultDraw && (gw->g.flags & GLIST_FLG_ENABLERENDER)
+				&& delta < gw->g.height-2 && -delta < gw->g.height-2 && _gwinDrawStart(&gw->g)) {
+			gw2obj->top = top;
+
+			ps = (gw->g.flags & GWIN_FLG_SYSENABLED) ? &gw->pstyle->enabled : &gw->pstyle->disabled;
+			iheight = gdispGetFontMetric(gw->g.font, fontHeight) + LST_VERT_PAD;
+			x = 1;
+			if (gw->g.flags & GLIST_FLG_SCROLLSMOOTH) {
+				iwidth = gw->g.width - 2 - 4;
+				ListDrawSmoothBar(gw, ps, iheight);
+			} else
+				iwidth = gw->g.width - (LST_SCROLLWIDTH+3);		// We are scrolling so there must be a scroll bar
+			#if GWIN_NEED_LIST_IMAGES
+				if ((gw->g.flags & GLIST_FLG_HASIMAGES)) {
+					x += iheight;
+					iwidth -= iheight;
+				}
+			#endif
+
+			// Move what is already there and then fill in the gap
+			gdispGVerticalScroll(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+1, gwinGetDrawY(&gw->g)+1, x-1+iwidth, gw->g.height-2, delta, gw->pstyle->background);
+			if (delta > 0)
+				ListDrawItems(gw, ps, x, iwidth, iheight, gw->g.height-1-delta, gw->g.height-1);
+			else
+				ListDrawItems(gw, ps, x, iwidth, iheight, 1, 1-delta);
+
+			_gwinDrawEnd(&gw->g);
+			return;
+		}
+	#endif
+
+	gw2obj->top = top;
+	_gwinUpdate(&gw->g);
+}
+
 #if GINPUT_NEED_MOUSE
+	#if GWIN_LIST_KINETIC_SCROLL
+		// Return the milliseconds since the last drag movement or kinetic frame
+		static int32_t ListKineticElapsed(GListObject *gl) {
+			systemticks_t	now, dt;
+
+			now = gfxSystemTicks();
+			dt = now - gl->klast;
+			gl->klast = now;
+			if (dt >= gfxMillisecondsToTicks(LST_KINETIC_MAXDT))
+				return LST_KINETIC_MAXDT;
+			return (int32_t)(dt * 1000 / gfxMillisecondsToTicks(1000));
+		}
+
+		static void ListKineticStop(GListObject *gl) {
+			gtimerStop(&gl->kt);
+			gl->kvel = 0;
+			gl->kfrac = 0;
+		}
+
+		// One frame of kinetic scrolling. The list moves by the time that has really elapsed.
+		static void ListKineticTimer(void *param) {
+			GWidgetObject *	gw;
+			int32_t			dt, d;
+			int				top, maxtop;
+
+			gw = (GWidgetObject *)param;
+			dt = ListKineticElapsed(gw2obj);
+
+			// Move the list
+			d = gw2obj->kvel * dt + gw2obj->kfrac;
+			gw2obj->kfrac = d % 256;
+			top = gw2obj->top + d / 256;
+			maxtop = gw2obj->cnt * (gdispGetFontMetric(gw->g.font, fontHeight) + LST_VERT_PAD) - (gw->g.height-2) - 1;
+			if (top > maxtop) {
+				top = maxtop;
+				gw2obj->kvel = 0;
+			}
+			if (top < 0) {
+				top = 0;
+				gw2obj->kvel = 0;
+			}
+			ListSetTop(gw, top);
+
+			// Slow down
+			if (dt >= LST_KINETIC_DECAY)
+				gw2obj->kvel = 0;
+			else
+				gw2obj->kvel -= gw2obj->kvel * dt / LST_KINETIC_DECAY;
+			if (gw2obj->kvel < LST_KINETIC_MINVEL && gw2obj->kvel > -LST_KINETIC_MINVEL)
+				ListKineticStop(gw2obj);
+		}
+	#endif
+
     static void ListMouseSelect(GWidgetObject* gw, coord_t x, coord_t y) {
         const gfxQueueASyncItem*    qi;
         int                         item, i;
@@ -68,6 +327,20 @@ static void sendListEvent(GWidgetObject *gw, int item) {
         if (item < 0 || item >= gw2obj->cnt)
             return;
 
+        #if GWIN_NEED_LIST_VIRTUAL
+            if (gw2obj->vfn) {
+                if ((gw->g.flags & GLIST_FLG_MULTISELECT))
+                    vselSetSelected(gw2obj, item, !vselIsSelected(gw2obj, item));
+                else {
+                    gw2obj->vselcnt = 0;
+                    vselSetSelected(gw2obj, item, TRUE);
+                }
+                _gwinUpdate(&gw->g);
+                sendListEvent(gw, item);
+                return;
+            }
+        #endif
+
         for(qi = gfxQueueASyncPeek(&gw2obj->list_head), i = 0; qi; qi = gfxQueueASyncNext(qi), i++) {
             if ((gw->g.flags & GLIST_FLG_MULTISELECT)) {
                 if (item == i) {
@@ -97,8 +370,14 @@ static void sendListEvent(GWidgetObject *gw, int item) {
 		gw2obj->last_mouse_y = y;
 
 		// For smooth scrolling, scrolling is done in the ListMouseMove and selection is done on ListMouseUp
-		if (gw->g.flags & GLIST_FLG_SCROLLSMOOTH)
+		if (gw->g.flags & GLIST_FLG_SCROLLSMOOTH) {
+			#if GWIN_LIST_KINETIC_SCROLL
+				// Touching the list stops it
+				ListKineticStop(gw2obj);
+				gw2obj->klast = gfxSystemTicks();
+			#endif
 		    return;
+		}
 
 		// Some initial stuff
 		iheight = gdispGetFontMetric(gw->g.font, fontHeight) + LST_VERT_PAD;
@@ -107,18 +386,14 @@ static void sendListEvent(GWidgetObject *gw, int item) {
 		// Handle click over the scroll bar
 		if (x >= gw->g.width-(LST_SCROLLWIDTH+2) && (gw2obj->cnt > pgsz/iheight || (gw->g.flags & GLIST_FLG_SCROLLALWAYS))) {
 			if (y < 2*LST_ARROW_SZ) {
-				if (gw2obj->top > 0) {
-					gw2obj->top -= iheight;
-					if (gw2obj->top < 0)
-					    gw2obj->top = 0;
-					_gwinUpdate(&gw->g);
-				}
+				if (gw2obj->top > 0)
+					ListSetTop(gw, gw2obj->top > iheight ? gw2obj->top - iheight : 0);
 			} else if (y >= gw->g.height - 2*LST_ARROW_SZ) {
 				if (gw2obj->top < gw2obj->cnt * iheight - pgsz) {
-				    gw2obj->top += iheight;
-				    if (gw2obj->top > gw2obj->cnt * iheight - pgsz)
-				        gw2obj->top = gw2obj->cnt * iheight - pgsz;
-				    _gwinUpdate(&gw->g);
+				    if (gw2obj->top < gw2obj->cnt * iheight - pgsz - iheight)
+				    	ListSetTop(gw, gw2obj->top + iheight);
+				    else
+				    	ListSetTop(gw, gw2obj->cnt * iheight - pgsz);
 				}
 			} else if (y < gw->g.height/2) {
 				if (gw2obj->top > 0) {
@@ -149,30 +424,49 @@ static void sendListEvent(GWidgetObject *gw, int item) {
             return;
 
         // Only allow selection when we did not scroll
-        if (abs(gw2obj->start_mouse_x - x) > 4 || abs(gw2obj->start_mouse_y - y) > 4)
+        if (abs(gw2obj->start_mouse_x - x) > 4 || abs(gw2obj->start_mouse_y - y) > 4) {
+			#if GWIN_LIST_KINETIC_SCROLL
+				// Keep going if the list was flicked rather than dragged and then held still
+				if (ListKineticElapsed(gw2obj) < LST_KINETIC_MAXDT
+						&& (gw2obj->kvel >= LST_KINETIC_MINVEL || gw2obj->kvel <= -LST_KINETIC_MINVEL)) {
+					gw2obj->kfrac = 0;
+					gtimerStart(&gw2obj->kt, ListKineticTimer, (void *)gw, TRUE, GWIN_LIST_KINETIC_PERIOD);
+				} else
+					gw2obj->kvel = 0;
+			#endif
             return;
+        }
 
         ListMouseSelect(gw, x, y);
     }
 
 	static void ListMouseMove(GWidgetObject* gw, coord_t x, coord_t y) {
-        int iheight, oldtop;
+        int iheight, top;
         (void) x;
 
         if (!(gw->g.flags & GLIST_FLG_SCROLLSMOOTH)) return;
 
         if (gw2obj->last_mouse_y != y) {
-            oldtop = gw2obj->top;
             iheight = gdispGetFontMetric(gw->g.font, fontHeight) + LST_VERT_PAD;
 
-            gw2obj->top -= y - gw2obj->last_mouse_y;
-            if (gw2obj->top >= gw2obj->cnt * iheight - (gw->g.height-2))
-                gw2obj->top = gw2obj->cnt * iheight - (gw->g.height-2) - 1;
-            if (gw2obj->top < 0)
-                gw2obj->top = 0;
+            #if GWIN_LIST_KINETIC_SCROLL
+            	// Track the velocity of the drag (smoothed over the last few movements)
+            	{
+            		int32_t	dt;
+
+            		if (!(dt = ListKineticElapsed(gw2obj)))
+            			dt = 1;
+            		gw2obj->kvel = (gw2obj->kvel + 3 * ((int32_t)(gw2obj->last_mouse_y - y) * 256 / dt)) / 4;
+            	}
+            #endif
+
+            top = gw2obj->top - (y - gw2obj->last_mouse_y);
+            if (top >= gw2obj->cnt * iheight - (gw->g.height-2))
+                top = gw2obj->cnt * iheight - (gw->g.height-2) - 1;
+            if (top < 0)
+                top = 0;
             gw2obj->last_mouse_y = y;
-            if (oldtop != gw2obj->top)
-            	_gwinUpdate(&gw->g);
+            ListSetTop(gw, top);
         }
 	}
 #endif
@@ -187,6 +481,37 @@ static void sendListEvent(GWidgetObject *gw, int item) {
 		coord_t		iheight;
 		iheight = gdispGetFontMetric(gw->g.font, fontHeight) + LST_VERT_PAD;
 
+		#if GWIN_NEED_LIST_VIRTUAL
+			if (gw2obj->vfn) {
+				// Toggles only work for a single select list
+				if (!gw2obj->vselcnt)
+					return;
+				i = gw2obj->vsel[0];
+				if (role == 0) {
+					if (i+1 >= gw2obj->cnt)
+						return;
+					gw2obj->vsel[0] = i+1;
+
+					//if we need to scroll down
+					if (((i+2)*iheight - gw2obj->top) > gw->g.height)
+						gw2obj->top += iheight;
+				} else {
+					if (i <= 0)
+						return;
+					gw2obj->vsel[0] = i-1;
+
+					//if we need to scroll up
+					if (((i-1)*iheight) < gw2obj->top) {
+						gw2obj->top -= iheight;
+						if (gw2obj->top < 0)
+							gw2obj->top = 0;
+					}
+				}
+				_gwinUpdate(&gw->g);
+				return;
+			}
+		#endif
+
 		switch (role) {
 			// select down
 			case 0:
@@ -251,9 +576,19 @@ static void sendListEvent(GWidgetObject *gw, int item) {
 static void ListDestroy(GHandle gh) {
 	const gfxQueueASyncItem* qi;
 
+	#if GINPUT_NEED_MOUSE && GWIN_LIST_KINETIC_SCROLL
+		gtimerStop(&gh2obj->kt);
+		gtimerDeinit(&gh2obj->kt);
+	#endif
+
 	while((qi = gfxQueueASyncGet(&gh2obj->list_head)))
 		gfxFree((void *)qi);
 
+	#if GWIN_NEED_LIST_VIRTUAL
+		if (gh2obj->vsel)
+			gfxFree(gh2obj->vsel);
+	#endif
+
 	_gwidgetDestroy(gh);
 }
 
@@ -305,6 +640,17 @@ GHandle gwinGListCreate(GDisplay *g, GListObject* gobj, GWidgetInit* pInit, bool
 	gfxQueueASyncInit(&gobj->list_head);
 	gobj->cnt = 0;
 	gobj->top = 0;
+	#if GINPUT_NEED_MOUSE && GWIN_LIST_KINETIC_SCROLL
+		gtimerInit(&gobj->kt);
+		gobj->kvel = 0;
+		gobj->kfrac = 0;
+	#endif
+	#if GWIN_NEED_LIST_VIRTUAL
+		gobj->vfn = 0;
+		gobj->vsel = 0;
+		gobj->vselcnt = 0;
+		gobj->vselmax = 0;
+	#endif
 	if (multiselect)
 		gobj->w.g.flags |= GLIST_FLG_MULTISELECT;
 	gobj->w.g.flags |= GLIST_FLG_SCROLLALWAYS;
@@ -355,6 +701,12 @@ int gwinListAddItem(GHandle gh, const char* text, bool_t useAlloc) {
 	if (gh->vmt != (gwinVMT *)&listVMT)
 		return -1;
 
+	#if GWIN_NEED_LIST_VIRTUAL
+		// The application owns the items of a virtual list
+		if (gh2obj->vfn)
+			return -1;
+	#endif
+
 	if (useAlloc) {
 		size_t len = strlen(text)+1;
 		if (!(newItem = gfxAlloc(sizeof(ListItem) + len)))
@@ -451,6 +803,14 @@ const char* gwinListItemGetText(GHandle gh, int item) {
 	if (item < 0 || item >= gh2obj->cnt)
 		return 0;
 
+	#if GWIN_NEED_LIST_VIRTUAL
+		if (gh2obj->vfn) {
+			ListItem	li;
+
+			return vGetItem(gh2obj, item, &li)->text;
+		}
+	#endif
+
 	for(qi = gfxQueueASyncPeek(&gh2obj->list_head), i = 0; qi; qi = gfxQueueASyncNext(qi), i++) {
 		if (i == item)
 			return qi2li->text;
@@ -470,6 +830,18 @@ int gwinListFindText(GHandle gh, const char* text) {
 	if (!text)
 		return -1;
 
+	#if GWIN_NEED_LIST_VIRTUAL
+		if (gh2obj->vfn) {
+			ListItem	li;
+
+			for(i = 0; i < gh2obj->cnt; i++) {
+				if (strcmp(vGetItem(gh2obj, i, &li)->text, text) == 0)
+					return i;
+			}
+			return -1;
+		}
+	#endif
+
 	for(qi = gfxQueueASyncPeek(&gh2obj->list_head), i = 0; qi; qi = gfxQueueASyncNext(qi), i++) {
 		if (strcmp(((ListItem *)qi)->text, text) == 0)
 			return i;	
@@ -490,6 +862,11 @@ int gwinListGetSelected(GHandle gh) {
 	if ((gh->flags & GLIST_FLG_MULTISELECT))
 		return -1;
 
+	#if GWIN_NEED_LIST_VIRTUAL
+		if (gh2obj->vfn)
+			return gh2obj->vselcnt ? gh2obj->vsel[0] : -1;
+	#endif
+
 	for(qi = gfxQueueASyncPeek(&gh2obj->list_head), i = 0; qi; qi = gfxQueueASyncNext(qi), i++) {
 		if (qi2li->flags & GLIST_FLG_SELECTED)
 			return i;
@@ -528,6 +905,10 @@ void gwinListDeleteAll(GHandle gh) {
 	while((qi = gfxQueueASyncGet(&gh2obj->list_head)))
 		gfxFree(qi);
 
+	#if GWIN_NEED_LIST_VIRTUAL
+		gh2obj->vselcnt = 0;
+	#endif
+
 	gh->flags &= ~GLIST_FLG_HASIMAGES;
 	gh2obj->cnt = 0;
 	gh2obj->top = 0;
@@ -571,6 +952,14 @@ uint16_t gwinListItemGetParam(GHandle gh, int item) {
 	if (item < 0 || item > (gh2obj->cnt) - 1)
 		return 0;
 
+	#if GWIN_NEED_LIST_VIRTUAL
+		if (gh2obj->vfn) {
+			ListItem	li;
+
+			return vGetItem(gh2obj, item, &li)->param;
+		}
+	#endif
+
 	for(qi = gfxQueueASyncPeek(&gh2obj->list_head), i = 0; qi; qi = gfxQueueASyncNext(qi), i++) {
 		if (i == item)
 			return qi2li->param;
@@ -590,6 +979,11 @@ bool_t gwinListItemIsSelected(GHandle gh, int item) {
 	if (item < 0 || item > (gh2obj->cnt) - 1)
 		return FALSE;
 
+	#if GWIN_NEED_LIST_VIRTUAL
+		if (gh2obj->vfn)
+			return vselIsSelected(gh2obj, item);
+	#endif
+
 	for(qi = gfxQueueASyncPeek(&gh2obj->list_head), i = 0; qi; qi = gfxQueueASyncNext(qi), i++) {
 		if (i == item)
 			return (qi2li->flags &  GLIST_FLG_SELECTED) ? TRUE : FALSE;
@@ -629,6 +1023,16 @@ void gwinListSetSelected(GHandle gh, int item, bool_t doSelect) {
 	if (item < 0 || item >= gh2obj->cnt)
 		return;
 
+	#if GWIN_NEED_LIST_VIRTUAL
+		if (gh2obj->vfn) {
+			if (doSelect && !(gh->flags & GLIST_FLG_MULTISELECT))
+				gh2obj->vselcnt = 0;
+			vselSetSelected(gh2obj, item, doSelect);
+			_gwinUpdate(gh);
+			return;
+		}
+	#endif
+
 	// If not a multiselect mode - clear previous selected item
 	if (doSelect && !(gh->flags & GLIST_FLG_MULTISELECT)) {
 		for(qi = gfxQueueASyncPeek(&gh2obj->list_head); qi; qi = gfxQueueASyncNext(qi)) {
@@ -676,6 +1080,52 @@ void gwinListViewItem(GHandle gh, int item) {
 	_gwinUpdate(gh);
 }
 
+#if GWIN_NEED_LIST_VIRTUAL
+	void gwinListSetVirtual(GHandle gh, int cnt, ListVirtualItemFunction fn, void *param) {
+		gfxQueueASyncItem* qi;
+
+		// is it a valid handle?
+		if (gh->vmt != (gwinVMT *)&listVMT)
+			return;
+
+		// Throw away any existing items and selections
+		while((qi = gfxQueueASyncGet(&gh2obj->list_head)))
+			gfxFree(qi);
+		gh2obj->vselcnt = 0;
+
+		gh2obj->vfn = fn;
+		gh2obj->vparam = param;
+		gh->flags &= ~GLIST_FLG_HASIMAGES;
+		gh2obj->cnt = fn && cnt > 0 ? cnt : 0;
+		gh2obj->top = 0;
+		_gwinUpdate(gh);
+	}
+
+	void gwinListSetCount(GHandle gh, int cnt) {
+		coord_t		iheight;
+
+		// is it a valid virtual list handle?
+		if (gh->vmt != (gwinVMT *)&listVMT || !gh2obj->vfn)
+			return;
+
+		if (cnt < 0)
+			cnt = 0;
+		gh2obj->cnt = cnt;
+
+		// Unselect anything past the end
+		gh2obj->vselcnt = vselFind(gh2obj, cnt);
+
+		// Don't scroll past the end
+		iheight = gdispGetFontMetric(gh->font, fontHeight) + LST_VERT_PAD;
+		if (gh2obj->top > cnt * iheight - (gh->height-2))
+			gh2obj->top = cnt * iheight - (gh->height-2);
+		if (gh2obj->top < 0)
+			gh2obj->top = 0;
+
+		_gwinUpdate(gh);
+	}
+#endif
+
 #if GWIN_NEED_LIST_IMAGES
 	void gwinListItemSetImage(GHandle gh, int item, gdispImage *pimg) {
 		const gfxQueueASyncItem	*	qi;
@@ -701,14 +1151,8 @@ void gwinListViewItem(GHandle gh, int item) {
 #endif
 
 void gwinListDefaultDraw(GWidgetObject* gw, void* param) {
-	const gfxQueueASyncItem*	qi;
-	int							i;
-	coord_t						x, y, iheight, iwidth;
-	color_t						fill;
+	coord_t						x, iheight, iwidth;
 	const GColorSet *			ps;
-	#if GWIN_NEED_LIST_IMAGES
-		coord_t					sy;
-	#endif
 	#if GDISP_NEED_CONVEX_POLYGON
 		static const point upArrow[] = { {0, LST_ARROW_SZ}, {LST_ARROW_SZ, LST_ARROW_SZ}, {LST_ARROW_SZ/2, 0} };
 		static const point downArrow[] = { {0, 0}, {LST_ARROW_SZ, 0}, {LST_ARROW_SZ/2, LST_ARROW_SZ} };
@@ -731,25 +1175,18 @@ void gwinListDefaultDraw(GWidgetObject* gw, void* param) {
 	// the scroll area
 	if (gw->g.flags & GLIST_FLG_SCROLLSMOOTH) {
 		iwidth = gw->g.width - 2 - 4;
-		if (gw2obj->cnt > 0) {
-			int max_scroll_value = gw2obj->cnt * iheight - gw->g.height-2;
-			if (max_scroll_value > 0) {
-				int bar_height = (gw->g.height-2) * (gw->g.height-2) / (gw2obj->cnt * iheight);
-				gdispGFillArea(gw->g.display, gw->g.x + gw->g.width-4, gw->g.y + 1, 2, gw->g.height-1, gw->pstyle->background);
-				gdispGFillArea(gw->g.display, gw->g.x + gw->g.width-4, gw->g.y + gw2obj->top * ((gw->g.height-2)-bar_height) / max_scroll_value, 2, bar_height, ps->edge);
-			}
-		}
+		ListDrawSmoothBar(gw, ps, iheight);
 	} else if ((gw2obj->cnt > (gw->g.height-2) / iheight) || (gw->g.flags & GLIST_FLG_SCROLLALWAYS)) {
 		iwidth = gw->g.width - (LST_SCROLLWIDTH+3);
-		gdispGFillArea(gw->g.display, gw->g.x+iwidth+2, gw->g.y+1, LST_SCROLLWIDTH, gw->g.height-2, gdispBlendColor(ps->fill, gw->pstyle->background, 128));
-		gdispGDrawLine(gw->g.display, gw->g.x+iwidth+1, gw->g.y+1, gw->g.x+iwidth+1, gw->g.y+gw->g.height-2, ps->edge);
+		gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+iwidth+2, gwinGetDrawY(&gw->g)+1, LST_SCROLLWIDTH, gw->g.height-2, gdispBlendColor(ps->fill, gw->pstyle->background, 128));
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+iwidth+1, gwinGetDrawY(&gw->g)+1, gwinGetDrawX(&gw->g)+iwidth+1, gwinGetDrawY(&gw->g)+gw->g.height-2, ps->edge);
 		#if GDISP_NEED_CONVEX_POLYGON
-			gdispGFillConvexPoly(gw->g.display, gw->g.x+iwidth+((LST_SCROLLWIDTH-LST_ARROW_SZ)/2+2), gw->g.y+(LST_ARROW_SZ/2+1), upArrow, 3, ps->fill);
-			gdispGFillConvexPoly(gw->g.display, gw->g.x+iwidth+((LST_SCROLLWIDTH-LST_ARROW_SZ)/2+2), gw->g.y+gw->g.height-(LST_ARROW_SZ+LST_ARROW_SZ/2+1), downArrow, 3, ps->fill);
+			gdispGFillConvexPoly(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+iwidth+((LST_SCROLLWIDTH-LST_ARROW_SZ)/2+2), gwinGetDrawY(&gw->g)+(LST_ARROW_SZ/2+1), upArrow, 3, ps->fill);
+			gdispGFillConvexPoly(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+iwidth+((LST_SCROLLWIDTH-LST_ARROW_SZ)/2+2), gwinGetDrawY(&gw->g)+gw->g.height-(LST_ARROW_SZ+LST_ARROW_SZ/2+1), downArrow, 3, ps->fill);
 		#else
 			#warning "GWIN: Lists display better when GDISP_NEED_CONVEX_POLYGON is turned on"
-			gdispGFillArea(gw->g.display, gw->g.x+iwidth+((LST_SCROLLWIDTH-LST_ARROW_SZ)/2+2), gw->g.y+(LST_ARROW_SZ/2+1), LST_ARROW_SZ, LST_ARROW_SZ, ps->fill);
-			gdispGFillArea(gw->g.display, gw->g.x+iwidth+((LST_SCROLLWIDTH-LST_ARROW_SZ)/2+2), gw->g.y+gw->g.height-(LST_ARROW_SZ+LST_ARROW_SZ/2+1), LST_ARROW_SZ, LST_ARROW_SZ, ps->fill);
+			gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+iwidth+((LST_SCROLLWIDTH-LST_ARROW_SZ)/2+2), gwinGetDrawY(&gw->g)+(LST_ARROW_SZ/2+1), LST_ARROW_SZ, LST_ARROW_SZ, ps->fill);
+			gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+iwidth+((LST_SCROLLWIDTH-LST_ARROW_SZ)/2+2), gwinGetDrawY(&gw->g)+gw->g.height-(LST_ARROW_SZ+LST_ARROW_SZ/2+1), LST_ARROW_SZ, LST_ARROW_SZ, ps->fill);
 		#endif
 	} else
 		iwidth = gw->g.width - 2;
@@ -762,43 +1199,11 @@ void gwinListDefaultDraw(GWidgetObject* gw, void* param) {
 	#endif
 
 
-	// Find the top item
-	for (qi = gfxQueueASyncPeek(&gw2obj->list_head), i = iheight - 1; i < gw2obj->top && qi; qi = gfxQueueASyncNext(qi), i+=iheight);
-
 	// the list frame
-	gdispGDrawBox(gw->g.display, gw->g.x, gw->g.y, gw->g.width, gw->g.height, ps->edge);
-
-	// Set the clipping region so we do not override the frame.
-	#if GDISP_NEED_CLIP
-		gdispGSetClip(gw->g.display, gw->g.x+1, gw->g.y+1, gw->g.width-2, gw->g.height-2);
-	#endif
+	gdispGDrawBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw->g.width, gw->g.height, ps->edge);
 
-	// Draw until we run out of room or items
-	for (y = 1-(gw2obj->top%iheight); y < gw->g.height-2 && qi; qi = gfxQueueASyncNext(qi), y += iheight) {
-		fill = (qi2li->flags & GLIST_FLG_SELECTED) ? ps->fill : gw->pstyle->background;
-		gdispGFillArea(gw->g.display, gw->g.x+1, gw->g.y+y, iwidth, iheight, fill);
-		#if GWIN_NEED_LIST_IMAGES
-			if ((gw->g.flags & GLIST_FLG_HASIMAGES)) {
-				// Clear the image area
-				if (qi2li->pimg && gdispImageIsOpen(qi2li->pimg)) {
-					// Calculate which image
-					sy = (qi2li->flags & GLIST_FLG_SELECTED) ? 0 : (iheight-LST_VERT_PAD);
-					if (!(gw->g.flags & GWIN_FLG_SYSENABLED))
-						sy += 2*(iheight-LST_VERT_PAD);
-					while (sy > qi2li->pimg->height)
-						sy -= iheight-LST_VERT_PAD;
-					// Draw the image
-					gdispImageSetBgColor(qi2li->pimg, fill);
-					gdispGImageDraw(gw->g.display, qi2li->pimg, gw->g.x+1, gw->g.y+y, iheight-LST_VERT_PAD, iheight-LST_VERT_PAD, 0, sy);
-				}
-			}
-		#endif
-		gdispGFillStringBox(gw->g.display, gw->g.x+x+LST_HORIZ_PAD, gw->g.y+y, iwidth-LST_HORIZ_PAD, iheight, qi2li->text, gw->g.font, ps->text, fill, justifyLeft);
-	}
-
-	// Fill any remaining item space
-	if (y < gw->g.height-1)
-		gdispGFillArea(gw->g.display, gw->g.x+1, gw->g.y+y, iwidth, gw->g.height-1-y, gw->pstyle->background);
+	// the items
+	ListDrawItems(gw, ps, x, iwidth, iheight, 1, gw->g.height-1);
 }
 
 #undef gh2obj
@@ -47,6 +47,23 @@ typedef struct GEventGWinList {
 	int				item;		// The item that has been selected (or unselected in a multi-select listbox)
 } GEventGWinList;
 
+#if GWIN_NEED_LIST_VIRTUAL || defined(__DOXYGEN__)
+	struct ListItem;
+
+	/**
+	 * @brief	A function that supplies an item of a virtual list
+	 *
+	 * @param[in] gh		The list
+	 * @param[in] item		The item ID
+	 * @param[in] pli		The item to fill in. The text, image and param members should be set.
+	 * 						The flags member is already set from the list's selection state.
+	 * @param[in] param		The parameter passed to @p gwinListSetVirtual()
+	 *
+	 * @note	The text (and image) must remain valid until the next call for the same item.
+	 */
+	typedef void (*ListVirtualItemFunction)(GHandle gh, int item, struct ListItem *pli, void *param);
+#endif
+
 // A list window
 typedef struct GListObject {
 	GWidgetObject	w;
@@ -55,6 +72,12 @@ typedef struct GListObject {
         coord_t start_mouse_x;
         coord_t start_mouse_y;
         coord_t last_mouse_y;
+		#if GWIN_LIST_KINETIC_SCROLL
+			GTimer			kt;			// The timer that keeps a flicked list scrolling
+			systemticks_t	klast;		// The time of the last drag movement or kinetic frame
+			int32_t			kvel;		// The kinetic scrolling velocity in 1/256 pixels per millisecond
+			int32_t			kfrac;		// The sub-pixel part of the kinetic scrolling position
+		#endif
     #endif
 	#if GINPUT_NEED_TOGGLE
 		uint16_t	t_up;
@@ -64,6 +87,13 @@ typedef struct GListObject {
 	int				cnt;		// Number of items currently in the list (quicker than counting each time)
 	int				top;		// Viewing offset in pixels from the top of the list
 	gfxQueueASync	list_head;	// The list of items
+	#if GWIN_NEED_LIST_VIRTUAL
+		ListVirtualItemFunction	vfn;		// The function that supplies the items of a virtual list (or NULL)
+		void *					vparam;		// The parameter for the virtual item function
+		int *					vsel;		// The selected items of a virtual list in ascending order
+		int						vselcnt;	// The number of selected items of a virtual list
+		int						vselmax;	// The room in vsel
+	#endif
 } GListObject;
 
 /**
@@ -338,6 +368,47 @@ void gwinListSetSelected(GHandle gh, int item, bool_t doSelect);
  */
 void gwinListViewItem(GHandle gh, int item);
 
+#if GWIN_NEED_LIST_VIRTUAL || defined(__DOXYGEN__)
+	/**
+	 * @brief				Make the list a virtual list with items supplied by the application
+	 *
+	 * @pre					GWIN_NEED_LIST_VIRTUAL must be set to true in your gfxconf.h
+	 *
+	 * @param[in] gh		The widget handle (must be a list handle)
+	 * @param[in] cnt		The number of items in the list
+	 * @param[in] fn		The function that supplies an item or NULL to make it a normal list again
+	 * @param[in] param		A parameter passed to the function
+	 *
+	 * @note				Any existing items are deleted and nothing is selected.
+	 * @note				Only the items that are being drawn are fetched so the number of items
+	 * 						affects neither the drawing time nor the RAM used. Only the selected items
+	 * 						are remembered by the list.
+	 * @note				The application owns the items in a virtual list. @p gwinListAddItem(),
+	 * 						@p gwinListItemSetText(), @p gwinListItemSetParam(), @p gwinListItemDelete()
+	 * 						and @p gwinListItemSetImage() do nothing. Use @p gwinListSetCount() when the
+	 * 						number of items changes and @p gwinRedraw() when the items change.
+	 * @note				If any item returns an image then space for images is allocated from then on
+	 * 						until the list is made virtual again or @p gwinListDeleteAll() is called.
+	 *
+	 * @api
+	 */
+	void gwinListSetVirtual(GHandle gh, int cnt, ListVirtualItemFunction fn, void *param);
+
+	/**
+	 * @brief				Set the number of items in a virtual list
+	 *
+	 * @pre					GWIN_NEED_LIST_VIRTUAL must be set to true in your gfxconf.h
+	 *
+	 * @param[in] gh		The widget handle (must be a virtual list handle)
+	 * @param[in] cnt		The number of items in the list
+	 *
+	 * @note				Any selected items past the new end of the list are unselected.
+	 *
+	 * @api
+	 */
+	void gwinListSetCount(GHandle gh, int cnt);
+#endif
+
 #if GWIN_NEED_LIST_IMAGES || defined(__DOXYGEN__)
 	/**
 	 * @brief				Set the image for a list item
@@ -185,6 +185,23 @@
 	#ifndef GWIN_WIDGET_TAGS
 		#define GWIN_WIDGET_TAGS		FALSE
 	#endif
+	/**
+	 * @brief   Allow widgets to be drawn from an off-screen copy
+	 * @details	Defaults to FALSE
+	 * @note	Adds @p gwinSetCached(). Each cached widget keeps a pixmap of itself.
+	 * @pre		GDISP_NEED_PIXMAP must be TRUE
+	 */
+	#ifndef GWIN_WIDGET_CACHE
+		#define GWIN_WIDGET_CACHE		FALSE
+	#endif
+	/**
+	 * @brief   The maximum number of bytes of pixels used by all cached widgets together
+	 * @details	Defaults to 32768
+	 * @note	When a new copy doesn't fit, copies of invisible widgets are thrown away first.
+	 */
+	#ifndef GWIN_WIDGET_CACHE_BUDGET
+		#define GWIN_WIDGET_CACHE_BUDGET	32768
+	#endif
 	/**
 	 * @brief   Use flat styling for controls rather than a 3D look
 	 * @details	Defaults to FALSE
@@ -221,6 +238,20 @@
 	#ifndef GWIN_REDRAW_SINGLEOP
 		#define GWIN_REDRAW_SINGLEOP	FALSE
 	#endif
+	/**
+	 * @brief	The maximum number of times a second windows are redrawn
+	 * @details	Defaults to 0 (no limit)
+	 * @note	When this is set windows that need redrawing are collected and
+	 * 			redrawn together in a single pass once per frame. Changing a window many
+	 * 			times between frames costs just one redraw and each display is flushed once at
+	 * 			the end of the frame. Updates can take up to a frame to appear.
+	 * @note	The frame timer only runs while there is something to redraw.
+	 * @note	This is only relevant if GWIN_REDRAW_IMMEDIATE is FALSE. GWIN_REDRAW_SINGLEOP
+	 * 			is ignored as every frame redraws everything that is waiting.
+	 */
+	#ifndef GWIN_REDRAW_FRAMERATE
+		#define GWIN_REDRAW_FRAMERATE	0
+	#endif
 	/**
 	 * @brief   Buttons should not insist the mouse is over the button on mouse release
 	 * @details	Defaults to FALSE
@@ -275,6 +306,24 @@
 	#ifndef GWIN_CONSOLE_HISTORY_ATCREATE
 		#define GWIN_CONSOLE_HISTORY_ATCREATE	FALSE
 	#endif
+	/**
+	 * @brief	Should console output be able to be stored and rendered later.
+	 * @details	Defaults to FALSE
+	 * @details	If this feature is enabled, @p gwinConsoleSetDeferred() can be used to make
+	 * 			a console only store output in its history buffer. The changed lines are then
+	 * 			rendered together by a timer.
+	 * @pre		GWIN_CONSOLE_USE_HISTORY must be TRUE.
+	 */
+	#ifndef GWIN_CONSOLE_DEFERRED_RENDER
+		#define GWIN_CONSOLE_DEFERRED_RENDER	FALSE
+	#endif
+	/**
+	 * @brief	How often deferred console output is rendered (in milliseconds).
+	 * @details	Defaults to 40
+	 */
+	#ifndef GWIN_CONSOLE_DEFERRED_PERIOD
+		#define GWIN_CONSOLE_DEFERRED_PERIOD	40
+	#endif
 	/**
 	 * @brief   Console Windows need floating point support in @p gwinPrintf
 	 * @details	Defaults to FALSE
@@ -337,6 +386,32 @@
 	#ifndef GWIN_NEED_LIST_IMAGES
 	 	#define GWIN_NEED_LIST_IMAGES			FALSE
 	#endif
+	/**
+	 * @brief	Enable the API to supply the items of a list widget from an application callback
+	 * @details	Defaults to FALSE
+	 * @note	A virtual list only fetches the items it is drawing so the number of items
+	 * 			has no effect on the drawing time or on the RAM used.
+	 */
+	#ifndef GWIN_NEED_LIST_VIRTUAL
+	 	#define GWIN_NEED_LIST_VIRTUAL			FALSE
+	#endif
+	/**
+	 * @brief	Should a smooth scrolling list keep scrolling when it is flicked
+	 * @details	Defaults to FALSE
+	 * @note	The list slows down and stops by itself. Touching the list stops it immediately.
+	 */
+	#ifndef GWIN_LIST_KINETIC_SCROLL
+	 	#define GWIN_LIST_KINETIC_SCROLL		FALSE
+	#endif
+	/**
+	 * @brief	The frame period (in milliseconds) of the kinetic scrolling of a list
+	 * @details	Defaults to 20
+	 * @note	Each frame moves the list by the time that has really elapsed so a
+	 * 			slow display just gives fewer frames rather than slower scrolling.
+	 */
+	#ifndef GWIN_LIST_KINETIC_PERIOD
+	 	#define GWIN_LIST_KINETIC_PERIOD		20
+	#endif
 	/**
 	 * @brief	Enable the API to automatically increment the progressbar over time
 	 * @details	Defaults to FALSE
@@ -394,6 +469,42 @@
 	#ifndef GWIN_FLASHING_PERIOD
 		#define GWIN_FLASHING_PERIOD			250
 	#endif
+	/**
+	 * @brief	Keep a spatial index of the windows on each display
+	 * @details	Defaults to FALSE
+	 * @pre		Requires GWIN_NEED_WINDOWMANAGER to be TRUE
+	 * @note	Each display is divided into a grid of cells with each cell holding a z-ordered
+	 * 			list of the windows that overlap it. Mouse hit-testing and the search for
+	 * 			windows exposed by a window being hidden then only look at the windows in the
+	 * 			relevant cells instead of every window in the system.
+	 * @note	This costs some RAM per display and per window but is worthwhile once there
+	 * 			are more than a few dozen windows.
+	 */
+	#ifndef GWIN_NEED_SPATIAL_INDEX
+		#define GWIN_NEED_SPATIAL_INDEX			FALSE
+	#endif
+	/**
+	 * @brief	The size of a spatial index cell as a power of 2
+	 * @details	Defaults to 5 (32 x 32 pixel cells)
+	 * @note	Smaller cells mean fewer windows to test per cell but more cells for each window to be stored in.
+	 */
+	#ifndef GWIN_SPATIAL_INDEX_CELL_SHIFT
+		#define GWIN_SPATIAL_INDEX_CELL_SHIFT	5
+	#endif
+	/**
+	 * @brief	Include the compositing window manager
+	 * @details	Defaults to FALSE
+	 * @pre		Requires GWIN_NEED_WINDOWMANAGER, GDISP_NEED_PIXMAP and GDISP_NEED_CLIP to be TRUE
+	 * @note	The compositing window manager is selected by calling
+	 * 			gwinSetWindowManager(&GCompositingWindowManager). Each visible top level window
+	 * 			then draws into its own pixmap and only the damaged areas of the display are
+	 * 			rebuilt from those pixmaps. Moving, raising or hiding a top level window
+	 * 			no longer redraws the windows underneath it.
+	 * @note	This costs a pixmap the size of each visible top level window.
+	 */
+	#ifndef GWIN_NEED_COMPOSITOR
+		#define GWIN_NEED_COMPOSITOR			FALSE
+	#endif
 	/**
 	 * @brief	The default keyboard layout for the virtual gwin keyboard
 	 * @details	Defaults to VirtualKeyboardLayout_English1
@@ -24,6 +24,34 @@ static void PBResetDisplayPos(GProgressbarObject *gsw) {
 		gsw->dpos = ((gsw->w.g.width-1)*(gsw->pos-gsw->min))/(gsw->max-gsw->min);
 }
 
+// Recalculate the display position and redraw just the part of the bar that has changed
+static void PBMoveDisplayPos(GProgressbarObject *gsw) {
+	coord_t		lo, hi;
+
+	lo = hi = gsw->dpos;
+	PBResetDisplayPos(gsw);
+
+	// A custom draw routine can draw anything based on the position
+	if (gsw->w.fnDraw != gwinProgressbarDraw_Std
+			#if GDISP_NEED_IMAGE
+				&& gsw->w.fnDraw != gwinProgressbarDraw_Image
+			#endif
+			) {
+		_gwinUpdate(&gsw->w.g);
+		return;
+	}
+
+	// The built-in draw routines only change between the old and new thumb positions
+	if (gsw->dpos < lo)
+		lo = gsw->dpos;
+	else
+		hi = gsw->dpos;
+	if (gsw->w.g.width < gsw->w.g.height)
+		_gwinUpdateArea(&gsw->w.g, 0, lo, gsw->w.g.width, hi-lo+1);
+	else
+		_gwinUpdateArea(&gsw->w.g, lo, 0, hi-lo+1, gsw->w.g.height);
+}
+
 // We have to deinitialize the timer which auto updates the progressbar if any
 static void PBDestroy(GHandle gh) {
 	#if GWIN_PROGRESSBAR_AUTO
@@ -129,8 +157,7 @@ void gwinProgressbarSetPosition(GHandle gh, int pos) {
 	else if (pos > gsw->max) gsw->pos = gsw->max;
 	else gsw->pos = pos;
 
-	PBResetDisplayPos(gsw);
-	_gwinUpdate(gh);
+	PBMoveDisplayPos(gsw);
 
 	#undef gsw
 }
@@ -156,8 +183,7 @@ void gwinProgressbarIncrement(GHandle gh) {
 	if (gsw->pos < gsw->min) gsw->pos = gsw->min;
 	else if (gsw->pos > gsw->max) gsw->pos = gsw->max;
 
-	PBResetDisplayPos(gsw);
-	_gwinUpdate(gh);
+	PBMoveDisplayPos(gsw);
 
 	#undef gsw
 }
@@ -172,8 +198,7 @@ void gwinProgressbarDecrement(GHandle gh) {
 	if (gsw->pos < gsw->min) gsw->pos = gsw->min;
 	else if (gsw->pos > gsw->max) gsw->pos = gsw->max;
 
-	PBResetDisplayPos(gsw);
-	_gwinUpdate(gh);
+	PBMoveDisplayPos(gsw);
 
 	#undef gsw
 }
@@ -240,22 +265,22 @@ void gwinProgressbarDraw_Std(GWidgetObject *gw, void *param) {
 	// Vertical progressbar
 	if (gw->g.width < gw->g.height) {
 		if (gsw->dpos != gw->g.height-1)
-			gdispGFillArea(gw->g.display, gw->g.x, gw->g.y+gsw->dpos, gw->g.width, gw->g.height - gsw->dpos, pcol->progress);				// Active Area
+			gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g)+gsw->dpos, gw->g.width, gw->g.height - gsw->dpos, pcol->progress);				// Active Area
 		if (gsw->dpos != 0)
-			gdispGFillArea(gw->g.display, gw->g.x, gw->g.y, gw->g.width, gsw->dpos, pcol->fill);											// Inactive area
-		gdispGDrawBox(gw->g.display, gw->g.x, gw->g.y, gw->g.width, gw->g.height, pcol->edge);												// Edge
-		gdispGDrawLine(gw->g.display, gw->g.x, gw->g.y+gsw->dpos, gw->g.x+gw->g.width-1, gw->g.y+gsw->dpos, pcol->edge);					// Thumb
+			gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw->g.width, gsw->dpos, pcol->fill);											// Inactive area
+		gdispGDrawBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw->g.width, gw->g.height, pcol->edge);												// Edge
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g)+gsw->dpos, gwinGetDrawX(&gw->g)+gw->g.width-1, gwinGetDrawY(&gw->g)+gsw->dpos, pcol->edge);					// Thumb
 
 	// Horizontal progressbar
 	} else {
 		if (gsw->dpos != gw->g.width-1)
-			gdispGFillArea(gw->g.display, gw->g.x+gsw->dpos, gw->g.y, gw->g.width-gsw->dpos, gw->g.height, pcol->fill);						// Inactive area
+			gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+gsw->dpos, gwinGetDrawY(&gw->g), gw->g.width-gsw->dpos, gw->g.height, pcol->fill);						// Inactive area
 		if (gsw->dpos != 0)
-			gdispGFillArea(gw->g.display, gw->g.x, gw->g.y, gsw->dpos, gw->g.height, pcol->progress);										// Active Area
-		gdispGDrawBox(gw->g.display, gw->g.x, gw->g.y, gw->g.width, gw->g.height, pcol->edge);												// Edge
-		gdispGDrawLine(gw->g.display, gw->g.x+gsw->dpos, gw->g.y, gw->g.x+gsw->dpos, gw->g.y+gw->g.height-1, pcol->edge);					// Thumb
+			gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gsw->dpos, gw->g.height, pcol->progress);										// Active Area
+		gdispGDrawBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw->g.width, gw->g.height, pcol->edge);												// Edge
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+gsw->dpos, gwinGetDrawY(&gw->g), gwinGetDrawX(&gw->g)+gsw->dpos, gwinGetDrawY(&gw->g)+gw->g.height-1, pcol->edge);					// Thumb
 	}
-	gdispGDrawStringBox(gw->g.display, gw->g.x+1, gw->g.y+1, gw->g.width-2, gw->g.height-2, gw->text, gw->g.font, pcol->text, justifyCenter);
+	gdispGDrawStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+1, gwinGetDrawY(&gw->g)+1, gw->g.width-2, gw->g.height-2, gw->text, gw->g.font, pcol->text, justifyCenter);
 
 	#undef gsw
 }
@@ -278,7 +303,7 @@ void gwinProgressbarDraw_Image(GWidgetObject *gw, void *param) {
 	// Vertical progressbar
 	if (gw->g.width < gw->g.height) {
 		if (gsw->dpos != 0)							// The unfilled area
-			gdispGFillArea(gw->g.display, gw->g.x+1, gw->g.y+1, gw->g.width-2, gsw->dpos-1, gw->pstyle->enabled.progress);	// Inactive area
+			gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+1, gwinGetDrawY(&gw->g)+1, gw->g.width-2, gsw->dpos-1, gw->pstyle->enabled.progress);	// Inactive area
 		if (gsw->dpos != gw->g.height-1) {			// The filled area
 			for(z=gw->g.height, v=gi->height; z > gsw->dpos;) {
 				z -= v;
@@ -286,27 +311,27 @@ void gwinProgressbarDraw_Image(GWidgetObject *gw, void *param) {
 					v -= gsw->dpos - z;
 					z = gsw->dpos;
 				}
-				gdispGImageDraw(gw->g.display, gi, gw->g.x+1, gw->g.y+z+1, gw->g.width-1, v-2, 0, gi->height-v);
+				gdispGImageDraw(gwinGetDrawDisplay(&gw->g), gi, gwinGetDrawX(&gw->g)+1, gwinGetDrawY(&gw->g)+z+1, gw->g.width-1, v-2, 0, gi->height-v);
 			}
 		}
-		gdispGDrawBox(gw->g.display, gw->g.x, gw->g.y, gw->g.width, gw->g.height, pcol->edge);								// Edge
-		gdispGDrawLine(gw->g.display, gw->g.x+1, gw->g.y+gsw->dpos, gw->g.x+gw->g.width-2, gw->g.y+gsw->dpos, pcol->edge);	// Thumb
+		gdispGDrawBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw->g.width, gw->g.height, pcol->edge);								// Edge
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+1, gwinGetDrawY(&gw->g)+gsw->dpos, gwinGetDrawX(&gw->g)+gw->g.width-2, gwinGetDrawY(&gw->g)+gsw->dpos, pcol->edge);	// Thumb
 
 	// Horizontal progressbar
 	} else {
 		if (gsw->dpos != gw->g.width-1)				// The unfilled area
-			gdispGFillArea(gw->g.display, gw->g.x+gsw->dpos+1, gw->g.y+1, gw->g.width-gsw->dpos-2, gw->g.height-2, gw->pstyle->enabled.progress);	// Inactive area
+			gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+gsw->dpos+1, gwinGetDrawY(&gw->g)+1, gw->g.width-gsw->dpos-2, gw->g.height-2, gw->pstyle->enabled.progress);	// Inactive area
 		if (gsw->dpos != 0) {						// The filled area
 			for(z=0, v=gi->width; z < gsw->dpos; z += v) {
 				if (z+v > gsw->dpos)
 					v -= z+v - gsw->dpos;
-				gdispGImageDraw(gw->g.display, gi, gw->g.x+z+1, gw->g.y+1, v-1, gw->g.height-2, 0, 0);
+				gdispGImageDraw(gwinGetDrawDisplay(&gw->g), gi, gwinGetDrawX(&gw->g)+z+1, gwinGetDrawY(&gw->g)+1, v-1, gw->g.height-2, 0, 0);
 			}
 		}
-		gdispGDrawBox(gw->g.display, gw->g.x, gw->g.y, gw->g.width, gw->g.height, pcol->edge);								// Edge
-		gdispGDrawLine(gw->g.display, gw->g.x+gsw->dpos, gw->g.y+1, gw->g.x+gsw->dpos, gw->g.y+gw->g.height-2, pcol->edge);	// Thumb
+		gdispGDrawBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw->g.width, gw->g.height, pcol->edge);								// Edge
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+gsw->dpos, gwinGetDrawY(&gw->g)+1, gwinGetDrawX(&gw->g)+gsw->dpos, gwinGetDrawY(&gw->g)+gw->g.height-2, pcol->edge);	// Thumb
 	}
-	gdispGDrawStringBox(gw->g.display, gw->g.x+1, gw->g.y+1, gw->g.width-2, gw->g.height-2, gw->text, gw->g.font, pcol->text, justifyCenter);
+	gdispGDrawStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+1, gwinGetDrawY(&gw->g)+1, gw->g.width-2, gw->g.height-2, gw->text, gw->g.font, pcol->text, justifyCenter);
 
 	#undef gsw
 }
@@ -180,21 +180,21 @@ void gwinRadioDraw_Radio(GWidgetObject *gw, void *param) {
 
 	#if GDISP_NEED_CIRCLE
 		df = (ld-1)/2;
-		gdispGFillArea(gw->g.display, gw->g.x, gw->g.y, ld, ld, gw->pstyle->background);
-		gdispGDrawCircle(gw->g.display, gw->g.x+df, gw->g.y+df, df, pcol->edge);
+		gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), ld, ld, gw->pstyle->background);
+		gdispGDrawCircle(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+df, gwinGetDrawY(&gw->g)+df, df, pcol->edge);
 
 		if (gw->g.flags & GRADIO_FLG_PRESSED)
-			gdispGFillCircle(gw->g.display, gw->g.x+df, gw->g.y+df, df <= 2 ? 1 : (df-2), pcol->fill);
+			gdispGFillCircle(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+df, gwinGetDrawY(&gw->g)+df, df <= 2 ? 1 : (df-2), pcol->fill);
 	#else
-		gdispGFillArea(gw->g.display, gw->g.x+1, gw->g.y+1, ld, ld-2, gw->pstyle->background);
-		gdispGDrawBox(gw->g.display, gw->g.x, gw->g.y, ld, ld, pcol->edge);
+		gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+1, gwinGetDrawY(&gw->g)+1, ld, ld-2, gw->pstyle->background);
+		gdispGDrawBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), ld, ld, pcol->edge);
 
 		df = ld < 4 ? 1 : 2;
 		if (gw->g.flags & GRADIO_FLG_PRESSED)
-			gdispGFillArea(gw->g.display, gw->g.x+df, gw->g.y+df, ld-2*df, ld-2*df, pcol->fill);
+			gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+df, gwinGetDrawY(&gw->g)+df, ld-2*df, ld-2*df, pcol->fill);
 	#endif
 
-	gdispGFillStringBox(gw->g.display, gw->g.x+ld+1, gw->g.y, gw->g.width-ld-1, gw->g.height, gw->text, gw->g.font, pcol->text, gw->pstyle->background, justifyLeft);
+	gdispGFillStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+ld+1, gwinGetDrawY(&gw->g), gw->g.width-ld-1, gw->g.height, gw->text, gw->g.font, pcol->text, gw->pstyle->background, justifyLeft);
 	#undef gcw
 }
 
@@ -211,9 +211,9 @@ void gwinRadioDraw_Radio(GWidgetObject *gw, void *param) {
 			pcol = _gwinGetFlashedColor(gw, pcol, FALSE);
 		#endif
 
-		gdispGFillStringBox(gw->g.display, gw->g.x, gw->g.y, gw->g.width-1, gw->g.height-1, gw->text, gw->g.font, pcol->text, pcol->fill, justifyCenter);
-		gdispGDrawLine(gw->g.display, gw->g.x+gw->g.width-1, gw->g.y, gw->g.x+gw->g.width-1, gw->g.y+gw->g.height-1, pcol->edge);
-		gdispGDrawLine(gw->g.display, gw->g.x, gw->g.y+gw->g.height-1, gw->g.x+gw->g.width-2, gw->g.y+gw->g.height-1, pcol->edge);
+		gdispGFillStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw->g.width-1, gw->g.height-1, gw->text, gw->g.font, pcol->text, pcol->fill, justifyCenter);
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+gw->g.width-1, gwinGetDrawY(&gw->g), gwinGetDrawX(&gw->g)+gw->g.width-1, gwinGetDrawY(&gw->g)+gw->g.height-1, pcol->edge);
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g)+gw->g.height-1, gwinGetDrawX(&gw->g)+gw->g.width-2, gwinGetDrawY(&gw->g)+gw->g.height-1, pcol->edge);
 	}
 	void gwinRadioDraw_Tab(GWidgetObject *gw, void *param) {
 		const GColorSet *	pcol;
@@ -228,12 +228,12 @@ void gwinRadioDraw_Radio(GWidgetObject *gw, void *param) {
 		#endif
 
 		if ((gw->g.flags & GRADIO_FLG_PRESSED)) {
-			gdispGDrawBox(gw->g.display, gw->g.x, gw->g.y, gw->g.width, gw->g.height, pcol->edge);
-			gdispGFillStringBox(gw->g.display, gw->g.x+1, gw->g.y+1, gw->g.width-2, gw->g.height-1, gw->text, gw->g.font, pcol->text, pcol->fill, justifyCenter);
+			gdispGDrawBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw->g.width, gw->g.height, pcol->edge);
+			gdispGFillStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+1, gwinGetDrawY(&gw->g)+1, gw->g.width-2, gw->g.height-1, gw->text, gw->g.font, pcol->text, pcol->fill, justifyCenter);
 		} else {
-			gdispGFillStringBox(gw->g.display, gw->g.x, gw->g.y, gw->g.width-1, gw->g.height-1, gw->text, gw->g.font, pcol->text, pcol->fill, justifyCenter);
-			gdispGDrawLine(gw->g.display, gw->g.x+gw->g.width-1, gw->g.y, gw->g.x+gw->g.width-1, gw->g.y+gw->g.height-1, pcol->edge);
-			gdispGDrawLine(gw->g.display, gw->g.x, gw->g.y+gw->g.height-1, gw->g.x+gw->g.width-2, gw->g.y+gw->g.height-1, pcol->edge);
+			gdispGFillStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw->g.width-1, gw->g.height-1, gw->text, gw->g.font, pcol->text, pcol->fill, justifyCenter);
+			gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+gw->g.width-1, gwinGetDrawY(&gw->g), gwinGetDrawX(&gw->g)+gw->g.width-1, gwinGetDrawY(&gw->g)+gw->g.height-1, pcol->edge);
+			gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g)+gw->g.height-1, gwinGetDrawX(&gw->g)+gw->g.width-2, gwinGetDrawY(&gw->g)+gw->g.height-1, pcol->edge);
 		}
 	}
 #else
@@ -253,11 +253,11 @@ void gwinRadioDraw_Radio(GWidgetObject *gw, void *param) {
 		bcol = gdispBlendColor(Black, pcol->fill, GRADIO_BOTTOM_FADE);
 		dalpha = FIXED(255)/gw->g.height;
 		for(alpha = 0, i = 0; i < gw->g.height; i++, alpha += dalpha)
-			gdispGDrawLine(gw->g.display, gw->g.x, gw->g.y+i, gw->g.x+gw->g.width-2, gw->g.y+i, gdispBlendColor(bcol, tcol, NONFIXED(alpha)));
+			gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g)+i, gwinGetDrawX(&gw->g)+gw->g.width-2, gwinGetDrawY(&gw->g)+i, gdispBlendColor(bcol, tcol, NONFIXED(alpha)));
 
-		gdispGDrawStringBox(gw->g.display, gw->g.x, gw->g.y, gw->g.width-1, gw->g.height-1, gw->text, gw->g.font, pcol->text, justifyCenter);
-		gdispGDrawLine(gw->g.display, gw->g.x+gw->g.width-1, gw->g.y, gw->g.x+gw->g.width-1, gw->g.y+gw->g.height-1, pcol->edge);
-		gdispGDrawLine(gw->g.display, gw->g.x, gw->g.y+gw->g.height-1, gw->g.x+gw->g.width-2, gw->g.y+gw->g.height-1, pcol->edge);
+		gdispGDrawStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw->g.width-1, gw->g.height-1, gw->text, gw->g.font, pcol->text, justifyCenter);
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+gw->g.width-1, gwinGetDrawY(&gw->g), gwinGetDrawX(&gw->g)+gw->g.width-1, gwinGetDrawY(&gw->g)+gw->g.height-1, pcol->edge);
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g)+gw->g.height-1, gwinGetDrawX(&gw->g)+gw->g.width-2, gwinGetDrawY(&gw->g)+gw->g.height-1, pcol->edge);
 	}
 	void gwinRadioDraw_Tab(GWidgetObject *gw, void *param) {
 		const GColorSet *	pcol;
@@ -272,19 +272,19 @@ void gwinRadioDraw_Radio(GWidgetObject *gw, void *param) {
 
 		if ((gw->g.flags & GRADIO_FLG_PRESSED)) {
 			tcol = gdispBlendColor(pcol->edge, gw->pstyle->background, GRADIO_OUTLINE_FADE);
-			gdispGFillStringBox(gw->g.display, gw->g.x, gw->g.y, gw->g.width, gw->g.height, gw->text, gw->g.font, pcol->text, gw->g.bgcolor, justifyCenter);
-			gdispGDrawLine(gw->g.display, gw->g.x, gw->g.y, gw->g.x+gw->g.width-(GRADIO_TAB_CNR+1), gw->g.y, tcol);
-			gdispGDrawLine(gw->g.display, gw->g.x+gw->g.width-(GRADIO_TAB_CNR+1), gw->g.y, gw->g.x+gw->g.width-1, gw->g.y+GRADIO_TAB_CNR, tcol);
-			gdispGDrawLine(gw->g.display, gw->g.x+gw->g.width-1, gw->g.y+GRADIO_TAB_CNR, gw->g.x+gw->g.width-1, gw->g.y+gw->g.height-1, tcol);
+			gdispGFillStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw->g.width, gw->g.height, gw->text, gw->g.font, pcol->text, gw->g.bgcolor, justifyCenter);
+			gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gwinGetDrawX(&gw->g)+gw->g.width-(GRADIO_TAB_CNR+1), gwinGetDrawY(&gw->g), tcol);
+			gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+gw->g.width-(GRADIO_TAB_CNR+1), gwinGetDrawY(&gw->g), gwinGetDrawX(&gw->g)+gw->g.width-1, gwinGetDrawY(&gw->g)+GRADIO_TAB_CNR, tcol);
+			gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+gw->g.width-1, gwinGetDrawY(&gw->g)+GRADIO_TAB_CNR, gwinGetDrawX(&gw->g)+gw->g.width-1, gwinGetDrawY(&gw->g)+gw->g.height-1, tcol);
 		} else {
 			/* Fill the box blended from variants of the fill color */
 			tcol = gdispBlendColor(White, pcol->fill, GRADIO_TOP_FADE);
 			bcol = gdispBlendColor(Black, pcol->fill, GRADIO_BOTTOM_FADE);
 			dalpha = FIXED(255)/gw->g.height;
 			for(alpha = 0, i = 0; i < gw->g.height; i++, alpha += dalpha)
-				gdispGDrawLine(gw->g.display, gw->g.x, gw->g.y+i, gw->g.x+gw->g.width-2, gw->g.y+i, gdispBlendColor(bcol, tcol, NONFIXED(alpha)));
-			gdispGDrawLine(gw->g.display, gw->g.x+gw->g.width-1, gw->g.y, gw->g.x+gw->g.width-1, gw->g.y+gw->g.height-1, pcol->edge);
-			gdispGDrawStringBox(gw->g.display, gw->g.x+1, gw->g.y+1, gw->g.width-2, gw->g.height-2, gw->text, gw->g.font, pcol->text, justifyCenter);
+				gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g)+i, gwinGetDrawX(&gw->g)+gw->g.width-2, gwinGetDrawY(&gw->g)+i, gdispBlendColor(bcol, tcol, NONFIXED(alpha)));
+			gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+gw->g.width-1, gwinGetDrawY(&gw->g), gwinGetDrawX(&gw->g)+gw->g.width-1, gwinGetDrawY(&gw->g)+gw->g.height-1, pcol->edge);
+			gdispGDrawStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+1, gwinGetDrawY(&gw->g)+1, gw->g.width-2, gw->g.height-2, gw->text, gw->g.font, pcol->text, justifyCenter);
 		}
 	}
 #endif
@@ -80,6 +80,24 @@
 			#undef GDISP_NEED_MULTITHREAD
 			#define GDISP_NEED_MULTITHREAD	TRUE
 		#endif
+		#if GWIN_WIDGET_CACHE && !GDISP_NEED_PIXMAP
+			#error "GWIN: GDISP_NEED_PIXMAP is required if GWIN_WIDGET_CACHE is TRUE."
+		#endif
+	#endif
+	#if GWIN_NEED_COMPOSITOR
+		#if !GWIN_NEED_WINDOWMANAGER
+			#if GFX_DISPLAY_RULE_WARNINGS
+				#warning "GWIN: GWIN_NEED_WINDOWMANAGER is required if GWIN_NEED_COMPOSITOR is TRUE. It has been turned on for you."
+			#endif
+			#undef GWIN_NEED_WINDOWMANAGER
+			#define GWIN_NEED_WINDOWMANAGER	TRUE
+		#endif
+		#if !GDISP_NEED_PIXMAP
+			#error "GWIN: GDISP_NEED_PIXMAP is required if GWIN_NEED_COMPOSITOR is TRUE."
+		#endif
+		#if !GDISP_NEED_CLIP
+			#error "GWIN: GDISP_NEED_CLIP is required if GWIN_NEED_COMPOSITOR is TRUE."
+		#endif
 	#endif
 	#if GWIN_NEED_WINDOWMANAGER
 		#if !GFX_USE_GQUEUE || !GQUEUE_NEED_ASYNC
@@ -98,6 +116,13 @@
 			#undef GFX_USE_GTIMER
 			#define GFX_USE_GTIMER		TRUE
 		#endif
+		#if GWIN_REDRAW_IMMEDIATE && GWIN_REDRAW_FRAMERATE
+			#if GFX_DISPLAY_RULE_WARNINGS
+				#warning "GWIN: GWIN_REDRAW_FRAMERATE has no effect if GWIN_REDRAW_IMMEDIATE is TRUE. It has been turned off for you."
+			#endif
+			#undef GWIN_REDRAW_FRAMERATE
+			#define GWIN_REDRAW_FRAMERATE	0
+		#endif
 	#endif
 
 	// Rules for individual objects
@@ -122,6 +147,18 @@
 		#if !GDISP_NEED_TEXT
 			#error "GWIN: GDISP_NEED_TEXT is required if GWIN_NEED_CONSOLE is TRUE."
 		#endif
+		#if GWIN_CONSOLE_DEFERRED_RENDER
+			#if !GWIN_CONSOLE_USE_HISTORY
+				#error "GWIN: GWIN_CONSOLE_USE_HISTORY is required if GWIN_CONSOLE_DEFERRED_RENDER is TRUE."
+			#endif
+			#if !GFX_USE_GTIMER
+				#if GFX_DISPLAY_RULE_WARNINGS
+					#warning "GWIN: GFX_USE_GTIMER is required if GWIN_CONSOLE_DEFERRED_RENDER is TRUE. It has been turned on for you."
+				#endif
+				#undef GFX_USE_GTIMER
+				#define GFX_USE_GTIMER		TRUE
+			#endif
+		#endif
 	#endif
 	#if GWIN_NEED_TEXTEDIT
 		#if !GDISP_NEED_TEXT
@@ -90,6 +90,34 @@ static void SliderResetDisplayPos(GSliderObject *gsw) {
 		gsw->dpos = (gsw->w.g.width-1)*(gsw->pos-gsw->min)/(gsw->max-gsw->min);
 }
 
+// Redraw the part of the slider that changed when the display position moved from odpos
+static void SliderUpdateDisplayPos(GSliderObject *gsw, coord_t odpos) {
+	coord_t		lo, hi;
+
+	// A custom draw routine can draw anything based on the position
+	if (gsw->w.fnDraw != gwinSliderDraw_Std
+			#if GDISP_NEED_IMAGE
+				&& gsw->w.fnDraw != gwinSliderDraw_Image
+			#endif
+			) {
+		_gwinUpdate(&gsw->w.g);
+		return;
+	}
+
+	// The built-in draw routines only change between the old and new thumbs (which are up to 5 pixels wide)
+	if (gsw->dpos < odpos) {
+		lo = gsw->dpos - 2;
+		hi = odpos + 2;
+	} else {
+		lo = odpos - 2;
+		hi = gsw->dpos + 2;
+	}
+	if (gsw->w.g.width < gsw->w.g.height)
+		_gwinUpdateArea(&gsw->w.g, 0, lo, gsw->w.g.width, hi-lo+1);
+	else
+		_gwinUpdateArea(&gsw->w.g, lo, 0, hi-lo+1, gsw->w.g.height);
+}
+
 #if GINPUT_NEED_MOUSE
 	// Set the display position from the mouse position
 	static void SetDisplayPosFromMouse(GSliderObject *gsw, coord_t x, coord_t y) {
@@ -102,13 +130,16 @@ static void SliderResetDisplayPos(GSliderObject *gsw) {
 	// A mouse up event
 	static void SliderMouseUp(GWidgetObject *gw, coord_t x, coord_t y) {
 		#define gsw		((GSliderObject *)gw)
+		coord_t		odpos;
+
+		odpos = gsw->dpos;
 
 		#if !GWIN_BUTTON_LAZY_RELEASE
 			// Are we over the slider?
 			if (x < 0 || x >= gsw->w.g.width || y < 0 || y >= gsw->w.g.height) {
 				// No - restore the slider
 				SliderResetDisplayPos(gsw);
-				_gwinUpdate(&gsw->w.g);
+				SliderUpdateDisplayPos(gsw, odpos);
 				SendSliderEvent(gsw, GSLIDER_EVENT_CANCEL);
 				return;
 			}
@@ -135,7 +166,7 @@ static void SliderResetDisplayPos(GSliderObject *gsw) {
 		#else
 			SliderResetDisplayPos(gsw);
 		#endif
-		_gwinUpdate(&gsw->w.g);
+		SliderUpdateDisplayPos(gsw, odpos);
 
 		// Generate the event
 		SendSliderEvent(gsw, GSLIDER_EVENT_SET);
@@ -146,12 +177,14 @@ static void SliderResetDisplayPos(GSliderObject *gsw) {
 	// A mouse down event
 	static void SliderMouseDown(GWidgetObject *gw, coord_t x, coord_t y) {
 		#define gsw		((GSliderObject *)gw)
+		coord_t		odpos;
 
 		// Determine the display position
+		odpos = gsw->dpos;
 		SetDisplayPosFromMouse(gsw, x, y);
 
 		// Update the display
-		_gwinUpdate(&gsw->w.g);
+		SliderUpdateDisplayPos(gsw, odpos);
 
 		// Send the event
 		SendSliderEvent(gsw, GSLIDER_EVENT_START);
@@ -162,12 +195,14 @@ static void SliderResetDisplayPos(GSliderObject *gsw) {
 	// A mouse move event
 	static void SliderMouseMove(GWidgetObject *gw, coord_t x, coord_t y) {
 		#define gsw		((GSliderObject *)gw)
+		coord_t		odpos;
 
 		// Determine the display position
+		odpos = gsw->dpos;
 		SetDisplayPosFromMouse(gsw, x, y);
 
 		// Update the display
-		_gwinUpdate(&gsw->w.g);
+		SliderUpdateDisplayPos(gsw, odpos);
 
 		// Send the event
 		SendSliderEvent(gsw, GSLIDER_EVENT_MOVE);
@@ -207,13 +242,15 @@ static void SliderResetDisplayPos(GSliderObject *gsw) {
 	// A dial move event
 	static void SliderDialMove(GWidgetObject *gw, uint16_t role, uint16_t value, uint16_t max) {
 		#define gsw		((GSliderObject *)gw)
+		coord_t			odpos;
 		(void)			role;
 
 		// Set the new position
 		gsw->pos = (uint16_t)((uint32_t)value*(gsw->max-gsw->min)/max + gsw->min);
 
+		odpos = gsw->dpos;
 		SliderResetDisplayPos(gsw);
-		_gwinUpdate(&gsw->w.g);
+		SliderUpdateDisplayPos(gsw, odpos);
 
 		// Generate the event
 		SendSliderEvent(gsw, GSLIDER_EVENT_SET);
@@ -307,6 +344,7 @@ void gwinSliderSetRange(GHandle gh, int min, int max) {
 
 void gwinSliderSetPosition(GHandle gh, int pos) {
 	#define gsw		((GSliderObject *)gh)
+	coord_t		odpos;
 
 	if (gh->vmt != (gwinVMT *)&sliderVMT)
 		return;
@@ -320,8 +358,9 @@ void gwinSliderSetPosition(GHandle gh, int pos) {
 		else if (pos < gsw->max) gsw->pos = gsw->max;
 		else gsw->pos = pos;
 	}
+	odpos = gsw->dpos;
 	SliderResetDisplayPos(gsw);
-	_gwinUpdate(gh);
+	SliderUpdateDisplayPos(gsw, odpos);
 
 	#undef gsw
 }
@@ -356,32 +395,32 @@ void gwinSliderDraw_Std(GWidgetObject *gw, void *param) {
 	// Vertical slider
 	if (gw->g.width < gw->g.height) {
 		if (gsw->dpos != gw->g.height-1)
-			gdispGFillArea(gw->g.display, gw->g.x, gw->g.y+gsw->dpos, gw->g.width, gw->g.height - gsw->dpos, pcol->progress);		// Active area
+			gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g)+gsw->dpos, gw->g.width, gw->g.height - gsw->dpos, pcol->progress);		// Active area
 		if (gsw->dpos != 0)
-			gdispGFillArea(gw->g.display, gw->g.x, gw->g.y, gw->g.width, gsw->dpos, pcol->fill);									// Inactive area
-		gdispGDrawBox(gw->g.display, gw->g.x, gw->g.y, gw->g.width, gw->g.height, pcol->edge);										// Edge
-		gdispGDrawLine(gw->g.display, gw->g.x, gw->g.y+gsw->dpos, gw->g.x+gw->g.width-1, gw->g.y+gsw->dpos, pcol->edge);			// Thumb
+			gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw->g.width, gsw->dpos, pcol->fill);									// Inactive area
+		gdispGDrawBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw->g.width, gw->g.height, pcol->edge);										// Edge
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g)+gsw->dpos, gwinGetDrawX(&gw->g)+gw->g.width-1, gwinGetDrawY(&gw->g)+gsw->dpos, pcol->edge);			// Thumb
 		if (gsw->dpos >= 2)
-			gdispGDrawLine(gw->g.display, gw->g.x, gw->g.y+gsw->dpos-2, gw->g.x+gw->g.width-1, gw->g.y+gsw->dpos-2, pcol->edge);	// Thumb
+			gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g)+gsw->dpos-2, gwinGetDrawX(&gw->g)+gw->g.width-1, gwinGetDrawY(&gw->g)+gsw->dpos-2, pcol->edge);	// Thumb
 		if (gsw->dpos <= gw->g.height-2)
-			gdispGDrawLine(gw->g.display, gw->g.x, gw->g.y+gsw->dpos+2, gw->g.x+gw->g.width-1, gw->g.y+gsw->dpos+2, pcol->edge);	// Thumb
+			gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g)+gsw->dpos+2, gwinGetDrawX(&gw->g)+gw->g.width-1, gwinGetDrawY(&gw->g)+gsw->dpos+2, pcol->edge);	// Thumb
 
 	// Horizontal slider
 	} else {
 		if (gsw->dpos != gw->g.width-1)
-			gdispGFillArea(gw->g.display, gw->g.x+gsw->dpos, gw->g.y, gw->g.width-gsw->dpos, gw->g.height, pcol->fill);				// Inactive area
+			gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+gsw->dpos, gwinGetDrawY(&gw->g), gw->g.width-gsw->dpos, gw->g.height, pcol->fill);				// Inactive area
 		if (gsw->dpos != 0)
-			gdispGFillArea(gw->g.display, gw->g.x, gw->g.y, gsw->dpos, gw->g.height, pcol->progress);								// Active area
-		gdispGDrawBox(gw->g.display, gw->g.x, gw->g.y, gw->g.width, gw->g.height, pcol->edge);										// Edge
-		gdispGDrawLine(gw->g.display, gw->g.x+gsw->dpos, gw->g.y, gw->g.x+gsw->dpos, gw->g.y+gw->g.height-1, pcol->edge);			// Thumb
+			gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gsw->dpos, gw->g.height, pcol->progress);								// Active area
+		gdispGDrawBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw->g.width, gw->g.height, pcol->edge);										// Edge
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+gsw->dpos, gwinGetDrawY(&gw->g), gwinGetDrawX(&gw->g)+gsw->dpos, gwinGetDrawY(&gw->g)+gw->g.height-1, pcol->edge);			// Thumb
 		if (gsw->dpos >= 2)
-			gdispGDrawLine(gw->g.display, gw->g.x+gsw->dpos-2, gw->g.y, gw->g.x+gsw->dpos-2, gw->g.y+gw->g.height-1, pcol->edge);	// Thumb
+			gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+gsw->dpos-2, gwinGetDrawY(&gw->g), gwinGetDrawX(&gw->g)+gsw->dpos-2, gwinGetDrawY(&gw->g)+gw->g.height-1, pcol->edge);	// Thumb
 		if (gsw->dpos <= gw->g.width-2)
-			gdispGDrawLine(gw->g.display, gw->g.x+gsw->dpos+2, gw->g.y, gw->g.x+gsw->dpos+2, gw->g.y+gw->g.height-1, pcol->edge);	// Thumb
+			gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+gsw->dpos+2, gwinGetDrawY(&gw->g), gwinGetDrawX(&gw->g)+gsw->dpos+2, gwinGetDrawY(&gw->g)+gw->g.height-1, pcol->edge);	// Thumb
 	}
 
 	// Draw the string
-	gdispGDrawStringBox(gw->g.display, gw->g.x+1, gw->g.y+1, gw->g.width-2, gw->g.height-2, gw->text, gw->g.font, pcol->text, justifyCenter);
+	gdispGDrawStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+1, gwinGetDrawY(&gw->g)+1, gw->g.width-2, gw->g.height-2, gw->text, gw->g.font, pcol->text, justifyCenter);
 
 	#undef gsw
 }
@@ -403,7 +442,7 @@ void gwinSliderDraw_Image(GWidgetObject *gw, void *param) {
 
 	if (gw->g.width < gw->g.height) {			// Vertical slider
 		if (gsw->dpos != 0)							// The unfilled area
-			gdispGFillArea(gw->g.display, gw->g.x+1, gw->g.y+1, gw->g.width-2, gsw->dpos-1, gw->pstyle->enabled.progress);	// Inactive area
+			gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+1, gwinGetDrawY(&gw->g)+1, gw->g.width-2, gsw->dpos-1, gw->pstyle->enabled.progress);	// Inactive area
 		if (gsw->dpos != gw->g.height-1) {			// The filled area
 			for(z=gw->g.height, v=gi->height; z > gsw->dpos;) {
 				z -= v;
@@ -411,27 +450,27 @@ void gwinSliderDraw_Image(GWidgetObject *gw, void *param) {
 					v -= gsw->dpos - z;
 					z = gsw->dpos;
 				}
-				gdispGImageDraw(gw->g.display, gi, gw->g.x+1, gw->g.y+z+1, gw->g.width-1, v-2, 0, gi->height-v);
+				gdispGImageDraw(gwinGetDrawDisplay(&gw->g), gi, gwinGetDrawX(&gw->g)+1, gwinGetDrawY(&gw->g)+z+1, gw->g.width-1, v-2, 0, gi->height-v);
 			}
 		}
-		gdispGDrawBox(gw->g.display, gw->g.x, gw->g.y, gw->g.width, gw->g.height, pcol->edge);								// Edge
-		gdispGDrawLine(gw->g.display, gw->g.x+1, gw->g.y+gsw->dpos, gw->g.x+gw->g.width-2, gw->g.y+gsw->dpos, pcol->edge);	// Thumb
+		gdispGDrawBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw->g.width, gw->g.height, pcol->edge);								// Edge
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+1, gwinGetDrawY(&gw->g)+gsw->dpos, gwinGetDrawX(&gw->g)+gw->g.width-2, gwinGetDrawY(&gw->g)+gsw->dpos, pcol->edge);	// Thumb
 
 	// Horizontal slider
 	} else {
 		if (gsw->dpos != gw->g.width-1)				// The unfilled area
-			gdispGFillArea(gw->g.display, gw->g.x+gsw->dpos+1, gw->g.y+1, gw->g.width-gsw->dpos-2, gw->g.height-2, gw->pstyle->enabled.progress);	// Inactive area
+			gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+gsw->dpos+1, gwinGetDrawY(&gw->g)+1, gw->g.width-gsw->dpos-2, gw->g.height-2, gw->pstyle->enabled.progress);	// Inactive area
 		if (gsw->dpos != 0) {						// The filled area
 			for(z=0, v=gi->width; z < gsw->dpos; z += v) {
 				if (z+v > gsw->dpos)
 					v -= z+v - gsw->dpos;
-				gdispGImageDraw(gw->g.display, gi, gw->g.x+z+1, gw->g.y+1, v-1, gw->g.height-2, 0, 0);
+				gdispGImageDraw(gwinGetDrawDisplay(&gw->g), gi, gwinGetDrawX(&gw->g)+z+1, gwinGetDrawY(&gw->g)+1, v-1, gw->g.height-2, 0, 0);
 			}
 		}
-		gdispGDrawBox(gw->g.display, gw->g.x, gw->g.y, gw->g.width, gw->g.height, pcol->edge);								// Edge
-		gdispGDrawLine(gw->g.display, gw->g.x+gsw->dpos, gw->g.y+1, gw->g.x+gsw->dpos, gw->g.y+gw->g.height-2, pcol->edge);	// Thumb
+		gdispGDrawBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw->g.width, gw->g.height, pcol->edge);								// Edge
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+gsw->dpos, gwinGetDrawY(&gw->g)+1, gwinGetDrawX(&gw->g)+gsw->dpos, gwinGetDrawY(&gw->g)+gw->g.height-2, pcol->edge);	// Thumb
 	}
-	gdispGDrawStringBox(gw->g.display, gw->g.x+1, gw->g.y+1, gw->g.width-2, gw->g.height-2, gw->text, gw->g.font, pcol->text, justifyCenter);
+	gdispGDrawStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+1, gwinGetDrawY(&gw->g)+1, gw->g.width-2, gw->g.height-2, gw->text, gw->g.font, pcol->text, justifyCenter);
 
 	#undef gsw
 	#undef gi
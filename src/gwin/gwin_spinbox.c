@@ -263,8 +263,8 @@ void gwinSpinboxDefaultDraw(GWidgetObject* gw, void* param)
 	if ((gw->g.flags & GSPINBOX_NUM_REDRAW)) {
 
 		// Fill the stringbox with value - justifyRight
-		gdispGFillStringBox(gw->g.display, gw->g.x + gw2ButtonSize + 1 + TEXTPADDING,
-				gw->g.y + 1, gw->g.width - 2 * gw2ButtonSize - gdispGetStringWidth(gsw->strData, gw->g.font) - 6, gw->g.height - 2, ptr,
+		gdispGFillStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g) + gw2ButtonSize + 1 + TEXTPADDING,
+				gwinGetDrawY(&gw->g) + 1, gw->g.width - 2 * gw2ButtonSize - gdispGetStringWidth(gsw->strData, gw->g.font) - 6, gw->g.height - 2, ptr,
 				gw->g.font, ps->text, gw->pstyle->background, justifyRight);
 				gw->g.flags &= ~GSPINBOX_NUM_REDRAW;		// Reset flag
 
@@ -288,63 +288,63 @@ void gwinSpinboxDefaultDraw(GWidgetObject* gw, void* param)
 		#endif
 
 		// Draw the border
-		gdispGDrawBox(gw->g.display, gw->g.x, gw->g.y, gw->g.width,
+		gdispGDrawBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw->g.width,
 				gw->g.height, ps->edge);
 
 		// Fill left button box background area
-		gdispGFillArea(gw->g.display, gw->g.x + 1,
-				gw->g.y + 1, gw2ButtonSize-1, gw->g.height - 2,
+		gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g) + 1,
+				gwinGetDrawY(&gw->g) + 1, gw2ButtonSize-1, gw->g.height - 2,
 				gdispBlendColor(ps->fill, gw->pstyle->background, 128));
 
 		// Fill right button box background area
-		gdispGFillArea(gw->g.display, gw->g.x + gw->g.width - gw2ButtonSize,
-				gw->g.y + 1, gw2ButtonSize-1, gw->g.height - 2,
+		gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g) + gw->g.width - gw2ButtonSize,
+				gwinGetDrawY(&gw->g) + 1, gw2ButtonSize-1, gw->g.height - 2,
 				gdispBlendColor(ps->fill, gw->pstyle->background, 128));
 
 		// Draw left vertical line
-		gdispGDrawLine(gw->g.display, gw->g.x + gw2ButtonSize,
-				gw->g.y + 1, gw->g.x + gw2ButtonSize,
-				gw->g.y + gw->g.height - 2, ps->edge);
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g) + gw2ButtonSize,
+				gwinGetDrawY(&gw->g) + 1, gwinGetDrawX(&gw->g) + gw2ButtonSize,
+				gwinGetDrawY(&gw->g) + gw->g.height - 2, ps->edge);
 
 		// Draw right vertical line
-		gdispGDrawLine(gw->g.display, gw->g.x + gw->g.width - gw2ButtonSize,
-				gw->g.y + 1, gw->g.x + gw->g.width - gw2ButtonSize,
-				gw->g.y + gw->g.height - 2, ps->edge);
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g) + gw->g.width - gw2ButtonSize,
+				gwinGetDrawY(&gw->g) + 1, gwinGetDrawX(&gw->g) + gw->g.width - gw2ButtonSize,
+				gwinGetDrawY(&gw->g) + gw->g.height - 2, ps->edge);
 
 		#if GDISP_NEED_CONVEX_POLYGON
 			// Up Arrow
-			gdispGFillConvexPoly(gw->g.display,gw->g.x + border, gw->g.y + border, upArrow, 3, ps->edge);
+			gdispGFillConvexPoly(gwinGetDrawDisplay(&gw->g),gwinGetDrawX(&gw->g) + border, gwinGetDrawY(&gw->g) + border, upArrow, 3, ps->edge);
 			// Down Arrow
-			gdispGFillConvexPoly(gw->g.display,gw->g.x + gw->g.width - arrowSize - border,gw->g.y + gw->g.height - border,downArrow,3,ps->edge);
+			gdispGFillConvexPoly(gwinGetDrawDisplay(&gw->g),gwinGetDrawX(&gw->g) + gw->g.width - arrowSize - border,gwinGetDrawY(&gw->g) + gw->g.height - border,downArrow,3,ps->edge);
 		#else
 			#warning "GWIN: Spinbox will display arrow symbols when GDISP_NEED_CONVEX_POLYGON is turned on"
 			// Plus symbol horizontal line
-			gdispGDrawLine(gw->g.display, gw->g.x + border,
-				gw->g.y + gw->g.height / 2, gw->g.x + gw2ButtonSize - border,
-				gw->g.y + gw->g.height / 2, ps->edge);
+			gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g) + border,
+				gwinGetDrawY(&gw->g) + gw->g.height / 2, gwinGetDrawX(&gw->g) + gw2ButtonSize - border,
+				gwinGetDrawY(&gw->g) + gw->g.height / 2, ps->edge);
 
 			// Plus symbol vertical line
-			gdispGDrawLine(gw->g.display, gw->g.x + gw2ButtonSize/2,
-				gw->g.y + border, gw->g.x + gw2ButtonSize/2,
-				gw->g.y + gw->g.height - border-1, ps->edge);
+			gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g) + gw2ButtonSize/2,
+				gwinGetDrawY(&gw->g) + border, gwinGetDrawX(&gw->g) + gw2ButtonSize/2,
+				gwinGetDrawY(&gw->g) + gw->g.height - border-1, ps->edge);
 
 			// Minus symbol horizontal line
-			gdispGDrawLine(gw->g.display, gw->g.x + gw->g.width - 1 - border,
-				gw->g.y + gw->g.height - gw->g.height / 2 -1, gw->g.x + gw->g.width - gw2ButtonSize + border,
-				gw->g.y + gw->g.height - gw->g.height / 2 -1, ps->edge);
+			gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g) + gw->g.width - 1 - border,
+				gwinGetDrawY(&gw->g) + gw->g.height - gw->g.height / 2 -1, gwinGetDrawX(&gw->g) + gw->g.width - gw2ButtonSize + border,
+				gwinGetDrawY(&gw->g) + gw->g.height - gw->g.height / 2 -1, ps->edge);
 		#endif
 
 		if ((gw->g.flags & GSPINBOX_NUM)) {
 			// Fill the stringbox with units - justifyRight
-			gdispGFillStringBox(gw->g.display, gw->g.x + gw->g.width - gw2ButtonSize - gdispGetStringWidth(gsw->strData, gw->g.font) - TEXTPADDING,
-				gw->g.y + 1, gdispGetStringWidth(gsw->strData, gw->g.font),
+			gdispGFillStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g) + gw->g.width - gw2ButtonSize - gdispGetStringWidth(gsw->strData, gw->g.font) - TEXTPADDING,
+				gwinGetDrawY(&gw->g) + 1, gdispGetStringWidth(gsw->strData, gw->g.font),
 				gw->g.height - 2, gsw->strData, gw->g.font, ps->text,
 				gw->pstyle->background, justifyRight);
 		}
 
 		// Fill the stringbox with value - justifyRight
-		gdispGFillStringBox(gw->g.display, gw->g.x + gw2ButtonSize + 1 + TEXTPADDING,
-			gw->g.y + 1, gw->g.width - 2 * gw2ButtonSize - gdispGetStringWidth(gsw->strData, gw->g.font) - 6, gw->g.height - 2, ptr, gw->g.font, ps->text,	gw->pstyle->background, justifyRight);
+		gdispGFillStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g) + gw2ButtonSize + 1 + TEXTPADDING,
+			gwinGetDrawY(&gw->g) + 1, gw->g.width - 2 * gw2ButtonSize - gdispGetStringWidth(gsw->strData, gw->g.font) - 6, gw->g.height - 2, ptr, gw->g.font, ps->text,	gw->pstyle->background, justifyRight);
 	}
 
 	#undef gsw
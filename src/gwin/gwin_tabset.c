@@ -400,25 +400,25 @@ void gwinTabsetSetTab(GHandle gh) {
 
 		pcol = (gw->g.flags & GWIN_FLG_SYSENABLED) ? &gw->pstyle->pressed : &gw->pstyle->disabled;
 
-		gdispGDrawBox(gw->g.display, gw->g.x+x, gw->g.y+y, w, GWIN_TABSET_TABHEIGHT, pcol->edge);
-		gdispGFillStringBox(gw->g.display, gw->g.x+x+1, gw->g.y+y+1, w-2, GWIN_TABSET_TABHEIGHT-1, text, gw->g.font, pcol->text, pcol->fill, justifyCenter);
+		gdispGDrawBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x, gwinGetDrawY(&gw->g)+y, w, GWIN_TABSET_TABHEIGHT, pcol->edge);
+		gdispGFillStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x+1, gwinGetDrawY(&gw->g)+y+1, w-2, GWIN_TABSET_TABHEIGHT-1, text, gw->g.font, pcol->text, pcol->fill, justifyCenter);
 	}
 	static void bgarea(GWidgetObjset *gw, const char *text, coord_t y, coord_t x, coord_t w) {
 		const GColorSet *	pcol;
 
 		pcol = (gw->g.flags & GWIN_FLG_SYSENABLED) ? &gw->pstyle->enabled : &gw->pstyle->disabled;
 
-		gdispGFillStringBox(gw->g.display, gw->g.x+x, gw->g.y+y, w-1, GWIN_TABSET_TABHEIGHT, text, gw->g.font, pcol->text, pcol->fill, justifyCenter);
-		gdispGDrawLine(gw->g.display, gw->g.x+x+w-1, gw->g.y+y, gw->g.x+x+w-1, gw->g.y+y+GWIN_TABSET_TABHEIGHT-1, pcol->edge);
-		gdispGDrawLine(gw->g.display, gw->g.x+x, gw->g.y+y+GWIN_TABSET_TABHEIGHT-1, gw->g.x+x+w-2, gw->g.y+y+GWIN_TABSET_TABHEIGHT-1, pcol->edge);
+		gdispGFillStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x, gwinGetDrawY(&gw->g)+y, w-1, GWIN_TABSET_TABHEIGHT, text, gw->g.font, pcol->text, pcol->fill, justifyCenter);
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x+w-1, gwinGetDrawY(&gw->g)+y, gwinGetDrawX(&gw->g)+x+w-1, gwinGetDrawY(&gw->g)+y+GWIN_TABSET_TABHEIGHT-1, pcol->edge);
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x, gwinGetDrawY(&gw->g)+y+GWIN_TABSET_TABHEIGHT-1, gwinGetDrawX(&gw->g)+x+w-2, gwinGetDrawY(&gw->g)+y+GWIN_TABSET_TABHEIGHT-1, pcol->edge);
 	}
 	static void ntarea(GWidgetObjset *gw, coord_t y, coord_t x, coord_t w) {
 		const GColorSet *	pcol;
 
 		pcol = (gw->g.flags & GWIN_FLG_SYSENABLED) ? &gw->pstyle->pressed : &gw->pstyle->disabled;
 
-		gdispGFillArea(gw->g.display, gw->g.x+x, gw->g.y, w+y, GWIN_TABSET_TABHEIGHT-1, gw->g.bgcolor);
-		gdispGDrawLine(gw->g.display, gw->g.x+x, gw->g.y+y+GWIN_TABSET_TABHEIGHT-1, gw->g.x+x+w-1, gw->g.y+y+GWIN_TABSET_TABHEIGHT-1, pcol->edge);
+		gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x, gwinGetDrawY(&gw->g), w+y, GWIN_TABSET_TABHEIGHT-1, gw->g.bgcolor);
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x, gwinGetDrawY(&gw->g)+y+GWIN_TABSET_TABHEIGHT-1, gwinGetDrawX(&gw->g)+x+w-1, gwinGetDrawY(&gw->g)+y+GWIN_TABSET_TABHEIGHT-1, pcol->edge);
 	}
 #else
 	static void fgarea(GWidgetObject *gw, const char *text, coord_t y, coord_t x, coord_t w) {
@@ -428,12 +428,12 @@ void gwinTabsetSetTab(GHandle gh) {
 		pcol = (gw->g.flags & GWIN_FLG_SYSENABLED) ? &gw->pstyle->pressed : &gw->pstyle->disabled;
 
 		tcol = gdispBlendColor(pcol->edge, gw->pstyle->background, GTABSET_OUTLINE_FADE);
-		gdispGFillStringBox(gw->g.display, gw->g.x+x, gw->g.y+y, w, GWIN_TABSET_TABHEIGHT, text, gw->g.font, pcol->text, gw->g.bgcolor, justifyCenter);
-		gdispGDrawLine(gw->g.display, gw->g.x+x, gw->g.y+y, gw->g.x+x+w-(GTABSET_TAB_CNR+1), gw->g.y+y, tcol);
-		gdispGDrawLine(gw->g.display, gw->g.x+x+w-(GTABSET_TAB_CNR+1), gw->g.y+y, gw->g.x+x+w-1, gw->g.y+y+GTABSET_TAB_CNR, tcol);
-		gdispGDrawLine(gw->g.display, gw->g.x+x+w-1, gw->g.y+y+GTABSET_TAB_CNR, gw->g.x+x+w-1, gw->g.y+y+GWIN_TABSET_TABHEIGHT-1, tcol);
+		gdispGFillStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x, gwinGetDrawY(&gw->g)+y, w, GWIN_TABSET_TABHEIGHT, text, gw->g.font, pcol->text, gw->g.bgcolor, justifyCenter);
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x, gwinGetDrawY(&gw->g)+y, gwinGetDrawX(&gw->g)+x+w-(GTABSET_TAB_CNR+1), gwinGetDrawY(&gw->g)+y, tcol);
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x+w-(GTABSET_TAB_CNR+1), gwinGetDrawY(&gw->g)+y, gwinGetDrawX(&gw->g)+x+w-1, gwinGetDrawY(&gw->g)+y+GTABSET_TAB_CNR, tcol);
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x+w-1, gwinGetDrawY(&gw->g)+y+GTABSET_TAB_CNR, gwinGetDrawX(&gw->g)+x+w-1, gwinGetDrawY(&gw->g)+y+GWIN_TABSET_TABHEIGHT-1, tcol);
 		if (!x)
-			gdispGDrawLine(gw->g.display, gw->g.x, gw->g.y+y, gw->g.x, gw->g.y+y+GWIN_TABSET_TABHEIGHT-1, tcol);
+			gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g)+y, gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g)+y+GWIN_TABSET_TABHEIGHT-1, tcol);
 	}
 	static void bgarea(GWidgetObject *gw, const char *text, coord_t y, coord_t x, coord_t w) {
 		const GColorSet *	pcol;
@@ -447,17 +447,17 @@ void gwinTabsetSetTab(GHandle gh) {
 		tcol = gdispBlendColor(White, pcol->fill, GTABSET_TOP_FADE);
 		bcol = gdispBlendColor(Black, pcol->fill, GTABSET_BOTTOM_FADE);
 		for(alpha = 0, i = 0; i < GWIN_TABSET_TABHEIGHT; i++, alpha += FIXED(255)/GWIN_TABSET_TABHEIGHT)
-			gdispGDrawLine(gw->g.display, gw->g.x+x, gw->g.y+y+i, gw->g.x+x+w-2, gw->g.y+y+i, gdispBlendColor(bcol, tcol, NONFIXED(alpha)));
-		gdispGDrawLine(gw->g.display, gw->g.x+x+w-1, gw->g.y+y, gw->g.x+x+w-1, gw->g.y+y+GWIN_TABSET_TABHEIGHT-1, pcol->edge);
-		gdispGDrawStringBox(gw->g.display, gw->g.x+x+1, gw->g.y+y+1, w-2, GWIN_TABSET_TABHEIGHT-2, text, gw->g.font, pcol->text, justifyCenter);
+			gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x, gwinGetDrawY(&gw->g)+y+i, gwinGetDrawX(&gw->g)+x+w-2, gwinGetDrawY(&gw->g)+y+i, gdispBlendColor(bcol, tcol, NONFIXED(alpha)));
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x+w-1, gwinGetDrawY(&gw->g)+y, gwinGetDrawX(&gw->g)+x+w-1, gwinGetDrawY(&gw->g)+y+GWIN_TABSET_TABHEIGHT-1, pcol->edge);
+		gdispGDrawStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x+1, gwinGetDrawY(&gw->g)+y+1, w-2, GWIN_TABSET_TABHEIGHT-2, text, gw->g.font, pcol->text, justifyCenter);
 	}
 	static void ntarea(GWidgetObject *gw, coord_t y, coord_t x, coord_t w) {
 		const GColorSet *	pcol;
 
 		pcol = (gw->g.flags & GWIN_FLG_SYSENABLED) ? &gw->pstyle->pressed : &gw->pstyle->disabled;
 
-		gdispGFillArea(gw->g.display, gw->g.x+x, gw->g.y+y, w, GWIN_TABSET_TABHEIGHT-1, gw->g.bgcolor);
-		gdispGDrawLine(gw->g.display, gw->g.x+x, gw->g.y+y+GWIN_TABSET_TABHEIGHT-1, gw->g.x+x+w-1, gw->g.y+y+GWIN_TABSET_TABHEIGHT-1, pcol->edge);
+		gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x, gwinGetDrawY(&gw->g)+y, w, GWIN_TABSET_TABHEIGHT-1, gw->g.bgcolor);
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x, gwinGetDrawY(&gw->g)+y+GWIN_TABSET_TABHEIGHT-1, gwinGetDrawX(&gw->g)+x+w-1, gwinGetDrawY(&gw->g)+y+GWIN_TABSET_TABHEIGHT-1, pcol->edge);
 	}
 #endif
 
@@ -493,11 +493,11 @@ static void drawborder(GWidgetObject *gw, coord_t y) {
 		coord_t				x, w;
 
 		pcol = (gw->g.flags & GWIN_FLG_SYSENABLED) ? &gw->pstyle->enabled : &gw->pstyle->disabled;
-		x = gw->g.x+gw->g.width-1;
-		w = gw->g.y+gw->g.height-1;
-		gdispGDrawLine(gw->g.display, gw->g.x, gw->g.y+y, gw->g.x, w-1, pcol->edge);
-		gdispGDrawLine(gw->g.display, gw->g.x, w, x, w, pcol->edge);
-		gdispGDrawLine(gw->g.display, x, gw->g.y+y, x, w-1, pcol->edge);
+		x = gwinGetDrawX(&gw->g)+gw->g.width-1;
+		w = gwinGetDrawY(&gw->g)+gw->g.height-1;
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g)+y, gwinGetDrawX(&gw->g), w-1, pcol->edge);
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), w, x, w, pcol->edge);
+		gdispGDrawLine(gwinGetDrawDisplay(&gw->g), x, gwinGetDrawY(&gw->g)+y, x, w-1, pcol->edge);
 	}
 }
 
@@ -525,9 +525,9 @@ void gwinTabsetDraw_Std(GWidgetObject *gw, void *param) {
 
 	// Draw the client area
 	if ((gw->g.flags & GWIN_CONTAINER_BORDER))
-		gdispGFillArea(gw->g.display, gw->g.x+1, gw->g.y+y, gw->g.width-2, gw->g.height-y-1, gw->pstyle->background);
+		gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+1, gwinGetDrawY(&gw->g)+y, gw->g.width-2, gw->g.height-y-1, gw->pstyle->background);
 	else
-		gdispGFillArea(gw->g.display, gw->g.x, gw->g.y+y, gw->g.width, gw->g.height-y, gw->pstyle->background);
+		gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g)+y, gw->g.width, gw->g.height-y, gw->pstyle->background);
 }
 
 #if GDISP_NEED_IMAGE
@@ -543,22 +543,22 @@ void gwinTabsetDraw_Std(GWidgetObject *gw, void *param) {
 		drawborder(gw, y);
 
 		// Draw the client area by tiling the image
-		mx = gw->g.x+gw->g.width;
-		my = gw->g.y+gw->g.height;
+		mx = gwinGetDrawX(&gw->g)+gw->g.width;
+		my = gwinGetDrawY(&gw->g)+gw->g.height;
 		if ((gw->g.flags & GWIN_CONTAINER_BORDER)) {
 			mx -= 2;
 			my -= 1;
 		}
-		for(y = gw->g.y+y, ih = gi->height; y < my; y += ih) {
+		for(y = gwinGetDrawY(&gw->g)+y, ih = gi->height; y < my; y += ih) {
 			if (ih > my - y)
 				ih = my - y;
-			x = gw->g.x;
+			x = gwinGetDrawX(&gw->g);
 			if ((gw->g.flags & GWIN_CONTAINER_BORDER))
 				x++;
 			for(iw = gi->width; x < mx; x += iw) {
 				if (iw > mx - x)
 					iw = mx - x;
-				gdispGImageDraw(gw->g.display, gi, x, y, iw, ih, 0, 0);
+				gdispGImageDraw(gwinGetDrawDisplay(&gw->g), gi, x, y, iw, ih, 0, 0);
 			}
 		}
 
@@ -19,66 +19,452 @@
 
 // Some settings
 #define TEXT_PADDING_LEFT		4
+#define TEXT_PADDING_TOP		2		// Only used for multiline
 #define CURSOR_PADDING_LEFT		0
 #define CURSOR_EXTRA_HEIGHT		1
+#define TEXT_GROW_MIN			32		// The minimum amount the text buffer grows by
+#define LINES_GROW_MIN			16		// The minimum number of line starts the line cache grows by
 
 // Macros to assist in data type conversions
 #define gh2obj ((GTexteditObject *)gh)
 #define gw2obj ((GTexteditObject *)gw)
 
-static bool_t resizeText(GWidgetObject* gw, size_t pos, int32_t diff) {
-	char	*p, *q;
-	size_t	sz;
-
-	p = (char *)gw->text;
-	sz = strlen(p)+1;
-	if (diff < 0)
-		memcpy(p+pos, p+pos-diff, sz-pos+diff);
-	if (!(p = gfxRealloc(p, sz, sz+diff)))
-		return FALSE;
-	gw->text = p;
-	if (diff > 0) {
-		q = p + sz;
-		p += pos;
-		while(--q >= p)
-			q[diff] = q[0];
+// Macros to access the gap buffer and the line cache
+#define TextLen(gt)				((gt)->bufSize - 1 - ((gt)->gapEnd - (gt)->gapStart))
+#define TextAt(gt, pos)			((gt)->textBuffer[(pos) < (gt)->gapStart ? (pos) : (pos) + ((gt)->gapEnd - (gt)->gapStart)])
+#define LineStart(gt, ln)		((ln) ? (gt)->lines[(ln)-1] : 0)
+#define isMultiline(gt)			((gt)->w.g.flags & GTEXTEDIT_FLG_MULTILINE)
+#if GDISP_NEED_UTF8
+	#define isUTF8Cont(c)		(((uint8_t)(c) & 0xC0) == 0x80)
+#else
+	#define isUTF8Cont(c)		FALSE
+#endif
+
+static void TexteditDestroy(GHandle gh);
+static void TexteditRedraw(GHandle gh);
+
+// Move the gap to a text position
+static void moveGap(GTexteditObject *gt, size_t pos) {
+	size_t	n;
+
+	if (pos < gt->gapStart) {
+		n = gt->gapStart - pos;
+		memmove(gt->textBuffer + gt->gapEnd - n, gt->textBuffer + pos, n);
+		gt->gapStart -= n;
+		gt->gapEnd -= n;
+	} else if (pos > gt->gapStart) {
+		n = pos - gt->gapStart;
+		memmove(gt->textBuffer + gt->gapStart, gt->textBuffer + gt->gapEnd, n);
+		gt->gapStart += n;
+		gt->gapEnd += n;
+	}
+}
+
+// Move the gap to the end so the text is a normal string
+static void closeGap(GTexteditObject *gt) {
+	moveGap(gt, TextLen(gt));
+	gt->textBuffer[gt->gapStart] = 0;
+}
+
+// Which line a text position is on
+static unsigned lineOf(GTexteditObject *gt, size_t pos) {
+	unsigned	lo, hi, mid;
+
+	for(lo = 0, hi = gt->lineCnt; hi - lo > 1;) {
+		mid = (lo + hi) / 2;
+		if (gt->lines[mid-1] <= pos)
+			lo = mid;
+		else
+			hi = mid;
+	}
+	return lo;
+}
+
+// The text position of the end of a line (the position of its line break)
+static size_t lineEnd(GTexteditObject *gt, unsigned ln) {
+	return ln+1 < gt->lineCnt ? gt->lines[ln]-1 : TextLen(gt);
+}
+
+// Rebuild the line starts after line ln. Only needed when a line break is added or removed.
+static void relayout(GTexteditObject *gt, unsigned ln) {
+	size_t		pos, len;
+	size_t *	p;
+	unsigned	max;
+
+	if (!isMultiline(gt)) {
+		gt->lineCnt = 1;
+		return;
 	}
+	gt->lineCnt = ln+1;
+	len = TextLen(gt);
+	for(pos = LineStart(gt, ln); pos < len; pos++) {
+		if (TextAt(gt, pos) != '\n')
+			continue;
+		if (gt->lineCnt > gt->lineMax) {
+			// If we run out of memory the rest of the text just stays on the last line
+			max = gt->lineMax + gt->lineMax/2 + LINES_GROW_MIN;
+			if (!(p = gfxRealloc(gt->lines, gt->lineMax*sizeof(size_t), max*sizeof(size_t))))
+				break;
+			gt->lines = p;
+			gt->lineMax = max;
+		}
+		gt->lines[gt->lineCnt-1] = pos+1;
+		gt->lineCnt++;
+	}
+}
+
+// Move the start of the lines after line ln
+static void shiftLines(GTexteditObject *gt, unsigned ln, size_t n, bool_t forward) {
+	for(; ln+1 < gt->lineCnt; ln++) {
+		if (forward)
+			gt->lines[ln] += n;
+		else
+			gt->lines[ln] -= n;
+	}
+}
+
+static bool_t insertText(GTexteditObject *gt, size_t pos, const char *str, size_t n) {
+	char	*p;
+	size_t	sz, tail;
+
+	// Make the gap big enough. It grows by more than we need so typing doesn't realloc for every character.
+	if (gt->gapEnd - gt->gapStart < n) {
+		sz = gt->bufSize + n + gt->bufSize/2 + TEXT_GROW_MIN;
+		if (gt->maxSize && sz > gt->maxSize+1)
+			sz = gt->maxSize+1;
+		if (!(p = gfxRealloc(gt->textBuffer, gt->bufSize, sz)))
+			return FALSE;
+		tail = gt->bufSize - gt->gapEnd;
+		memmove(p + sz - tail, p + gt->gapEnd, tail);
+		gt->gapEnd = sz - tail;
+		gt->bufSize = sz;
+		gt->textBuffer = p;
+		gt->w.text = p;
+	}
+
+	moveGap(gt, pos);
+	memcpy(gt->textBuffer + gt->gapStart, str, n);
+	gt->gapStart += n;
+
+	if (memchr(str, '\n', n))
+		relayout(gt, lineOf(gt, pos));
+	else
+		shiftLines(gt, lineOf(gt, pos), n, TRUE);
 	return TRUE;
 }
 
-// Function that allows to set the cursor to any position in the string
-// This should be optimized. Currently it is an O(n^2) problem and therefore very
-// slow. An optimized version would copy the behavior of mf_get_string_width()
-// and do the comparation directly inside of that loop so we only iterate
-// the string once.
-static void TextEditMouseDown(GWidgetObject* gw, coord_t x, coord_t y) {
-	uint16_t i = 0;
+static void deleteText(GTexteditObject *gt, size_t pos, size_t n) {
+	bool_t	hasbreak;
 
-	(void)y;
+	moveGap(gt, pos);
+	hasbreak = memchr(gt->textBuffer + gt->gapEnd, '\n', n) != 0;
+	gt->gapEnd += n;
 
-	// Directly jump to the end of the string
-	if (x > gdispGetStringWidth(gw->text, gw->g.font)) {
-		gw2obj->cursorPos = strlen(gw->text);
+	if (hasbreak)
+		relayout(gt, lineOf(gt, pos));
+	else
+		shiftLines(gt, lineOf(gt, pos), n, FALSE);
+}
+
+// Take over the widget text as our gap buffer. Needed when the widget is created and when the text is set.
+static bool_t adoptText(GTexteditObject *gt) {
+	char	*p;
+	size_t	len, sz;
 
-	// Otherwise iterate through each character and get the size in pixels to compare
+	gt->textBuffer = 0;
+	if (!gt->w.text)
+		gt->w.text = "";
+	len = strlen(gt->w.text);
+	if (gt->maxSize && len > gt->maxSize)
+		len = gt->maxSize;
+	sz = (gt->maxSize ? gt->maxSize : len) + 1;
+
+	// Reallocate the text (if necessary)
+	if (!(gt->w.g.flags & GWIN_FLG_ALLOCTXT) || sz != len+1) {
+		if (!(p = gfxAlloc(sz)))
+			return FALSE;
+		memcpy(p, gt->w.text, len);
+		if ((gt->w.g.flags & GWIN_FLG_ALLOCTXT))
+			gfxFree((void *)gt->w.text);
+		gt->w.text = p;
+		gt->w.g.flags |= GWIN_FLG_ALLOCTXT;
+	}
+
+	// Start with the gap at the end and the cursor at the end of the text
+	gt->textBuffer = (char *)gt->w.text;
+	gt->textBuffer[len] = 0;
+	gt->textBuffer[sz-1] = 0;
+	gt->bufSize = sz;
+	gt->gapStart = len;
+	gt->gapEnd = sz-1;
+	gt->cursorPos = len;
+	gt->topLine = 0;
+	relayout(gt, 0);
+	return TRUE;
+}
+
+// Get the character at a text position, its width and the number of bytes it uses
+static unsigned getChar(GTexteditObject *gt, size_t pos, uint16_t *pc, coord_t *pw) {
+	char		tmp[5];
+	uint16_t	c;
+	unsigned	n, i;
+
+	c = (uint8_t)TextAt(gt, pos);
+	n = 1;
+	#if GDISP_NEED_UTF8
+		if (c >= 0xC0) {
+			size_t	len;
+			unsigned	need;
+
+			if (c < 0xE0) {
+				c &= 0x1F;
+				need = 1;
+			} else if (c < 0xF0) {
+				c &= 0x0F;
+				need = 2;
+			} else {
+				c &= 0x07;
+				need = 3;
+			}
+			for(len = TextLen(gt); n <= need && pos+n < len && isUTF8Cont(TextAt(gt, pos+n)); n++)
+				c = (c << 6) | ((uint8_t)TextAt(gt, pos+n) & 0x3F);
+		}
+	#endif
+	*pc = c;
+
+	// Printable ASCII characters are measured once for each font
+	if (c >= 0x20 && c < 0x80) {
+		if (gt->wfont != gt->w.g.font) {
+			gt->wfont = gt->w.g.font;
+			for(i = 0; i < sizeof(gt->widths); i++)
+				gt->widths[i] = gdispGetCharWidth((char)(i+0x20), gt->wfont);
+		}
+		*pw = gt->widths[c-0x20];
 	} else {
-		i = 1;
-		while (gdispGetStringWidthCount(gw->text, gw->g.font, i) < x) {
-			i++;
+		for(i = 0; i < n; i++)
+			tmp[i] = TextAt(gt, pos+i);
+		tmp[i] = 0;
+		*pw = gdispGetStringWidthCount(tmp, gt->w.g.font, 1);
+	}
+	return n;
+}
+
+static size_t prevPos(GTexteditObject *gt, size_t pos) {
+	do {
+		pos--;
+	} while (pos && isUTF8Cont(TextAt(gt, pos)));
+	return pos;
+}
+
+static size_t nextPos(GTexteditObject *gt, size_t pos) {
+	size_t	len;
+
+	len = TextLen(gt);
+	do {
+		pos++;
+	} while (pos < len && isUTF8Cont(TextAt(gt, pos)));
+	return pos;
+}
+
+// The width of the text from the start of its line to a text position
+static coord_t posX(GTexteditObject *gt, size_t pos) {
+	size_t		p;
+	coord_t		x, w;
+	uint16_t	c;
+
+	for(p = LineStart(gt, lineOf(gt, pos)), x = 0; p < pos; x += w)
+		p += getChar(gt, p, &c, &w);
+	return x;
+}
+
+// The text position in a line that is closest to a horizontal pixel position
+static size_t xPos(GTexteditObject *gt, unsigned ln, coord_t x) {
+	size_t		p, end;
+	coord_t		cx, w;
+	uint16_t	c;
+	unsigned	n;
+
+	for(p = LineStart(gt, ln), end = lineEnd(gt, ln), cx = 0; p < end; p += n, cx += w) {
+		n = getChar(gt, p, &c, &w);
+		if (cx + w/2 >= x)
+			break;
+	}
+	return p;
+}
+
+// The number of rows that can be seen completely
+static unsigned visibleRows(GWidgetObject *gw) {
+	coord_t	rows;
+
+	rows = (gw->g.height - 2*TEXT_PADDING_TOP) / gdispGetFontMetric(gw->g.font, fontHeight);
+	return rows > 0 ? rows : 1;
+}
+
+// The number of rows that need drawing (including any partly visible row at the bottom)
+static unsigned drawnRows(GWidgetObject *gw) {
+	coord_t	fh;
+
+	fh = gdispGetFontMetric(gw->g.font, fontHeight);
+	return (gw->g.height - TEXT_PADDING_TOP + fh - 1) / fh;
+}
+
+// Scroll the view so the cursor can be seen. Returns TRUE if the view has changed.
+static bool_t scrollToCursor(GWidgetObject *gw) {
+	coord_t		avail, cx;
+	unsigned	ln, top, rows;
+	bool_t		changed;
+
+	avail = gw->g.width - (TEXT_PADDING_LEFT+CURSOR_PADDING_LEFT);
+	cx = posX(gw2obj, gw2obj->cursorPos);
+	cx = cx >= avail ? cx - avail + 1 : 0;
+	changed = cx != gw2obj->xoff;
+	gw2obj->xoff = cx;
+
+	if (isMultiline(gw2obj)) {
+		ln = lineOf(gw2obj, gw2obj->cursorPos);
+		rows = visibleRows(gw);
+		top = gw2obj->topLine;
+		if (ln < top)
+			top = ln;
+		else if (ln >= top + rows)
+			top = ln - rows + 1;
+		if (top != gw2obj->topLine) {
+			gw2obj->topLine = top;
+			changed = TRUE;
 		}
+	}
+	return changed;
+}
 
-		gw2obj->cursorPos = i-1;
+// Draw one row of text. A single line textedit only has one row which is the height of the widget.
+static void drawRow(GWidgetObject *gw, const GColorSet *pcol, unsigned row) {
+	coord_t		y, cy, ty, x, w, fh;
+	size_t		pos, end;
+	unsigned	ln, n;
+	uint16_t	c;
+
+	fh = gdispGetFontMetric(gw->g.font, fontHeight);
+	if (isMultiline(gw2obj)) {
+		y = TEXT_PADDING_TOP + row*fh;
+		if (y >= gw->g.height)
+			return;
+		cy = y + fh > gw->g.height ? gw->g.height - y : fh;
+		ty = y;
+		ln = gw2obj->topLine + row;
+	} else {
+		y = 0;
+		cy = gw->g.height;
+		ty = (gw->g.height+1-fh)/2;
+		ln = 0;
 	}
 
-	_gwinUpdate((GHandle)gw);
+	// The background
+	gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g)+y, gw->g.width, cy, pcol->fill);
+	if (ln >= gw2obj->lineCnt)
+		return;
+
+	// The characters that can be seen
+	#if GDISP_NEED_CLIP
+		gdispGSetClip(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+TEXT_PADDING_LEFT, gwinGetDrawY(&gw->g)+y, gw->g.width-TEXT_PADDING_LEFT, cy);
+	#endif
+	x = TEXT_PADDING_LEFT - gdispGetFontMetric(gw->g.font, fontBaselineX) - gw2obj->xoff;
+	for(pos = LineStart(gw2obj, ln), end = lineEnd(gw2obj, ln); pos < end && x < gw->g.width; pos += n, x += w) {
+		n = getChar(gw2obj, pos, &c, &w);
+		if (x + w > 0)
+			gdispGDrawChar(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g)+x, gwinGetDrawY(&gw->g)+ty, c, gw->g.font, pcol->text);
+	}
+
+	// The cursor (if focused)
+	if (gwinGetFocus() == (GHandle)gw && lineOf(gw2obj, gw2obj->cursorPos) == ln) {
+		x = gwinGetDrawX(&gw->g) + posX(gw2obj, gw2obj->cursorPos) - gw2obj->xoff + CURSOR_PADDING_LEFT + TEXT_PADDING_LEFT + gdispGetFontMetric(gw->g.font, fontBaselineX)/2;
+		if (isMultiline(gw2obj))
+			gdispGDrawLine(gwinGetDrawDisplay(&gw->g), x, gwinGetDrawY(&gw->g) + ty, x, gwinGetDrawY(&gw->g) + ty + fh - 1, pcol->edge);
+		else {
+			cy = (gw->g.height - fh)/2 - CURSOR_EXTRA_HEIGHT;
+			gdispGDrawLine(gwinGetDrawDisplay(&gw->g), x, gwinGetDrawY(&gw->g) + cy, x, gwinGetDrawY(&gw->g) + gw->g.height - cy, pcol->edge);
+		}
+	}
+
+	#if GDISP_NEED_CLIP
+		gdispGSetClip(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw->g.width, gw->g.height);
+	#endif
+}
+
+static void drawFrame(GWidgetObject *gw, const GColorSet *pcol) {
+	// Render border
+	gdispGDrawBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw->g.width, gw->g.height, pcol->edge);
+
+	// Render highlighted border if focused
+	_gwidgetDrawFocusRect(gw, 0, 0, gw->g.width, gw->g.height);
+}
+
+// Redraw the lines from first to last after an edit or a cursor movement.
+// Nothing else is re-measured or redrawn unless the view has to scroll.
+static void redrawLines(GWidgetObject *gw, unsigned first, unsigned last) {
+	const GColorSet*	pcol;
+	unsigned			ln, rows;
+
+	if (scrollToCursor(gw) || gw->fnDraw != gwinTexteditDefaultDraw) {
+		_gwinUpdate(&gw->g);
+		return;
+	}
+	if (!_gwinDrawStart(&gw->g))
+		return;
+
+	pcol = (gw->g.flags & GWIN_FLG_SYSENABLED) ? &gw->pstyle->enabled : &gw->pstyle->disabled;
+	if (!isMultiline(gw2obj))
+		drawRow(gw, pcol, 0);
+	else {
+		rows = drawnRows(gw);
+		if (first < gw2obj->topLine)
+			first = gw2obj->topLine;
+		for(ln = first; ln <= last && ln - gw2obj->topLine < rows; ln++)
+			drawRow(gw, pcol, ln - gw2obj->topLine);
+	}
+	drawFrame(gw, pcol);
+
+	_gwinDrawEnd(&gw->g);
+}
+
+static void TextEditMouseDown(GWidgetObject* gw, coord_t x, coord_t y) {
+	unsigned	ln, oldln;
+
+	if (!gw2obj->textBuffer)
+		return;
+
+	// Find the line and then the character
+	oldln = lineOf(gw2obj, gw2obj->cursorPos);
+	ln = 0;
+	if (isMultiline(gw2obj)) {
+		if (y > TEXT_PADDING_TOP)
+			ln = gw2obj->topLine + (y - TEXT_PADDING_TOP) / gdispGetFontMetric(gw->g.font, fontHeight);
+		if (ln >= gw2obj->lineCnt)
+			ln = gw2obj->lineCnt-1;
+	}
+	gw2obj->cursorPos = xPos(gw2obj, ln, x - (TEXT_PADDING_LEFT+CURSOR_PADDING_LEFT) + gw2obj->xoff);
+
+	if (ln < oldln)
+		redrawLines(gw, ln, oldln);
+	else
+		redrawLines(gw, oldln, ln);
 }
 
 #if (GFX_USE_GINPUT && GINPUT_NEED_KEYBOARD) || GWIN_NEED_KEYBOARD
 	static void TextEditKeyboard(GWidgetObject* gw, GEventKeyboard* pke) {
+		size_t		pos;
+		unsigned	ln, oldln, oldcnt;
+
 		// Only react on KEYDOWN events. Ignore KEYUP events.
 		if ((pke->keystate & GKEYSTATE_KEYUP) || !pke->bytecount)
 			return;
 
+		// We can't do anything if we ran out of memory for the text
+		if (!gw2obj->textBuffer)
+			return;
+
+		oldln = lineOf(gw2obj, gw2obj->cursorPos);
+		oldcnt = gw2obj->lineCnt;
+
 		// Is it a special key?
 		if (pke->keystate & GKEYSTATE_SPECIAL) {
 
@@ -87,22 +473,32 @@ static void TextEditMouseDown(GWidgetObject* gw, coord_t x, coord_t y) {
 			case GKEY_LEFT:
 				if (!gw2obj->cursorPos)
 					return;
-				gw2obj->cursorPos--;
+				gw2obj->cursorPos = prevPos(gw2obj, gw2obj->cursorPos);
 				break;
 			case GKEY_RIGHT:
-				if (!gw->text[gw2obj->cursorPos])
+				if (gw2obj->cursorPos >= TextLen(gw2obj))
 					return;
-				gw2obj->cursorPos++;
+				gw2obj->cursorPos = nextPos(gw2obj, gw2obj->cursorPos);
 				break;
 			case GKEY_HOME:
-				if (!gw2obj->cursorPos)
+				if (gw2obj->cursorPos == LineStart(gw2obj, oldln))
 					return;
-				gw2obj->cursorPos = 0;
+				gw2obj->cursorPos = LineStart(gw2obj, oldln);
 				break;
 			case GKEY_END:
-				if (!gw->text[gw2obj->cursorPos])
+				if (gw2obj->cursorPos == lineEnd(gw2obj, oldln))
 					return;
-				gw2obj->cursorPos = strlen(gw->text);
+				gw2obj->cursorPos = lineEnd(gw2obj, oldln);
+				break;
+			case GKEY_UP:
+				if (!oldln)
+					return;
+				gw2obj->cursorPos = xPos(gw2obj, oldln-1, posX(gw2obj, gw2obj->cursorPos));
+				break;
+			case GKEY_DOWN:
+				if (oldln+1 >= gw2obj->lineCnt)
+					return;
+				gw2obj->cursorPos = xPos(gw2obj, oldln+1, posX(gw2obj, gw2obj->cursorPos));
 				break;
 			default:
 				return;
@@ -116,20 +512,31 @@ static void TextEditMouseDown(GWidgetObject* gw, coord_t x, coord_t y) {
 				// Backspace
 				if (!gw2obj->cursorPos)
 					return;
-				gw2obj->cursorPos--;
-				resizeText(gw, gw2obj->cursorPos, -1);
+				pos = prevPos(gw2obj, gw2obj->cursorPos);
+				deleteText(gw2obj, pos, gw2obj->cursorPos - pos);
+				gw2obj->cursorPos = pos;
 				break;
-			case GKEY_TAB:
 			case GKEY_LF:
 			case GKEY_CR:
+				// A multiline textedit starts a new line
+				if (isMultiline(gw2obj)) {
+					if (gw2obj->maxSize && TextLen(gw2obj) >= gw2obj->maxSize)
+						return;
+					if (!insertText(gw2obj, gw2obj->cursorPos, "\n", 1))
+						return;
+					gw2obj->cursorPos++;
+					break;
+				}
+				// Fall through
+			case GKEY_TAB:
 				// Move to the next field
 				_gwinMoveFocus();
 				return;
 			case GKEY_DEL:
 				// Delete
-				if (!gw->text[gw2obj->cursorPos])
+				if (gw2obj->cursorPos >= TextLen(gw2obj))
 					return;
-				resizeText(gw, gw2obj->cursorPos, -1);
+				deleteText(gw2obj, gw2obj->cursorPos, nextPos(gw2obj, gw2obj->cursorPos) - gw2obj->cursorPos);
 				break;
 			default:
 				// Ignore any other control characters
@@ -137,20 +544,25 @@ static void TextEditMouseDown(GWidgetObject* gw, coord_t x, coord_t y) {
 					return;
 
 				// Keep the edit length to less than the maximum
-				if (gw2obj->maxSize && gw2obj->cursorPos+pke->bytecount > gw2obj->maxSize)
+				if (gw2obj->maxSize && TextLen(gw2obj)+pke->bytecount > gw2obj->maxSize)
 					return;
 
-				// Make space
-				resizeText(gw, gw2obj->cursorPos, pke->bytecount);
-
 				// Insert the character
-				memcpy((char *)gw->text+gw2obj->cursorPos, pke->c, pke->bytecount);
+				if (!insertText(gw2obj, gw2obj->cursorPos, pke->c, pke->bytecount))
+					return;
 				gw2obj->cursorPos += pke->bytecount;
 				break;
 			}
 		}
 
-		_gwinUpdate((GHandle)gw);
+		// Redraw from the changed line. If lines have been added or removed everything below it moves too.
+		ln = lineOf(gw2obj, gw2obj->cursorPos);
+		if (ln < oldln) {
+			pos = ln;
+			ln = oldln;
+			oldln = pos;
+		}
+		redrawLines(gw, oldln, gw2obj->lineCnt != oldcnt ? (unsigned)-1 : ln);
 	}
 #endif
 
@@ -158,8 +570,8 @@ static const gwidgetVMT texteditVMT = {
 	{
 		"TextEdit",					// The class name
 		sizeof(GTexteditObject),	// The object size
-		_gwidgetDestroy,			// The destroy routine
-		_gwidgetRedraw, 			// The redraw routine
+		TexteditDestroy,			// The destroy routine
+		TexteditRedraw, 			// The redraw routine
 		0,							// The after-clear routine
 	},
 	gwinTexteditDefaultDraw,		// default drawing routine
@@ -194,38 +606,71 @@ static const gwidgetVMT texteditVMT = {
 	#endif
 };
 
+static void TexteditDestroy(GHandle gh) {
+	if (gh2obj->lines)
+		gfxFree(gh2obj->lines);
+	_gwidgetDestroy(gh);
+}
+
+static void TexteditRedraw(GHandle gh) {
+	// A custom draw routine expects the text to be a normal string
+	if (gh2obj->w.fnDraw != gwinTexteditDefaultDraw)
+		_gwinTexteditCloseGap(gh);
+	_gwidgetRedraw(gh);
+}
+
+void _gwinTexteditCloseGap(GHandle gh) {
+	if (gh->vmt != (gwinVMT*)&texteditVMT || !gh2obj->textBuffer || gh2obj->w.text != gh2obj->textBuffer)
+		return;
+	closeGap(gh2obj);
+}
+
+void _gwinTexteditNewText(GHandle gh) {
+	if (gh->vmt != (gwinVMT*)&texteditVMT)
+		return;
+	adoptText(gh2obj);
+}
+
 GHandle gwinGTexteditCreate(GDisplay* g, GTexteditObject* wt, GWidgetInit* pInit, size_t maxSize)
 {
-	char	*p;
-
 	// Create the underlying widget
 	if (!(wt = (GTexteditObject*)_gwidgetCreate(g, &wt->w, pInit, &texteditVMT)))
 		return 0;
 
 	wt->maxSize = maxSize;
-
-	// Reallocate the text (if necessary)
-	if (!(wt->w.g.flags & GWIN_FLG_ALLOCTXT)) {
-		if (!(p = gfxAlloc(wt->maxSize+1)))
-			return 0;
-		strncpy(p, wt->w.text, wt->maxSize);
-		wt->w.text = p;
-		wt->w.g.flags |= GWIN_FLG_ALLOCTXT;
-	}
-
-	// Set text and cursor position
-	wt->cursorPos = strlen(wt->w.text);
+	wt->lines = 0;
+	wt->lineCnt = 1;
+	wt->lineMax = 0;
+	wt->xoff = 0;
+	wt->wfont = 0;
+
+	// Set up the gap buffer and the cursor position
+	if (!adoptText(wt))
+		return 0;
 
 	gwinSetVisible(&wt->w.g, pInit->g.show);
 
 	return (GHandle)wt;
 }
 
+void gwinTexteditSetMultiline(GHandle gh, bool_t multiline) {
+	if (gh->vmt != (gwinVMT*)&texteditVMT)
+		return;
+
+	if (multiline)
+		gh->flags |= GTEXTEDIT_FLG_MULTILINE;
+	else
+		gh->flags &= ~GTEXTEDIT_FLG_MULTILINE;
+	gh2obj->topLine = 0;
+	if (gh2obj->textBuffer)
+		relayout(gh2obj, 0);
+	_gwinUpdate(gh);
+}
+
 void gwinTexteditDefaultDraw(GWidgetObject* gw, void* param)
 {
-	const char*			p;
-	coord_t				cpos, tpos;
 	const GColorSet*	pcol;
+	unsigned			row, rows;
 
 	(void)param;
 
@@ -239,40 +684,25 @@ void gwinTexteditDefaultDraw(GWidgetObject* gw, void* param)
 	else
 		pcol = &gw->pstyle->disabled;
 
-	// Adjust the text position so the cursor fits in the window
-	p = gw->text;
-	if (!gw2obj->cursorPos)
-		tpos = 0;
-	else {
-		for(cpos = gw2obj->cursorPos; ; p++, cpos--) {
-			tpos = gdispGetStringWidthCount(p, gw->g.font, cpos);
-			if (tpos < gw->g.width-(TEXT_PADDING_LEFT+CURSOR_PADDING_LEFT))
-				break;
-		}
-	}
-
-	// Render background and string
-	#if TEXT_PADDING_LEFT
-		gdispGFillArea(gw->g.display, gw->g.x, gw->g.y, TEXT_PADDING_LEFT, gw->g.height, pcol->fill);
-	#endif
-	gdispGFillStringBox(gw->g.display, gw->g.x + TEXT_PADDING_LEFT, gw->g.y, gw->g.width-TEXT_PADDING_LEFT, gw->g.height, p, gw->g.font, pcol->text, pcol->fill, justifyLeft);
-
-	// Render cursor (if focused)
-	if (gwinGetFocus() == (GHandle)gw) {
-		// Calculate cursor stuff
-
-		// Draw cursor
-		tpos += gw->g.x + CURSOR_PADDING_LEFT + TEXT_PADDING_LEFT + gdispGetFontMetric(gw->g.font, fontBaselineX)/2;
-		cpos = (gw->g.height - gdispGetFontMetric(gw->g.font, fontHeight))/2 - CURSOR_EXTRA_HEIGHT;
-		gdispGDrawLine(gw->g.display, tpos, gw->g.y + cpos, tpos, gw->g.y + gw->g.height - cpos, pcol->edge);
+	// Without a text buffer we can only show the text
+	if (!gw2obj->textBuffer) {
+		gdispGFillStringBox(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw->g.width, gw->g.height, gw->text, gw->g.font, pcol->text, pcol->fill, justifyLeft);
+		drawFrame(gw, pcol);
+		return;
 	}
 
-	// Render border
-	gdispGDrawBox(gw->g.display, gw->g.x, gw->g.y, gw->g.width, gw->g.height, pcol->edge);
+	// Adjust the text position so the cursor fits in the window
+	scrollToCursor(gw);
 
-	// Render highlighted border if focused
-	_gwidgetDrawFocusRect(gw, 0, 0, gw->g.width, gw->g.height);
+	// Render background and text
+	if (isMultiline(gw2obj)) {
+		gdispGFillArea(gwinGetDrawDisplay(&gw->g), gwinGetDrawX(&gw->g), gwinGetDrawY(&gw->g), gw->g.width, TEXT_PADDING_TOP, pcol->fill);
+		for(row = 0, rows = drawnRows(gw); row < rows; row++)
+			drawRow(gw, pcol, row);
+	} else
+		drawRow(gw, pcol, 0);
 
+	drawFrame(gw, pcol);
 }
 
 #undef gh2obj
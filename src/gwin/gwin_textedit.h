@@ -31,13 +31,35 @@
 
 // This file is included within "src/gwin/gwin_widget.h"
 
+/**
+ * @brief	The internal textedit object flags
+ * @note	Used only for writing a custom draw routine.
+ * @{
+ */
+#define GTEXTEDIT_FLG_MULTILINE		0x01
+/** @} */
+
 // A TextEdit widget
 typedef struct GTexteditObject {
 	GWidgetObject	w;
 
-	char*			textBuffer;
+	char*			textBuffer;		// The gap buffer. Normally the same as w.text
 	size_t			maxSize;
-	uint16_t		cursorPos;
+	size_t			cursorPos;
+
+	// The gap buffer - [text before the gap] [gap] [text after the gap] [nul]
+	size_t			bufSize;		// The allocated size of textBuffer
+	size_t			gapStart;		// The position of the gap in textBuffer
+	size_t			gapEnd;			// The position of the text after the gap in textBuffer
+
+	// The layout cache
+	size_t *		lines;			// The text position of the start of each line after the first
+	unsigned		lineCnt;		// The number of lines
+	unsigned		lineMax;		// The room in lines
+	unsigned		topLine;		// The first line shown (multiline only)
+	coord_t			xoff;			// How far the text is scrolled to the left (in pixels)
+	font_t			wfont;			// The font that the widths were measured with
+	uint8_t			widths[96];		// The width of each printable ASCII character
 } GTexteditObject;
 
 #ifdef __cplusplus
@@ -63,6 +85,20 @@ extern "C" {
 GHandle gwinGTexteditCreate(GDisplay* g, GTexteditObject* wt, GWidgetInit* pInit, size_t maxSize);
 #define gwinTexteditCreate(wt, pInit, maxSize)			gwinGTexteditCreate(GDISP, wt, pInit, maxSize)
 
+/**
+ * @brief				Allow the TextEdit widget to hold more than one line of text
+ * @details				A multiline TextEdit inserts a new line when the enter key is pressed and the
+ *						up and down keys move between the lines. It scrolls vertically to keep the cursor visible.
+ *
+ * @param[in] gh		The widget handle (must be a TextEdit widget)
+ * @param[in] multiline	TRUE for multiline editing, FALSE for a single line field (the default)
+ *
+ * @note				The text is held in a gap buffer so editing is fast anywhere in a large document.
+ *						@p gwinGetText() closes the gap so the text can be read as a normal string.
+ * @api
+ */
+void gwinTexteditSetMultiline(GHandle gh, bool_t multiline);
+
 /**
  * @defgroup Renderings_Textedit Renderings
  *
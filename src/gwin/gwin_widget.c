@@ -26,6 +26,16 @@ static GListener gl;
 	static GHandle				_widgetInFocus;
 #endif
 
+#if GFX_USE_GINPUT && GINPUT_NEED_MOUSE && GWIN_NEED_SPATIAL_INDEX
+	// The widget that has captured the mouse (so we don't have to search for it)
+	static GHandle				_widgetMouseCapture;
+#endif
+
+#if GWIN_WIDGET_CACHE
+	// The number of bytes of pixels used by all the widget caches
+	static size_t				_widgetCacheUsed;
+#endif
+
 // Our default style - a white background theme
 const GWidgetStyle WhiteWidgetStyle = {
 	HTML2COLOR(0xFFFFFF),			// window background
@@ -112,6 +122,25 @@ static void gwidgetEvent(void *param, GEvent *pe) {
 	#if GFX_USE_GINPUT && GINPUT_NEED_MOUSE
 	case GEVENT_MOUSE:
 	case GEVENT_TOUCH:
+		#if GWIN_NEED_SPATIAL_INDEX
+			// Is the mouse currently captured by a widget?
+			if ((h = _widgetMouseCapture) && h->display == pme->display && (h->flags & GWIN_FLG_SYSVISIBLE)) {
+				gh = h;
+				if ((pme->buttons & GMETA_MOUSE_UP)) {
+					gh->flags &= ~GWIN_FLG_MOUSECAPTURE;
+					_widgetMouseCapture = 0;
+					if (wvmt->MouseUp)
+						wvmt->MouseUp(gw, pme->x - gh->x, pme->y - gh->y);
+				} else if (wvmt->MouseMove)
+					wvmt->MouseMove(gw, pme->x - gh->x, pme->y - gh->y);
+
+				// There is only ever one captured mouse. Prevent normal mouse processing if there is a captured mouse
+				break;
+			}
+
+			// Get the highest z-order window that the mouse is over
+			gh = gwinFindWindowAt(pme->display, pme->x, pme->y);
+		#else
 		// Cycle through all windows
 		for (gh = 0, h = gwinGetNextWindow(0); h; h = gwinGetNextWindow(h)) {
 
@@ -139,11 +168,15 @@ static void gwidgetEvent(void *param, GEvent *pe) {
 			if (pme->x >= h->x && pme->x < h->x + h->width && pme->y >= h->y && pme->y < h->y + h->height)
 				gh = h;
 		}
+		#endif
 
 		// Process any mouse down over the highest order window if it is an enabled widget
 		if (gh && (gh->flags & (GWIN_FLG_WIDGET|GWIN_FLG_SYSENABLED)) == (GWIN_FLG_WIDGET|GWIN_FLG_SYSENABLED)) {
 			if ((pme->buttons & GMETA_MOUSE_DOWN)) {
 				gh->flags |= GWIN_FLG_MOUSECAPTURE;
+				#if GWIN_NEED_SPATIAL_INDEX
+					_widgetMouseCapture = gh;
+				#endif
 
 				#if (GFX_USE_GINPUT && GINPUT_NEED_KEYBOARD) || GWIN_NEED_KEYBOARD
 					// We should try and capture the focus on this window.
@@ -301,6 +334,7 @@ static void gwidgetEvent(void *param, GEvent *pe) {
 
 				// This new window still needs to be marked for redraw (but don't actually do it yet).
 				gh->flags |= GWIN_FLG_NEEDREDRAW;
+				gh->dirtycx = 0;
 				// RedrawPending |= DOREDRAW_VISIBLES;			- FIX LATER
 				return;
 			}
@@ -319,7 +353,7 @@ static void gwidgetEvent(void *param, GEvent *pe) {
 
 		// Use the very simplest possible focus rectangle for now
 		for (i = 0; i < GWIN_FOCUS_HIGHLIGHT_WIDTH; i++) {
-			gdispGDrawBox(gx->g.display, gx->g.x+x+i, gx->g.y+y+i, cx-2*i, cy-2*i, gx->pstyle->focus);
+			gdispGDrawBox(gwinGetDrawDisplay(&gx->g), gwinGetDrawX(&gx->g)+x+i, gwinGetDrawY(&gx->g)+y+i, cx-2*i, cy-2*i, gx->pstyle->focus);
 		}
 	}
 
@@ -378,6 +412,76 @@ void _gwidgetDeinit(void)
 	/* ToDo */
 }
 
+#if GWIN_WIDGET_CACHE
+	#define CacheBytes(w, h)	((size_t)(w) * (size_t)(h) * sizeof(pixel_t))
+
+	static void CacheFree(GWidgetObject *pgw) {
+		if (!pgw->cache)
+			return;
+		_widgetCacheUsed -= CacheBytes(gdispGGetWidth(pgw->cache), gdispGGetHeight(pgw->cache));
+		gdispPixmapDelete(pgw->cache);
+		pgw->cache = 0;
+		pgw->cacheok = FALSE;
+	}
+
+	// Draw the widget into its off-screen copy. Must be called within the redraw session.
+	static bool_t CacheRender(GWidgetObject *pgw) {
+		GHandle		gx;
+		GDisplay *	g;
+		coord_t		dx, dy;
+		size_t		sz;
+
+		// Throw away a copy of the wrong size
+		if (pgw->cache && (gdispGGetWidth(pgw->cache) != pgw->g.width || gdispGGetHeight(pgw->cache) != pgw->g.height))
+			CacheFree(pgw);
+
+		if (!pgw->cache) {
+			// Make room by throwing away the copies of invisible widgets
+			sz = CacheBytes(pgw->g.width, pgw->g.height);
+			for(gx = gwinGetNextWindow(0); gx && _widgetCacheUsed + sz > GWIN_WIDGET_CACHE_BUDGET; gx = gwinGetNextWindow(gx)) {
+				if ((gx->flags & (GWIN_FLG_WIDGET|GWIN_FLG_SYSVISIBLE)) == GWIN_FLG_WIDGET)
+					CacheFree((GWidgetObject *)gx);
+			}
+			if (_widgetCacheUsed + sz > GWIN_WIDGET_CACHE_BUDGET || !(pgw->cache = gdispPixmapCreate(pgw->g.width, pgw->g.height)))
+				return FALSE;
+			_widgetCacheUsed += sz;
+		}
+
+		// Mark it up to date first so a change while we are drawing is not lost
+		pgw->cacheok = TRUE;
+
+		// Draw the widget at the origin of the pixmap. The window itself doesn't move.
+		g = pgw->g.drawdisplay;
+		dx = pgw->g.drawdx;
+		dy = pgw->g.drawdy;
+		pgw->g.drawdisplay = pgw->cache;
+		pgw->g.drawdx = pgw->g.x;
+		pgw->g.drawdy = pgw->g.y;
+		pgw->fnDraw(pgw, pgw->fnParam);
+		pgw->g.drawdisplay = g;
+		pgw->g.drawdx = dx;
+		pgw->g.drawdy = dy;
+		return TRUE;
+	}
+
+	void _gwinCacheInvalidate(GHandle gh) {
+		if ((gh->flags & GWIN_FLG_WIDGET))
+			gw->cacheok = FALSE;
+	}
+
+	void gwinSetCached(GHandle gh, bool_t cached) {
+		if (!(gh->flags & GWIN_FLG_WIDGET))
+			return;
+
+		// Any copy is thrown away on the next redraw
+		if (cached)
+			gh->flags |= GWIN_FLG_CACHED;
+		else
+			gh->flags &= ~GWIN_FLG_CACHED;
+		gw->cacheok = FALSE;
+	}
+#endif
+
 GHandle _gwidgetCreate(GDisplay *g, GWidgetObject *pgw, const GWidgetInit *pInit, const gwidgetVMT *vmt) {
 	if (!(pgw = (GWidgetObject *)_gwindowCreate(g, &pgw->g, &pInit->g, &vmt->g, GWIN_FLG_WIDGET|GWIN_FLG_ENABLED|GWIN_FLG_SYSENABLED)))
 		return 0;
@@ -394,6 +498,10 @@ GHandle _gwidgetCreate(GDisplay *g, GWidgetObject *pgw, const GWidgetInit *pInit
 	#if GWIN_WIDGET_TAGS
 			pgw->tag = pInit->tag;
 	#endif
+	#if GWIN_WIDGET_CACHE
+		pgw->cache = 0;
+		pgw->cacheok = FALSE;
+	#endif
 
 	return 	&pgw->g;
 }
@@ -407,6 +515,12 @@ void _gwidgetDestroy(GHandle gh) {
 	gh->flags &= ~GWIN_FLG_VISIBLE;
 	_gwinFixFocus(gh);
 
+	#if GFX_USE_GINPUT && GINPUT_NEED_MOUSE && GWIN_NEED_SPATIAL_INDEX
+		// It can't have the mouse anymore
+		if (_widgetMouseCapture == gh)
+			_widgetMouseCapture = 0;
+	#endif
+
 	// Deallocate the text (if necessary)
 	if ((gh->flags & GWIN_FLG_ALLOCTXT)) {
 		gh->flags &= ~GWIN_FLG_ALLOCTXT;
@@ -439,12 +553,33 @@ void _gwidgetDestroy(GHandle gh) {
 
 	// Remove any listeners on this object.
 	geventDetachSourceListeners((GSourceHandle)gh);
+
+	#if GWIN_WIDGET_CACHE
+		// Throw away any off-screen copy
+		gh->flags &= ~GWIN_FLG_CACHED;
+		CacheFree(gw);
+	#endif
 }
 
 void _gwidgetRedraw(GHandle gh) {
 	if (!(gh->flags & GWIN_FLG_SYSVISIBLE))
 		return;
 
+	#if GWIN_WIDGET_CACHE
+		if ((gh->flags & GWIN_FLG_CACHED)) {
+			// A resize makes the copy stale
+			if (gw->cacheok && (gdispGGetWidth(gw->cache) != gh->width || gdispGGetHeight(gw->cache) != gh->height))
+				gw->cacheok = FALSE;
+
+			// Just copy the off-screen copy if we can
+			if (gw->cacheok || CacheRender(gw)) {
+				gdispGBlitArea(gwinGetDrawDisplay(gh), gwinGetDrawX(gh), gwinGetDrawY(gh), gh->width, gh->height, 0, 0, gh->width, gdispPixmapGetBits(gw->cache));
+				return;
+			}
+		} else if (gw->cache)
+			CacheFree(gw);
+	#endif
+
 	gw->fnDraw(gw, gw->fnParam);
 }
 
@@ -527,6 +662,9 @@ void gwinSetText(GHandle gh, const char *text, bool_t useAlloc) {
 		gw->text = (const char *)str;
 	} else
 		gw->text = text;
+	#if GWIN_NEED_TEXTEDIT
+		_gwinTexteditNewText(gh);
+	#endif
 	_gwinUpdate(gh);
 }
 
@@ -564,6 +702,9 @@ void gwinSetText(GHandle gh, const char *text, bool_t useAlloc) {
 		
 		va_end (va);
 
+		#if GWIN_NEED_TEXTEDIT
+			_gwinTexteditNewText(gh);
+		#endif
 		_gwinUpdate(gh);
 	}
 #endif
@@ -572,6 +713,11 @@ const char *gwinGetText(GHandle gh) {
 	if (!(gh->flags & GWIN_FLG_WIDGET))
 		return 0;
 
+	#if GWIN_NEED_TEXTEDIT
+		// A textedit keeps a gap in its text where it was last edited
+		_gwinTexteditCloseGap(gh);
+	#endif
+
 	return gw->text;
 }
 
@@ -124,6 +124,10 @@ typedef struct GWidgetObject {
 	#if GWIN_WIDGET_TAGS || defined(__DOXYGEN__)
 		WidgetTag				tag;				/**< The widget tag */
 	#endif
+	#if GWIN_WIDGET_CACHE || defined(__DOXYGEN__)
+		GDisplay *				cache;				/**< The off-screen copy of the widget (if any) */
+		bool_t					cacheok;			/**< The off-screen copy is up to date */
+	#endif
 } GWidgetObject;
 /** @} */
 
@@ -288,6 +292,30 @@ bool_t gwinIsWidget(GHandle gh);
 	WidgetTag gwinGetTag(GHandle gh);
 #endif
 
+#if GWIN_WIDGET_CACHE || defined(__DOXYGEN__)
+	/**
+	 * @brief   Draw a widget from an off-screen copy.
+	 *
+	 * @param[in] gh		The widget handle
+	 * @param[in] cached	If TRUE the widget is drawn once into a pixmap and the pixmap is copied
+	 * 						to the display whenever the widget needs redrawing but has not changed.
+	 *
+	 * @note				This suits widgets that are expensive to draw but rarely change eg. frames,
+	 * 						labels, tabsets and keyboards. The copy is redrawn automatically when the
+	 * 						text, style, state or size of the widget changes.
+	 * @note				The widget must draw every pixel of its area. Nothing underneath the widget
+	 * 						shows through the copy.
+	 * @note				All the copies together are limited to @p GWIN_WIDGET_CACHE_BUDGET bytes of pixels.
+	 * 						If a copy would not fit the widget is drawn normally.
+	 * @note				Non-widgets will ignore this call.
+	 *
+	 * @pre					Requires GWIN_WIDGET_CACHE to be TRUE
+	 *
+	 * @api
+	 */
+	void gwinSetCached(GHandle gh, bool_t cached);
+#endif
+
 /**
  * @brief   Set the style of a widget.
  *
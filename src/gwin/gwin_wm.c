@@ -148,12 +148,23 @@
 	void gwinRedraw(GHandle gh) {
 		_gwinUpdate(gh);
 	}
+
+	void gwinInvalidateRect(GHandle gh, coord_t x, coord_t y, coord_t cx, coord_t cy) {
+		(void) x; (void) y; (void) cx; (void) cy;
+
+		// Without a window manager there is nowhere to remember the area
+		_gwinUpdate(gh);
+	}
 #endif
 
 #if GFX_USE_GWIN && GWIN_NEED_WINDOWMANAGER
 
 #include "gwin_class.h"
 
+#if GWIN_NEED_SPATIAL_INDEX || GWIN_NEED_COMPOSITOR
+	#include <string.h>				// Required for memmove(), memset() and memcpy()
+#endif
+
 /*-----------------------------------------------
  * Data
  *-----------------------------------------------*/
@@ -170,12 +181,333 @@ static gfxQueueASync		_GWINList;
 #if !GWIN_REDRAW_IMMEDIATE
 	static GTimer			RedrawTimer;
 	static void				RedrawTimerFn(void *param);
+	#if GWIN_REDRAW_FRAMERATE
+		static systemticks_t	LastFrame;
+	#endif
 #endif
 static volatile uint8_t		RedrawPending;
 	#define DOREDRAW_INVISIBLES		0x01
 	#define DOREDRAW_VISIBLES		0x02
 	#define DOREDRAW_FLASHRUNNING	0x04
+	#define DOREDRAW_FRAMERUNNING	0x08
+	#define DOREDRAW_COMPOSITE		0x10
+	#define DOREDRAW_WORK			(DOREDRAW_INVISIBLES|DOREDRAW_VISIBLES|DOREDRAW_COMPOSITE)
+#if GWIN_NEED_COMPOSITOR
+	static GDisplay *CompositePending(void);
+#endif
+
+
+/*-----------------------------------------------
+ * Spatial Index Routines
+ *-----------------------------------------------*/
+
+#if GWIN_NEED_SPATIAL_INDEX
+	/**
+	 * Each display is divided into a grid of cells. Each cell holds the windows that overlap it
+	 * sorted by their z-order (bottom to top). The index holds all windows whether visible or not
+	 * so visibility changes don't need to touch it - visibility is tested when it is searched.
+	 * The cells covered by a window include the cells its right and bottom edges touch so that
+	 * windows that just touch an area are found (this is how WM_Redraw() treats overlaps).
+	 */
+	typedef struct gwinIndexCell {
+		GHandle *			wins;				// The windows overlapping this cell sorted by z-order
+		uint16_t			cnt;				// The number of windows in the cell
+		uint16_t			max;				// The number of windows we have room for
+	} gwinIndexCell;
+
+	typedef struct gwinIndex {
+		struct gwinIndex *	next;				// The index for the next display
+		GDisplay *			display;			// The display this index is for
+		uint16_t			cols, rows;			// The size of the cell grid
+		gwinIndexCell		cells[1];			// The cells - really cols * rows of them
+	} gwinIndex;
+
+	#define INDEX_CELL_GROW		4
+
+	static gfxMutex			IndexMutex;
+	static gwinIndex *		IndexList;
+	static uint32_t			IndexZOrder;
+	static bool_t			IndexFailed;		// We ran out of memory - every window gets tested instead
+
+	static void IndexInit(void) {
+		gfxMutexInit(&IndexMutex);
+		IndexList = 0;
+		IndexZOrder = 0;
+		IndexFailed = FALSE;
+	}
+
+	// Free all the index memory. Must be called with the mutex held.
+	static void IndexFree(void) {
+		gwinIndex *		pi;
+		unsigned		i;
+
+		while((pi = IndexList)) {
+			IndexList = pi->next;
+			for(i = 0; i < (unsigned)pi->cols * pi->rows; i++) {
+				if (pi->cells[i].wins)
+					gfxFree(pi->cells[i].wins);
+			}
+			gfxFree(pi);
+		}
+	}
+
+	static void IndexDeinit(void) {
+		IndexFree();
+		gfxMutexDestroy(&IndexMutex);
+	}
+
+	// Find (and optionally create) the index for a display. Must be called with the mutex held.
+	static gwinIndex *IndexGet(GDisplay *g, bool_t create) {
+		gwinIndex *		pi;
+		uint16_t		cols, rows;
+
+		for(pi = IndexList; pi; pi = pi->next) {
+			if (pi->display == g)
+				return pi;
+		}
+		if (!create)
+			return 0;
+
+		cols = ((gdispGGetWidth(g) - 1) >> GWIN_SPATIAL_INDEX_CELL_SHIFT) + 1;
+		rows = ((gdispGGetHeight(g) - 1) >> GWIN_SPATIAL_INDEX_CELL_SHIFT) + 1;
+		if (!(pi = gfxAlloc(sizeof(gwinIndex) + ((unsigned)cols * rows - 1) * sizeof(gwinIndexCell))))
+			return 0;
+		memset(pi->cells, 0, (unsigned)cols * rows * sizeof(gwinIndexCell));
+		pi->display = g;
+		pi->cols = cols;
+		pi->rows = rows;
+		pi->next = IndexList;
+		IndexList = pi;
+		return pi;
+	}
+
+	// Convert a screen coordinate to a cell coordinate clipped to the grid.
+	//	Clipping keeps the index correct even if the display orientation is changed.
+	static uint16_t IndexCell(coord_t v, uint16_t cnt) {
+		if (v <= 0)
+			return 0;
+		v >>= GWIN_SPATIAL_INDEX_CELL_SHIFT;
+		return (uint16_t)v >= cnt ? cnt - 1 : (uint16_t)v;
+	}
+
+	// Find the first entry in a cell with a z-order greater than z
+	static uint16_t IndexSearch(gwinIndexCell *pc, uint32_t z) {
+		uint16_t	lo, hi, mid;
+
+		for(lo = 0, hi = pc->cnt; lo < hi; ) {
+			mid = (lo + hi) >> 1;
+			if (pc->wins[mid]->zorder <= z)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		return lo;
+	}
+
+	// Remove a window from the cells it currently occupies. Must be called with the mutex held.
+	static void IndexCellsRemove(gwinIndex *pi, GHandle gh) {
+		gwinIndexCell *	pc;
+		uint16_t		cx, cy, i;
+
+		for(cy = gh->icy0; cy <= gh->icy1; cy++) {
+			for(cx = gh->icx0, pc = pi->cells + cy * pi->cols + cx; cx <= gh->icx1; cx++, pc++) {
+				i = IndexSearch(pc, gh->zorder - 1);
+				if (i < pc->cnt && pc->wins[i] == gh) {
+					pc->cnt--;
+					memmove(pc->wins + i, pc->wins + i + 1, (pc->cnt - i) * sizeof(GHandle));
+				}
+			}
+		}
+	}
+
+	// Add a window to the cells it occupies. Must be called with the mutex held.
+	static bool_t IndexCellsAdd(gwinIndex *pi, GHandle gh) {
+		gwinIndexCell *	pc;
+		GHandle *		p;
+		uint16_t		cx, cy, i;
+
+		for(cy = gh->icy0; cy <= gh->icy1; cy++) {
+			for(cx = gh->icx0, pc = pi->cells + cy * pi->cols + cx; cx <= gh->icx1; cx++, pc++) {
+				if (pc->cnt >= pc->max) {
+					if (!(p = gfxRealloc(pc->wins, pc->max * sizeof(GHandle), (pc->max + INDEX_CELL_GROW) * sizeof(GHandle))))
+						return FALSE;
+					pc->wins = p;
+					pc->max += INDEX_CELL_GROW;
+				}
+				i = IndexSearch(pc, gh->zorder);
+				memmove(pc->wins + i + 1, pc->wins + i, (pc->cnt - i) * sizeof(GHandle));
+				pc->wins[i] = gh;
+				pc->cnt++;
+			}
+		}
+		return TRUE;
+	}
+
+	// Give up on the index. Must be called with the mutex held.
+	static void IndexFail(void) {
+		IndexFailed = TRUE;
+		IndexFree();
+	}
 
+	// Get the next z-order. Must be called with the mutex held.
+	static uint32_t IndexNextZOrder(void) {
+		GHandle		gh;
+
+		if (!++IndexZOrder) {
+			// We have wrapped - renumber the indexed windows in list order.
+			//	This doesn't change their relative order so the cells stay sorted.
+			for(gh = gwinGetNextWindow(0); gh; gh = gwinGetNextWindow(gh)) {
+				if (gh->zorder)
+					gh->zorder = ++IndexZOrder;
+			}
+			IndexZOrder++;
+		}
+		return IndexZOrder;
+	}
+
+	void _gwinIndexUpdate(GHandle gh) {
+		gwinIndex *		pi;
+		uint16_t		cx0, cy0, cx1, cy1;
+
+		gfxMutexEnter(&IndexMutex);
+		if (!IndexFailed) {
+			if (!(pi = IndexGet(gh->display, TRUE))) {
+				IndexFail();
+				gfxMutexExit(&IndexMutex);
+				return;
+			}
+			cx0 = IndexCell(gh->x, pi->cols);
+			cy0 = IndexCell(gh->y, pi->rows);
+			cx1 = IndexCell(gh->x + gh->width, pi->cols);
+			cy1 = IndexCell(gh->y + gh->height, pi->rows);
+			if (gh->zorder) {
+				// Nothing to do if it still covers the same cells
+				if (gh->icx0 == cx0 && gh->icy0 == cy0 && gh->icx1 == cx1 && gh->icy1 == cy1) {
+					gfxMutexExit(&IndexMutex);
+					return;
+				}
+				IndexCellsRemove(pi, gh);
+			} else
+				gh->zorder = IndexNextZOrder();
+			gh->icx0 = cx0; gh->icy0 = cy0;
+			gh->icx1 = cx1; gh->icy1 = cy1;
+			if (!IndexCellsAdd(pi, gh))
+				IndexFail();
+		}
+		gfxMutexExit(&IndexMutex);
+	}
+
+	void _gwinIndexRaise(GHandle gh) {
+		gwinIndex *		pi;
+
+		gfxMutexEnter(&IndexMutex);
+		if (!IndexFailed && gh->zorder && (pi = IndexGet(gh->display, FALSE))) {
+			IndexCellsRemove(pi, gh);
+			gh->zorder = IndexNextZOrder();
+			if (!IndexCellsAdd(pi, gh))
+				IndexFail();
+		}
+		gfxMutexExit(&IndexMutex);
+	}
+
+	void _gwinIndexRemove(GHandle gh) {
+		gwinIndex *		pi;
+
+		gfxMutexEnter(&IndexMutex);
+		if (!IndexFailed && gh->zorder && (pi = IndexGet(gh->display, FALSE)))
+			IndexCellsRemove(pi, gh);
+		gh->zorder = 0;
+		gfxMutexExit(&IndexMutex);
+	}
+
+	GHandle _gwinIndexNextOverlap(GDisplay *g, coord_t x, coord_t y, coord_t cx, coord_t cy, GHandle gh) {
+		gwinIndex *		pi;
+		gwinIndexCell *	pc;
+		GHandle			gx, best;
+		uint32_t		z;
+		uint16_t		cx0, cy0, cx1, cy1, i, j, k;
+
+		#define OVERLAPS(gx)	((gx->flags & GWIN_FLG_SYSVISIBLE) && gx->display == g \
+									&& gx->x < x+cx && gx->y < y+cy && gx->x+gx->width >= x && gx->y+gx->height >= y)
+
+		gfxMutexEnter(&IndexMutex);
+
+		// If we have no index just test every window
+		if (IndexFailed) {
+			gfxMutexExit(&IndexMutex);
+			for(gx = gwinGetNextWindow(gh); gx; gx = gwinGetNextWindow(gx)) {
+				if (OVERLAPS(gx))
+					break;
+			}
+			return gx;
+		}
+
+		// Find the lowest z-order window above the previous one in any of the cells
+		best = 0;
+		if ((pi = IndexGet(g, FALSE))) {
+			z = gh ? gh->zorder : 0;
+			cx0 = IndexCell(x, pi->cols);
+			cy0 = IndexCell(y, pi->rows);
+			cx1 = IndexCell(x + cx, pi->cols);
+			cy1 = IndexCell(y + cy, pi->rows);
+			for(j = cy0; j <= cy1; j++) {
+				for(i = cx0, pc = pi->cells + j * pi->cols + cx0; i <= cx1; i++, pc++) {
+					for(k = IndexSearch(pc, z); k < pc->cnt; k++) {
+						gx = pc->wins[k];
+						if (best && gx->zorder >= best->zorder)
+							break;
+						if (OVERLAPS(gx)) {
+							best = gx;
+							break;
+						}
+					}
+				}
+			}
+		}
+		gfxMutexExit(&IndexMutex);
+		return best;
+
+		#undef OVERLAPS
+	}
+
+#endif
+
+GHandle gwinFindWindowAt(GDisplay *g, coord_t x, coord_t y) {
+	GHandle			gh, h;
+
+	#if GWIN_NEED_SPATIAL_INDEX
+		gwinIndex *		pi;
+		gwinIndexCell *	pc;
+		uint16_t		i;
+
+		gfxMutexEnter(&IndexMutex);
+		if (!IndexFailed) {
+			// Search the cell containing the point from the top down
+			gh = 0;
+			if ((pi = IndexGet(g, FALSE))) {
+				pc = pi->cells + IndexCell(y, pi->rows) * pi->cols + IndexCell(x, pi->cols);
+				for(i = pc->cnt; i--; ) {
+					h = pc->wins[i];
+					if ((h->flags & GWIN_FLG_SYSVISIBLE) && x >= h->x && x < h->x + h->width && y >= h->y && y < h->y + h->height) {
+						gh = h;
+						break;
+					}
+				}
+			}
+			gfxMutexExit(&IndexMutex);
+			return gh;
+		}
+		gfxMutexExit(&IndexMutex);
+	#endif
+
+	// Test every window saving the highest z-order window that the point is in
+	for(gh = 0, h = gwinGetNextWindow(0); h; h = gwinGetNextWindow(h)) {
+		if (h->display == g && (h->flags & GWIN_FLG_SYSVISIBLE)
+				&& x >= h->x && x < h->x + h->width && y >= h->y && y < h->y + h->height)
+			gh = h;
+	}
+	return gh;
+}
 
 /*-----------------------------------------------
  * Window Routines
@@ -185,12 +517,17 @@ void _gwmInit(void)
 {
 	gfxSemInit(&gwinsem, 1, 1);
 	gfxQueueASyncInit(&_GWINList);
+	#if GWIN_NEED_SPATIAL_INDEX
+		IndexInit();
+	#endif
 	#if GWIN_NEED_FLASHING
 		gtimerInit(&FlashTimer);
 	#endif
 	#if !GWIN_REDRAW_IMMEDIATE
 		gtimerInit(&RedrawTimer);
-		gtimerStart(&RedrawTimer, RedrawTimerFn, 0, TRUE, TIME_INFINITE);
+		#if !GWIN_REDRAW_FRAMERATE
+			gtimerStart(&RedrawTimer, RedrawTimerFn, 0, TRUE, TIME_INFINITE);
+		#endif
 	#endif
 	_GWINwm = (GWindowManager *)&GNullWindowManager;
 	_GWINwm->vmt->Init();
@@ -207,12 +544,48 @@ void _gwmDeinit(void)
 	#if !GWIN_REDRAW_IMMEDIATE
 		gtimerDeinit(&RedrawTimer);
 	#endif
+	#if GWIN_NEED_SPATIAL_INDEX
+		IndexDeinit();
+	#endif
 	gfxQueueASyncDeinit(&_GWINList);
 	gfxSemDestroy(&gwinsem);
 }
 
 #if GWIN_REDRAW_IMMEDIATE
 	#define TriggerRedraw(void) _gwinFlushRedraws(REDRAW_NOWAIT);
+#elif GWIN_REDRAW_FRAMERATE
+	#define FRAME_PERIOD		(1000/GWIN_REDRAW_FRAMERATE)
+	#define TriggerRedraw()		StartFrames();
+
+	// Start the frame timer if it isn't already running
+	static void StartFrames(void) {
+		if ((RedrawPending & DOREDRAW_FRAMERUNNING))
+			return;
+		RedrawPending |= DOREDRAW_FRAMERUNNING;
+		gtimerStart(&RedrawTimer, RedrawTimerFn, 0, TRUE, FRAME_PERIOD);
+
+		// Don't wait if it is already more than a frame since the last one
+		if (gfxSystemTicks() - LastFrame >= gfxMillisecondsToTicks(FRAME_PERIOD))
+			gtimerJab(&RedrawTimer);
+	}
+
+	static void RedrawTimerFn(void *param) {
+		(void)		param;
+
+		// Stop the frames if there is nothing to do
+		if (!(RedrawPending & DOREDRAW_WORK)) {
+			gtimerStop(&RedrawTimer);
+			RedrawPending &= ~DOREDRAW_FRAMERUNNING;
+
+			// Someone may have asked for a redraw while we were stopping
+			if ((RedrawPending & DOREDRAW_WORK))
+				StartFrames();
+			return;
+		}
+
+		LastFrame = gfxSystemTicks();
+		_gwinFlushRedraws(REDRAW_NOWAIT);
+	}
 #else
 	#define TriggerRedraw()		gtimerJab(&RedrawTimer);
 
@@ -222,11 +595,21 @@ void _gwmDeinit(void)
 	}
 #endif
 
+// Make the area to be redrawn the whole window
+static void DamageAll(GHandle gh) {
+	gh->dirtyx = gh->dirtyy = 0;
+	gh->dirtycx = gh->width;
+	gh->dirtycy = gh->height;
+}
+
 void _gwinFlushRedraws(GRedrawMethod how) {
 	GHandle		gh;
+	#if GWIN_REDRAW_FRAMERATE
+		GDisplay *	g;
+	#endif
 
 	// Do we really need to do anything?
-	if (!RedrawPending)
+	if (!(RedrawPending & DOREDRAW_WORK))
 		return;
 
 	// Obtain the drawing lock
@@ -236,6 +619,10 @@ void _gwinFlushRedraws(GRedrawMethod how) {
 		// Someone is drawing - They will do the redraw when they are finished
 		return;
 
+	#if GWIN_REDRAW_FRAMERATE
+		g = 0;
+	#endif
+
 	// Do loss of visibility first
 	while ((RedrawPending & DOREDRAW_INVISIBLES)) {
 		RedrawPending &= ~DOREDRAW_INVISIBLES;				// Catch new requests
@@ -245,6 +632,7 @@ void _gwinFlushRedraws(GRedrawMethod how) {
 				continue;
 
 			// Do the redraw
+			DamageAll(gh);
 			#if GDISP_NEED_CLIP
 				gdispGSetClip(gh->display, gh->x, gh->y, gh->width, gh->height);
 				_GWINwm->vmt->Redraw(gh);
@@ -252,9 +640,17 @@ void _gwinFlushRedraws(GRedrawMethod how) {
 			#else
 				_GWINwm->vmt->Redraw(gh);
 			#endif
+			gh->dirtycx = 0;
+
+			#if GWIN_REDRAW_FRAMERATE
+				// Each display gets flushed once at the end
+				if (g && g != gh->display)
+					gdispGFlush(g);
+				g = gh->display;
+			#endif
 
 			// Postpone further redraws
-			#if !GWIN_REDRAW_IMMEDIATE && !GWIN_REDRAW_SINGLEOP
+			#if !GWIN_REDRAW_IMMEDIATE && !GWIN_REDRAW_SINGLEOP && !GWIN_REDRAW_FRAMERATE
 				if (how == REDRAW_NOWAIT) {
 					RedrawPending |= DOREDRAW_INVISIBLES;
 					TriggerRedraw();
@@ -272,17 +668,30 @@ void _gwinFlushRedraws(GRedrawMethod how) {
 			if ((gh->flags & (GWIN_FLG_NEEDREDRAW|GWIN_FLG_SYSVISIBLE)) != (GWIN_FLG_NEEDREDRAW|GWIN_FLG_SYSVISIBLE))
 				continue;
 
-			// Do the redraw
+			// Do the redraw. Just the damaged area is drawn unless the whole window is needed.
+			if (!gh->dirtycx || (gh->flags & GWIN_FLG_BGREDRAW))
+				DamageAll(gh);
 			#if GDISP_NEED_CLIP
-				gdispGSetClip(gh->display, gh->x, gh->y, gh->width, gh->height);
+				gdispGSetClip(gh->display, gh->x+gh->dirtyx, gh->y+gh->dirtyy, gh->dirtycx, gh->dirtycy);
 				_GWINwm->vmt->Redraw(gh);
 				gdispGUnsetClip(gh->display);
 			#else
 				_GWINwm->vmt->Redraw(gh);
 			#endif
 
+			// Keep any new area if it has been marked for redraw again while we were drawing it
+			if (!(gh->flags & GWIN_FLG_NEEDREDRAW))
+				gh->dirtycx = 0;
+
+			#if GWIN_REDRAW_FRAMERATE
+				// Each display gets flushed once at the end
+				if (g && g != gh->display)
+					gdispGFlush(g);
+				g = gh->display;
+			#endif
+
 			// Postpone further redraws (if there are any and the options are set right)
-			#if !GWIN_REDRAW_IMMEDIATE && !GWIN_REDRAW_SINGLEOP
+			#if !GWIN_REDRAW_IMMEDIATE && !GWIN_REDRAW_SINGLEOP && !GWIN_REDRAW_FRAMERATE
 				if (how == REDRAW_NOWAIT) {
 					while((gh = gwinGetNextWindow(gh))) {
 						if ((gh->flags & (GWIN_FLG_NEEDREDRAW|GWIN_FLG_SYSVISIBLE)) == (GWIN_FLG_NEEDREDRAW|GWIN_FLG_SYSVISIBLE)) {
@@ -297,7 +706,32 @@ void _gwinFlushRedraws(GRedrawMethod how) {
 		}
 	}
 
-	#if !GWIN_REDRAW_IMMEDIATE && !GWIN_REDRAW_SINGLEOP
+	#if GWIN_NEED_COMPOSITOR
+		// Put the display together from what has been drawn into the back buffers.
+		//	A drawing session leaves this for the redraw timer so that many small drawing
+		//	operations get composited together.
+		if ((RedrawPending & DOREDRAW_COMPOSITE) && how != REDRAW_INSESSION) {
+			#if GWIN_REDRAW_FRAMERATE
+				GDisplay *	gc;
+
+				// Each display gets flushed once at the end
+				if ((gc = CompositePending())) {
+					if (g && g != gc)
+						gdispGFlush(g);
+					g = gc;
+				}
+			#else
+				CompositePending();
+			#endif
+		}
+	#endif
+
+	#if GWIN_REDRAW_FRAMERATE
+		if (g)
+			gdispGFlush(g);
+	#endif
+
+	#if !GWIN_REDRAW_IMMEDIATE && !GWIN_REDRAW_SINGLEOP && !GWIN_REDRAW_FRAMERATE
 		releaselock:
 	#endif
 
@@ -306,12 +740,55 @@ void _gwinFlushRedraws(GRedrawMethod how) {
 		gfxSemSignal(&gwinsem);
 }
 
-void _gwinUpdate(GHandle gh) {
+// Redraw a window whose contents haven't changed (it has just been uncovered or overwritten)
+static void ExposeWindow(GHandle gh) {
+	// Only redraw if visible
+	if (!(gh->flags & GWIN_FLG_SYSVISIBLE))
+		return;
+
+	// Mark the whole window for redraw
+	gh->flags |= GWIN_FLG_NEEDREDRAW;
+	gh->dirtycx = 0;
+	RedrawPending |= DOREDRAW_VISIBLES;
+
+	// Asynchronous redraw
+	TriggerRedraw();
+}
+
+// Redraw part of a window whose contents haven't changed. The area is relative to the window.
+static void ExposeArea(GHandle gh, coord_t x, coord_t y, coord_t cx, coord_t cy) {
+	coord_t		v;
+
 	// Only redraw if visible
 	if (!(gh->flags & GWIN_FLG_SYSVISIBLE))
 		return;
 
-	// Mark for redraw
+	// Clip to the window
+	if (x < 0) { cx += x; x = 0; }
+	if (y < 0) { cy += y; y = 0; }
+	if (cx > gh->width - x)		cx = gh->width - x;
+	if (cy > gh->height - y)	cy = gh->height - y;
+	if (cx <= 0 || cy <= 0)
+		return;
+
+	// Merge it with any area already waiting to be redrawn
+	if (!(gh->flags & GWIN_FLG_NEEDREDRAW)) {
+		gh->dirtyx = x;
+		gh->dirtyy = y;
+		gh->dirtycx = cx;
+		gh->dirtycy = cy;
+	} else if (gh->dirtycx) {
+		v = gh->dirtyx + gh->dirtycx;
+		if (x + cx > v)			v = x + cx;
+		if (x < gh->dirtyx)		gh->dirtyx = x;
+		gh->dirtycx = v - gh->dirtyx;
+		v = gh->dirtyy + gh->dirtycy;
+		if (y + cy > v)			v = y + cy;
+		if (y < gh->dirtyy)		gh->dirtyy = y;
+		gh->dirtycy = v - gh->dirtyy;
+	}
+	// else the whole window is already waiting
+
 	gh->flags |= GWIN_FLG_NEEDREDRAW;
 	RedrawPending |= DOREDRAW_VISIBLES;
 
@@ -319,6 +796,18 @@ void _gwinUpdate(GHandle gh) {
 	TriggerRedraw();
 }
 
+void _gwinUpdate(GHandle gh) {
+	// The contents have changed so any cached copy is stale
+	_gwinCacheInvalidate(gh);
+	ExposeWindow(gh);
+}
+
+void _gwinUpdateArea(GHandle gh, coord_t x, coord_t y, coord_t cx, coord_t cy) {
+	// The contents have changed so any cached copy is stale
+	_gwinCacheInvalidate(gh);
+	ExposeArea(gh, x, y, cx, cy);
+}
+
 #if GWIN_NEED_CONTAINERS
 	void _gwinRippleVisibility(void) {
 		GHandle		gh;
@@ -381,9 +870,16 @@ bool_t _gwinDrawStart(GHandle gh) {
 		return FALSE;
 	}
 
+	// Drawing directly on the window makes any cached copy stale
+	_gwinCacheInvalidate(gh);
+
+	// Let the window manager redirect the drawing
+	if (_GWINwm->vmt->DrawStart)
+		_GWINwm->vmt->DrawStart(gh);
+
 	// OK - we are ready to draw.
 	#if GDISP_NEED_CLIP
-		gdispGSetClip(gh->display, gh->x, gh->y, gh->width, gh->height);
+		gdispGSetClip(gwinGetDrawDisplay(gh), gwinGetDrawX(gh), gwinGetDrawY(gh), gh->width, gh->height);
 	#endif
 	return TRUE;
 }
@@ -391,14 +887,26 @@ bool_t _gwinDrawStart(GHandle gh) {
 void _gwinDrawEnd(GHandle gh) {
 	// Ensure there is no clip set
 	#if GDISP_NEED_CLIP
-		gdispGUnsetClip(gh->display);
+		gdispGUnsetClip(gwinGetDrawDisplay(gh));
 	#endif
 
-	// Look for something to redraw
-	_gwinFlushRedraws(REDRAW_INSESSION);
+	// Let the window manager finish any redirection
+	if (_GWINwm->vmt->DrawEnd)
+		_GWINwm->vmt->DrawEnd(gh);
+
+	// Look for something to redraw (unless it waits for the next frame)
+	#if !GWIN_REDRAW_FRAMERATE
+		_gwinFlushRedraws(REDRAW_INSESSION);
+	#endif
 
 	// Release the lock
 	gfxSemSignal(&gwinsem);
+
+	// Compositing is left for the redraw timer which needs the lock we have just released
+	#if GWIN_NEED_COMPOSITOR && !GWIN_REDRAW_IMMEDIATE
+		if ((RedrawPending & DOREDRAW_COMPOSITE))
+			TriggerRedraw();
+	#endif
 }
 
 bool_t _gwinWMAdd(GHandle gh, const GWindowInit *pInit) {
@@ -411,6 +919,12 @@ bool_t _gwinWMAdd(GHandle gh, const GWindowInit *pInit) {
 			return FALSE;
 	#endif
 
+	gh->dirtycx = 0;
+	#if GWIN_NEED_COMPOSITOR
+		gh->backbuf = 0;
+		gh->opacity = 255;
+	#endif
+
 	// Add to the window manager
 	if (!_GWINwm->vmt->Add(gh, pInit))
 		return FALSE;
@@ -431,6 +945,9 @@ void gwinSetWindowManager(struct GWindowManager *gwm) {
 		_GWINwm->vmt->DeInit();
 		_GWINwm = gwm;
 		_GWINwm->vmt->Init();
+
+		// Do anything the window managers have asked for
+		TriggerRedraw();
 	}
 }
 
@@ -439,14 +956,20 @@ void gwinRedraw(GHandle gh) {
 	if (!(gh->flags & GWIN_FLG_SYSVISIBLE))
 		return;
 
-	// Mark for redraw
+	// Mark for redraw (from scratch)
+	_gwinCacheInvalidate(gh);
 	gh->flags |= GWIN_FLG_NEEDREDRAW;
+	gh->dirtycx = 0;
 	RedrawPending |= DOREDRAW_VISIBLES;
 
 	// Synchronous redraw
 	_gwinFlushRedraws(REDRAW_WAIT);
 }
 
+void gwinInvalidateRect(GHandle gh, coord_t x, coord_t y, coord_t cx, coord_t cy) {
+	_gwinUpdateArea(gh, x, y, cx, cy);
+}
+
 #if GWIN_NEED_CONTAINERS
 	void gwinSetVisible(GHandle gh, bool_t visible) {
 		if (visible) {
@@ -599,7 +1122,7 @@ void gwinRedrawDisplay(GDisplay *g, bool_t preserve) {
 		if (!preserve)
 			gh->flags |= GWIN_FLG_BGREDRAW;
 
-		_gwinUpdate(gh);
+		ExposeWindow(gh);
 	}
 }
 
@@ -706,6 +1229,8 @@ static const gwmVMT GNullWindowManagerVMT = {
 	WM_Move,
 	WM_Raise,
 	WM_MinMax,
+	0,
+	0,
 };
 
 const GWindowManager	GNullWindowManager = {
@@ -735,8 +1260,16 @@ static bool_t WM_Add(GHandle gh, const GWindowInit *pInit) {
 	// Make sure the size/position is valid - prefer position over size.
 	gh->width = MIN_WIN_WIDTH; gh->height = MIN_WIN_HEIGHT;
 	gh->x = gh->y = 0;
+	#if GWIN_NEED_SPATIAL_INDEX
+		gh->zorder = 0;
+	#endif
 	WM_Move(gh, pInit->x, pInit->y);
 	WM_Size(gh, pInit->width, pInit->height);
+
+	#if GWIN_NEED_SPATIAL_INDEX
+		// Make sure it is in the index even if it didn't move
+		_gwinIndexUpdate(gh);
+	#endif
 	return TRUE;
 }
 
@@ -744,6 +1277,9 @@ static void WM_Delete(GHandle gh) {
 	// Remove it from the window list
 	gfxSemWait(&gwinsem, TIME_INFINITE);
 	gfxQueueASyncRemove(&_GWINList, &gh->wmq);
+	#if GWIN_NEED_SPATIAL_INDEX
+		_gwinIndexRemove(gh);
+	#endif
 	gfxSemSignal(&gwinsem);
 }
 
@@ -761,7 +1297,7 @@ static void WM_Redraw(GHandle gh) {
 			gh->vmt->Redraw(gh);
 		else if ((flags & GWIN_FLG_BGREDRAW)) {
 			// We can't redraw but we want full coverage so just clear the area
-			gdispGFillArea(gh->display, gh->x, gh->y, gh->width, gh->height, gh->bgcolor);
+			gdispGFillArea(gwinGetDrawDisplay(gh), gwinGetDrawX(gh), gwinGetDrawY(gh), gh->width, gh->height, gh->bgcolor);
 
 			// Only do an after clear if this is not a parent reveal
 			if (!(flags & GWIN_FLG_PARENTREVEAL) && gh->vmt->AfterClear)
@@ -771,13 +1307,15 @@ static void WM_Redraw(GHandle gh) {
 		#if GWIN_NEED_CONTAINERS
 			// If this is container but not a parent reveal, mark any visible children for redraw
 			//	We redraw our children here as we have overwritten them in redrawing the parent
-			//	as GDISP/GWIN doesn't support complex clipping regions.
+			//	as GDISP/GWIN doesn't support complex clipping regions. Only the part of each child
+			//	inside the area we have just drawn needs redrawing.
 			if ((flags & (GWIN_FLG_CONTAINER|GWIN_FLG_PARENTREVEAL)) == GWIN_FLG_CONTAINER) {
+				GHandle		gx;
 
 				// Container redraw is done
 
-				for(gh = gwinGetFirstChild(gh); gh; gh = gwinGetSibling(gh))
-					_gwinUpdate(gh);
+				for(gx = gwinGetFirstChild(gh); gx; gx = gwinGetSibling(gx))
+					ExposeArea(gx, gh->x+gh->dirtyx-gx->x, gh->y+gh->dirtyy-gx->y, gh->dirtycx, gh->dirtycy);
 				return;
 			}
 		#endif
@@ -791,11 +1329,14 @@ static void WM_Redraw(GHandle gh) {
 					// Child redraw is done
 
 					// Get the parent to redraw the area
-					gh = gh->parent;
+					gx = gh->parent;
 
-					// The parent is already marked for redraw - don't do it now.
-					if ((gh->flags & GWIN_FLG_NEEDREDRAW))
+					// The parent is already marked for redraw - make sure it covers our area and don't do it now.
+					if ((gx->flags & GWIN_FLG_NEEDREDRAW)) {
+						ExposeArea(gx, gh->x-gx->x, gh->y-gx->y, gh->width, gh->height);
 						return;
+					}
+					gh = gx;
 
 					// Use the existing clipping region and redraw now
 					gh->flags |= (GWIN_FLG_BGREDRAW|GWIN_FLG_PARENTREVEAL);
@@ -807,17 +1348,28 @@ static void WM_Redraw(GHandle gh) {
 			gdispGFillArea(gh->display, gh->x, gh->y, gh->width, gh->height, gwinGetDefaultBgColor());
 
 			// Now loop over all windows looking for overlaps. Redraw them if they overlap the newly exposed area.
-			for(gx = gwinGetNextWindow(0); gx; gx = gwinGetNextWindow(gx)) {
-				if ((gx->flags & GWIN_FLG_SYSVISIBLE)
-						&& gx->display == gh->display
-						&& gx->x < gh->x+gh->width && gx->y < gh->y+gh->height && gx->x+gx->width >= gh->x && gx->y+gx->height >= gh->y) {
+			#if GWIN_NEED_SPATIAL_INDEX
+				// The index only gives us visible windows on this display that overlap the area
+				for(gx = _gwinIndexNextOverlap(gh->display, gh->x, gh->y, gh->width, gh->height, 0); gx; gx = _gwinIndexNextOverlap(gh->display, gh->x, gh->y, gh->width, gh->height, gx)) {
 					if (gx->vmt->Redraw)
 						gx->vmt->Redraw(gx);
 					else
 						// We can't redraw this window but we want full coverage so just clear the area
 						gdispGFillArea(gx->display, gx->x, gx->y, gx->width, gx->height, gx->bgcolor);
 				}
-			}
+			#else
+				for(gx = gwinGetNextWindow(0); gx; gx = gwinGetNextWindow(gx)) {
+					if ((gx->flags & GWIN_FLG_SYSVISIBLE)
+							&& gx->display == gh->display
+							&& gx->x < gh->x+gh->width && gx->y < gh->y+gh->height && gx->x+gx->width >= gh->x && gx->y+gx->height >= gh->y) {
+						if (gx->vmt->Redraw)
+							gx->vmt->Redraw(gx);
+						else
+							// We can't redraw this window but we want full coverage so just clear the area
+							gdispGFillArea(gx->display, gx->x, gx->y, gx->width, gx->height, gx->bgcolor);
+					}
+				}
+			#endif
 
 		}
 	}
@@ -856,6 +1408,9 @@ static void WM_Size(GHandle gh, coord_t w, coord_t h) {
 
 			// The new size is larger - just redraw
 			gh->width = w; gh->height = h;
+			#if GWIN_NEED_SPATIAL_INDEX
+				_gwinIndexUpdate(gh);
+			#endif
 			_gwinUpdate(gh);
 
 		} else {
@@ -865,6 +1420,9 @@ static void WM_Size(GHandle gh, coord_t w, coord_t h) {
 
 			// Resize
 			gh->width = w; gh->height = h;
+			#if GWIN_NEED_SPATIAL_INDEX
+				_gwinIndexUpdate(gh);
+			#endif
 
 			#if GWIN_NEED_CONTAINERS
 				// Any children outside the new area need to be moved
@@ -882,6 +1440,9 @@ static void WM_Size(GHandle gh, coord_t w, coord_t h) {
 		}
 	} else {
 		gh->width = w; gh->height = h;
+		#if GWIN_NEED_SPATIAL_INDEX
+			_gwinIndexUpdate(gh);
+		#endif
 
 		#if GWIN_NEED_CONTAINERS
 			// Any children outside the new area need to be moved
@@ -947,6 +1508,9 @@ static void WM_Move(GHandle gh, coord_t x, coord_t y) {
 		// Do the move
 		u = gh->x; gh->x = x;
 		v = gh->y; gh->y = y;
+		#if GWIN_NEED_SPATIAL_INDEX
+			_gwinIndexUpdate(gh);
+		#endif
 
 		#if GWIN_NEED_CONTAINERS
 			// Any children need to be moved
@@ -963,6 +1527,9 @@ static void WM_Move(GHandle gh, coord_t x, coord_t y) {
 	} else {
 		u = gh->x; gh->x = x;
 		v = gh->y; gh->y = y;
+		#if GWIN_NEED_SPATIAL_INDEX
+			_gwinIndexUpdate(gh);
+		#endif
 
 		#if GWIN_NEED_CONTAINERS
 			// Any children need to be moved
@@ -982,14 +1549,15 @@ static void WM_MinMax(GHandle gh, GWindowMinMax minmax) {
 	// We don't support minimising, maximising or restoring
 }
 
-static void WM_Raise(GHandle gh) {
+// Put a window (and its children) on top of the z-order. Must be called with the drawing lock held.
+static void RaiseWindow(GHandle gh) {
 	// Take it off the list and then put it back on top
 	// The order of the list then reflects the z-order.
-
-	gfxSemWait(&gwinsem, TIME_INFINITE);
-	
 	gfxQueueASyncRemove(&_GWINList, &gh->wmq);
 	gfxQueueASyncPut(&_GWINList, &gh->wmq);
+	#if GWIN_NEED_SPATIAL_INDEX
+		_gwinIndexRaise(gh);
+	#endif
 
 	#if GWIN_NEED_CONTAINERS
 		// Any children need to be raised too
@@ -1008,6 +1576,9 @@ static void WM_Raise(GHandle gh) {
 							// Oops - this child is behind its parent. Move it to the front.
 							gfxQueueASyncRemove(&_GWINList, &child->wmq);
 							gfxQueueASyncPut(&_GWINList, &child->wmq);
+							#if GWIN_NEED_SPATIAL_INDEX
+								_gwinIndexRaise(child);
+							#endif
 
 							// Restart at the front of the list for this parent container as we have moved this child
 							// to the end of the list. We also need to restart everything once this container is done.
@@ -1021,12 +1592,478 @@ static void WM_Raise(GHandle gh) {
 			}
 		}
 	#endif
+}
 
+static void WM_Raise(GHandle gh) {
+	gfxSemWait(&gwinsem, TIME_INFINITE);
+	RaiseWindow(gh);
 	gfxSemSignal(&gwinsem);
-		
+
 	// Redraw the window
-	_gwinUpdate(gh);
+	ExposeWindow(gh);
+}
+
+#if GWIN_NEED_COMPOSITOR
+/*-----------------------------------------------
+ * Compositing Window Manager Routines
+ *-----------------------------------------------*/
+
+// This top level window couldn't get a back buffer and is drawn directly on the display
+#define GWIN_FLG_UNBUFFERED		(GWIN_FIRST_WM_FLAG << 1)
+
+// The number of pixels composited at a time
+#define COMPOSITE_SPAN			64
+
+// Is this a window that is composited onto this display
+#define COMPOSITED(gh, g)		((gh)->backbuf && (gh)->display == (g) && ((gh)->flags & GWIN_FLG_SYSVISIBLE))
+
+static void CM_Init(void);
+static void CM_DeInit(void);
+static void CM_Delete(GHandle gh);
+static void CM_Redraw(GHandle gh);
+static void CM_Size(GHandle gh, coord_t w, coord_t h);
+static void CM_Move(GHandle gh, coord_t x, coord_t y);
+static void CM_Raise(GHandle gh);
+static void CM_DrawStart(GHandle gh);
+static void CM_DrawEnd(GHandle gh);
+
+static const gwmVMT GCompositingWindowManagerVMT = {
+	CM_Init,
+	CM_DeInit,
+	WM_Add,
+	CM_Delete,
+	CM_Redraw,
+	CM_Size,
+	CM_Move,
+	CM_Raise,
+	WM_MinMax,
+	CM_DrawStart,
+	CM_DrawEnd,
+};
+
+GWindowManager	GCompositingWindowManager = {
+	&GCompositingWindowManagerVMT,
+};
+
+static pixel_t		CompositeLine[COMPOSITE_SPAN];	// Where each span of the display is put together
+static GHandle		RedirectWin;					// The window currently drawing into a back buffer
+static GDisplay *	CompDisplay;					// The display with an area waiting to be composited
+static coord_t		CompX0, CompY0, CompX1, CompY1;	// The area waiting to be composited
+
+static GHandle TopWindow(GHandle gh) {
+	#if GWIN_NEED_CONTAINERS
+		while(gh->parent)
+			gh = gh->parent;
+	#endif
+	return gh;
+}
+
+static void BufferFree(GHandle gh) {
+	if (gh->backbuf) {
+		gdispPixmapDelete(gh->backbuf);
+		gh->backbuf = 0;
+	}
+}
+
+// Point a window's drawing into its top level window's back buffer. Must be called with the drawing lock held.
+//	The window itself stays where it is so that anyone looking at it doesn't see it move.
+static void RedirectStart(GHandle gh, GHandle top) {
+	RedirectWin = gh;
+	gh->drawdisplay = top->backbuf;
+	gh->drawdx = top->x;
+	gh->drawdy = top->y;
+}
+
+static void RedirectEnd(void) {
+	if (!RedirectWin)
+		return;
+	RedirectWin->drawdisplay = 0;
+	RedirectWin->drawdx = RedirectWin->drawdy = 0;
+	RedirectWin = 0;
+}
+
+// Draw a window into its top level window's back buffer clipped to an area of the display
+static void BufferDraw(GHandle gh, GHandle top, uint32_t flags, coord_t x, coord_t y, coord_t cx, coord_t cy) {
+	gdispGSetClip(top->backbuf, x - top->x, y - top->y, cx, cy);
+	RedirectStart(gh, top);
+	if (gh->vmt->Redraw)
+		gh->vmt->Redraw(gh);
+	else if ((flags & GWIN_FLG_BGREDRAW)) {
+		// We can't redraw but we want full coverage so just clear the area
+		gdispGFillArea(gwinGetDrawDisplay(gh), gwinGetDrawX(gh), gwinGetDrawY(gh), gh->width, gh->height, gh->bgcolor);
+
+		// Only do an after clear if this is not a parent reveal
+		if (!(flags & GWIN_FLG_PARENTREVEAL) && gh->vmt->AfterClear)
+			gh->vmt->AfterClear(gh);
+	}
+	gdispGUnsetClip(top->backbuf);
+	RedirectEnd();
+}
+
+// Rebuild an area of the display from the back buffers. Must be called with the drawing lock held.
+static void CompositeArea(GDisplay *g, coord_t x, coord_t y, coord_t cx, coord_t cy) {
+	GHandle			gh, base;
+	bool_t			above;
+	const pixel_t	*src;
+	pixel_t			*dst;
+	color_t			bg;
+	coord_t			j, xs, n, x0, x1, y0, y1;
+
+	#define COVERS(gh, ax, ay, acx, acy)	((gh)->x <= (ax) && (gh)->y <= (ay) && (gh)->x+(gh)->width >= (ax)+(acx) && (gh)->y+(gh)->height >= (ay)+(acy))
+	#define OVERLAPS(gh, ax, ay, acx, acy)	((gh)->x < (ax)+(acx) && (gh)->y < (ay)+(acy) && (gh)->x+(gh)->width > (ax) && (gh)->y+(gh)->height > (ay))
+
+	// Find the top-most opaque window covering the whole area and whether anything is above it
+	for(base = 0, above = FALSE, gh = gwinGetNextWindow(0); gh; gh = gwinGetNextWindow(gh)) {
+		if (!COMPOSITED(gh, g) || !OVERLAPS(gh, x, y, cx, cy))
+			continue;
+		if (gh->opacity == 255 && COVERS(gh, x, y, cx, cy)) {
+			base = gh;
+			above = FALSE;
+		} else
+			above = TRUE;
+	}
+
+	// If it is the only window visible in the area just copy it
+	if (base && !above) {
+		gdispGBlitArea(g, x, y, cx, cy, x - base->x, y - base->y, base->width, gdispPixmapGetBits(base->backbuf));
+		goto unbuffered;
+	}
+
+	// Otherwise paint each span from the bottom up
+	bg = gwinGetDefaultBgColor();
+	for(j = y; j < y+cy; j++) {
+		for(xs = x; xs < x+cx; xs += n) {
+			n = x+cx - xs;
+			if (n > COMPOSITE_SPAN)
+				n = COMPOSITE_SPAN;
+
+			// Nothing under the top-most opaque window covering the span can be seen
+			for(base = 0, gh = gwinGetNextWindow(0); gh; gh = gwinGetNextWindow(gh)) {
+				if (COMPOSITED(gh, g) && gh->opacity == 255 && COVERS(gh, xs, j, n, 1))
+					base = gh;
+			}
+			if (!base) {
+				for(x0 = 0; x0 < n; x0++)
+					CompositeLine[x0] = bg;
+			}
+
+			for(gh = base ? base : gwinGetNextWindow(0); gh; gh = gwinGetNextWindow(gh)) {
+				if (!COMPOSITED(gh, g) || !OVERLAPS(gh, xs, j, n, 1))
+					continue;
+				x0 = gh->x > xs ? gh->x : xs;
+				x1 = gh->x+gh->width < xs+n ? gh->x+gh->width : xs+n;
+				src = gdispPixmapGetBits(gh->backbuf) + (j - gh->y) * gh->width + (x0 - gh->x);
+				dst = CompositeLine + (x0 - xs);
+				if (gh->opacity == 255)
+					memcpy(dst, src, (x1 - x0) * sizeof(pixel_t));
+				else {
+					for(; x0 < x1; x0++, src++, dst++)
+						*dst = gdispBlendColor(*src, *dst, gh->opacity);
+				}
+			}
+			gdispGBlitArea(g, xs, j, n, 1, 0, 0, n, CompositeLine);
+		}
+	}
+
+unbuffered:
+	// Windows without a back buffer have just been painted over so they need to draw themselves again.
+	//	Like the null window manager they draw over anything above them unless it completely covers them.
+	for(base = gwinGetNextWindow(0); base; base = gwinGetNextWindow(base)) {
+		if ((base->flags & (GWIN_FLG_UNBUFFERED|GWIN_FLG_SYSVISIBLE)) != (GWIN_FLG_UNBUFFERED|GWIN_FLG_SYSVISIBLE)
+				|| base->display != g || !OVERLAPS(base, x, y, cx, cy))
+			continue;
+
+		// The part of the area it covers
+		x0 = base->x > x ? base->x : x;
+		x1 = base->x+base->width < x+cx ? base->x+base->width : x+cx;
+		y0 = base->y > y ? base->y : y;
+		y1 = base->y+base->height < y+cy ? base->y+base->height : y+cy;
+
+		for(gh = gwinGetNextWindow(base); gh; gh = gwinGetNextWindow(gh)) {
+			if (COMPOSITED(gh, g) && gh->opacity == 255 && COVERS(gh, x0, y0, x1-x0, y1-y0))
+				break;
+		}
+		if (!gh)
+			ExposeArea(base, x0 - base->x, y0 - base->y, x1 - x0, y1 - y0);
+	}
+
+	#undef COVERS
+	#undef OVERLAPS
+}
+
+// Composite the area that has been drawn since the last time. Must be called with the drawing lock held.
+static GDisplay *CompositePending(void) {
+	GDisplay *	g;
+
+	RedrawPending &= ~DOREDRAW_COMPOSITE;
+	if (!(g = CompDisplay))
+		return 0;
+	CompDisplay = 0;
+	CompositeArea(g, CompX0, CompY0, CompX1 - CompX0, CompY1 - CompY0);
+	return g;
+}
+
+#if !GWIN_REDRAW_IMMEDIATE
+// Add an area of the display to what will be composited by the next redraw pass
+static void CompositeLater(GDisplay *g, coord_t x, coord_t y, coord_t cx, coord_t cy) {
+	// Only one display at a time
+	if (CompDisplay && CompDisplay != g)
+		CompositePending();
+
+	if (!CompDisplay) {
+		CompDisplay = g;
+		CompX0 = x;
+		CompY0 = y;
+		CompX1 = x + cx;
+		CompY1 = y + cy;
+	} else {
+		if (x < CompX0)				CompX0 = x;
+		if (y < CompY0)				CompY0 = y;
+		if (x + cx > CompX1)		CompX1 = x + cx;
+		if (y + cy > CompY1)		CompY1 = y + cy;
+	}
+	// _gwinDrawEnd() starts the redraw timer once the drawing lock has been released
+	RedrawPending |= DOREDRAW_COMPOSITE;
+}
+#endif
+
+static void CM_Init(void) {
+	GHandle		gh;
+
+	// Draw every visible top level window into a back buffer
+	for(gh = gwinGetNextWindow(0); gh; gh = gwinGetNextWindow(gh)) {
+		if (gh == TopWindow(gh))
+			ExposeWindow(gh);
+	}
 }
 
+static void CM_DeInit(void) {
+	GHandle		gh;
+
+	// Throw away the back buffers and mark the top level windows for the new window manager to redraw
+	gfxSemWait(&gwinsem, TIME_INFINITE);
+	CompDisplay = 0;
+	RedrawPending &= ~DOREDRAW_COMPOSITE;
+	for(gh = gwinGetNextWindow(0); gh; gh = gwinGetNextWindow(gh)) {
+		gh->flags &= ~GWIN_FLG_UNBUFFERED;
+		BufferFree(gh);
+		if (gh == TopWindow(gh) && (gh->flags & GWIN_FLG_SYSVISIBLE)) {
+			gh->flags |= GWIN_FLG_NEEDREDRAW;
+			gh->dirtycx = 0;
+			RedrawPending |= DOREDRAW_VISIBLES;
+		}
+	}
+	gfxSemSignal(&gwinsem);
+}
+
+static void CM_Delete(GHandle gh) {
+	WM_Delete(gh);
+	BufferFree(gh);
+}
+
+static void CM_Redraw(GHandle gh) {
+	GHandle		top, gx;
+	uint32_t	flags;
+
+	top = TopWindow(gh);
+
+	if (gh == top) {
+		if (!(gh->flags & GWIN_FLG_SYSVISIBLE)) {
+			// Hiding a top level window just uncovers what is underneath it
+			gh->flags &= ~(GWIN_FLG_NEEDREDRAW|GWIN_FLG_BGREDRAW|GWIN_FLG_PARENTREVEAL|GWIN_FLG_UNBUFFERED);
+			BufferFree(gh);
+			CompositeArea(gh->display, gh->x, gh->y, gh->width, gh->height);
+			return;
+		}
+
+		// Make sure we have a back buffer of the right size. A new one needs to be completely drawn.
+		if (gh->backbuf && (gdispGGetWidth(gh->backbuf) != gh->width || gdispGGetHeight(gh->backbuf) != gh->height))
+			BufferFree(gh);
+		if (!gh->backbuf) {
+			if ((gh->backbuf = gdispPixmapCreate(gh->width, gh->height))) {
+				gh->flags &= ~GWIN_FLG_UNBUFFERED;
+				gh->flags |= GWIN_FLG_BGREDRAW;
+				DamageAll(gh);
+			} else
+				gh->flags |= GWIN_FLG_UNBUFFERED;
+		}
+	}
+
+	// Without a back buffer we draw directly just like the null window manager
+	if ((top->flags & GWIN_FLG_UNBUFFERED)) {
+		WM_Redraw(gh);
+		return;
+	}
+
+	flags = gh->flags;
+	gh->flags &= ~(GWIN_FLG_NEEDREDRAW|GWIN_FLG_BGREDRAW|GWIN_FLG_PARENTREVEAL);
+
+	// If our top level window hasn't been drawn yet we will be drawn with it
+	if (!top->backbuf) {
+		ExposeWindow(top);
+		return;
+	}
+
+	if ((flags & GWIN_FLG_SYSVISIBLE)) {
+		// Just the damaged area
+		BufferDraw(gh, top, flags, gh->x+gh->dirtyx, gh->y+gh->dirtyy, gh->dirtycx, gh->dirtycy);
+
+		#if GWIN_NEED_CONTAINERS
+			// A container has overwritten its children so they need to be drawn again
+			if ((flags & GWIN_FLG_CONTAINER)) {
+				for(gx = gwinGetFirstChild(gh); gx; gx = gwinGetSibling(gx))
+					ExposeArea(gx, gh->x+gh->dirtyx-gx->x, gh->y+gh->dirtyy-gx->y, gh->dirtycx, gh->dirtycy);
+			}
+		#endif
+		CompositeArea(top->display, gh->x+gh->dirtyx, gh->y+gh->dirtyy, gh->dirtycx, gh->dirtycy);
+		return;
+
+	} else if ((flags & GWIN_FLG_BGREDRAW)) {
+		// A child has been hidden. Repaint its area from everything in the top level window underneath it.
+		for(gx = gwinGetNextWindow(0); gx; gx = gwinGetNextWindow(gx)) {
+			if ((gx->flags & GWIN_FLG_SYSVISIBLE) && TopWindow(gx) == top
+					&& gx->x < gh->x+gh->width && gx->y < gh->y+gh->height && gx->x+gx->width > gh->x && gx->y+gx->height > gh->y)
+				BufferDraw(gx, top, GWIN_FLG_BGREDRAW|GWIN_FLG_PARENTREVEAL, gh->x, gh->y, gh->width, gh->height);
+		}
+
+	} else
+		return;
+
+	CompositeArea(top->display, gh->x, gh->y, gh->width, gh->height);
+}
+
+static void CM_Size(GHandle gh, coord_t w, coord_t h) {
+	WM_Size(gh, w, h);
+
+	// A back buffer of the wrong size can't be composited. The window gets a new one when it is redrawn.
+	if (gh->backbuf) {
+		gfxSemWait(&gwinsem, TIME_INFINITE);
+		if (gh->backbuf && (gdispGGetWidth(gh->backbuf) != gh->width || gdispGGetHeight(gh->backbuf) != gh->height))
+			BufferFree(gh);
+		gfxSemSignal(&gwinsem);
+	}
+}
+
+static void CM_Move(GHandle gh, coord_t x, coord_t y) {
+	GHandle		gx;
+	coord_t		u, v;
+	coord_t		ox, oy;
+
+	// Child windows and unbuffered windows get moved by redrawing them
+	if (gh != TopWindow(gh) || ((gh->flags & GWIN_FLG_SYSVISIBLE) && !gh->backbuf)) {
+		WM_Move(gh, x, y);
+		return;
+	}
+
+	// Make sure we are positioned on the screen
+	u = gdispGGetWidth(gh->display);
+	v = gdispGGetHeight(gh->display);
+	if (x+gh->width > u)	x = u-gh->width;
+	if (x < 0) x = 0;
+	if (y+gh->height > v)	y = v-gh->height;
+	if (y < 0) y = 0;
+
+	// Make sure we don't overflow the screen
+	u -= x;
+	v -= y;
+	if (gh->width < u)	u = gh->width;
+	if (gh->height < v)	v = gh->height;
+	if (u != gh->width || v != gh->height)
+		CM_Size(gh, u, v);
+
+	// If there has been no move just exit
+	if (gh->x == x && gh->y == y)
+		return;
+
+	gfxSemWait(&gwinsem, TIME_INFINITE);
+
+	// Move the window and everything in it. The back buffer is still correct.
+	ox = gh->x;
+	oy = gh->y;
+	for(gx = gwinGetNextWindow(0); gx; gx = gwinGetNextWindow(gx)) {
+		if (TopWindow(gx) != gh)
+			continue;
+		gx->x += x - ox;
+		gx->y += y - oy;
+		#if GWIN_NEED_SPATIAL_INDEX
+			_gwinIndexUpdate(gx);
+		#endif
+	}
+
+	// Rebuild the old and new areas of the display
+	if ((gh->flags & GWIN_FLG_SYSVISIBLE)) {
+		u = x > ox ? x - ox : ox - x;
+		v = y > oy ? y - oy : oy - y;
+		if (u < gh->width && v < gh->height) {
+			// They overlap - do them together
+			CompositeArea(gh->display, x < ox ? x : ox, y < oy ? y : oy, gh->width + u, gh->height + v);
+		} else {
+			CompositeArea(gh->display, ox, oy, gh->width, gh->height);
+			CompositeArea(gh->display, x, y, gh->width, gh->height);
+		}
+	}
+
+	gfxSemSignal(&gwinsem);
+
+	// Windows without a back buffer may need to draw themselves again
+	_gwinFlushRedraws(REDRAW_WAIT);
+}
+
+static void CM_Raise(GHandle gh) {
+	gfxSemWait(&gwinsem, TIME_INFINITE);
+	RaiseWindow(gh);
+
+	// A top level window just needs its area rebuilt
+	if (gh == TopWindow(gh) && gh->backbuf) {
+		if ((gh->flags & GWIN_FLG_SYSVISIBLE))
+			CompositeArea(gh->display, gh->x, gh->y, gh->width, gh->height);
+		gfxSemSignal(&gwinsem);
+		_gwinFlushRedraws(REDRAW_WAIT);
+		return;
+	}
+	gfxSemSignal(&gwinsem);
+
+	// Redraw the window
+	ExposeWindow(gh);
+}
+
+static void CM_DrawStart(GHandle gh) {
+	GHandle		top;
+
+	// Draw into the back buffer (if there is one)
+	top = TopWindow(gh);
+	if (top->backbuf)
+		RedirectStart(gh, top);
+}
+
+static void CM_DrawEnd(GHandle gh) {
+	if (RedirectWin != gh)
+		return;
+	RedirectEnd();
+
+	// Unless we have been asked to draw immediately many drawing sessions get composited together
+	#if GWIN_REDRAW_IMMEDIATE
+		CompositeArea(gh->display, gh->x, gh->y, gh->width, gh->height);
+	#else
+		CompositeLater(gh->display, gh->x, gh->y, gh->width, gh->height);
+	#endif
+}
+
+void gwinSetOpacity(GHandle gh, uint8_t alpha) {
+	if (gh->opacity == alpha)
+		return;
+	gh->opacity = alpha;
+
+	// Rebuild the area of the display it covers
+	if (_GWINwm == &GCompositingWindowManager && gh->backbuf) {
+		gfxSemWait(&gwinsem, TIME_INFINITE);
+		if ((gh->flags & GWIN_FLG_SYSVISIBLE))
+			CompositeArea(gh->display, gh->x, gh->y, gh->width, gh->height);
+		gfxSemSignal(&gwinsem);
+		_gwinFlushRedraws(REDRAW_WAIT);
+	}
+}
+#endif
+
 #endif /* GFX_USE_GWIN && GWIN_NEED_WINDOWMANAGER */
 /** @} */
@@ -47,6 +47,166 @@ static char *clean4c(char *fname) {
 	return fname;
 }
 
+/**
+ * Native image compression.
+ *
+ * A native image ("NI") is an 8 byte header followed by the raw pixels in the display pixel format.
+ * A compressed native image ("NC") has the same header (with the second byte changed to 'C') followed by...
+ *		byte 8		The number of bytes per pixel
+ *		byte 9		The number of pixel rows compressed together as a block
+ *		byte 10-11	Reserved (0)
+ *		byte 12		A table of (blocks+1) 32 bit big endian offsets (relative to the end of the table)
+ *					giving the start of each compressed block. The last entry is the total data length.
+ * Each block is independently compressed using LZ4 style sequences so any block can be decoded
+ * without decoding the blocks before it.
+ */
+#define NC_MINMATCH		4
+#define NC_MAXOFFSET	65535
+#define NC_HASHBITS		12
+
+static unsigned nchash(const unsigned char *p) {
+	unsigned long	v;
+
+	v = (unsigned long)p[0] | ((unsigned long)p[1] << 8) | ((unsigned long)p[2] << 16) | ((unsigned long)p[3] << 24);
+	return (unsigned)(((v * 2654435761UL) & 0xFFFFFFFFUL) >> (32 - NC_HASHBITS));
+}
+
+static unsigned char *ncputlen(unsigned char *d, size_t len) {
+	for(; len >= 255; len -= 255)
+		*d++ = 255;
+	*d++ = (unsigned char)len;
+	return d;
+}
+
+static unsigned char *ncputseq(unsigned char *d, const unsigned char *lit, size_t litlen, size_t off, size_t mlen) {
+	unsigned char	*tok;
+
+	tok = d++;
+	*tok = (unsigned char)((litlen >= 15 ? 15 : litlen) << 4);
+	if (litlen >= 15)
+		d = ncputlen(d, litlen - 15);
+	memcpy(d, lit, litlen);
+	d += litlen;
+	if (mlen) {
+		*d++ = (unsigned char)off;
+		*d++ = (unsigned char)(off >> 8);
+		mlen -= NC_MINMATCH;
+		*tok |= (unsigned char)(mlen >= 15 ? 15 : mlen);
+		if (mlen >= 15)
+			d = ncputlen(d, mlen - 15);
+	}
+	return d;
+}
+
+static size_t nccompressblock(const unsigned char *src, size_t len, unsigned char *dst) {
+	static long		ht[1 << NC_HASHBITS];
+	unsigned char	*d;
+	size_t			i, anchor, m;
+	long			cand;
+	unsigned		h;
+
+	for(h = 0; h < (1 << NC_HASHBITS); h++)
+		ht[h] = -1;
+	d = dst;
+	for(i = anchor = 0; i + NC_MINMATCH <= len;) {
+		h = nchash(src+i);
+		cand = ht[h];
+		ht[h] = (long)i;
+		if (cand < 0 || i - cand > NC_MAXOFFSET || memcmp(src+cand, src+i, NC_MINMATCH)) {
+			i++;
+			continue;
+		}
+		for(m = NC_MINMATCH; i + m < len && src[cand+m] == src[i+m]; m++);
+		d = ncputseq(d, src+anchor, i-anchor, i-cand, m);
+		for(anchor = i + m, i++; i < anchor && i + NC_MINMATCH <= len; i++)
+			ht[nchash(src+i)] = (long)i;
+		i = anchor;
+	}
+	if (anchor < len)
+		d = ncputseq(d, src+anchor, len-anchor, 0, 0);
+	return d - dst;
+}
+
+static FILE *nccompress(FILE *f_input, unsigned blockrows) {
+	unsigned char	hdr[12];
+	unsigned char	*src, *dst, *tbl;
+	size_t			width, height, bpp, len, rowlen, blocks, b, rows, pos;
+	FILE *			f_nc;
+
+	/* Read the native image header */
+	if (fread(hdr, 1, 8, f_input) != 8 || hdr[0] != 'N' || hdr[1] != 'I') {
+		fprintf(stderr, "The input file is not a native (NI) image\n");
+		return 0;
+	}
+	width = ((size_t)hdr[2] << 8) | hdr[3];
+	height = ((size_t)hdr[4] << 8) | hdr[5];
+	if (!width || !height) {
+		fprintf(stderr, "Bad native image dimensions\n");
+		return 0;
+	}
+
+	/* Read the pixels and work out the pixel size from the data length */
+	for(src = 0, len = 0; ; len += b) {
+		if (!(src = realloc(src, len + sizeof(buf)))) {
+			fprintf(stderr, "Out of memory\n");
+			return 0;
+		}
+		if (!(b = fread(src+len, 1, sizeof(buf), f_input)))
+			break;
+	}
+	bpp = len / (width * height);
+	if (!bpp || bpp > 255 || len != bpp * width * height) {
+		fprintf(stderr, "The native image data length does not match its dimensions\n");
+		free(src);
+		return 0;
+	}
+	if (!blockrows || blockrows > 255)
+		blockrows = 1;
+	rowlen = width * bpp;
+	blocks = (height + blockrows - 1) / blockrows;
+
+	/* Worst case is a little bigger than the input */
+	if (!(dst = malloc(len + len/255 + blocks*16 + 16)) || !(tbl = malloc((blocks+1)*4))) {
+		fprintf(stderr, "Out of memory\n");
+		free(src);
+		return 0;
+	}
+
+	/* Compress each block */
+	for(b = 0, pos = 0; b < blocks; b++) {
+		tbl[b*4+0] = (unsigned char)(pos >> 24);
+		tbl[b*4+1] = (unsigned char)(pos >> 16);
+		tbl[b*4+2] = (unsigned char)(pos >> 8);
+		tbl[b*4+3] = (unsigned char)pos;
+		rows = height - b * blockrows;
+		if (rows > blockrows)
+			rows = blockrows;
+		pos += nccompressblock(src + b * blockrows * rowlen, rows * rowlen, dst + pos);
+	}
+	tbl[b*4+0] = (unsigned char)(pos >> 24);
+	tbl[b*4+1] = (unsigned char)(pos >> 16);
+	tbl[b*4+2] = (unsigned char)(pos >> 8);
+	tbl[b*4+3] = (unsigned char)pos;
+
+	/* Write the compressed image to a temporary file */
+	hdr[1] = 'C';
+	hdr[8] = (unsigned char)bpp;
+	hdr[9] = (unsigned char)blockrows;
+	hdr[10] = hdr[11] = 0;
+	if ((f_nc = tmpfile())) {
+		fwrite(hdr, 1, 12, f_nc);
+		fwrite(tbl, 1, (blocks+1)*4, f_nc);
+		fwrite(dst, 1, pos, f_nc);
+		rewind(f_nc);
+		fprintf(stderr, "Compressed %u bytes to %u bytes\n", (unsigned)(len+8), (unsigned)(pos+12+(blocks+1)*4));
+	} else
+		fprintf(stderr, "Could not create a temporary file\n");
+	free(tbl);
+	free(dst);
+	free(src);
+	return f_nc;
+}
+
 int main(int argc, char * argv[])
 {
 char *		opt_progname;
@@ -56,6 +216,8 @@ char *		opt_arrayname;
 char *		opt_dirname;
 int			opt_breakblocks;
 int			opt_romdir;
+int			opt_compress;
+unsigned	opt_blockrows;
 char *		opt_static;
 char *		opt_const;
 FILE *		f_input;
@@ -67,7 +229,8 @@ size_t		i;
 	/* Default values for our parameters */
 	opt_progname = basenameof(argv[0]);
 	opt_inputfile = opt_outputfile = opt_arrayname = opt_dirname = 0;
-	opt_breakblocks = opt_romdir = 0;
+	opt_breakblocks = opt_romdir = opt_compress = 0;
+	opt_blockrows = 1;
 	opt_static = opt_const = "";
 
 	/* Read the arguments */
@@ -80,6 +243,8 @@ size_t		i;
 				case 'b':		opt_breakblocks = 1;					break;
 				case 'c':		opt_const = "const ";					break;
 				case 's':		opt_static = "static ";					break;
+				case 'z':		opt_compress = 1;						break;
+				case 'r':		opt_blockrows = atoi(*++argv);			goto nextarg;
 				case 'n':		opt_arrayname = *++argv;				goto nextarg;
 				case 'f':		opt_romdir = 1; opt_dirname = *++argv;	goto nextarg;
 				default:
@@ -94,15 +259,17 @@ size_t		i;
 		else {
 			usage:
 			fprintf(stderr, "Usage:\n\n%s -?\n"
-							"%s [-dbcs] [-n name] [-f file] [inputfile] [outputfile]\n"
+							"%s [-dbcsz] [-n name] [-f file] [-r rows] [inputfile] [outputfile]\n"
 							"\t-?\tThis help\n"
 							"\t-h\tThis help\n"
 							"\t-d\tAdd a directory entry for the ROM file system\n"
 							"\t-b\tBreak the arrays for compilers that won't handle large arrays\n"
 							"\t-c\tDeclare as const (useful to ensure they end up in Flash)\n"
 							"\t-s\tDeclare as static\n"
+							"\t-z\tCompress a native (NI) image into a compressed native (NC) image\n"
 							"\t-n name\tUse \"name\" as the name of the array\n"
 							"\t-f file\tUse \"file\" as the filename in the ROM directory entry\n"
+							"\t-r rows\tCompress \"rows\" pixel rows together for -z (1 to 255, default 1)\n"
 					, opt_progname, opt_progname);
 			return 1;
 		}
@@ -134,6 +301,17 @@ size_t		i;
 #endif
 	}
 
+	/* Compress the native image if required */
+	if (opt_compress) {
+		FILE *	f_nc;
+
+		if (!(f_nc = nccompress(f_input, opt_blockrows)))
+			return 1;
+		if (f_input != stdin)
+			fclose(f_input);
+		f_input = f_nc;
+	}
+
 	/* Open the output file */
 	if (opt_outputfile) {
 		f_output = fopen(opt_outputfile, "w");
@@ -148,14 +326,16 @@ size_t		i;
 	fprintf(f_output, "/**\n * This file was generated ");
 	if (opt_inputfile) fprintf(f_output, "from \"%s\" ", opt_inputfile);
 	fprintf(f_output, "using...\n *\n *\t%s", opt_progname);
-	if (opt_arrayname || opt_static[0] || opt_const[0] || opt_breakblocks || opt_romdir) {
+	if (opt_arrayname || opt_static[0] || opt_const[0] || opt_breakblocks || opt_romdir || opt_compress) {
 		fprintf(f_output, " -");
 		if (opt_romdir)  fprintf(f_output, "d");
 		if (opt_breakblocks) fprintf(f_output, "b");
 		if (opt_const[0]) fprintf(f_output, "c");
 		if (opt_static[0]) fprintf(f_output, "s");
+		if (opt_compress) fprintf(f_output, "z");
 		if (opt_arrayname) fprintf(f_output, "n %s", opt_arrayname);
 		if (opt_dirname) fprintf(f_output, (opt_arrayname ? " -f %s" : "f %s"), opt_dirname);
+		if (opt_compress && opt_blockrows != 1) fprintf(f_output, " -r %u", opt_blockrows);
 	}
 	if (opt_inputfile) fprintf(f_output, " %s", opt_inputfile);
 	if (opt_outputfile) fprintf(f_output, " %s", opt_outputfile);